@@ -0,0 +1,249 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+#define AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+
+#include "autoware/universe_utils/geometry/geometry.hpp"
+
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace autoware::motion_utils
+{
+/**
+ * @brief search structure built once from the points of a trajectory, path, ...
+ * It holds the cumulative arc length, the yaw of each point and R-trees of the points, so that the
+ * overloads of the trajectory queries below do not scan all the points on every call.
+ * The overloads return the same results as the functions taking the points container, except for
+ * rounding errors of the arc length which is computed as a difference of cumulative sums.
+ * The index does not refer to the points container, so it must be rebuilt when the points change.
+ */
+class TrajectoryIndex
+{
+public:
+  TrajectoryIndex() { build({}); }
+
+  /**
+   * @brief build the index from points of trajectory, path, ...
+   * @param points points of trajectory, path, ...
+   */
+  template <class T>
+  explicit TrajectoryIndex(const T & points)
+  {
+    std::vector<geometry_msgs::msg::Pose> poses;
+    poses.reserve(points.size());
+    for (const auto & point : points) {
+      poses.push_back(autoware::universe_utils::getPose(point));
+    }
+    build(poses);
+  }
+
+  /**
+   * @brief number of points
+   */
+  size_t size() const;
+
+  /**
+   * @brief true if built from empty points
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief pose of the idx-th point
+   */
+  const geometry_msgs::msg::Pose & pose(const size_t idx) const;
+
+  /**
+   * @brief arc length from the first point to the idx-th point
+   */
+  double arc_length(const size_t idx) const;
+
+  /**
+   * @brief find the nearest point. The smallest index is returned when several points have the
+   * same distance, as findNearestIndex(points, point) does.
+   */
+  size_t find_nearest_index(const geometry_msgs::msg::Point & point) const;
+
+  /**
+   * @brief find the nearest point. The largest index is returned when several points have the
+   * same distance, as findNearestIndex(points, point) does on the reversed points.
+   */
+  size_t find_last_nearest_index(const geometry_msgs::msg::Point & point) const;
+
+  /**
+   * @brief find the nearest point whose distance and yaw deviation are within the thresholds
+   */
+  std::optional<size_t> find_nearest_index(
+    const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw) const;
+
+  /**
+   * @brief indices of the points which remain after removeOverlapPoints(points, 0)
+   */
+  const std::vector<size_t> & overlap_removed_indices() const;
+
+  /**
+   * @brief find the nearest point among the points after removeOverlapPoints(points, 0)
+   * @return index in overlap_removed_indices()
+   */
+  size_t find_nearest_overlap_removed_index(const geometry_msgs::msg::Point & point) const;
+
+private:
+  struct Impl;
+
+  void build(const std::vector<geometry_msgs::msg::Pose> & poses);
+
+  std::shared_ptr<const Impl> impl_;
+};
+
+/**
+ * @brief find nearest point index using the index. Same as findNearestIndex(points, point).
+ * @param index index built from points of trajectory, path, ...
+ * @param point given point
+ * @return index of nearest point
+ */
+size_t findNearestIndex(const TrajectoryIndex & index, const geometry_msgs::msg::Point & point);
+
+/**
+ * @brief find nearest point index with distance and yaw thresholds using the index. Same as
+ * findNearestIndex(points, pose, max_dist, max_yaw).
+ * @param index index built from points of trajectory, path, ...
+ * @param pose given pose
+ * @param max_dist max distance used to get squared distance for finding the nearest point to given
+ * pose
+ * @param max_yaw max yaw used for finding nearest point to given pose
+ * @return index of nearest point (index or none if not found)
+ */
+std::optional<size_t> findNearestIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max());
+
+/**
+ * @brief calculate longitudinal offset (length along trajectory from seg_idx point to nearest point
+ * to p_target on trajectory) using the index. Same as calcLongitudinalOffsetToSegment(points,
+ * seg_idx, p_target, throw_exception).
+ * @param index index built from points of trajectory, path, ...
+ * @param seg_idx segment index of point at beginning of length
+ * @param p_target target point at end of length
+ * @param throw_exception flag to enable/disable exception throwing
+ * @return signed length
+ */
+double calcLongitudinalOffsetToSegment(
+  const TrajectoryIndex & index, const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception = false);
+
+/**
+ * @brief find nearest segment index to point using the index. Same as
+ * findNearestSegmentIndex(points, point).
+ * @param index index built from points of trajectory, path, ...
+ * @param point point to which to find nearest segment index
+ * @return nearest index
+ */
+size_t findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point);
+
+/**
+ * @brief find nearest segment index to pose using the index. Same as
+ * findNearestSegmentIndex(points, pose, max_dist, max_yaw).
+ * @param index index built from points of trajectory, path, ...
+ * @param pose pose to which to find nearest segment index
+ * @param max_dist max distance used for finding the nearest index to given pose
+ * @param max_yaw max yaw used for finding nearest index to given pose
+ * @return nearest index
+ */
+std::optional<size_t> findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max());
+
+/**
+ * @brief calculate lateral offset from p_target using the index. Same as calcLateralOffset(points,
+ * p_target, throw_exception).
+ * @param index index built from points of trajectory, path, ...
+ * @param p_target target point
+ * @param throw_exception flag to enable/disable exception throwing
+ * @return length (unsigned)
+ */
+double calcLateralOffset(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception = false);
+
+/**
+ * @brief calculate length of 2D distance between two points using the cumulative arc length. Same
+ * as calcSignedArcLength(points, src_idx, dst_idx).
+ * @param index index built from points of trajectory, path, ...
+ * @param src_idx index of start point
+ * @param dst_idx index of end point
+ * @return length of distance between two points.
+ */
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx, const size_t dst_idx);
+
+/**
+ * @brief calculate length of 2D distance between two points using the index. Same as
+ * calcSignedArcLength(points, src_point, dst_idx).
+ */
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const size_t dst_idx);
+
+/**
+ * @brief calculate length of 2D distance between two points using the index. Same as
+ * calcSignedArcLength(points, src_idx, dst_point).
+ */
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx,
+  const geometry_msgs::msg::Point & dst_point);
+
+/**
+ * @brief calculate length of 2D distance between two points using the index. Same as
+ * calcSignedArcLength(points, src_point, dst_point).
+ */
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const geometry_msgs::msg::Point & dst_point);
+
+/**
+ * @brief calculate the point offset from source point index by a binary search of the cumulative
+ * arc length. Same as calcLongitudinalOffsetPoint(points, src_idx, offset, throw_exception).
+ * @param index index built from points of trajectory, path, ...
+ * @param src_idx index of source point
+ * @param offset length of offset from source point
+ * @param throw_exception flag to enable/disable exception throwing
+ * @return offset point
+ */
+std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+  const TrajectoryIndex & index, const size_t src_idx, const double offset,
+  const bool throw_exception = false);
+
+/**
+ * @brief calculate the point offset from source point using the index. Same as
+ * calcLongitudinalOffsetPoint(points, src_point, offset).
+ * @param index index built from points of trajectory, path, ...
+ * @param src_point source point
+ * @param offset length of offset from source point
+ * @return offset point
+ */
+std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const double offset);
+}  // namespace autoware::motion_utils
+
+#endif  // AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
@@ -17,8 +17,7 @@
 #include "autoware/motion_utils/resample/resample_utils.hpp"
 #include "autoware/motion_utils/trajectory/trajectory.hpp"
 #include "autoware/universe_utils/geometry/geometry.hpp"
-#include "interpolation/linear_interpolation.hpp"
-#include "interpolation/spline_interpolation.hpp"
+#include "interpolation/batch_interpolation.hpp"
 #include "interpolation/zero_order_hold.hpp"
 
 namespace autoware::motion_utils
@@ -58,14 +57,13 @@ std::vector<geometry_msgs::msg::Point> resamplePointVector(
   }
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-  const auto spline = [&](const auto & input) {
-    return interpolation::spline(input_arclength, input, resampled_arclength);
-  };
+  // NOTE: x, y and z share the arc length, so that the segments of the resampled points are
+  //       searched only once.
+  const interpolation::BatchInterpolation interpolator(input_arclength, resampled_arclength);
+  const auto lerp = [&](const auto & input) { return interpolator.lerp(input); };
+  const auto spline = [&](const auto & input) { return interpolator.spline(input); };
   const auto spline_by_akima = [&](const auto & input) {
-    return interpolation::splineByAkima(input_arclength, input, resampled_arclength);
+    return interpolator.splineByAkima(input);
   };
 
   const auto interpolated_x = use_akima_spline_for_xy ? lerp(x) : spline_by_akima(x);
@@ -277,9 +275,8 @@ tier4_planning_msgs::msg::PathWithLaneId resamplePath(
   }
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampling_arclength);
-  };
+  const interpolation::BatchInterpolation interpolator(input_arclength, resampling_arclength);
+  const auto lerp = [&](const auto & input) { return interpolator.lerp(input); };
 
   auto closest_segment_indices =
     interpolation::calc_closest_segment_indices(input_arclength, resampling_arclength);
@@ -459,9 +456,8 @@ autoware_planning_msgs::msg::Path resamplePath(
   }
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
+  const interpolation::BatchInterpolation interpolator(input_arclength, resampled_arclength);
+  const auto lerp = [&](const auto & input) { return interpolator.lerp(input); };
 
   std::vector<size_t> closest_segment_indices;
   if (use_zero_order_hold_for_v) {
@@ -618,9 +614,8 @@ autoware_planning_msgs::msg::Trajectory resampleTrajectory(
   }
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
+  const interpolation::BatchInterpolation interpolator(input_arclength, resampled_arclength);
+  const auto lerp = [&](const auto & input) { return interpolator.lerp(input); };
 
   std::vector<size_t> closest_segment_indices;
   if (use_zero_order_hold_for_twist) {
@@ -0,0 +1,627 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/universe_utils/geometry/boost_geometry.hpp"
+#include "autoware/universe_utils/math/normalization.hpp"
+#include "autoware/universe_utils/system/backtrace.hpp"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <tf2/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace autoware::motion_utils
+{
+namespace bgi = boost::geometry::index;
+using autoware::universe_utils::Point2d;
+
+namespace
+{
+using PointRtree = bgi::rtree<std::pair<Point2d, size_t>, bgi::rstar<16>>;
+
+// same threshold as removeOverlapPoints()
+constexpr double overlap_eps = 1.0E-08;
+
+// relative margin so that the candidates from the R-tree include all the points whose distance
+// computed by calcSquaredDistance2d() is the minimum
+constexpr double distance_margin = 1.0E-09;
+
+bool isOverlapping(const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2)
+{
+  return std::abs(p1.x - p2.x) < overlap_eps && std::abs(p1.y - p2.y) < overlap_eps;
+}
+
+PointRtree createRtree(
+  const std::vector<geometry_msgs::msg::Pose> & poses, const std::vector<size_t> & indices)
+{
+  std::vector<std::pair<Point2d, size_t>> values;
+  values.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto & p = poses.at(indices.at(i)).position;
+    values.emplace_back(Point2d(p.x, p.y), i);
+  }
+  // packing algorithm of the constructor is faster to build and to query than insertion
+  return PointRtree(values.begin(), values.end());
+}
+
+/**
+ * @brief find the nearest point in the R-tree. The smallest index is returned among the points
+ * with the same distance, or the largest one if is_last is true.
+ * @return index of the value in the R-tree
+ */
+size_t findNearestInRtree(
+  const PointRtree & rtree, const std::vector<geometry_msgs::msg::Pose> & poses,
+  const std::vector<size_t> & indices, const geometry_msgs::msg::Point & point,
+  const bool is_last = false)
+{
+  const auto calc_squared_distance = [&](const size_t i) {
+    return autoware::universe_utils::calcSquaredDistance2d(poses.at(indices.at(i)), point);
+  };
+
+  std::vector<std::pair<Point2d, size_t>> nearest;
+  rtree.query(bgi::nearest(Point2d(point.x, point.y), 1), std::back_inserter(nearest));
+  const auto nearest_dist = std::sqrt(calc_squared_distance(nearest.front().second));
+
+  // collect all the points which may have the same distance
+  const double radius = nearest_dist * (1.0 + distance_margin) + distance_margin;
+  const autoware::universe_utils::Box2d box(
+    Point2d(point.x - radius, point.y - radius), Point2d(point.x + radius, point.y + radius));
+  std::vector<std::pair<Point2d, size_t>> candidates;
+  rtree.query(bgi::intersects(box), std::back_inserter(candidates));
+  std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+    return a.second < b.second;
+  });
+
+  double min_dist = std::numeric_limits<double>::max();
+  size_t min_idx = nearest.front().second;
+  for (const auto & candidate : candidates) {
+    const auto dist = calc_squared_distance(candidate.second);
+    if (dist < min_dist || (is_last && dist == min_dist)) {
+      min_dist = dist;
+      min_idx = candidate.second;
+    }
+  }
+  return min_idx;
+}
+
+/**
+ * @brief same as calcLongitudinalOffsetToSegment(reversed points, size - 1 - front_idx, p_target),
+ * whose segment runs from front_idx to the previous point which does not overlap
+ * @return signed length, or NaN if there is no such segment
+ */
+double calcLongitudinalOffsetToBackwardSegment(
+  const TrajectoryIndex & index, const size_t front_idx, const geometry_msgs::msg::Point & p_target)
+{
+  const auto & p_front = index.pose(front_idx).position;
+  size_t back_idx = front_idx;
+  while (back_idx > 0 && isOverlapping(p_front, index.pose(back_idx - 1).position)) {
+    --back_idx;
+  }
+  if (back_idx == 0) {
+    return std::nan("");
+  }
+
+  const auto & p_back = index.pose(back_idx - 1).position;
+
+  const Eigen::Vector3d segment_vec{p_back.x - p_front.x, p_back.y - p_front.y, 0};
+  const Eigen::Vector3d target_vec{p_target.x - p_front.x, p_target.y - p_front.y, 0};
+
+  return segment_vec.dot(target_vec) / segment_vec.norm();
+}
+}  // namespace
+
+struct TrajectoryIndex::Impl
+{
+  std::vector<geometry_msgs::msg::Pose> poses;
+  std::vector<double> yaws;
+  std::vector<double> arc_lengths;
+
+  std::vector<size_t> all_indices;
+  PointRtree rtree;
+
+  // the points after removeOverlapPoints(points, 0), which are used for the lateral offset
+  std::vector<size_t> overlap_removed_indices;
+  PointRtree overlap_removed_rtree;
+};
+
+void TrajectoryIndex::build(const std::vector<geometry_msgs::msg::Pose> & poses)
+{
+  auto impl = std::make_shared<Impl>();
+  impl->poses = poses;
+
+  impl->yaws.reserve(poses.size());
+  impl->arc_lengths.reserve(poses.size());
+  impl->all_indices.reserve(poses.size());
+  double arc_length = 0.0;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    if (i != 0) {
+      arc_length += autoware::universe_utils::calcDistance2d(poses.at(i - 1), poses.at(i));
+    }
+    impl->arc_lengths.push_back(arc_length);
+    impl->yaws.push_back(tf2::getYaw(poses.at(i).orientation));
+    impl->all_indices.push_back(i);
+
+    const auto & overlap_removed_indices = impl->overlap_removed_indices;
+    if (
+      overlap_removed_indices.empty() ||
+      !isOverlapping(poses.at(overlap_removed_indices.back()).position, poses.at(i).position)) {
+      impl->overlap_removed_indices.push_back(i);
+    }
+  }
+
+  impl->rtree = createRtree(poses, impl->all_indices);
+  if (impl->overlap_removed_indices.size() != poses.size()) {
+    impl->overlap_removed_rtree = createRtree(poses, impl->overlap_removed_indices);
+  }
+  impl_ = impl;
+}
+
+size_t TrajectoryIndex::size() const
+{
+  return impl_->poses.size();
+}
+
+const geometry_msgs::msg::Pose & TrajectoryIndex::pose(const size_t idx) const
+{
+  return impl_->poses.at(idx);
+}
+
+double TrajectoryIndex::arc_length(const size_t idx) const
+{
+  return impl_->arc_lengths.at(idx);
+}
+
+size_t TrajectoryIndex::find_nearest_index(const geometry_msgs::msg::Point & point) const
+{
+  return findNearestInRtree(impl_->rtree, impl_->poses, impl_->all_indices, point);
+}
+
+size_t TrajectoryIndex::find_last_nearest_index(const geometry_msgs::msg::Point & point) const
+{
+  return findNearestInRtree(impl_->rtree, impl_->poses, impl_->all_indices, point, true);
+}
+
+std::optional<size_t> TrajectoryIndex::find_nearest_index(
+  const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw) const
+{
+  if (impl_->poses.empty()) {
+    return std::nullopt;
+  }
+
+  const double max_squared_dist = max_dist * max_dist;
+  const double target_yaw = tf2::getYaw(pose.orientation);
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  std::optional<size_t> min_idx;
+
+  // visit the points in the order of the distance, and stop when they are farther than the found
+  // nearest point, keeping the smallest index among the points with the same distance
+  const Point2d query_point(pose.position.x, pose.position.y);
+  for (auto itr = impl_->rtree.qbegin(bgi::nearest(query_point, impl_->poses.size()));
+       itr != impl_->rtree.qend(); ++itr) {
+    const size_t i = itr->second;
+    const auto squared_dist =
+      autoware::universe_utils::calcSquaredDistance2d(impl_->poses.at(i), pose);
+    const double bound = min_idx ? min_squared_dist : max_squared_dist;
+    if (squared_dist > bound * (1.0 + 2.0 * distance_margin) + distance_margin) {
+      break;
+    }
+    if (squared_dist > max_squared_dist) {
+      continue;
+    }
+    const bool is_same_dist_with_larger_idx =
+      min_idx && squared_dist == min_squared_dist && i > *min_idx;
+    if (squared_dist > min_squared_dist || is_same_dist_with_larger_idx) {
+      continue;
+    }
+
+    const auto yaw = autoware::universe_utils::normalizeRadian(target_yaw - impl_->yaws.at(i));
+    if (std::fabs(yaw) > max_yaw) {
+      continue;
+    }
+
+    min_squared_dist = squared_dist;
+    min_idx = i;
+  }
+  return min_idx;
+}
+
+const std::vector<size_t> & TrajectoryIndex::overlap_removed_indices() const
+{
+  return impl_->overlap_removed_indices;
+}
+
+size_t TrajectoryIndex::find_nearest_overlap_removed_index(
+  const geometry_msgs::msg::Point & point) const
+{
+  if (impl_->overlap_removed_indices.size() == impl_->poses.size()) {
+    return find_nearest_index(point);
+  }
+  return findNearestInRtree(
+    impl_->overlap_removed_rtree, impl_->poses, impl_->overlap_removed_indices, point);
+}
+
+size_t findNearestIndex(const TrajectoryIndex & index, const geometry_msgs::msg::Point & point)
+{
+  validateNonEmpty(index);
+  return index.find_nearest_index(point);
+}
+
+std::optional<size_t> findNearestIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Pose & pose, const double max_dist,
+  const double max_yaw)
+{
+  return index.find_nearest_index(pose, max_dist, max_yaw);
+}
+
+double calcLongitudinalOffsetToSegment(
+  const TrajectoryIndex & index, const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception)
+{
+  if (seg_idx >= index.size() - 1) {
+    const std::string error_message(
+      "[autoware_motion_utils] " + std::string(__func__) +
+      ": Failed to calculate longitudinal offset because the given segment index is out of the "
+      "points size.");
+    autoware::universe_utils::print_backtrace();
+    if (throw_exception) {
+      throw std::out_of_range(error_message);
+    }
+    RCLCPP_DEBUG(
+      get_logger(),
+      "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+      error_message.c_str());
+    return std::nan("");
+  }
+
+  // the back point is the next point which does not overlap, as removeOverlapPoints(points,
+  // seg_idx) does
+  const auto & p_front = index.pose(seg_idx).position;
+  size_t back_idx = seg_idx + 1;
+  while (back_idx < index.size() && isOverlapping(p_front, index.pose(back_idx).position)) {
+    ++back_idx;
+  }
+
+  if (back_idx == index.size()) {
+    const std::string error_message(
+      "[autoware_motion_utils] " + std::string(__func__) +
+      ": Longitudinal offset calculation is not supported for the same points.");
+    autoware::universe_utils::print_backtrace();
+    if (throw_exception) {
+      throw std::runtime_error(error_message);
+    }
+    RCLCPP_DEBUG(
+      get_logger(),
+      "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+      error_message.c_str());
+    return std::nan("");
+  }
+
+  const auto & p_back = index.pose(back_idx).position;
+
+  const Eigen::Vector3d segment_vec{p_back.x - p_front.x, p_back.y - p_front.y, 0};
+  const Eigen::Vector3d target_vec{p_target.x - p_front.x, p_target.y - p_front.y, 0};
+
+  return segment_vec.dot(target_vec) / segment_vec.norm();
+}
+
+size_t findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point)
+{
+  const size_t nearest_idx = findNearestIndex(index, point);
+
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == index.size() - 1) {
+    return index.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(index, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+
+std::optional<size_t> findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Pose & pose, const double max_dist,
+  const double max_yaw)
+{
+  const auto nearest_idx = findNearestIndex(index, pose, max_dist, max_yaw);
+
+  if (!nearest_idx) {
+    return std::nullopt;
+  }
+
+  if (*nearest_idx == 0) {
+    return 0;
+  }
+  if (*nearest_idx == index.size() - 1) {
+    return index.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(index, *nearest_idx, pose.position);
+
+  if (signed_length <= 0) {
+    return *nearest_idx - 1;
+  }
+
+  return *nearest_idx;
+}
+
+double calcLateralOffset(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception)
+{
+  const auto & overlap_removed_indices = index.overlap_removed_indices();
+
+  if (throw_exception) {
+    validateNonEmpty(overlap_removed_indices);
+  } else {
+    try {
+      validateNonEmpty(overlap_removed_indices);
+    } catch (const std::exception & e) {
+      RCLCPP_DEBUG(
+        get_logger(),
+        "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+        e.what());
+      return std::nan("");
+    }
+  }
+
+  if (overlap_removed_indices.size() == 1) {
+    const std::string error_message(
+      "[autoware_motion_utils] " + std::string(__func__) +
+      ": Lateral offset calculation is not supported for the same points.");
+    autoware::universe_utils::print_backtrace();
+    if (throw_exception) {
+      throw std::runtime_error(error_message);
+    }
+    RCLCPP_DEBUG(
+      get_logger(),
+      "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+      error_message.c_str());
+    return std::nan("");
+  }
+
+  const auto get_point = [&](const size_t i) -> const geometry_msgs::msg::Point & {
+    return index.pose(overlap_removed_indices.at(i)).position;
+  };
+
+  // same as findNearestSegmentIndex() for the points without overlap
+  const size_t nearest_idx = index.find_nearest_overlap_removed_index(p_target);
+  size_t seg_idx = nearest_idx;
+  if (nearest_idx == overlap_removed_indices.size() - 1) {
+    seg_idx = overlap_removed_indices.size() - 2;
+  } else if (nearest_idx != 0) {
+    const auto & p_front = get_point(nearest_idx);
+    const auto & p_back = get_point(nearest_idx + 1);
+    const Eigen::Vector3d segment_vec{p_back.x - p_front.x, p_back.y - p_front.y, 0};
+    const Eigen::Vector3d target_vec{p_target.x - p_front.x, p_target.y - p_front.y, 0};
+    if (segment_vec.dot(target_vec) / segment_vec.norm() <= 0) {
+      seg_idx = nearest_idx - 1;
+    }
+  }
+
+  const auto & p_front = get_point(seg_idx);
+  const auto & p_back = get_point(seg_idx + 1);
+
+  const Eigen::Vector3d segment_vec{p_back.x - p_front.x, p_back.y - p_front.y, 0.0};
+  const Eigen::Vector3d target_vec{p_target.x - p_front.x, p_target.y - p_front.y, 0.0};
+
+  const Eigen::Vector3d cross_vec = segment_vec.cross(target_vec);
+  return cross_vec(2) / segment_vec.norm();
+}
+
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx, const size_t dst_idx)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "%s", e.what());
+    return 0.0;
+  }
+  return index.arc_length(dst_idx) - index.arc_length(src_idx);
+}
+
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const size_t dst_idx)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "%s", e.what());
+    return 0.0;
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+
+  return signed_length_on_traj - signed_length_src_offset;
+}
+
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "%s", e.what());
+    return 0.0;
+  }
+
+  return -calcSignedArcLength(index, dst_point, src_idx);
+}
+
+double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "%s", e.what());
+    return 0.0;
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+  const size_t dst_seg_idx = findNearestSegmentIndex(index, dst_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_seg_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+  const double signed_length_dst_offset =
+    calcLongitudinalOffsetToSegment(index, dst_seg_idx, dst_point);
+
+  return signed_length_on_traj - signed_length_src_offset + signed_length_dst_offset;
+}
+
+std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+  const TrajectoryIndex & index, const size_t src_idx, const double offset,
+  const bool throw_exception)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "%s", e.what());
+    return {};
+  }
+
+  if (index.size() - 1 < src_idx) {
+    const std::string error_message(
+      "[autoware_motion_utils] " + std::string(__func__) +
+      " error: The given source index is out of the points size. Failed to calculate longitudinal "
+      "offset.");
+    autoware::universe_utils::print_backtrace();
+    if (throw_exception) {
+      throw std::out_of_range(error_message);
+    }
+    RCLCPP_DEBUG(
+      get_logger(),
+      "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+      error_message.c_str());
+    return {};
+  }
+
+  if (index.size() == 1) {
+    return {};
+  }
+
+  if (src_idx + 1 == index.size() && offset == 0.0) {
+    return index.pose(src_idx).position;
+  }
+
+  const double target_arc_length = index.arc_length(src_idx) + offset;
+
+  if (offset < 0.0) {
+    // the last point whose arc length is not larger than the target, searched backward from src_idx
+    if (src_idx == 0 || index.arc_length(0) > target_arc_length) {
+      return {};
+    }
+    size_t low = 0;
+    size_t high = src_idx - 1;
+    while (low < high) {
+      const size_t mid = (low + high + 1) / 2;
+      if (index.arc_length(mid) <= target_arc_length) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    const size_t front_idx = low;
+    const double dist_segment = index.arc_length(front_idx + 1) - index.arc_length(front_idx);
+    return autoware::universe_utils::calcInterpolatedPoint(
+      index.pose(front_idx), index.pose(front_idx + 1),
+      std::abs((target_arc_length - index.arc_length(front_idx)) / dist_segment));
+  }
+
+  // the first point whose arc length is not smaller than the target, searched forward from src_idx
+  size_t low = src_idx + 1;
+  size_t high = index.size() - 1;
+  if (index.arc_length(high) < target_arc_length) {
+    // not found (out of range)
+    return {};
+  }
+  while (low < high) {
+    const size_t mid = (low + high) / 2;
+    if (index.arc_length(mid) >= target_arc_length) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  const size_t back_idx = low;
+  const double dist_segment = index.arc_length(back_idx) - index.arc_length(back_idx - 1);
+  return autoware::universe_utils::calcInterpolatedPoint(
+    index.pose(back_idx), index.pose(back_idx - 1),
+    std::abs((index.arc_length(back_idx) - target_arc_length) / dist_segment));
+}
+
+std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point, const double offset)
+{
+  try {
+    validateNonEmpty(index);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(get_logger(), "Failed to calculate longitudinal offset: %s", e.what());
+    return {};
+  }
+
+  if (offset < 0.0) {
+    // same as the forward search on the reversed points, whose nearest segment runs backward from
+    // front_idx and is not the same segment as the forward one
+    const size_t nearest_idx = index.find_last_nearest_index(src_point);
+    size_t front_idx = nearest_idx;
+    if (nearest_idx == 0) {
+      front_idx = std::min<size_t>(1, index.size() - 1);
+    } else if (
+      nearest_idx != index.size() - 1 &&
+      calcLongitudinalOffsetToBackwardSegment(index, nearest_idx, src_point) <= 0) {
+      front_idx = nearest_idx + 1;
+    }
+    const double signed_length_src_offset =
+      calcLongitudinalOffsetToBackwardSegment(index, front_idx, src_point);
+    if (std::isnan(signed_length_src_offset)) {
+      return {};
+    }
+    return calcLongitudinalOffsetPoint(index, front_idx, offset - signed_length_src_offset);
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+
+  return calcLongitudinalOffsetPoint(index, src_seg_idx, offset + signed_length_src_offset);
+}
+
+}  // namespace autoware::motion_utils
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
 
 #include <gtest/gtest.h>
 #include <gtest/internal/gtest-port.h>
@@ -75,3 +76,65 @@ TEST(trajectory_benchmark, DISABLED_calcLateralOffset)
     calcLateralOffset(traj.points, point);
   }
 }
+
+TEST(trajectory_benchmark, DISABLED_calcLateralOffsetWithTrajectoryIndex)
+{
+  std::random_device r;
+  std::default_random_engine e1(r());
+  std::uniform_real_distribution<double> uniform_dist(0.0, 1000.0);
+
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  const auto traj = generateTestTrajectory<Trajectory>(1000, 1.0, 0.0, 0.0, 0.1);
+  const TrajectoryIndex index(traj.points);
+  constexpr auto nb_iteration = 10000;
+  for (auto i = 0; i < nb_iteration; ++i) {
+    const auto point = createPoint(uniform_dist(e1), uniform_dist(e1), 0.0);
+    calcLateralOffset(index, point);
+  }
+}
+
+TEST(trajectory_benchmark, DISABLED_trajectoryQueries)
+{
+  std::random_device r;
+  std::default_random_engine e1(r());
+  std::uniform_real_distribution<double> uniform_dist(0.0, 1000.0);
+  std::uniform_int_distribution<size_t> index_dist(0, 999);
+
+  using autoware::motion_utils::calcLongitudinalOffsetPoint;
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::findNearestSegmentIndex;
+
+  const auto traj = generateTestTrajectory<Trajectory>(1000, 1.0, 0.0, 0.0, 0.1);
+  constexpr auto nb_iteration = 10000;
+  for (auto i = 0; i < nb_iteration; ++i) {
+    const auto point = createPoint(uniform_dist(e1), uniform_dist(e1), 0.0);
+    findNearestSegmentIndex(traj.points, point);
+    calcSignedArcLength(traj.points, point, index_dist(e1));
+    calcLongitudinalOffsetPoint(traj.points, index_dist(e1), uniform_dist(e1));
+  }
+}
+
+TEST(trajectory_benchmark, DISABLED_trajectoryQueriesWithTrajectoryIndex)
+{
+  std::random_device r;
+  std::default_random_engine e1(r());
+  std::uniform_real_distribution<double> uniform_dist(0.0, 1000.0);
+  std::uniform_int_distribution<size_t> index_dist(0, 999);
+
+  using autoware::motion_utils::calcLongitudinalOffsetPoint;
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::findNearestSegmentIndex;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  const auto traj = generateTestTrajectory<Trajectory>(1000, 1.0, 0.0, 0.0, 0.1);
+  const TrajectoryIndex index(traj.points);
+  constexpr auto nb_iteration = 10000;
+  for (auto i = 0; i < nb_iteration; ++i) {
+    const auto point = createPoint(uniform_dist(e1), uniform_dist(e1), 0.0);
+    findNearestSegmentIndex(index, point);
+    calcSignedArcLength(index, point, index_dist(e1));
+    calcLongitudinalOffsetPoint(index, index_dist(e1), uniform_dist(e1));
+  }
+}
@@ -0,0 +1,230 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPointArray = std::vector<TrajectoryPoint>;
+
+constexpr double epsilon = 1e-6;
+
+TrajectoryPoint createTrajectoryPoint(const double x, const double y, const double yaw)
+{
+  TrajectoryPoint p;
+  p.pose.position.x = x;
+  p.pose.position.y = y;
+  p.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(yaw);
+  return p;
+}
+
+// curved points with some overlapping points
+TrajectoryPointArray generateCurvedPoints(const size_t num_points, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> curvature_dist(-0.2, 0.2);
+  std::uniform_real_distribution<double> interval_dist(0.5, 2.0);
+  std::bernoulli_distribution overlap_dist(0.05);
+
+  TrajectoryPointArray points;
+  double x = 0.0;
+  double y = 0.0;
+  double yaw = 0.0;
+  for (size_t i = 0; i < num_points; ++i) {
+    points.push_back(createTrajectoryPoint(x, y, yaw));
+    if (overlap_dist(engine)) {
+      points.push_back(createTrajectoryPoint(x, y, yaw));
+    }
+    const double interval = interval_dist(engine);
+    yaw += curvature_dist(engine) * interval;
+    x += interval * std::cos(yaw);
+    y += interval * std::sin(yaw);
+  }
+  return points;
+}
+
+geometry_msgs::msg::Point createRandomPoint(
+  const TrajectoryPointArray & points, std::mt19937 & engine)
+{
+  std::uniform_int_distribution<size_t> idx_dist(0, points.size() - 1);
+  std::uniform_real_distribution<double> offset_dist(-3.0, 3.0);
+  auto p = points.at(idx_dist(engine)).pose.position;
+  p.x += offset_dist(engine);
+  p.y += offset_dist(engine);
+  return p;
+}
+
+void expectSameValue(const double expected, const double actual)
+{
+  if (std::isnan(expected)) {
+    EXPECT_TRUE(std::isnan(actual));
+  } else {
+    EXPECT_NEAR(expected, actual, epsilon);
+  }
+}
+}  // namespace
+
+TEST(trajectory_index, findNearestIndex)
+{
+  using autoware::motion_utils::findNearestIndex;
+  using autoware::motion_utils::findNearestSegmentIndex;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  std::mt19937 engine(0);
+  const auto points = generateCurvedPoints(300, engine);
+  const TrajectoryIndex index(points);
+  ASSERT_EQ(index.size(), points.size());
+
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto point = createRandomPoint(points, engine);
+    EXPECT_EQ(findNearestIndex(points, point), findNearestIndex(index, point));
+    EXPECT_EQ(findNearestSegmentIndex(points, point), findNearestSegmentIndex(index, point));
+
+    geometry_msgs::msg::Pose pose;
+    pose.position = point;
+    pose.orientation = autoware::universe_utils::createQuaternionFromYaw(yaw_dist(engine));
+    EXPECT_EQ(findNearestIndex(points, pose), findNearestIndex(index, pose));
+    EXPECT_EQ(findNearestIndex(points, pose, 2.0, 0.5), findNearestIndex(index, pose, 2.0, 0.5));
+    EXPECT_EQ(
+      findNearestSegmentIndex(points, pose, 2.0, 0.5),
+      findNearestSegmentIndex(index, pose, 2.0, 0.5));
+  }
+
+  // the smallest index is returned for the overlapping points
+  const TrajectoryPointArray overlapping_points{
+    createTrajectoryPoint(0.0, 0.0, 0.0), createTrajectoryPoint(1.0, 0.0, 0.0),
+    createTrajectoryPoint(1.0, 0.0, 0.0), createTrajectoryPoint(2.0, 0.0, 0.0)};
+  geometry_msgs::msg::Point point;
+  point.x = 1.1;
+  EXPECT_EQ(findNearestIndex(TrajectoryIndex(overlapping_points), point), 1U);
+  EXPECT_EQ(TrajectoryIndex(overlapping_points).find_last_nearest_index(point), 2U);
+
+  // empty points
+  EXPECT_THROW(findNearestIndex(TrajectoryIndex{}, point), std::invalid_argument);
+  EXPECT_FALSE(findNearestIndex(TrajectoryIndex{}, geometry_msgs::msg::Pose{}));
+}
+
+TEST(trajectory_index, calcLateralOffset)
+{
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::calcLongitudinalOffsetToSegment;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  std::mt19937 engine(1);
+  const auto points = generateCurvedPoints(300, engine);
+  const TrajectoryIndex index(points);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto point = createRandomPoint(points, engine);
+    expectSameValue(calcLateralOffset(points, point), calcLateralOffset(index, point));
+
+    const size_t seg_idx = i % (points.size() - 1);
+    expectSameValue(
+      calcLongitudinalOffsetToSegment(points, seg_idx, point),
+      calcLongitudinalOffsetToSegment(index, seg_idx, point));
+  }
+
+  // same points
+  const TrajectoryPointArray same_points{
+    createTrajectoryPoint(1.0, 0.0, 0.0), createTrajectoryPoint(1.0, 0.0, 0.0)};
+  const TrajectoryIndex same_points_index(same_points);
+  EXPECT_TRUE(std::isnan(calcLateralOffset(same_points_index, geometry_msgs::msg::Point{})));
+  EXPECT_THROW(
+    calcLateralOffset(same_points_index, geometry_msgs::msg::Point{}, true),
+    std::runtime_error);
+}
+
+TEST(trajectory_index, calcSignedArcLength)
+{
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  std::mt19937 engine(2);
+  const auto points = generateCurvedPoints(300, engine);
+  const TrajectoryIndex index(points);
+
+  std::uniform_int_distribution<size_t> idx_dist(0, points.size() - 1);
+  for (size_t i = 0; i < 1000; ++i) {
+    const size_t src_idx = idx_dist(engine);
+    const size_t dst_idx = idx_dist(engine);
+    const auto src_point = createRandomPoint(points, engine);
+    const auto dst_point = createRandomPoint(points, engine);
+    EXPECT_NEAR(
+      calcSignedArcLength(points, src_idx, dst_idx), calcSignedArcLength(index, src_idx, dst_idx),
+      epsilon);
+    expectSameValue(
+      calcSignedArcLength(points, src_point, dst_idx),
+      calcSignedArcLength(index, src_point, dst_idx));
+    expectSameValue(
+      calcSignedArcLength(points, src_idx, dst_point),
+      calcSignedArcLength(index, src_idx, dst_point));
+    expectSameValue(
+      calcSignedArcLength(points, src_point, dst_point),
+      calcSignedArcLength(index, src_point, dst_point));
+  }
+}
+
+TEST(trajectory_index, calcLongitudinalOffsetPoint)
+{
+  using autoware::motion_utils::calcLongitudinalOffsetPoint;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  std::mt19937 engine(3);
+  const auto points = generateCurvedPoints(300, engine);
+  const TrajectoryIndex index(points);
+
+  std::uniform_int_distribution<size_t> idx_dist(0, points.size() - 1);
+  std::uniform_real_distribution<double> offset_dist(-100.0, 100.0);
+  const auto expect_same_point = [](const auto & expected, const auto & actual) {
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_NEAR(expected->x, actual->x, epsilon);
+      EXPECT_NEAR(expected->y, actual->y, epsilon);
+    }
+  };
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const size_t src_idx = idx_dist(engine);
+    const double offset = offset_dist(engine);
+    expect_same_point(
+      calcLongitudinalOffsetPoint(points, src_idx, offset),
+      calcLongitudinalOffsetPoint(index, src_idx, offset));
+
+    const auto src_point = createRandomPoint(points, engine);
+    expect_same_point(
+      calcLongitudinalOffsetPoint(points, src_point, offset),
+      calcLongitudinalOffsetPoint(index, src_point, offset));
+  }
+
+  // out of range
+  expect_same_point(
+    calcLongitudinalOffsetPoint(points, points.size() - 1, 1.0),
+    calcLongitudinalOffsetPoint(index, points.size() - 1, 1.0));
+  expect_same_point(
+    calcLongitudinalOffsetPoint(points, 0, -1.0), calcLongitudinalOffsetPoint(index, 0, -1.0));
+  expect_same_point(
+    calcLongitudinalOffsetPoint(points, points.size() - 1, 0.0),
+    calcLongitudinalOffsetPoint(index, points.size() - 1, 0.0));
+  EXPECT_THROW(
+    calcLongitudinalOffsetPoint(index, points.size(), 1.0, true), std::out_of_range);
+}
@@ -0,0 +1,332 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
+#define AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace autoware::universe_utils
+{
+/**
+ * @brief Single trace event, which is a pair of begin and end ticks of a named scope
+ */
+struct TraceEvent
+{
+  uint32_t name_id{0};    //!< Id returned by TraceRecorder::register_name()
+  uint32_t thread_id{0};  //!< Id of the thread which recorded the event
+  uint64_t begin{0};      //!< Begin tick
+  uint64_t end{0};        //!< End tick
+};
+
+/**
+ * @brief Lock-free ring buffer with a single producer and a single consumer
+ *
+ * The producer never blocks. When the ring is full, the event is dropped and counted.
+ */
+class TraceRing
+{
+public:
+  /**
+   * @brief Construct a new TraceRing object
+   *
+   * @param capacity Capacity of the ring, which is rounded up to a power of two
+   * @param thread_id Id of the producer thread
+   */
+  TraceRing(const size_t capacity, const uint32_t thread_id);
+
+  /**
+   * @brief Push an event from the producer thread
+   *
+   * @return false if the ring is full and the event is dropped
+   */
+  bool push(const uint32_t name_id, const uint64_t begin, const uint64_t end) noexcept
+  {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= buffer_.size()) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    auto & event = buffer_[head & mask_];
+    event.name_id = name_id;
+    event.thread_id = thread_id_;
+    event.begin = begin;
+    event.end = end;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pop all events from the consumer thread
+   *
+   * @param out Vector to which the events are appended
+   * @return size_t Number of popped events
+   */
+  size_t pop_all(std::vector<TraceEvent> & out);
+
+  uint32_t thread_id() const { return thread_id_; }
+  uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Mark that the producer thread has exited, so that the ring can be released once empty
+   */
+  void retire() { retired_.store(true, std::memory_order_release); }
+  bool is_retired() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+  std::vector<TraceEvent> buffer_;
+  uint64_t mask_;
+  const uint32_t thread_id_;
+
+  alignas(64) std::atomic<uint64_t> head_{0};  //!< Written only by the producer
+  alignas(64) std::atomic<uint64_t> tail_{0};  //!< Written only by the consumer
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> retired_{false};
+};
+
+/**
+ * @brief Aggregated processing time of a named scope
+ */
+struct TraceHistogram
+{
+  static constexpr size_t num_buckets = 64;
+
+  std::string name;        //!< Name of the scope
+  uint64_t count{0};       //!< Number of recorded events
+  double total_ms{0.0};    //!< Sum of the processing time
+  double min_ms{0.0};      //!< Minimum processing time
+  double max_ms{0.0};      //!< Maximum processing time
+  std::array<uint64_t, num_buckets>
+    buckets{};  //!< buckets[i] counts the events whose duration is in [2^i, 2^(i+1)) ns
+
+  /**
+   * @brief Get the approximate percentile from the buckets
+   *
+   * @param ratio Percentile in [0, 1]
+   * @return double Upper bound of the bucket containing the percentile [ms]
+   */
+  double percentile_ms(const double ratio) const;
+};
+
+/**
+ * @brief Process-wide recorder of trace events with low overhead
+ *
+ * Each thread records events into its own TraceRing, so that recording does not take any lock nor
+ * allocate memory, except for creating the ring of a thread on its first use. The rings are drained
+ * by a background thread started by start(), or by calling drain() manually. The drained events
+ * are aggregated into histograms and the latest events are kept to be exported in the Chrome trace
+ * event format, which can be opened by chrome://tracing and Perfetto.
+ */
+class TraceRecorder
+{
+public:
+  /**
+   * @brief Get the process-wide recorder. The first call calibrates the ticks against the steady
+   * clock, which takes about 10 ms.
+   */
+  static TraceRecorder & instance();
+
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder & operator=(const TraceRecorder &) = delete;
+  TraceRecorder(TraceRecorder &&) = delete;
+  TraceRecorder & operator=(TraceRecorder &&) = delete;
+
+  /**
+   * @brief Register the name of a scope. This takes a lock and should be called only once per name.
+   *
+   * @param name Name of the scope
+   * @return uint32_t Id of the name, which is the same for the same name
+   */
+  uint32_t register_name(const std::string & name);
+
+  /**
+   * @brief Get the current tick, which is the TSC on x86 and nanoseconds of steady_clock otherwise
+   */
+  static uint64_t now() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+#endif
+  }
+
+  /**
+   * @brief Record an event of the current thread. This does nothing when the recorder is disabled.
+   *
+   * The first call in a thread creates its ring, which allocates memory and may throw. Call
+   * reserve_local_ring() beforehand to avoid it.
+   */
+  void record(const uint32_t name_id, const uint64_t begin, const uint64_t end)
+  {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    local_ring().push(name_id, begin, end);
+  }
+
+  /**
+   * @brief Create the ring of the current thread if it does not exist yet
+   */
+  void reserve_local_ring() { local_ring(); }
+
+  void set_enabled(const bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+  bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Set the capacity of the rings which are created after this call
+   */
+  void set_ring_capacity(const size_t capacity);
+
+  /**
+   * @brief Set the maximum number of events kept for export. The oldest events are discarded.
+   */
+  void set_max_stored_events(const size_t max_stored_events);
+
+  /**
+   * @brief Start the background thread draining the rings periodically
+   */
+  void start(const std::chrono::milliseconds & drain_period);
+
+  /**
+   * @brief Stop the background thread and drain the remaining events
+   */
+  void stop();
+
+  /**
+   * @brief Drain the rings of all threads
+   */
+  void drain();
+
+  /**
+   * @brief Write the stored events in the Chrome trace event format
+   */
+  void write_chrome_trace(std::ostream & os);
+
+  /**
+   * @brief Get the histograms of all names which have been recorded
+   */
+  std::vector<TraceHistogram> get_histograms();
+
+  /**
+   * @brief Get the number of events dropped because a ring was full
+   */
+  uint64_t dropped_count();
+
+  /**
+   * @brief Clear the stored events and histograms
+   */
+  void clear();
+
+private:
+  TraceRecorder();
+  ~TraceRecorder();
+
+  TraceRing & local_ring();
+  std::shared_ptr<TraceRing> create_ring();
+
+  std::atomic<bool> enabled_{true};
+
+  // registry of names and rings, which is accessed only when a name or a thread is registered
+  std::mutex registry_mutex_;
+  std::unordered_map<std::string, uint32_t> name_ids_;
+  std::vector<std::string> names_;
+  std::vector<std::shared_ptr<TraceRing>> rings_;
+  size_t ring_capacity_{4096};
+  uint32_t next_thread_id_{0};
+  uint64_t retired_dropped_count_{0};
+
+  // consumer side, which is accessed by the draining thread and the exporters
+  std::mutex consumer_mutex_;
+  std::vector<TraceEvent> drain_buffer_;
+  std::deque<TraceEvent> stored_events_;
+  size_t max_stored_events_{100000};
+  std::vector<TraceHistogram> histograms_;
+
+  // conversion from ticks to time
+  const uint64_t start_tick_;
+  const double ns_per_tick_;
+
+  std::thread drain_thread_;
+  std::mutex drain_thread_mutex_;
+  std::condition_variable drain_thread_cv_;
+  bool is_drain_thread_running_{false};
+};
+
+/**
+ * @brief Class for recording the processing time of a scope into the TraceRecorder
+ *
+ * Unlike ScopedTimeTrack, this does not allocate memory nor take a lock, apart from creating the
+ * ring of the thread on its first use, so that it can be left enabled in hot loops. Use
+ * AUTOWARE_TRACE_SCOPE() to register the name only once.
+ */
+class ScopedTrace
+{
+public:
+  explicit ScopedTrace(const uint32_t name_id) : name_id_(name_id)
+  {
+    // the ring is created here rather than by record() in the destructor, which must not throw
+    TraceRecorder::instance().reserve_local_ring();
+    begin_ = TraceRecorder::now();
+  }
+
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace & operator=(const ScopedTrace &) = delete;
+  ScopedTrace(ScopedTrace &&) = delete;
+  ScopedTrace & operator=(ScopedTrace &&) = delete;
+
+  ~ScopedTrace() { TraceRecorder::instance().record(name_id_, begin_, TraceRecorder::now()); }
+
+private:
+  const uint32_t name_id_;
+  uint64_t begin_{0};
+};
+
+}  // namespace autoware::universe_utils
+
+#define AUTOWARE_TRACE_CONCAT_IMPL(a, b) a##b
+#define AUTOWARE_TRACE_CONCAT(a, b) AUTOWARE_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Record the processing time of the current scope with the given name
+ */
+#define AUTOWARE_TRACE_SCOPE(name)                                                      \
+  static const uint32_t AUTOWARE_TRACE_CONCAT(autoware_trace_name_id_, __LINE__) =      \
+    ::autoware::universe_utils::TraceRecorder::instance().register_name(name);          \
+  const ::autoware::universe_utils::ScopedTrace AUTOWARE_TRACE_CONCAT(                  \
+    autoware_trace_scope_, __LINE__)(AUTOWARE_TRACE_CONCAT(autoware_trace_name_id_, __LINE__))
+
+#endif  // AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
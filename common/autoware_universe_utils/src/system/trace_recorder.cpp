@@ -0,0 +1,337 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/trace_recorder.hpp"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace autoware::universe_utils
+{
+namespace
+{
+size_t round_up_to_power_of_two(const size_t value)
+{
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+size_t to_bucket_index(const double duration_ns)
+{
+  if (duration_ns < 1.0) {
+    return 0;
+  }
+  const auto index = static_cast<size_t>(std::log2(duration_ns));
+  return std::min(index, TraceHistogram::num_buckets - 1);
+}
+
+std::string escape_json(const std::string & str)
+{
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+double calibrate_ns_per_tick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  // measure the TSC frequency with the steady clock over a short interval
+  constexpr auto calibration_period = std::chrono::milliseconds(10);
+  const auto begin_time = std::chrono::steady_clock::now();
+  const uint64_t begin_tick = TraceRecorder::now();
+  std::this_thread::sleep_for(calibration_period);
+  const uint64_t end_tick = TraceRecorder::now();
+  const auto end_time = std::chrono::steady_clock::now();
+  if (end_tick <= begin_tick) {
+    return 1.0;
+  }
+  const double elapsed_ns = static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count());
+  return elapsed_ns / static_cast<double>(end_tick - begin_tick);
+#else
+  return 1.0;
+#endif
+}
+
+/**
+ * @brief Owner of the ring of a thread, which retires the ring when the thread exits
+ */
+struct LocalRingHandle
+{
+  std::shared_ptr<TraceRing> ring;
+  ~LocalRingHandle()
+  {
+    if (ring) {
+      ring->retire();
+    }
+  }
+};
+}  // namespace
+
+TraceRing::TraceRing(const size_t capacity, const uint32_t thread_id)
+: buffer_(round_up_to_power_of_two(std::max<size_t>(capacity, 2))),
+  mask_(buffer_.size() - 1),
+  thread_id_(thread_id)
+{
+}
+
+size_t TraceRing::pop_all(std::vector<TraceEvent> & out)
+{
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  for (uint64_t i = tail; i < head; ++i) {
+    out.push_back(buffer_[i & mask_]);
+  }
+  tail_.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+double TraceHistogram::percentile_ms(const double ratio) const
+{
+  if (count == 0) {
+    return 0.0;
+  }
+  const auto target = static_cast<uint64_t>(std::ceil(std::clamp(ratio, 0.0, 1.0) * count));
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < num_buckets; ++i) {
+    accumulated += buckets[i];
+    if (accumulated >= std::max<uint64_t>(target, 1)) {
+      return std::min(std::ldexp(1.0, static_cast<int>(i) + 1) * 1e-6, max_ms);
+    }
+  }
+  return max_ms;
+}
+
+TraceRecorder & TraceRecorder::instance()
+{
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+TraceRecorder::TraceRecorder() : start_tick_(now()), ns_per_tick_(calibrate_ns_per_tick())
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+  stop();
+}
+
+uint32_t TraceRecorder::register_name(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  const auto itr = name_ids_.find(name);
+  if (itr != name_ids_.end()) {
+    return itr->second;
+  }
+  const auto name_id = static_cast<uint32_t>(names_.size());
+  names_.push_back(name);
+  name_ids_.emplace(name, name_id);
+  return name_id;
+}
+
+TraceRing & TraceRecorder::local_ring()
+{
+  thread_local LocalRingHandle handle;
+  if (!handle.ring) {
+    handle.ring = create_ring();
+  }
+  return *handle.ring;
+}
+
+std::shared_ptr<TraceRing> TraceRecorder::create_ring()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  auto ring = std::make_shared<TraceRing>(ring_capacity_, next_thread_id_++);
+  rings_.push_back(ring);
+  return ring;
+}
+
+void TraceRecorder::set_ring_capacity(const size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  ring_capacity_ = capacity;
+}
+
+void TraceRecorder::set_max_stored_events(const size_t max_stored_events)
+{
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  max_stored_events_ = max_stored_events;
+  while (stored_events_.size() > max_stored_events_) {
+    stored_events_.pop_front();
+  }
+}
+
+void TraceRecorder::drain()
+{
+  std::vector<std::shared_ptr<TraceRing>> rings;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    rings = rings_;
+  }
+
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  drain_buffer_.clear();
+  for (const auto & ring : rings) {
+    ring->pop_all(drain_buffer_);
+  }
+
+  const double tick_to_ns = ns_per_tick_;
+  for (const auto & event : drain_buffer_) {
+    if (histograms_.size() <= event.name_id) {
+      histograms_.resize(event.name_id + 1);
+    }
+    auto & histogram = histograms_.at(event.name_id);
+    const double duration_ns = static_cast<double>(event.end - event.begin) * tick_to_ns;
+    const double duration_ms = duration_ns * 1e-6;
+    histogram.min_ms = histogram.count == 0 ? duration_ms : std::min(histogram.min_ms, duration_ms);
+    histogram.max_ms = histogram.count == 0 ? duration_ms : std::max(histogram.max_ms, duration_ms);
+    histogram.total_ms += duration_ms;
+    histogram.count++;
+    histogram.buckets.at(to_bucket_index(duration_ns))++;
+
+    stored_events_.push_back(event);
+  }
+  while (stored_events_.size() > max_stored_events_) {
+    stored_events_.pop_front();
+  }
+
+  // release the rings of exited threads
+  std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+  for (auto itr = rings_.begin(); itr != rings_.end();) {
+    if ((*itr)->is_retired() && (*itr)->empty()) {
+      retired_dropped_count_ += (*itr)->dropped_count();
+      itr = rings_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+void TraceRecorder::start(const std::chrono::milliseconds & drain_period)
+{
+  std::lock_guard<std::mutex> lock(drain_thread_mutex_);
+  if (is_drain_thread_running_) {
+    return;
+  }
+  is_drain_thread_running_ = true;
+  drain_thread_ = std::thread([this, drain_period]() {
+    std::unique_lock<std::mutex> lock(drain_thread_mutex_);
+    while (is_drain_thread_running_) {
+      drain_thread_cv_.wait_for(lock, drain_period, [this]() { return !is_drain_thread_running_; });
+      lock.unlock();
+      drain();
+      lock.lock();
+    }
+  });
+}
+
+void TraceRecorder::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(drain_thread_mutex_);
+    is_drain_thread_running_ = false;
+  }
+  drain_thread_cv_.notify_all();
+  if (drain_thread_.joinable()) {
+    drain_thread_.join();
+  }
+  drain();
+}
+
+void TraceRecorder::write_chrome_trace(std::ostream & os)
+{
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    names = names_;
+  }
+
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  const double tick_to_us = ns_per_tick_ * 1e-3;
+  const int pid = static_cast<int>(getpid());
+
+  os << "{\"traceEvents\":[";
+  bool is_first = true;
+  for (const auto & event : stored_events_) {
+    // keep the difference signed in case the TSC of another core is slightly behind
+    const auto begin_from_start = static_cast<int64_t>(event.begin - start_tick_);
+    const double ts = static_cast<double>(begin_from_start) * tick_to_us;
+    const double dur = static_cast<double>(event.end - event.begin) * tick_to_us;
+    const std::string & name =
+      event.name_id < names.size() ? names.at(event.name_id) : std::string("unknown");
+    os << (is_first ? "" : ",")
+       << fmt::format(
+            "{{\"name\":\"{}\",\"cat\":\"autoware\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+            "\"pid\":{},\"tid\":{}}}",
+            escape_json(name), ts, dur, pid, event.thread_id);
+    is_first = false;
+  }
+  os << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+std::vector<TraceHistogram> TraceRecorder::get_histograms()
+{
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    names = names_;
+  }
+
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  std::vector<TraceHistogram> histograms;
+  for (size_t i = 0; i < histograms_.size(); ++i) {
+    if (histograms_.at(i).count == 0) {
+      continue;
+    }
+    histograms.push_back(histograms_.at(i));
+    histograms.back().name = i < names.size() ? names.at(i) : std::string("unknown");
+  }
+  return histograms;
+}
+
+uint64_t TraceRecorder::dropped_count()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  uint64_t dropped_count = retired_dropped_count_;
+  for (const auto & ring : rings_) {
+    dropped_count += ring->dropped_count();
+  }
+  return dropped_count;
+}
+
+void TraceRecorder::clear()
+{
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  stored_events_.clear();
+  histograms_.clear();
+}
+
+}  // namespace autoware::universe_utils
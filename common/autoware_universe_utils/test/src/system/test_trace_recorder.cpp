@@ -0,0 +1,130 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/trace_recorder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const autoware::universe_utils::TraceHistogram * find_histogram(
+  const std::vector<autoware::universe_utils::TraceHistogram> & histograms,
+  const std::string & name)
+{
+  for (const auto & histogram : histograms) {
+    if (histogram.name == name) {
+      return &histogram;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(system, TraceRing)
+{
+  autoware::universe_utils::TraceRing ring(3, 7);
+
+  // capacity is rounded up to 4
+  for (uint64_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(ring.push(1, i, i + 1), i < 4);
+  }
+  EXPECT_EQ(ring.dropped_count(), 2u);
+
+  std::vector<autoware::universe_utils::TraceEvent> events;
+  EXPECT_EQ(ring.pop_all(events), 4u);
+  ASSERT_EQ(events.size(), 4u);
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(events.at(i).thread_id, 7u);
+    EXPECT_EQ(events.at(i).begin, i);
+  }
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring.push(1, 0, 1));
+}
+
+TEST(system, TraceRecorderTickConversion)
+{
+  using autoware::universe_utils::TraceRecorder;
+
+  // the conversion is right from the creation of the recorder
+  auto & recorder = TraceRecorder::instance();
+  const auto name_id = recorder.register_name("trace_test_conversion");
+  const auto begin = TraceRecorder::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  recorder.record(name_id, begin, TraceRecorder::now());
+  recorder.drain();
+
+  const auto * histogram = find_histogram(recorder.get_histograms(), "trace_test_conversion");
+  ASSERT_NE(histogram, nullptr);
+  EXPECT_GE(histogram->max_ms, 4.5);
+  EXPECT_LE(histogram->max_ms, 100.0);
+}
+
+TEST(system, TraceRecorder)
+{
+  using autoware::universe_utils::TraceRecorder;
+
+  auto & recorder = TraceRecorder::instance();
+  recorder.clear();
+
+  EXPECT_EQ(recorder.register_name("trace_test_a"), recorder.register_name("trace_test_a"));
+
+  recorder.start(std::chrono::milliseconds(10));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 100; ++j) {
+        AUTOWARE_TRACE_SCOPE("trace_test_a");
+        { AUTOWARE_TRACE_SCOPE("trace_test_b"); }
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  {
+    AUTOWARE_TRACE_SCOPE("trace_test_sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  recorder.stop();
+
+  const auto histograms = recorder.get_histograms();
+  const auto * histogram_a = find_histogram(histograms, "trace_test_a");
+  const auto * histogram_b = find_histogram(histograms, "trace_test_b");
+  const auto * histogram_sleep = find_histogram(histograms, "trace_test_sleep");
+  ASSERT_NE(histogram_a, nullptr);
+  ASSERT_NE(histogram_b, nullptr);
+  ASSERT_NE(histogram_sleep, nullptr);
+  EXPECT_EQ(histogram_a->count + recorder.dropped_count() / 2, 400u);
+  EXPECT_EQ(histogram_sleep->count, 1u);
+  EXPECT_GE(histogram_sleep->max_ms, 15.0);
+  EXPECT_LE(histogram_sleep->percentile_ms(0.5), histogram_sleep->max_ms);
+
+  std::ostringstream oss;
+  recorder.write_chrome_trace(oss);
+  const auto trace = oss.str();
+  EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(trace.find("\"name\":\"trace_test_sleep\""), std::string::npos);
+
+  recorder.set_enabled(false);
+  { AUTOWARE_TRACE_SCOPE("trace_test_disabled"); }
+  recorder.set_enabled(true);
+  recorder.drain();
+  EXPECT_EQ(find_histogram(recorder.get_histograms(), "trace_test_disabled"), nullptr);
+}
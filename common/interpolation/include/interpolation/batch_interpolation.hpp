@@ -0,0 +1,69 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INTERPOLATION__BATCH_INTERPOLATION_HPP_
+#define INTERPOLATION__BATCH_INTERPOLATION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace interpolation
+{
+// Interpolation of multiple channels which share the same base keys and query keys.
+//
+// The keys are validated, and the segment of each query key is found by a single monotone sweep
+// in the constructor. The tridiagonal system of the natural cubic spline depends only on the base
+// keys, so it is factorized once and each channel only needs the forward and back substitution.
+// The results are the same as interpolation::lerp, interpolation::spline and
+// interpolation::splineByAkima.
+//
+// Usage:
+// ```
+// BatchInterpolation interpolator(base_keys, query_keys);
+// const auto x = interpolator.splineByAkima(base_x);
+// const auto z = interpolator.spline(base_z);
+// const auto v = interpolator.lerp(base_v);
+// ```
+class BatchInterpolation
+{
+public:
+  BatchInterpolation(const std::vector<double> & base_keys, const std::vector<double> & query_keys);
+
+  std::vector<double> lerp(const std::vector<double> & base_values) const;
+  std::vector<double> spline(const std::vector<double> & base_values) const;
+  std::vector<std::vector<double>> spline(
+    const std::vector<std::vector<double>> & base_values_list) const;
+  std::vector<double> splineByAkima(const std::vector<double> & base_values) const;
+
+  const std::vector<size_t> & getSegmentIndices() const { return segment_indices_; }
+
+private:
+  std::vector<double> base_keys_;
+  std::vector<double> diff_keys_;
+
+  // segment of each query key and the offset from the start of the segment
+  std::vector<size_t> segment_indices_;
+  std::vector<double> segment_offsets_;
+  std::vector<double> segment_ratios_;
+
+  // factorization of the tridiagonal system for the second derivatives of the spline
+  std::vector<double> tdma_lower_;
+  std::vector<double> tdma_den_;
+  std::vector<double> tdma_p_;
+
+  void validateValues(const std::vector<double> & base_values) const;
+};
+}  // namespace interpolation
+
+#endif  // INTERPOLATION__BATCH_INTERPOLATION_HPP_
@@ -0,0 +1,209 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/batch_interpolation.hpp"
+
+#include "interpolation/interpolation_utils.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace interpolation
+{
+BatchInterpolation::BatchInterpolation(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys)
+: base_keys_(base_keys)
+{
+  // throw exception for invalid arguments
+  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys, query_keys);
+
+  const size_t num_base = base_keys_.size();
+  diff_keys_.resize(num_base - 1);
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    diff_keys_[i] = base_keys_[i + 1] - base_keys_[i];
+  }
+
+  // find segments by a single sweep since both keys are sorted
+  segment_indices_.resize(validated_query_keys.size());
+  segment_offsets_.resize(validated_query_keys.size());
+  segment_ratios_.resize(validated_query_keys.size());
+  size_t j = 0;
+  for (size_t i = 0; i < validated_query_keys.size(); ++i) {
+    const double query_key = validated_query_keys[i];
+    while (base_keys_[j + 1] < query_key) {
+      ++j;
+    }
+    segment_indices_[i] = j;
+    segment_offsets_[i] = query_key - base_keys_[j];
+    segment_ratios_[i] = segment_offsets_[i] / (base_keys_[j + 1] - base_keys_[j]);
+  }
+
+  // factorize the tridiagonal system of the size N-1 for the inner base keys
+  if (num_base > 2) {
+    const size_t num_row = num_base - 2;
+    tdma_lower_.resize(num_row - 1);
+    tdma_den_.resize(num_row);
+    tdma_p_.resize(num_row);
+    for (size_t i = 0; i + 1 < num_row; ++i) {
+      tdma_lower_[i] = diff_keys_[i + 1];
+    }
+    tdma_den_[0] = 2 * (diff_keys_[0] + diff_keys_[1]);
+    if (num_row != 1) {
+      tdma_p_[0] = -diff_keys_[1] / tdma_den_[0];
+    }
+    for (size_t i = 1; i < num_row; ++i) {
+      const double b = 2 * (diff_keys_[i] + diff_keys_[i + 1]);
+      tdma_den_[i] = b + tdma_lower_[i - 1] * tdma_p_[i - 1];
+      tdma_p_[i] = -tdma_lower_[i - 1] / tdma_den_[i];
+    }
+  }
+}
+
+void BatchInterpolation::validateValues(const std::vector<double> & base_values) const
+{
+  // throw exception for invalid arguments
+  interpolation_utils::validateKeysAndValues(base_keys_, base_values);
+}
+
+std::vector<double> BatchInterpolation::lerp(const std::vector<double> & base_values) const
+{
+  validateValues(base_values);
+
+  std::vector<double> query_values(segment_indices_.size());
+  for (size_t i = 0; i < segment_indices_.size(); ++i) {
+    const double src_val = base_values[segment_indices_[i]];
+    const double dst_val = base_values[segment_indices_[i] + 1];
+    query_values[i] = src_val + (dst_val - src_val) * segment_ratios_[i];
+  }
+  return query_values;
+}
+
+std::vector<double> BatchInterpolation::spline(const std::vector<double> & base_values) const
+{
+  return spline(std::vector<std::vector<double>>{base_values}).front();
+}
+
+std::vector<std::vector<double>> BatchInterpolation::spline(
+  const std::vector<std::vector<double>> & base_values_list) const
+{
+  for (const auto & base_values : base_values_list) {
+    validateValues(base_values);
+  }
+
+  const size_t num_base = base_keys_.size();
+  const size_t num_channel = base_values_list.size();
+
+  // second derivatives divided by 2, stored as v[i * num_channel + channel]
+  std::vector<double> v(num_base * num_channel, 0.0);
+  if (num_base > 2) {
+    const size_t num_row = num_base - 2;
+    const auto rhs = [&](const std::vector<double> & values, const size_t i) {
+      const double diff_value = values[i + 1] - values[i];
+      const double next_diff_value = values[i + 2] - values[i + 1];
+      return 6.0 * (next_diff_value / diff_keys_[i + 1] - diff_value / diff_keys_[i]);
+    };
+
+    // forward substitution with the factorized system, stored in the inner rows of v
+    for (size_t ch = 0; ch < num_channel; ++ch) {
+      v[num_channel + ch] = rhs(base_values_list[ch], 0) / tdma_den_[0];
+    }
+    for (size_t i = 1; i < num_row; ++i) {
+      for (size_t ch = 0; ch < num_channel; ++ch) {
+        const double prev_q = v[i * num_channel + ch];
+        v[(i + 1) * num_channel + ch] =
+          (rhs(base_values_list[ch], i) - tdma_lower_[i - 1] * prev_q) / tdma_den_[i];
+      }
+    }
+
+    // back substitution
+    for (size_t i = 1; i < num_row; ++i) {
+      const size_t j = num_row - 1 - i;
+      for (size_t ch = 0; ch < num_channel; ++ch) {
+        v[(j + 1) * num_channel + ch] =
+          tdma_p_[j] * v[(j + 2) * num_channel + ch] + v[(j + 1) * num_channel + ch];
+      }
+    }
+  }
+
+  std::vector<std::vector<double>> query_values_list(num_channel);
+  for (size_t ch = 0; ch < num_channel; ++ch) {
+    const auto & base_values = base_values_list[ch];
+    auto & query_values = query_values_list[ch];
+    query_values.resize(segment_indices_.size());
+    for (size_t i = 0; i < segment_indices_.size(); ++i) {
+      const size_t j = segment_indices_[i];
+      const double v0 = v[j * num_channel + ch];
+      const double v1 = v[(j + 1) * num_channel + ch];
+      const double diff_value = base_values[j + 1] - base_values[j];
+      const double a = (v1 - v0) / 6.0 / diff_keys_[j];
+      const double b = v0 / 2.0;
+      const double c = diff_value / diff_keys_[j] - diff_keys_[j] * (2 * v0 + v1) / 6.0;
+      const double d = base_values[j];
+      const double ds = segment_offsets_[i];
+      query_values[i] = d + (c + (b + a * ds) * ds) * ds;
+    }
+  }
+  return query_values_list;
+}
+
+std::vector<double> BatchInterpolation::splineByAkima(const std::vector<double> & base_values) const
+{
+  validateValues(base_values);
+
+  constexpr double epsilon = 1e-5;
+  const size_t num_base = base_keys_.size();
+
+  // calculate m
+  std::vector<double> m_values(num_base - 1);
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    m_values[i] = (base_values[i + 1] - base_values[i]) / diff_keys_[i];
+  }
+
+  // calculate s
+  std::vector<double> s_values(num_base);
+  for (size_t i = 0; i < num_base; ++i) {
+    if (i == 0) {
+      s_values[i] = m_values.front();
+    } else if (i == num_base - 1) {
+      s_values[i] = m_values.back();
+    } else if (i == 1 || i == num_base - 2) {
+      s_values[i] = (m_values[i - 1] + m_values[i]) / 2.0;
+    } else {
+      const double denom =
+        std::abs(m_values[i + 1] - m_values[i]) + std::abs(m_values[i - 1] - m_values[i - 2]);
+      if (std::abs(denom) < epsilon) {
+        s_values[i] = (m_values[i - 1] + m_values[i]) / 2.0;
+      } else {
+        s_values[i] = (std::abs(m_values[i + 1] - m_values[i]) * m_values[i - 1] +
+                       std::abs(m_values[i - 1] - m_values[i - 2]) * m_values[i]) /
+                      denom;
+      }
+    }
+  }
+
+  // interpolate with the cubic coefficients of each segment
+  std::vector<double> query_values(segment_indices_.size());
+  for (size_t i = 0; i < segment_indices_.size(); ++i) {
+    const size_t j = segment_indices_[i];
+    const double a =
+      (s_values[j] + s_values[j + 1] - 2.0 * m_values[j]) / std::pow(diff_keys_[j], 2);
+    const double b = (3.0 * m_values[j] - 2.0 * s_values[j] - s_values[j + 1]) / diff_keys_[j];
+    const double c = s_values[j];
+    const double d = base_values[j];
+    const double ds = segment_offsets_[i];
+    query_values[i] = d + (c + (b + a * ds) * ds) * ds;
+  }
+  return query_values;
+}
+}  // namespace interpolation
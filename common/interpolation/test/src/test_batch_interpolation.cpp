@@ -0,0 +1,132 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/batch_interpolation.hpp"
+#include "interpolation/linear_interpolation.hpp"
+#include "interpolation/spline_interpolation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+std::vector<double> generateKeys(const size_t num, const double max_interval, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> interval_dist(0.01, max_interval);
+  std::vector<double> keys{0.0};
+  for (size_t i = 1; i < num; ++i) {
+    keys.push_back(keys.back() + interval_dist(engine));
+  }
+  return keys;
+}
+
+std::vector<double> generateValues(const size_t num, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> value_dist(-10.0, 10.0);
+  std::vector<double> values;
+  for (size_t i = 0; i < num; ++i) {
+    values.push_back(value_dist(engine));
+  }
+  return values;
+}
+}  // namespace
+
+TEST(batch_interpolation, same_as_single_channel_interpolation)
+{
+  std::mt19937 engine(0);
+  for (const size_t num_base : {2, 3, 4, 5, 10, 100}) {
+    const auto base_keys = generateKeys(num_base, 2.0, engine);
+
+    // query keys include the base keys, the both ends and the points slightly out of the range
+    std::vector<double> query_keys{-1e-4};
+    std::uniform_real_distribution<double> query_interval_dist(0.0, 0.3);
+    while (query_keys.back() < base_keys.back()) {
+      query_keys.push_back(query_keys.back() + query_interval_dist(engine));
+    }
+    query_keys.back() = base_keys.back() + 1e-4;
+
+    const interpolation::BatchInterpolation interpolator(base_keys, query_keys);
+    ASSERT_EQ(interpolator.getSegmentIndices().size(), query_keys.size());
+
+    std::vector<std::vector<double>> base_values_list;
+    for (size_t i = 0; i < 3; ++i) {
+      base_values_list.push_back(generateValues(num_base, engine));
+    }
+
+    const auto spline_values_list = interpolator.spline(base_values_list);
+    ASSERT_EQ(spline_values_list.size(), base_values_list.size());
+    for (size_t ch = 0; ch < base_values_list.size(); ++ch) {
+      const auto & base_values = base_values_list.at(ch);
+      // the calculation is the same, so that the results are identical
+      EXPECT_EQ(
+        interpolator.lerp(base_values), interpolation::lerp(base_keys, base_values, query_keys));
+      EXPECT_EQ(
+        spline_values_list.at(ch), interpolation::spline(base_keys, base_values, query_keys));
+      EXPECT_EQ(
+        interpolator.spline(base_values),
+        interpolation::spline(base_keys, base_values, query_keys));
+    }
+  }
+}
+
+TEST(batch_interpolation, splineByAkima)
+{
+  std::mt19937 engine(1);
+  for (const size_t num_base : {2, 3, 4, 5, 10, 100}) {
+    const auto base_keys = generateKeys(num_base, 2.0, engine);
+    const auto base_values = generateValues(num_base, engine);
+
+    std::vector<double> query_keys{0.0};
+    std::uniform_real_distribution<double> query_interval_dist(0.0, 0.3);
+    while (query_keys.back() < base_keys.back()) {
+      query_keys.push_back(query_keys.back() + query_interval_dist(engine));
+    }
+    query_keys.back() = base_keys.back();
+
+    const interpolation::BatchInterpolation interpolator(base_keys, query_keys);
+    EXPECT_EQ(
+      interpolator.splineByAkima(base_values),
+      interpolation::splineByAkima(base_keys, base_values, query_keys));
+  }
+
+  // flat
+  const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+  const std::vector<double> base_values{1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+  const interpolation::BatchInterpolation interpolator(base_keys, {0.0, 0.5, 2.3, 5.0});
+  for (const auto value : interpolator.splineByAkima(base_values)) {
+    EXPECT_DOUBLE_EQ(value, 1.0);
+  }
+}
+
+TEST(batch_interpolation, invalid_arguments)
+{
+  const std::vector<double> base_keys{0.0, 1.0, 2.0};
+
+  // invalid keys
+  EXPECT_THROW(interpolation::BatchInterpolation({}, {0.0}), std::invalid_argument);
+  EXPECT_THROW(interpolation::BatchInterpolation({0.0}, {0.0}), std::invalid_argument);
+  EXPECT_THROW(interpolation::BatchInterpolation(base_keys, {}), std::invalid_argument);
+  EXPECT_THROW(interpolation::BatchInterpolation(base_keys, {1.0, 0.5}), std::invalid_argument);
+  EXPECT_THROW(interpolation::BatchInterpolation(base_keys, {0.0, 2.1}), std::invalid_argument);
+
+  // invalid values
+  const interpolation::BatchInterpolation interpolator(base_keys, {0.0, 1.5});
+  EXPECT_THROW(interpolator.lerp({0.0, 1.0}), std::invalid_argument);
+  EXPECT_THROW(interpolator.spline({0.0, 1.0}), std::invalid_argument);
+  EXPECT_THROW(interpolator.spline({{0.0, 1.0, 2.0}, {0.0, 1.0}}), std::invalid_argument);
+  EXPECT_THROW(interpolator.splineByAkima({0.0, 1.0}), std::invalid_argument);
+}
@@ -0,0 +1,215 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KALMAN_FILTER__RING_BUFFER_TIME_DELAY_KALMAN_FILTER_HPP_
+#define KALMAN_FILTER__RING_BUFFER_TIME_DELAY_KALMAN_FILTER_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <Eigen/StdVector>
+
+#include <iostream>
+#include <vector>
+
+/**
+ * @file ring_buffer_time_delay_kalman_filter.hpp
+ * @brief kalman filter with delayed measurement, which stores the delayed states in a ring buffer
+ *
+ * This gives the same results as TimeDelayKalmanFilter. The extended state and covariance are kept
+ * as fixed-size blocks per delay step, and a prediction only rotates the ring and computes the
+ * blocks related to the latest state instead of shifting the whole dense covariance.
+ */
+template <int DimX>
+class RingBufferTimeDelayKalmanFilter
+{
+public:
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P0 initial covariance of estimated state
+   * @param max_delay_step Maximum number of delay steps, which determines the dimension of the
+   * extended kalman filter
+   */
+  void init(const Eigen::MatrixXd & x, const Eigen::MatrixXd & P0, const int max_delay_step)
+  {
+    max_delay_step_ = max_delay_step;
+    head_ = 0;
+    x_.assign(max_delay_step_, x);
+    P_.assign(max_delay_step_ * max_delay_step_, StateMatrix::Zero());
+    for (int i = 0; i < max_delay_step_; ++i) {
+      block(i, i) = P0;
+    }
+  }
+
+  /**
+   * @brief get latest time estimated state
+   */
+  StateVector getLatestX() const { return x_.at(head_); }
+
+  /**
+   * @brief get latest time estimation covariance
+   */
+  StateMatrix getLatestP() const { return block(head_, head_); }
+
+  /**
+   * @brief get i-th element of the extended state, ordered from the latest to the oldest
+   */
+  double getXelement(const unsigned int i) const
+  {
+    return x_.at(slot(static_cast<int>(i) / DimX))(static_cast<int>(i) % DimX);
+  }
+
+  /**
+   * @brief get the extended state in the same layout as TimeDelayKalmanFilter
+   */
+  Eigen::MatrixXd getX() const
+  {
+    Eigen::MatrixXd x(DimX * max_delay_step_, 1);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x.block<DimX, 1>(i * DimX, 0) = x_.at(slot(i));
+    }
+    return x;
+  }
+
+  /**
+   * @brief get the extended covariance in the same layout as TimeDelayKalmanFilter
+   */
+  Eigen::MatrixXd getP() const
+  {
+    Eigen::MatrixXd P(DimX * max_delay_step_, DimX * max_delay_step_);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      for (int j = 0; j < max_delay_step_; ++j) {
+        P.block<DimX, DimX>(i * DimX, j * DimX) = block(slot(i), slot(j));
+      }
+    }
+    return P;
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by precision model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param x_next predicted state by prediction model
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   */
+  bool predictWithDelay(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    /*
+     * Same model as TimeDelayKalmanFilter::predictWithDelay().
+     *
+     *     [A*P11*A'*+Q  A*P11  A*P12]
+     * P = [     P11*A'    P11    P12]
+     *     [     P21*A'    P21    P22]
+     *
+     * Only the first block row and column change. The others are shifted by one step, which is
+     * done by moving the head of the ring to the slot of the oldest state.
+     */
+    const int prev_head = head_;
+    const int next_head = slot(max_delay_step_ - 1);
+
+    block(next_head, next_head) = A * block(prev_head, prev_head) * A.transpose() + Q;
+    for (int i = 0; i < max_delay_step_ - 1; ++i) {
+      const int s = slot(i);
+      block(next_head, s) = A * block(prev_head, s);
+      block(s, next_head) = block(s, prev_head) * A.transpose();
+    }
+
+    x_.at(next_head) = x_next;
+    head_ = next_head;
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by measurement model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @param delay_step measurement delay
+   */
+  bool updateWithDelay(
+    const Eigen::MatrixXd & y, const Eigen::MatrixXd & C, const Eigen::MatrixXd & R,
+    const int delay_step)
+  {
+    if (delay_step >= max_delay_step_) {
+      std::cerr << "delay step is larger than max_delay_step. ignore update." << std::endl;
+      return false;
+    }
+
+    const auto dim_y = y.rows();
+    if (C.cols() != DimX || C.rows() != dim_y || R.rows() != dim_y || R.cols() != dim_y) {
+      return false;
+    }
+
+    /*
+     * The extended measurement matrix has C only in the column block of the delayed state s.
+     * Therefore P * C_ex' is the column block s multiplied by C', and C_ex * P is C multiplied by
+     * the row block s.
+     */
+    const int s = slot(delay_step);
+    pct_.resize(max_delay_step_);
+    cp_.resize(max_delay_step_);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      pct_.at(i).noalias() = block(i, s) * C.transpose();
+      cp_.at(i).noalias() = C * block(s, i);
+    }
+    const Eigen::MatrixXd S_inv = (R + C * pct_.at(s)).inverse();
+
+    gains_.resize(max_delay_step_);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      gains_.at(i).noalias() = pct_.at(i) * S_inv;
+      if (gains_.at(i).array().isNaN().any() || gains_.at(i).array().isInf().any()) {
+        return false;
+      }
+    }
+
+    const Eigen::VectorXd innovation = y - C * x_.at(s);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x_.at(i) += gains_.at(i) * innovation;
+      for (int j = 0; j < max_delay_step_; ++j) {
+        block(i, j).noalias() -= gains_.at(i) * cp_.at(j);
+      }
+    }
+    return true;
+  }
+
+private:
+  using GainMatrix = Eigen::Matrix<double, DimX, Eigen::Dynamic>;
+  using MeasurementMatrix = Eigen::Matrix<double, Eigen::Dynamic, DimX>;
+
+  int max_delay_step_{0};  //!< @brief maximum number of delay steps
+  int head_{0};            //!< @brief slot of the latest state
+
+  // state of each slot
+  std::vector<StateVector, Eigen::aligned_allocator<StateVector>> x_;
+  // covariance blocks between slots, stored in row-major order of slots
+  std::vector<StateMatrix, Eigen::aligned_allocator<StateMatrix>> P_;
+
+  // buffers for the update, which are kept to avoid allocation
+  std::vector<GainMatrix> pct_;
+  std::vector<MeasurementMatrix> cp_;
+  std::vector<GainMatrix> gains_;
+
+  int slot(const int delay_step) const { return (head_ + delay_step) % max_delay_step_; }
+  StateMatrix & block(const int i, const int j) { return P_[i * max_delay_step_ + j]; }
+  const StateMatrix & block(const int i, const int j) const
+  {
+    return P_[i * max_delay_step_ + j];
+  }
+};
+
+#endif  // KALMAN_FILTER__RING_BUFFER_TIME_DELAY_KALMAN_FILTER_HPP_
@@ -0,0 +1,143 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kalman_filter/ring_buffer_time_delay_kalman_filter.hpp"
+#include "kalman_filter/time_delay_kalman_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace
+{
+constexpr int dim_x = 6;
+constexpr int dim_y = 3;
+
+struct Sequence
+{
+  Eigen::MatrixXd x0;
+  Eigen::MatrixXd P0;
+  std::vector<Eigen::MatrixXd> A;
+  std::vector<Eigen::MatrixXd> Q;
+  std::vector<Eigen::MatrixXd> x_next;
+  std::vector<Eigen::MatrixXd> y;
+  std::vector<int> delay_step;
+  Eigen::MatrixXd C;
+  Eigen::MatrixXd R;
+};
+
+Sequence create_random_sequence(const int num_steps, const int max_delay_step)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::uniform_int_distribution<int> delay_dist(0, max_delay_step - 1);
+  auto random_matrix = [&](const int rows, const int cols) {
+    return Eigen::MatrixXd(Eigen::MatrixXd::NullaryExpr(rows, cols, [&]() { return dist(engine); }));
+  };
+
+  Sequence sequence;
+  sequence.x0 = random_matrix(dim_x, 1);
+  const Eigen::MatrixXd L = random_matrix(dim_x, dim_x);
+  sequence.P0 = L * L.transpose() + Eigen::MatrixXd::Identity(dim_x, dim_x);
+  sequence.C = Eigen::MatrixXd::Zero(dim_y, dim_x);
+  sequence.C.block(0, 0, dim_y, dim_y).setIdentity();
+  sequence.R = Eigen::MatrixXd::Identity(dim_y, dim_y) * 0.1;
+
+  for (int i = 0; i < num_steps; ++i) {
+    sequence.A.push_back(
+      Eigen::MatrixXd::Identity(dim_x, dim_x) + 0.01 * random_matrix(dim_x, dim_x));
+    sequence.Q.push_back(Eigen::MatrixXd::Identity(dim_x, dim_x) * 0.01);
+    sequence.x_next.push_back(random_matrix(dim_x, 1));
+    sequence.y.push_back(random_matrix(dim_y, 1));
+    sequence.delay_step.push_back(delay_dist(engine));
+  }
+  return sequence;
+}
+}  // namespace
+
+TEST(ring_buffer_time_delay_kalman_filter, same_as_time_delay_kalman_filter)
+{
+  constexpr int max_delay_step = 10;
+  const auto sequence = create_random_sequence(100, max_delay_step);
+
+  TimeDelayKalmanFilter dense_kf;
+  RingBufferTimeDelayKalmanFilter<dim_x> ring_kf;
+  dense_kf.init(sequence.x0, sequence.P0, max_delay_step);
+  ring_kf.init(sequence.x0, sequence.P0, max_delay_step);
+
+  for (size_t i = 0; i < sequence.A.size(); ++i) {
+    EXPECT_TRUE(dense_kf.predictWithDelay(sequence.x_next[i], sequence.A[i], sequence.Q[i]));
+    EXPECT_TRUE(ring_kf.predictWithDelay(sequence.x_next[i], sequence.A[i], sequence.Q[i]));
+
+    // update every other step like a measurement arriving at a lower rate
+    if (i % 2 == 0) {
+      const int delay_step = sequence.delay_step[i];
+      EXPECT_TRUE(dense_kf.updateWithDelay(sequence.y[i], sequence.C, sequence.R, delay_step));
+      EXPECT_TRUE(ring_kf.updateWithDelay(sequence.y[i], sequence.C, sequence.R, delay_step));
+    }
+
+    Eigen::MatrixXd dense_x;
+    Eigen::MatrixXd dense_P;
+    dense_kf.getX(dense_x);
+    dense_kf.getP(dense_P);
+    ASSERT_TRUE(ring_kf.getX().isApprox(dense_x, 1e-9));
+    ASSERT_TRUE(ring_kf.getP().isApprox(dense_P, 1e-9));
+    for (int j = 0; j < dim_x * max_delay_step; ++j) {
+      EXPECT_NEAR(ring_kf.getXelement(j), dense_kf.getXelement(j), 1e-9);
+    }
+  }
+}
+
+TEST(ring_buffer_time_delay_kalman_filter, reject_too_large_delay)
+{
+  constexpr int max_delay_step = 3;
+  const auto sequence = create_random_sequence(1, max_delay_step);
+
+  RingBufferTimeDelayKalmanFilter<dim_x> ring_kf;
+  ring_kf.init(sequence.x0, sequence.P0, max_delay_step);
+  EXPECT_FALSE(ring_kf.updateWithDelay(sequence.y[0], sequence.C, sequence.R, max_delay_step));
+
+  // measurement dimension mismatch
+  EXPECT_FALSE(ring_kf.updateWithDelay(
+    Eigen::MatrixXd::Zero(dim_y + 1, 1), sequence.C, sequence.R, 0));
+}
+
+TEST(ring_buffer_time_delay_kalman_filter, DISABLED_benchmark)
+{
+  // same dimension as ekf_localizer with 50 extended steps
+  constexpr int max_delay_step = 50;
+  constexpr int num_steps = 1000;
+  const auto sequence = create_random_sequence(num_steps, max_delay_step);
+
+  auto measure = [&](auto & kf) {
+    kf.init(sequence.x0, sequence.P0, max_delay_step);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_steps; ++i) {
+      kf.predictWithDelay(sequence.x_next[i], sequence.A[i], sequence.Q[i]);
+      if (i % 2 == 0) {
+        kf.updateWithDelay(sequence.y[i], sequence.C, sequence.R, sequence.delay_step[i]);
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / num_steps;
+  };
+
+  TimeDelayKalmanFilter dense_kf;
+  RingBufferTimeDelayKalmanFilter<dim_x> ring_kf;
+  std::cout << "TimeDelayKalmanFilter: " << measure(dense_kf) << " [us/step]" << std::endl;
+  std::cout << "RingBufferTimeDelayKalmanFilter: " << measure(ring_kf) << " [us/step]"
+            << std::endl;
+}
@@ -16,6 +16,7 @@
 #define QP_INTERFACE__QP_INTERFACE_HPP_
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <optional>
 #include <string>
@@ -31,6 +32,15 @@ public:
   std::vector<double> optimize(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u);
+  std::vector<double> optimize(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
+
+  // Set the primal variables to start the next optimization from. The guess is used only once.
+  void setPrimalInitialGuess(const std::vector<double> & primal_variables)
+  {
+    primal_initial_guess_ = primal_variables;
+  }
 
   virtual bool isSolved() const = 0;
   virtual int getIterationNumber() const = 0;
@@ -46,15 +56,29 @@ protected:
   void initializeProblem(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u);
+  void initializeProblem(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
 
   virtual void initializeProblemImpl(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u) = 0;
+  virtual void initializeProblemImpl(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l,
+    const std::vector<double> & u) = 0;
 
   virtual std::vector<double> optimizeImpl() = 0;
 
   std::optional<size_t> variables_num_{std::nullopt};
   std::optional<size_t> constraints_num_{std::nullopt};
+  std::optional<std::vector<double>> primal_initial_guess_{std::nullopt};
+
+private:
+  static void validateProblemSize(
+    const Eigen::Index P_rows, const Eigen::Index P_cols, const Eigen::Index A_rows,
+    const Eigen::Index A_cols, const std::vector<double> & q, const std::vector<double> & l,
+    const std::vector<double> & u);
 };
 }  // namespace autoware::common
 
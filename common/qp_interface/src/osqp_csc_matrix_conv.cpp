@@ -111,6 +111,55 @@ CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::MatrixXd & mat)
   return csc_matrix;
 }
 
+CSC_Matrix calCSCMatrix(const Eigen::SparseMatrix<double> & mat)
+{
+  CSC_Matrix csc_matrix;
+  csc_matrix.vals_.reserve(static_cast<size_t>(mat.nonZeros()));
+  csc_matrix.row_idxs_.reserve(static_cast<size_t>(mat.nonZeros()));
+  csc_matrix.col_idxs_.reserve(static_cast<size_t>(mat.outerSize() + 1));
+
+  // only the stored elements are visited, and small values are removed as the dense version does
+  csc_matrix.col_idxs_.push_back(0);
+  for (Eigen::Index j = 0; j < mat.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(mat, j); it; ++it) {
+      if (std::fabs(it.value()) < 1e-9) {
+        continue;
+      }
+      csc_matrix.vals_.push_back(it.value());
+      csc_matrix.row_idxs_.push_back(static_cast<c_int>(it.row()));
+    }
+    csc_matrix.col_idxs_.push_back(static_cast<c_int>(csc_matrix.vals_.size()));
+  }
+
+  return csc_matrix;
+}
+
+CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::SparseMatrix<double> & mat)
+{
+  if (mat.rows() != mat.cols()) {
+    throw std::invalid_argument("Matrix must be square (n, n)");
+  }
+
+  CSC_Matrix csc_matrix;
+  csc_matrix.vals_.reserve(static_cast<size_t>(mat.nonZeros()));
+  csc_matrix.row_idxs_.reserve(static_cast<size_t>(mat.nonZeros()));
+  csc_matrix.col_idxs_.reserve(static_cast<size_t>(mat.outerSize() + 1));
+
+  csc_matrix.col_idxs_.push_back(0);
+  for (Eigen::Index j = 0; j < mat.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(mat, j); it; ++it) {
+      if (j < it.row() || std::fabs(it.value()) < 1e-9) {
+        continue;
+      }
+      csc_matrix.vals_.push_back(it.value());
+      csc_matrix.row_idxs_.push_back(static_cast<c_int>(it.row()));
+    }
+    csc_matrix.col_idxs_.push_back(static_cast<c_int>(csc_matrix.vals_.size()));
+  }
+
+  return csc_matrix;
+}
+
 void printCSCMatrix(const CSC_Matrix & csc_mat)
 {
   std::cout << "[";
@@ -76,6 +76,15 @@ void OSQPInterface::initializeProblemImpl(
   initializeCSCProblemImpl(P_csc, A_csc, q, l, u);
 }
 
+void OSQPInterface::initializeProblemImpl(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
+{
+  CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
+  CSC_Matrix A_csc = calCSCMatrix(A);
+  initializeCSCProblemImpl(P_csc, A_csc, q, l, u);
+}
+
 void OSQPInterface::initializeCSCProblemImpl(
   CSC_Matrix P_csc, CSC_Matrix A_csc, const std::vector<double> & q, const std::vector<double> & l,
   const std::vector<double> & u)
@@ -351,6 +360,10 @@ std::vector<double> OSQPInterface::getDualSolution() const
 
 std::vector<double> OSQPInterface::optimizeImpl()
 {
+  // NOTE: OSQP starts from the given primal variables only when warm start is enabled.
+  if (primal_initial_guess_ && static_cast<int64_t>(primal_initial_guess_->size()) == param_n_) {
+    setPrimalVariables(*primal_initial_guess_);
+  }
   osqp_solve(work_.get());
 
   double * sol_x = work_->solution->x;
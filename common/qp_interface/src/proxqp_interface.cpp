@@ -32,6 +32,15 @@ ProxQPInterface::ProxQPInterface(
 void ProxQPInterface::initializeProblemImpl(
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
   const std::vector<double> & l, const std::vector<double> & u)
+{
+  const Eigen::SparseMatrix<double> P_sparse = P.sparseView();
+  const Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+  initializeProblemImpl(P_sparse, A_sparse, q, l, u);
+}
+
+void ProxQPInterface::initializeProblemImpl(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
 {
   const size_t variables_num = q.size();
   const size_t constraints_num = l.size();
@@ -61,9 +70,6 @@ void ProxQPInterface::initializeProblemImpl(
 
   qp_ptr_->settings = settings_;
 
-  Eigen::SparseMatrix<double> P_sparse(variables_num, constraints_num);
-  P_sparse = P.sparseView();
-
   // NOTE: const std vector cannot be converted to eigen vector
   std::vector<double> non_const_q = q;
   Eigen::VectorXd eigen_q =
@@ -76,11 +82,9 @@ void ProxQPInterface::initializeProblemImpl(
     Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(u_std_vec.data(), u_std_vec.size());
 
   if (enable_warm_start) {
-    qp_ptr_->update(
-      P_sparse, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A.sparseView(), eigen_l, eigen_u);
+    qp_ptr_->update(P, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A, eigen_l, eigen_u);
   } else {
-    qp_ptr_->init(
-      P_sparse, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A.sparseView(), eigen_l, eigen_u);
+    qp_ptr_->init(P, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A, eigen_l, eigen_u);
   }
 }
 
@@ -142,7 +146,14 @@ std::string ProxQPInterface::getStatus() const
 
 std::vector<double> ProxQPInterface::optimizeImpl()
 {
-  qp_ptr_->solve();
+  if (primal_initial_guess_ && primal_initial_guess_->size() == *variables_num_) {
+    // start from the given primal variables instead of the previous result
+    const Eigen::VectorXd x = Eigen::Map<const Eigen::VectorXd>(
+      primal_initial_guess_->data(), static_cast<Eigen::Index>(primal_initial_guess_->size()));
+    qp_ptr_->solve(x, proxsuite::nullopt, proxsuite::nullopt);
+  } else {
+    qp_ptr_->solve();
+  }
 
   std::vector<double> result;
   for (Eigen::Index i = 0; i < qp_ptr_->results.x.size(); ++i) {
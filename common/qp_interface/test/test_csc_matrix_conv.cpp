@@ -164,6 +164,30 @@ TEST(TestCscMatrixConv, Trapezoidal)
     EXPECT_EQ(e.what(), std::string("Matrix must be square (n, n)"));
   }
 }
+TEST(TestCscMatrixConv, Sparse)
+{
+  using autoware::common::calCSCMatrix;
+  using autoware::common::calCSCMatrixTrapezoidal;
+  using autoware::common::CSC_Matrix;
+
+  Eigen::MatrixXd square(3, 3);
+  Eigen::MatrixXd rect(2, 3);
+  square << 1.0, 2.0, 0.0, 2.0, 4.0, 1e-10, 0.0, 1e-10, 3.0;
+  rect << 0.0, 1.0, 5.0, -1.0, 0.0, 0.0;
+
+  // the same matrices as the dense version
+  const auto expect_same = [](const CSC_Matrix & expected, const CSC_Matrix & actual) {
+    EXPECT_EQ(expected.vals_, actual.vals_);
+    EXPECT_EQ(expected.row_idxs_, actual.row_idxs_);
+    EXPECT_EQ(expected.col_idxs_, actual.col_idxs_);
+  };
+  const Eigen::SparseMatrix<double> square_sparse = square.sparseView();
+  const Eigen::SparseMatrix<double> rect_sparse = rect.sparseView();
+  expect_same(calCSCMatrix(square), calCSCMatrix(square_sparse));
+  expect_same(calCSCMatrixTrapezoidal(square), calCSCMatrixTrapezoidal(square_sparse));
+  expect_same(calCSCMatrix(rect), calCSCMatrix(rect_sparse));
+  EXPECT_THROW(calCSCMatrixTrapezoidal(rect_sparse), std::invalid_argument);
+}
 TEST(TestCscMatrixConv, Print)
 {
   using autoware::common::calCSCMatrix;
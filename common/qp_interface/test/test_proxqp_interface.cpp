@@ -79,5 +79,27 @@ TEST(TestProxqpInterface, BasicQp)
       EXPECT_EQ(proxqp.getIterationNumber(), 0);
     }
   }
+
+  {
+    // Define problem with sparse matrices
+    autoware::common::ProxQPInterface proxqp(false, 4000, 1e-9, 1e-9, false);
+    const Eigen::SparseMatrix<double> P_sparse = P.sparseView();
+    const Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+    const auto solution = proxqp.QPInterface::optimize(P_sparse, A_sparse, q, l, u);
+    const auto status = proxqp.getStatus();
+    check_result(solution, status);
+  }
+
+  {
+    // Define problem with the initial guess of the optimal solution
+    autoware::common::ProxQPInterface proxqp(false, 4000, 1e-9, 1e-9, false);
+    const auto cold_solution = proxqp.QPInterface::optimize(P, A, q, l, u);
+    const auto cold_iteration = proxqp.getIterationNumber();
+    proxqp.setPrimalInitialGuess(cold_solution);
+    const auto solution = proxqp.QPInterface::optimize(P, A, q, l, u);
+    const auto status = proxqp.getStatus();
+    check_result(solution, status);
+    EXPECT_LE(proxqp.getIterationNumber(), cold_iteration);
+  }
 }
 }  // namespace
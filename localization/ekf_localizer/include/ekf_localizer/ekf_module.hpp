@@ -20,7 +20,7 @@
 #include "ekf_localizer/warning.hpp"
 
 #include <kalman_filter/kalman_filter.hpp>
-#include <kalman_filter/time_delay_kalman_filter.hpp>
+#include <kalman_filter/ring_buffer_time_delay_kalman_filter.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <geometry_msgs/msg/pose_stamped.hpp>
@@ -83,7 +83,7 @@ public:
     const PoseWithCovariance & pose, tf2::Vector3 last_angular_velocity, const double delay_time);
 
 private:
-  TimeDelayKalmanFilter kalman_filter_;
+  RingBufferTimeDelayKalmanFilter<6> kalman_filter_;  // x, y, yaw, yaw_bias, vx, wz
 
   std::shared_ptr<Warning> warning_;
   const int dim_x_;
@@ -16,6 +16,8 @@
 #define YABLOC_PARTICLE_FILTER__CAMERA_CORRECTOR__CAMERA_PARTICLE_CORRECTOR_HPP_
 
 #include <opencv4/opencv2/core.hpp>
+#include <sophus/geometry.hpp>
+#include <yabloc_particle_filter/camera_corrector/line_segment_samples.hpp>
 #include <yabloc_particle_filter/correction/abstract_corrector.hpp>
 #include <yabloc_particle_filter/ll2_cost_map/hierarchical_cost_map.hpp>
 
@@ -35,6 +37,8 @@ namespace yabloc::modularized_particle_filter
 {
 cv::Point2f cv2pt(const Eigen::Vector3f & v);
 float abs_cos(const Eigen::Vector3f & t, float deg);
+// same as abs_cos() with the directions of the integer degrees in a table, and 0 for a zero vector
+float abs_cos_from_table(const Eigen::Vector2f & t, int deg);
 
 class CameraParticleCorrector : public modularized_particle_filter::AbstractCorrector
 {
@@ -54,6 +58,7 @@ public:
 private:
   const float min_prob_;
   const float far_weight_gain_;
+  const int num_threads_;
   HierarchicalCostMap cost_map_;
 
   rclcpp::Subscription<PointCloud2>::SharedPtr sub_bounding_box_;
@@ -85,8 +90,11 @@ private:
 
   std::pair<LineSegments, LineSegments> split_line_segments(const PointCloud2 & msg);
 
+  void weight_particles(const LineSegmentSamples & samples, ParticleArray & particle_array);
+
   float compute_logit(
-    const LineSegments & line_segments_cloud, const Eigen::Vector3f & self_position);
+    const LineSegmentSamples & samples, const Sophus::SE3f & transform,
+    CostMapTileView & tile_view) const;
 
   pcl::PointCloud<pcl::PointXYZI> evaluate_cloud(
     const LineSegments & line_segments_cloud, const Eigen::Vector3f & self_position);
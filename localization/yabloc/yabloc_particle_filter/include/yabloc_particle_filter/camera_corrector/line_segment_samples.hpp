@@ -0,0 +1,51 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YABLOC_PARTICLE_FILTER__CAMERA_CORRECTOR__LINE_SEGMENT_SAMPLES_HPP_
+#define YABLOC_PARTICLE_FILTER__CAMERA_CORRECTOR__LINE_SEGMENT_SAMPLES_HPP_
+
+#include <Eigen/Core>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+namespace yabloc::modularized_particle_filter
+{
+/**
+ * Points sampled along line segments in the vehicle frame, stored column by column.
+ * The samples are identical for every particle, so they are built once per frame and only
+ * transformed by each particle pose.
+ */
+struct LineSegmentSamples
+{
+  using LineSegments = pcl::PointCloud<pcl::PointXYZLNormal>;
+
+  Eigen::Matrix3Xf positions;
+  Eigen::Matrix3Xf tangents;
+  Eigen::VectorXf weights;  // 1 for reliable (apriori) segments, smaller for iffy ones
+  float max_radius{0.f};    // max distance of the samples from the origin
+
+  /**
+   * @param[in] line_segments line segments in the vehicle frame
+   * @param[in] interval sampling interval along each segment [m]
+   * @param[in] iffy_weight weight of the samples on segments whose label is 0
+   */
+  static LineSegmentSamples build(
+    const LineSegments & line_segments, float interval, float iffy_weight);
+
+  [[nodiscard]] Eigen::Index size() const { return positions.cols(); }
+};
+}  // namespace yabloc::modularized_particle_filter
+
+#endif  // YABLOC_PARTICLE_FILTER__CAMERA_CORRECTOR__LINE_SEGMENT_SAMPLES_HPP_
@@ -30,7 +30,9 @@
 #include <pcl/point_types.h>
 
 #include <list>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace yabloc
@@ -94,6 +96,35 @@ struct CostMapValue
   bool unmapped;    // true/false
 };
 
+/**
+ * Read-only view of cost map tiles which have been built in advance.
+ * Lookups go directly to the tile images without building maps, so separate copies of a view can
+ * be used from multiple threads.
+ */
+class CostMapTileView
+{
+public:
+  CostMapTileView() = default;
+  CostMapTileView(
+    std::vector<std::pair<Area, const cv::Mat *>> tiles, float max_range, float image_size);
+
+  /**
+   * Get pixel value at specified pixel
+   *
+   * @param[in] position Real scale position at world frame
+   * @return The same value as HierarchicalCostMap::at(), or unmapped if the tile is not in this view
+   */
+  CostMapValue at(const Eigen::Vector2f & position);
+
+private:
+  std::vector<std::pair<Area, const cv::Mat *>> tiles_;
+  float max_range_{1.f};
+  float image_size_{1.f};
+  // the consecutive samples are mostly on the same tile
+  std::optional<Area> last_area_{std::nullopt};
+  const cv::Mat * last_tile_{nullptr};
+};
+
 class HierarchicalCostMap
 {
 public:
@@ -117,6 +148,15 @@ public:
    */
   CostMapValue at(const Eigen::Vector2f & position);
 
+  /**
+   * Build all tiles overlapping the specified rectangle and get a view of them
+   *
+   * @param[in] min_position Minimum corner of the rectangle at world frame
+   * @param[in] max_position Maximum corner of the rectangle at world frame
+   */
+  CostMapTileView prepare_tiles(
+    const Eigen::Vector2f & min_position, const Eigen::Vector2f & max_position);
+
   MarkerArray show_map_range() const;
 
   cv::Mat get_map_image(const Pose & pose);
@@ -25,7 +25,9 @@
 
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <array>
 #include <cmath>
+#include <limits>
 
 namespace yabloc::modularized_particle_filter
 {
@@ -34,6 +36,7 @@ CameraParticleCorrector::CameraParticleCorrector(const rclcpp::NodeOptions & opt
 : AbstractCorrector("camera_particle_corrector", options),
   min_prob_(static_cast<float>(declare_parameter<float>("min_prob"))),
   far_weight_gain_(static_cast<float>(declare_parameter<float>("far_weight_gain"))),
+  num_threads_(static_cast<int>(declare_parameter<int>("num_threads"))),
   cost_map_(this)
 {
   using std::placeholders::_1;
@@ -168,17 +171,12 @@ void CameraParticleCorrector::on_line_segments(const PointCloud2 & line_segments
   cost_map_.set_height(static_cast<float>(mean_pose.position.z));
 
   if (publish_weighted_particles) {
-    for (auto & particle : weighted_particles.particles) {
-      Sophus::SE3f transform = common::pose_to_se3(particle.pose);
-      LineSegments transformed_line_segments =
-        common::transform_line_segments(line_segments_cloud, transform);
-      LineSegments transformed_iffy_line_segments =
-        common::transform_line_segments(iffy_line_segments_cloud, transform);
-      transformed_line_segments += transformed_iffy_line_segments;
-
-      float logit = compute_logit(transformed_line_segments, transform.translation());
-      particle.weight = logit_to_prob(logit, 0.01f);
-    }
+    // the line segments are identical for all particles, so they are sampled only once
+    LineSegments all_line_segments_cloud = line_segments_cloud;
+    all_line_segments_cloud += iffy_line_segments_cloud;
+    const LineSegmentSamples samples =
+      LineSegmentSamples::build(all_line_segments_cloud, 0.1f, 0.2f);
+    weight_particles(samples, weighted_particles);
 
     if (enable_switch_) {
       this->set_weighted_particle_array(weighted_particles);
@@ -264,35 +262,91 @@ float abs_cos(const Eigen::Vector3f & t, float deg)
   return std::abs(x.dot(y));
 }
 
-float CameraParticleCorrector::compute_logit(
-  const LineSegments & line_segments_cloud, const Eigen::Vector3f & self_position)
+float abs_cos_from_table(const Eigen::Vector2f & t, int deg)
 {
-  float logit = 0;
-  for (const LineSegment & pn : line_segments_cloud) {
-    const Eigen::Vector3f tangent = (pn.getNormalVector3fMap() - pn.getVector3fMap()).normalized();
-    const float length = (pn.getVector3fMap() - pn.getNormalVector3fMap()).norm();
+  // (cos, sin) of every integer degree in [0, 180), which covers all directions as |cos| is
+  // unchanged by a half turn
+  static const std::array<Eigen::Vector2f, 180> direction_table = []() {
+    std::array<Eigen::Vector2f, 180> table;
+    for (size_t deg = 0; deg < table.size(); ++deg) {
+      const auto radian = static_cast<float>(deg * M_PI / 180.0);
+      table[deg] = Eigen::Vector2f(
+        autoware::universe_utils::cos(radian), autoware::universe_utils::sin(radian));
+    }
+    return table;
+  }();
 
-    for (float distance = 0; distance < length; distance += 0.1f) {
-      Eigen::Vector3f p = pn.getVector3fMap() + tangent * distance;
+  const float norm = t.norm();
+  if (norm == 0.f) {
+    return 0.f;
+  }
+  // the angle of the cost map is in [0, 180], but wrap it so that no value is out of the table
+  const int index = ((deg % 180) + 180) % 180;
+  return std::abs(t.dot(direction_table[static_cast<size_t>(index)])) / norm;
+}
 
-      // NOTE: Close points are prioritized
-      float squared_norm = (p - self_position).topRows(2).squaredNorm();
-      float gain = std::exp(-far_weight_gain_ * squared_norm);  // 0 < gain < 1
+void CameraParticleCorrector::weight_particles(
+  const LineSegmentSamples & samples, ParticleArray & particle_array)
+{
+  if (particle_array.particles.empty()) {
+    return;
+  }
 
-      const CostMapValue v3 = cost_map_.at(p.topRows(2));
+  // build all cost map tiles which the samples can reach before the parallel lookups
+  Eigen::Vector2f min_position = Eigen::Vector2f::Constant(std::numeric_limits<float>::max());
+  Eigen::Vector2f max_position = Eigen::Vector2f::Constant(std::numeric_limits<float>::lowest());
+  for (const auto & particle : particle_array.particles) {
+    const Eigen::Vector2f position(
+      static_cast<float>(particle.pose.position.x), static_cast<float>(particle.pose.position.y));
+    min_position = min_position.cwiseMin(position);
+    max_position = max_position.cwiseMax(position);
+  }
+  const Eigen::Vector2f margin = Eigen::Vector2f::Constant(samples.max_radius);
+  const CostMapTileView tile_view =
+    cost_map_.prepare_tiles(min_position - margin, max_position + margin);
 
-      if (v3.unmapped) {
-        // logit does not change if target pixel is unmapped
-        continue;
-      }
-      if (pn.label == 0) {  // posteriori
-        logit +=
-          0.2f * gain * (abs_cos(tangent, static_cast<float>(v3.angle)) * v3.intensity - 0.5f);
-      } else {  // apriori
-        logit += gain * (abs_cos(tangent, static_cast<float>(v3.angle)) * v3.intensity - 0.5f);
-      }
+  const auto particle_count = static_cast<int>(particle_array.particles.size());
+#pragma omp parallel num_threads(num_threads_)
+  {
+    CostMapTileView local_tile_view = tile_view;
+#pragma omp for
+    for (int i = 0; i < particle_count; ++i) {
+      auto & particle = particle_array.particles.at(static_cast<size_t>(i));
+      const float logit =
+        compute_logit(samples, common::pose_to_se3(particle.pose), local_tile_view);
+      particle.weight = logit_to_prob(logit, 0.01f);
     }
   }
+}
+
+float CameraParticleCorrector::compute_logit(
+  const LineSegmentSamples & samples, const Sophus::SE3f & transform,
+  CostMapTileView & tile_view) const
+{
+  // buffers are reused across particles handled by the same thread
+  thread_local Eigen::Matrix2Xf relative_positions;
+  thread_local Eigen::Matrix2Xf tangents;
+  thread_local Eigen::ArrayXf gains;
+
+  // only the horizontal components are used for the cost map lookup
+  const Eigen::Matrix<float, 2, 3> rotation = transform.rotationMatrix().topRows<2>();
+  const Eigen::Vector2f translation = transform.translation().topRows<2>();
+  relative_positions.noalias() = rotation * samples.positions;
+  tangents.noalias() = rotation * samples.tangents;
+  // NOTE: Close points are prioritized
+  gains = (-far_weight_gain_ * relative_positions.colwise().squaredNorm().array()).exp();
+
+  float logit = 0;
+  for (Eigen::Index i = 0; i < samples.size(); ++i) {
+    const CostMapValue v3 = tile_view.at(relative_positions.col(i) + translation);
+    if (v3.unmapped) {
+      // logit does not change if target pixel is unmapped
+      continue;
+    }
+
+    const float cos_value = abs_cos_from_table(tangents.col(i), v3.angle);
+    logit += samples.weights(i) * gains(i) * (cos_value * v3.intensity - 0.5f);
+  }
   return logit;
 }
 
@@ -0,0 +1,59 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/camera_corrector/line_segment_samples.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace yabloc::modularized_particle_filter
+{
+LineSegmentSamples LineSegmentSamples::build(
+  const LineSegments & line_segments, float interval, float iffy_weight)
+{
+  // count the samples first so that the buffers are allocated only once
+  auto sample_count = [interval](const pcl::PointXYZLNormal & pn) -> Eigen::Index {
+    const float length = (pn.getVector3fMap() - pn.getNormalVector3fMap()).norm();
+    Eigen::Index count = 0;
+    for (float distance = 0; distance < length; distance += interval) ++count;
+    return count;
+  };
+
+  Eigen::Index total = 0;
+  for (const auto & pn : line_segments) total += sample_count(pn);
+
+  LineSegmentSamples samples;
+  samples.positions.resize(3, total);
+  samples.tangents.resize(3, total);
+  samples.weights.resize(total);
+
+  Eigen::Index index = 0;
+  for (const auto & pn : line_segments) {
+    const Eigen::Vector3f from = pn.getVector3fMap();
+    const Eigen::Vector3f tangent = (pn.getNormalVector3fMap() - from).normalized();
+    const float length = (from - pn.getNormalVector3fMap()).norm();
+    const float weight = (pn.label == 0) ? iffy_weight : 1.f;
+
+    // NOTE: the accumulation must be the same as sample_count()
+    for (float distance = 0; distance < length; distance += interval) {
+      samples.positions.col(index) = from + tangent * distance;
+      samples.tangents.col(index) = tangent;
+      samples.weights(index) = weight;
+      samples.max_radius = std::max(samples.max_radius, samples.positions.col(index).norm());
+      ++index;
+    }
+  }
+  return samples;
+}
+}  // namespace yabloc::modularized_particle_filter
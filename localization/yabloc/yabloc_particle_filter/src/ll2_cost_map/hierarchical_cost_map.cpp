@@ -22,6 +22,10 @@
 
 #include <boost/geometry/geometry.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace yabloc
 {
 float Area::unit_length = -1;
@@ -62,6 +66,58 @@ CostMapValue HierarchicalCostMap::at(const Eigen::Vector2f & position)
   return {static_cast<float>(b3[0]) / 255.f, b3[1], b3[2] == 1};
 }
 
+CostMapTileView HierarchicalCostMap::prepare_tiles(
+  const Eigen::Vector2f & min_position, const Eigen::Vector2f & max_position)
+{
+  if (!cloud_.has_value()) {
+    return {};
+  }
+
+  const Area min_area(min_position);
+  const Area max_area(max_position);
+  std::vector<std::pair<Area, const cv::Mat *>> tiles;
+  for (int x = min_area.x; x <= max_area.x; ++x) {
+    for (int y = min_area.y; y <= max_area.y; ++y) {
+      Area key;
+      key.x = x;
+      key.y = y;
+      if (cost_maps_.count(key) == 0) {
+        build_map(key);
+      }
+      map_accessed_[key] = true;
+      tiles.emplace_back(key, &cost_maps_.at(key));
+    }
+  }
+  return {std::move(tiles), max_range_, image_size_};
+}
+
+CostMapTileView::CostMapTileView(
+  std::vector<std::pair<Area, const cv::Mat *>> tiles, float max_range, float image_size)
+: tiles_(std::move(tiles)), max_range_(max_range), image_size_(image_size)
+{
+}
+
+CostMapValue CostMapTileView::at(const Eigen::Vector2f & position)
+{
+  const Area key(position);
+  if (!last_area_ || *last_area_ != key) {
+    const auto itr = std::find_if(
+      tiles_.begin(), tiles_.end(), [&key](const auto & tile) { return tile.first == key; });
+    last_area_ = key;
+    last_tile_ = (itr != tiles_.end()) ? itr->second : nullptr;
+  }
+  if (!last_tile_) {
+    return CostMapValue{0.5f, 0, true};
+  }
+
+  // same as HierarchicalCostMap::to_cv_point()
+  const Eigen::Vector2f relative = position - key.real_scale();
+  const auto px = static_cast<int>(relative.x() / max_range_ * image_size_);
+  const auto py = static_cast<int>(relative.y() / max_range_ * image_size_);
+  const cv::Vec3b b3 = last_tile_->ptr<cv::Vec3b>(py)[px];
+  return {static_cast<float>(b3[0]) / 255.f, b3[1], b3[2] == 1};
+}
+
 void HierarchicalCostMap::set_height(float height)
 {
   if (height_) {
@@ -0,0 +1,50 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/camera_corrector/camera_particle_corrector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace mpf = yabloc::modularized_particle_filter;
+
+TEST(AbsCosTestSuite, tableMatchesTrigonometricComputation)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+  for (int deg = 0; deg <= 180; ++deg) {
+    for (int i = 0; i < 20; ++i) {
+      const Eigen::Vector2f tangent(distribution(engine), distribution(engine));
+      const Eigen::Vector3f tangent3(tangent.x(), tangent.y(), 0.f);
+      EXPECT_NEAR(
+        mpf::abs_cos_from_table(tangent, deg), mpf::abs_cos(tangent3, static_cast<float>(deg)),
+        1e-5f)
+        << "deg " << deg;
+    }
+  }
+}
+
+TEST(AbsCosTestSuite, outOfRangeAngleIsWrapped)
+{
+  const Eigen::Vector2f tangent(0.3f, -0.8f);
+  for (const int deg : {-181, -90, -1, 181, 270, 359, 360, 725}) {
+    const Eigen::Vector3f tangent3(tangent.x(), tangent.y(), 0.f);
+    EXPECT_NEAR(
+      mpf::abs_cos_from_table(tangent, deg), mpf::abs_cos(tangent3, static_cast<float>(deg)),
+      1e-5f)
+      << "deg " << deg;
+  }
+  EXPECT_FLOAT_EQ(mpf::abs_cos_from_table(Eigen::Vector2f::Zero(), 45), 0.f);
+}
@@ -0,0 +1,74 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/camera_corrector/line_segment_samples.hpp"
+
+#include <gtest/gtest.h>
+
+namespace mpf = yabloc::modularized_particle_filter;
+
+namespace
+{
+pcl::PointXYZLNormal make_segment(
+  const Eigen::Vector3f & from, const Eigen::Vector3f & to, const uint32_t label)
+{
+  pcl::PointXYZLNormal pn;
+  pn.getVector3fMap() = from;
+  pn.getNormalVector3fMap() = to;
+  pn.label = label;
+  return pn;
+}
+}  // namespace
+
+TEST(LineSegmentSamplesTestSuite, sampleAlongSegments)
+{
+  mpf::LineSegmentSamples::LineSegments segments;
+  segments.push_back(make_segment({0, 0, 0}, {1, 0, 0}, 1));
+  segments.push_back(make_segment({0, 2, 0}, {0, 2.5, 0}, 0));
+
+  const auto samples = mpf::LineSegmentSamples::build(segments, 0.1f, 0.2f);
+
+  // a sample is taken at every interval from the start point until the end point
+  int expected_count = 0;
+  for (const auto & pn : segments) {
+    const float length = (pn.getVector3fMap() - pn.getNormalVector3fMap()).norm();
+    for (float distance = 0; distance < length; distance += 0.1f) ++expected_count;
+  }
+  ASSERT_EQ(samples.size(), expected_count);
+
+  EXPECT_FLOAT_EQ(samples.weights(0), 1.f);
+  EXPECT_FLOAT_EQ(samples.weights(samples.size() - 1), 0.2f);
+  EXPECT_TRUE(samples.tangents.col(0).isApprox(Eigen::Vector3f::UnitX()));
+  EXPECT_TRUE(samples.tangents.col(samples.size() - 1).isApprox(Eigen::Vector3f::UnitY()));
+  EXPECT_NEAR(samples.max_radius, 2.5f, 0.1f);
+}
+
+TEST(LineSegmentSamplesTestSuite, transformedSamplesLieOnTransformedSegment)
+{
+  mpf::LineSegmentSamples::LineSegments segments;
+  segments.push_back(make_segment({1, 1, 0}, {3, 2, 0}, 1));
+  const auto samples = mpf::LineSegmentSamples::build(segments, 0.1f, 0.2f);
+
+  const Eigen::Matrix3f rotation =
+    Eigen::AngleAxisf(0.7f, Eigen::Vector3f::UnitZ()).toRotationMatrix();
+  const Eigen::Vector3f translation(10, -5, 1);
+  const Eigen::Vector3f from = rotation * Eigen::Vector3f(1, 1, 0) + translation;
+  const Eigen::Vector3f tangent = rotation * Eigen::Vector3f(2, 1, 0).normalized();
+
+  const Eigen::Matrix3Xf transformed = (rotation * samples.positions).colwise() + translation;
+  for (Eigen::Index i = 0; i < samples.size(); ++i) {
+    const Eigen::Vector3f expected = from + tangent * (0.1f * static_cast<float>(i));
+    EXPECT_TRUE(transformed.col(i).isApprox(expected, 1e-4f));
+  }
+}
@@ -0,0 +1,102 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_LOADER__LANELET2_SHARED_MAP_HPP_
+#define MAP_LOADER__LANELET2_SHARED_MAP_HPP_
+
+#include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace map_loader
+{
+
+/**
+ * @brief read-only lanelet map and routing graphs shared by every node in a process
+ * @details all members are built once from a LaneletMapBin message and must not be modified.
+ * The map is used from several nodes without a lock, so only the const interface may be used, and
+ * neither setCenterline() nor resetCache() may be called on its lanelets. lanelet2 fills the
+ * centerline cache of a lanelet lazily behind const, so it is filled for every lanelet in build().
+ */
+struct SharedLaneletMap
+{
+  lanelet::LaneletMapConstPtr map;
+  std::shared_ptr<const lanelet::traffic_rules::TrafficRules> traffic_rules;
+  std::shared_ptr<const lanelet::traffic_rules::TrafficRules> pedestrian_rules;
+  lanelet::routing::RoutingGraphConstPtr vehicle_graph;
+  lanelet::routing::RoutingGraphConstPtr pedestrian_graph;
+  std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs;
+};
+
+using SharedLaneletMapConstPtr = std::shared_ptr<const SharedLaneletMap>;
+
+/**
+ * @brief intra-process registry which deserializes each LaneletMapBin message only once
+ * @details nodes loaded into the same component container receive identical map messages. The
+ * first node to call acquire() deserializes the map and builds the routing graphs, and the others
+ * attach to the same object. The registry only holds weak references, so the map is released when
+ * the last consumer drops it.
+ */
+class SharedLaneletMapRegistry
+{
+public:
+  /**
+   * @brief get the shared map built from the message, deserializing it if it is not cached yet
+   * @param [in] msg lanelet map message
+   * @return shared read-only map
+   */
+  static SharedLaneletMapConstPtr acquire(const autoware_map_msgs::msg::LaneletMapBin & msg);
+
+  /**
+   * @brief number of maps which are currently alive in this process
+   */
+  static size_t size();
+
+  /**
+   * @brief build a shared map from the message without registering it
+   * @details the lazily filled caches of the map are filled here, before the map is shared
+   */
+  static SharedLaneletMapConstPtr build(const autoware_map_msgs::msg::LaneletMapBin & msg);
+
+private:
+  struct Key
+  {
+    int32_t stamp_sec{0};
+    uint32_t stamp_nanosec{0};
+    std::string version_map{};
+    size_t data_size{0};
+    size_t data_hash{0};
+
+    bool operator<(const Key & other) const;
+  };
+
+  static Key make_key(const autoware_map_msgs::msg::LaneletMapBin & msg);
+
+  static std::mutex & mutex();
+  static std::map<Key, std::weak_ptr<const SharedLaneletMap>> & entries();
+};
+
+}  // namespace map_loader
+
+#endif  // MAP_LOADER__LANELET2_SHARED_MAP_HPP_
@@ -0,0 +1,138 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/lanelet2_shared_map.hpp"
+
+#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace map_loader
+{
+
+bool SharedLaneletMapRegistry::Key::operator<(const Key & other) const
+{
+  return std::tie(stamp_sec, stamp_nanosec, version_map, data_size, data_hash) <
+         std::tie(
+           other.stamp_sec, other.stamp_nanosec, other.version_map, other.data_size,
+           other.data_hash);
+}
+
+SharedLaneletMapRegistry::Key SharedLaneletMapRegistry::make_key(
+  const autoware_map_msgs::msg::LaneletMapBin & msg)
+{
+  Key key;
+  key.stamp_sec = msg.header.stamp.sec;
+  key.stamp_nanosec = msg.header.stamp.nanosec;
+  key.version_map = msg.version_map;
+  key.data_size = msg.data.size();
+  // hashing the serialized data is much cheaper than deserializing it
+  key.data_hash = std::hash<std::string_view>{}(
+    std::string_view(reinterpret_cast<const char *>(msg.data.data()), msg.data.size()));
+  return key;
+}
+
+std::mutex & SharedLaneletMapRegistry::mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<SharedLaneletMapRegistry::Key, std::weak_ptr<const SharedLaneletMap>> &
+SharedLaneletMapRegistry::entries()
+{
+  static std::map<Key, std::weak_ptr<const SharedLaneletMap>> entries;
+  return entries;
+}
+
+SharedLaneletMapConstPtr SharedLaneletMapRegistry::build(
+  const autoware_map_msgs::msg::LaneletMapBin & msg)
+{
+  auto map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(msg, map);
+
+  // ConstLanelet::centerline() computes and stores the centerline on the first call without a
+  // lock, so it is computed here while the map is still owned by a single thread
+  for (const auto & lanelet : map->laneletLayer) {
+    static_cast<void>(lanelet.centerline());
+  }
+
+  auto shared_map = std::make_shared<SharedLaneletMap>();
+  std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules =
+    lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  std::shared_ptr<lanelet::traffic_rules::TrafficRules> pedestrian_rules =
+    lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+  const lanelet::routing::RoutingGraphConstPtr vehicle_graph =
+    lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  const lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
+    lanelet::routing::RoutingGraph::build(*map, *pedestrian_rules);
+
+  shared_map->map = map;
+  shared_map->traffic_rules = traffic_rules;
+  shared_map->pedestrian_rules = pedestrian_rules;
+  shared_map->vehicle_graph = vehicle_graph;
+  shared_map->pedestrian_graph = pedestrian_graph;
+  shared_map->overall_graphs = std::make_shared<const lanelet::routing::RoutingGraphContainer>(
+    lanelet::routing::RoutingGraphContainer({vehicle_graph, pedestrian_graph}));
+  return shared_map;
+}
+
+SharedLaneletMapConstPtr SharedLaneletMapRegistry::acquire(
+  const autoware_map_msgs::msg::LaneletMapBin & msg)
+{
+  const auto key = make_key(msg);
+
+  // the lock is held while building so that nodes receiving the map at the same time wait for the
+  // first one instead of deserializing it in parallel
+  std::lock_guard<std::mutex> lock(mutex());
+  auto & cache = entries();
+
+  // drop entries whose map is no longer used by any node
+  for (auto itr = cache.begin(); itr != cache.end();) {
+    itr = itr->second.expired() ? cache.erase(itr) : std::next(itr);
+  }
+
+  if (const auto itr = cache.find(key); itr != cache.end()) {
+    if (auto shared_map = itr->second.lock()) {
+      return shared_map;
+    }
+  }
+
+  auto shared_map = build(msg);
+  cache[key] = shared_map;
+  return shared_map;
+}
+
+size_t SharedLaneletMapRegistry::size()
+{
+  std::lock_guard<std::mutex> lock(mutex());
+  size_t num_alive = 0;
+  for (const auto & entry : entries()) {
+    if (!entry.second.expired()) {
+      ++num_alive;
+    }
+  }
+  return num_alive;
+}
+
+}  // namespace map_loader
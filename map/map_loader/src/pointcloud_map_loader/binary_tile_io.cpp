@@ -0,0 +1,139 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "binary_tile_io.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+constexpr char magic[8] = {'A', 'W', 'T', 'I', 'L', 'E', '0', '1'};
+constexpr size_t max_field_name_length = 32;
+
+struct BinaryTileHeader
+{
+  char magic[8];
+  uint32_t height;
+  uint32_t width;
+  uint32_t point_step;
+  uint32_t row_step;
+  uint32_t num_fields;
+  uint8_t is_bigendian;
+  uint8_t is_dense;
+  uint8_t reserved[2];
+  uint64_t data_size;
+};
+
+struct BinaryTileField
+{
+  char name[max_field_name_length];
+  uint32_t offset;
+  uint32_t count;
+  uint8_t datatype;
+  uint8_t reserved[7];
+};
+}  // namespace
+
+bool save_binary_tile(const std::string & path, const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      return false;
+    }
+
+    BinaryTileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.height = cloud.height;
+    header.width = cloud.width;
+    header.point_step = cloud.point_step;
+    header.row_step = cloud.row_step;
+    header.num_fields = static_cast<uint32_t>(cloud.fields.size());
+    header.is_bigendian = cloud.is_bigendian;
+    header.is_dense = cloud.is_dense;
+    header.data_size = cloud.data.size();
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (const auto & field : cloud.fields) {
+      if (field.name.size() >= max_field_name_length) {
+        return false;
+      }
+      BinaryTileField tile_field{};
+      std::memcpy(tile_field.name, field.name.data(), field.name.size());
+      tile_field.offset = field.offset;
+      tile_field.count = field.count;
+      tile_field.datatype = field.datatype;
+      ofs.write(reinterpret_cast<const char *>(&tile_field), sizeof(tile_field));
+    }
+
+    ofs.write(
+      reinterpret_cast<const char *>(cloud.data.data()),
+      static_cast<std::streamsize>(cloud.data.size()));
+    if (!ofs) {
+      return false;
+    }
+  }
+  return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool load_binary_tile(const std::string & path, sensor_msgs::msg::PointCloud2 & cloud)
+{
+  std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    return false;
+  }
+  const auto file_size = static_cast<uint64_t>(ifs.tellg());
+  ifs.seekg(0);
+
+  BinaryTileHeader header{};
+  if (
+    file_size < sizeof(header) || !ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+    return false;
+  }
+
+  const uint64_t fields_size = uint64_t{header.num_fields} * sizeof(BinaryTileField);
+  if (file_size != sizeof(header) + fields_size + header.data_size) {
+    return false;
+  }
+
+  cloud.height = header.height;
+  cloud.width = header.width;
+  cloud.point_step = header.point_step;
+  cloud.row_step = header.row_step;
+  cloud.is_bigendian = header.is_bigendian;
+  cloud.is_dense = header.is_dense;
+
+  cloud.fields.resize(header.num_fields);
+  for (auto & field : cloud.fields) {
+    BinaryTileField tile_field{};
+    if (!ifs.read(reinterpret_cast<char *>(&tile_field), sizeof(tile_field))) {
+      return false;
+    }
+    field.name = std::string(tile_field.name, strnlen(tile_field.name, max_field_name_length));
+    field.offset = tile_field.offset;
+    field.count = tile_field.count;
+    field.datatype = tile_field.datatype;
+  }
+
+  // read straight into the message, the data being copied once from the page cache
+  cloud.data.resize(header.data_size);
+  return static_cast<bool>(ifs.read(
+    reinterpret_cast<char *>(cloud.data.data()), static_cast<std::streamsize>(header.data_size)));
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__BINARY_TILE_IO_HPP_
+#define POINTCLOUD_MAP_LOADER__BINARY_TILE_IO_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <string>
+
+// Binary tile layout (native endian):
+//   BinaryTileHeader | BinaryTileField * num_fields | point data (data_size bytes)
+// The point data is the PointCloud2 data as is, so a tile is served by reading a single
+// contiguous block into the message without any PCD parsing.
+
+/**
+ * @brief save the pointcloud as a binary tile
+ * @details the file is written to a temporary path and renamed so that readers never see a
+ * partially written tile
+ */
+bool save_binary_tile(const std::string & path, const sensor_msgs::msg::PointCloud2 & cloud);
+
+/**
+ * @brief load a binary tile written by save_binary_tile
+ * @return false if the file does not exist or is not a valid binary tile
+ */
+bool load_binary_tile(const std::string & path, sensor_msgs::msg::PointCloud2 & cloud);
+
+#endif  // POINTCLOUD_MAP_LOADER__BINARY_TILE_IO_HPP_
@@ -14,12 +14,24 @@
 
 #include "differential_map_loader_module.hpp"
 
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 DifferentialMapLoaderModule::DifferentialMapLoaderModule(
-  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
+  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict,
+  std::shared_ptr<PointCloudMapCellCache> cell_cache, const double prefetch_time_horizon)
+: logger_(node->get_logger()),
+  all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict)),
+  cell_cache_(std::move(cell_cache)),
+  prefetch_time_horizon_(prefetch_time_horizon)
 {
+  if (!cell_cache_) {
+    // a cache without memory budget loads every cell synchronously
+    cell_cache_ = std::make_shared<PointCloudMapCellCache>(logger_, 0, "");
+  }
+
   get_differential_pcd_maps_service_ = node->create_service<GetDifferentialPointCloudMap>(
     "service/get_differential_pcd_map",
     std::bind(
@@ -73,19 +85,57 @@ bool DifferentialMapLoaderModule::on_service_get_differential_point_cloud_map(
   std::vector<std::string> cached_ids = req->cached_ids;
   differential_area_load(area, cached_ids, res);
   res->header.frame_id = "map";
+  prefetch_predicted_area(area);
   return true;
 }
 
+void DifferentialMapLoaderModule::prefetch_predicted_area(
+  const autoware_map_msgs::msg::AreaInfo & area_info) const
+{
+  if (!cell_cache_->is_enabled() || prefetch_time_horizon_ <= 0.0) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto last_request = last_request_;
+  last_request_ = std::make_pair(area_info, now);
+  if (!last_request) {
+    return;
+  }
+
+  // the requester's velocity is estimated from the centers of the consecutive requests
+  const double dt = std::chrono::duration<double>(now - last_request->second).count();
+  if (dt <= 0.0) {
+    return;
+  }
+  const double vx = (area_info.center_x - last_request->first.center_x) / dt;
+  const double vy = (area_info.center_y - last_request->first.center_y) / dt;
+
+  // cells on the way to the predicted position are queued in the order they will be requested
+  constexpr int num_prediction_steps = 2;
+  std::vector<std::string> paths_to_prefetch;
+  for (int step = 1; step <= num_prediction_steps; ++step) {
+    const double t = prefetch_time_horizon_ * step / num_prediction_steps;
+    autoware_map_msgs::msg::AreaInfo predicted_area = area_info;
+    predicted_area.center_x += static_cast<float>(vx * t);
+    predicted_area.center_y += static_cast<float>(vy * t);
+    for (const auto & [path, metadata] : all_pcd_file_metadata_dict_) {
+      if (
+        is_grid_within_queried_area(predicted_area, metadata) &&
+        !is_grid_within_queried_area(area_info, metadata)) {
+        paths_to_prefetch.push_back(path);
+      }
+    }
+  }
+  cell_cache_->prefetch(paths_to_prefetch);
+}
+
 autoware_map_msgs::msg::PointCloudMapCellWithID
 DifferentialMapLoaderModule::load_point_cloud_map_cell_with_id(
   const std::string & path, const std::string & map_id) const
 {
-  sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
-    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-  }
   autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
-  pointcloud_map_cell_with_id.pointcloud = pcd;
+  pointcloud_map_cell_with_id.pointcloud = *cell_cache_->get(path);
   pointcloud_map_cell_with_id.cell_id = map_id;
   return pointcloud_map_cell_with_id;
 }
@@ -14,12 +14,21 @@
 
 #include "partial_map_loader_module.hpp"
 
+#include <memory>
 #include <utility>
 
 PartialMapLoaderModule::PartialMapLoaderModule(
-  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
+  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict,
+  std::shared_ptr<PointCloudMapCellCache> cell_cache)
+: logger_(node->get_logger()),
+  all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict)),
+  cell_cache_(std::move(cell_cache))
 {
+  if (!cell_cache_) {
+    // a cache without memory budget loads every cell synchronously
+    cell_cache_ = std::make_shared<PointCloudMapCellCache>(logger_, 0, "");
+  }
+
   get_partial_pcd_maps_service_ = node->create_service<GetPartialPointCloudMap>(
     "service/get_partial_pcd_map",
     std::bind(
@@ -67,12 +76,8 @@ autoware_map_msgs::msg::PointCloudMapCellWithID
 PartialMapLoaderModule::load_point_cloud_map_cell_with_id(
   const std::string & path, const std::string & map_id) const
 {
-  sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
-    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-  }
   autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
-  pointcloud_map_cell_with_id.pointcloud = pcd;
+  pointcloud_map_cell_with_id.pointcloud = *cell_cache_->get(path);
   pointcloud_map_cell_with_id.cell_id = map_id;
   return pointcloud_map_cell_with_id;
 }
@@ -0,0 +1,222 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_map_cell_cache.hpp"
+
+#include "binary_tile_io.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+PointCloudMapCellCache::PointCloudMapCellCache(
+  const rclcpp::Logger & logger, const size_t memory_budget_bytes,
+  const std::string & binary_tile_directory)
+: logger_(logger),
+  memory_budget_bytes_(memory_budget_bytes),
+  binary_tile_directory_(binary_tile_directory)
+{
+  if (!binary_tile_directory_.empty()) {
+    std::error_code ec;
+    fs::create_directories(binary_tile_directory_, ec);
+    if (ec) {
+      RCLCPP_WARN_STREAM(
+        logger_, "Failed to create binary tile directory " << binary_tile_directory_ << ": "
+                                                           << ec.message());
+    }
+  }
+
+  if (is_enabled()) {
+    prefetch_thread_ = std::thread(&PointCloudMapCellCache::run_prefetch, this);
+  }
+}
+
+PointCloudMapCellCache::~PointCloudMapCellCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  request_cv_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+}
+
+PointCloudMapCellCache::PointCloud2ConstSharedPtr PointCloudMapCellCache::get(
+  const std::string & path)
+{
+  if (!is_enabled()) {
+    const auto cloud = load(path);
+    return cloud ? cloud : std::make_shared<const sensor_msgs::msg::PointCloud2>();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // wait for the prefetch thread instead of loading the same file twice
+    loaded_cv_.wait(lock, [&]() { return loading_paths_.count(path) == 0; });
+
+    const auto itr = entries_.find(path);
+    if (itr != entries_.end()) {
+      lru_list_.splice(lru_list_.begin(), lru_list_, itr->second.lru_itr);
+      return itr->second.cloud;
+    }
+    loading_paths_.insert(path);
+  }
+
+  PointCloud2ConstSharedPtr cloud;
+  try {
+    cloud = load(path);
+  } catch (...) {
+    finish_loading(path, nullptr);
+    throw;
+  }
+  finish_loading(path, cloud);
+  // a cell failing to load is served empty, as when loading the PCD file directly, but not cached
+  return cloud ? cloud : std::make_shared<const sensor_msgs::msg::PointCloud2>();
+}
+
+void PointCloudMapCellCache::prefetch(const std::vector<std::string> & paths)
+{
+  if (!is_enabled()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto & path : paths) {
+      if (entries_.count(path) == 0 && loading_paths_.count(path) == 0) {
+        prefetch_queue_.push_back(path);
+      }
+    }
+  }
+  request_cv_.notify_one();
+}
+
+bool PointCloudMapCellCache::contains(const std::string & path) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.count(path) > 0;
+}
+
+size_t PointCloudMapCellCache::memory_usage() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return memory_usage_;
+}
+
+void PointCloudMapCellCache::run_prefetch()
+{
+  while (true) {
+    std::string path;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      request_cv_.wait(lock, [this]() { return is_stopped_ || !prefetch_queue_.empty(); });
+      if (is_stopped_) {
+        return;
+      }
+      path = std::move(prefetch_queue_.front());
+      prefetch_queue_.pop_front();
+      // the cell may have been loaded since the request was queued
+      if (entries_.count(path) > 0 || loading_paths_.count(path) > 0) {
+        continue;
+      }
+      loading_paths_.insert(path);
+    }
+
+    // the thread keeps running when a cell fails to load, get() loading it again on request
+    PointCloud2ConstSharedPtr cloud;
+    try {
+      cloud = load(path);
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR_STREAM(logger_, "Failed to prefetch " << path << ": " << e.what());
+    }
+    finish_loading(path, cloud);
+  }
+}
+
+void PointCloudMapCellCache::finish_loading(
+  const std::string & path, const PointCloud2ConstSharedPtr & cloud)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loading_paths_.erase(path);
+
+    const size_t cloud_size = cloud ? cloud->data.size() : 0;
+    if (cloud && cloud_size <= memory_budget_bytes_ && entries_.count(path) == 0) {
+      lru_list_.push_front(path);
+      entries_.emplace(path, Entry{cloud, lru_list_.begin()});
+      memory_usage_ += cloud_size;
+
+      // evict the least recently used cells, which are still alive in responses holding them
+      while (memory_usage_ > memory_budget_bytes_) {
+        const auto itr = entries_.find(lru_list_.back());
+        memory_usage_ -= itr->second.cloud->data.size();
+        entries_.erase(itr);
+        lru_list_.pop_back();
+      }
+    }
+  }
+  loaded_cv_.notify_all();
+}
+
+PointCloudMapCellCache::PointCloud2ConstSharedPtr PointCloudMapCellCache::load(
+  const std::string & path) const
+{
+  auto cloud = std::make_shared<sensor_msgs::msg::PointCloud2>();
+
+  const auto binary_tile_path = get_binary_tile_path(path);
+  if (!binary_tile_path.empty()) {
+    std::error_code ec;
+    const bool is_tile_up_to_date =
+      fs::exists(binary_tile_path, ec) &&
+      fs::last_write_time(binary_tile_path, ec) >= fs::last_write_time(path, ec) && !ec;
+    if (is_tile_up_to_date && load_binary_tile(binary_tile_path, *cloud)) {
+      return cloud;
+    }
+  }
+
+  if (pcl::io::loadPCDFile(path, *cloud) == -1) {
+    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
+    return nullptr;
+  }
+
+  if (!binary_tile_path.empty() && !save_binary_tile(binary_tile_path, *cloud)) {
+    RCLCPP_WARN_STREAM(logger_, "Failed to save binary tile: " << binary_tile_path);
+  }
+  return cloud;
+}
+
+std::string PointCloudMapCellCache::get_binary_tile_path(const std::string & path) const
+{
+  if (binary_tile_directory_.empty()) {
+    return "";
+  }
+  // cells in different directories may share a file name, so the whole path is encoded
+  std::string name = fs::path(path).lexically_normal().string();
+  for (auto & c : name) {
+    if (c == '/' || c == '\\') {
+      c = '_';
+    }
+  }
+  return (fs::path(binary_tile_directory_) / (name + ".bin")).string();
+}
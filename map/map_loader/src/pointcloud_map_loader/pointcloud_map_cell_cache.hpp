@@ -0,0 +1,105 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_CELL_CACHE_HPP_
+#define POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_CELL_CACHE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief LRU cache of pointcloud map cells with a background prefetch thread
+ * @details cells are kept until the total size of their data exceeds the memory budget. When the
+ * budget is zero nothing is cached and every get() loads the cell synchronously, which is the
+ * same behavior as loading the PCD file directly.
+ */
+class PointCloudMapCellCache
+{
+public:
+  using PointCloud2ConstSharedPtr = std::shared_ptr<const sensor_msgs::msg::PointCloud2>;
+
+  PointCloudMapCellCache(
+    const rclcpp::Logger & logger, const size_t memory_budget_bytes,
+    const std::string & binary_tile_directory);
+  ~PointCloudMapCellCache();
+
+  PointCloudMapCellCache(const PointCloudMapCellCache &) = delete;
+  PointCloudMapCellCache & operator=(const PointCloudMapCellCache &) = delete;
+
+  /**
+   * @brief get the cell, loading it in the calling thread if it is neither cached nor being
+   * prefetched
+   * @details a cell whose file fails to load is returned empty and is not cached
+   */
+  PointCloud2ConstSharedPtr get(const std::string & path);
+
+  /**
+   * @brief request the background thread to load the cells which are not cached yet
+   */
+  void prefetch(const std::vector<std::string> & paths);
+
+  [[nodiscard]] bool is_enabled() const { return memory_budget_bytes_ > 0; }
+  [[nodiscard]] bool contains(const std::string & path) const;
+  [[nodiscard]] size_t memory_usage() const;
+
+private:
+  struct Entry
+  {
+    PointCloud2ConstSharedPtr cloud;
+    std::list<std::string>::iterator lru_itr;
+  };
+
+  rclcpp::Logger logger_;
+  const size_t memory_budget_bytes_;
+  const std::string binary_tile_directory_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable loaded_cv_;
+  std::condition_variable request_cv_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_list_;  // front is the most recently used
+  std::unordered_set<std::string> loading_paths_;
+  std::deque<std::string> prefetch_queue_;
+  size_t memory_usage_{0};
+  bool is_stopped_{false};
+  std::thread prefetch_thread_;
+
+  /**
+   * @brief load the cell from its binary tile or its PCD file
+   * @return nullptr if the PCD file fails to load
+   */
+  PointCloud2ConstSharedPtr load(const std::string & path) const;
+  /**
+   * @brief remove the path from the loading paths, waking up the waiting get(), and cache the
+   * cloud unless it is nullptr. Must be called once for each path added to the loading paths.
+   */
+  void finish_loading(const std::string & path, const PointCloud2ConstSharedPtr & cloud);
+  void run_prefetch();
+  std::string get_binary_tile_path(const std::string & path) const;
+};
+
+#endif  // POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_CELL_CACHE_HPP_
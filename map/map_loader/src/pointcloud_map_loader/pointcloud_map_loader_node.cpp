@@ -19,6 +19,7 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -50,6 +51,9 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
   bool enable_downsample_whole_load = declare_parameter<bool>("enable_downsampled_whole_load");
   bool enable_partial_load = declare_parameter<bool>("enable_partial_load");
   bool enable_selected_load = declare_parameter<bool>("enable_selected_load");
+  const auto tile_cache_memory_budget_mb = declare_parameter<double>("tile_cache_memory_budget_mb");
+  const auto tile_prefetch_time_horizon = declare_parameter<double>("tile_prefetch_time_horizon");
+  const auto binary_tile_directory = declare_parameter<std::string>("binary_tile_directory");
 
   if (enable_whole_load) {
     std::string publisher_name = "output/pointcloud_map";
@@ -66,11 +70,18 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
   // Parse the metadata file and get the map of (absolute pcd path, pcd file metadata)
   auto pcd_metadata_dict = get_pcd_metadata(pcd_metadata_path, pcd_paths);
 
+  // the partial and differential loaders share loaded cells
+  cell_cache_ = std::make_shared<PointCloudMapCellCache>(
+    get_logger(), static_cast<size_t>(std::max(tile_cache_memory_budget_mb, 0.0) * 1024 * 1024),
+    binary_tile_directory);
+
   if (enable_partial_load) {
-    partial_map_loader_ = std::make_unique<PartialMapLoaderModule>(this, pcd_metadata_dict);
+    partial_map_loader_ =
+      std::make_unique<PartialMapLoaderModule>(this, pcd_metadata_dict, cell_cache_);
   }
 
-  differential_map_loader_ = std::make_unique<DifferentialMapLoaderModule>(this, pcd_metadata_dict);
+  differential_map_loader_ = std::make_unique<DifferentialMapLoaderModule>(
+    this, pcd_metadata_dict, cell_cache_, tile_prefetch_time_horizon);
 
   if (enable_selected_load) {
     selected_map_loader_ = std::make_unique<SelectedMapLoaderModule>(this, pcd_metadata_dict);
@@ -17,6 +17,7 @@
 
 #include "differential_map_loader_module.hpp"
 #include "partial_map_loader_module.hpp"
+#include "pointcloud_map_cell_cache.hpp"
 #include "pointcloud_map_loader_module.hpp"
 #include "selected_map_loader_module.hpp"
 
@@ -39,6 +40,7 @@ public:
   explicit PointCloudMapLoaderNode(const rclcpp::NodeOptions & options);
 
 private:
+  std::shared_ptr<PointCloudMapCellCache> cell_cache_;
   std::unique_ptr<PointcloudMapLoaderModule> pcd_map_loader_;
   std::unique_ptr<PointcloudMapLoaderModule> downsampled_pcd_map_loader_;
   std::unique_ptr<PartialMapLoaderModule> partial_map_loader_;
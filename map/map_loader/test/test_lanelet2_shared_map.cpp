@@ -0,0 +1,83 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/lanelet2_shared_map.hpp"
+
+#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+
+#include <gmock/gmock.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <memory>
+
+using autoware_map_msgs::msg::LaneletMapBin;
+using map_loader::SharedLaneletMapRegistry;
+
+namespace
+{
+LaneletMapBin create_map_bin_msg(const int32_t stamp_sec)
+{
+  const lanelet::Point3d p1(lanelet::utils::getId(), 0.0, 0.0, 0.0);
+  const lanelet::Point3d p2(lanelet::utils::getId(), 10.0, 0.0, 0.0);
+  const lanelet::Point3d p3(lanelet::utils::getId(), 0.0, 3.0, 0.0);
+  const lanelet::Point3d p4(lanelet::utils::getId(), 10.0, 3.0, 0.0);
+  const lanelet::LineString3d right(lanelet::utils::getId(), {p1, p2});
+  const lanelet::LineString3d left(lanelet::utils::getId(), {p3, p4});
+  lanelet::Lanelet lanelet(lanelet::utils::getId(), left, right);
+  lanelet.setAttribute(lanelet::AttributeName::Subtype, lanelet::AttributeValueString::Road);
+
+  const auto map = lanelet::utils::createMap({lanelet});
+  LaneletMapBin msg;
+  msg.header.stamp.sec = stamp_sec;
+  msg.version_map = "test";
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  return msg;
+}
+}  // namespace
+
+TEST(SharedLaneletMapRegistryTest, SameMessageIsDeserializedOnce)
+{
+  const auto msg = create_map_bin_msg(1);
+
+  const auto map_a = SharedLaneletMapRegistry::acquire(msg);
+  const auto map_b = SharedLaneletMapRegistry::acquire(msg);
+
+  ASSERT_NE(map_a, nullptr);
+  EXPECT_EQ(map_a, map_b);
+  EXPECT_EQ(map_a->map->laneletLayer.size(), 1u);
+  EXPECT_NE(map_a->vehicle_graph, nullptr);
+  EXPECT_NE(map_a->pedestrian_graph, nullptr);
+  EXPECT_NE(map_a->overall_graphs, nullptr);
+  EXPECT_EQ(SharedLaneletMapRegistry::size(), 1u);
+}
+
+TEST(SharedLaneletMapRegistryTest, DifferentMessageIsNotShared)
+{
+  const auto map_a = SharedLaneletMapRegistry::acquire(create_map_bin_msg(1));
+  const auto map_b = SharedLaneletMapRegistry::acquire(create_map_bin_msg(2));
+
+  EXPECT_NE(map_a, map_b);
+  EXPECT_EQ(SharedLaneletMapRegistry::size(), 2u);
+}
+
+TEST(SharedLaneletMapRegistryTest, MapIsReleasedWithLastConsumer)
+{
+  const auto msg = create_map_bin_msg(3);
+  {
+    const auto map = SharedLaneletMapRegistry::acquire(msg);
+    EXPECT_EQ(SharedLaneletMapRegistry::size(), 1u);
+  }
+  EXPECT_EQ(SharedLaneletMapRegistry::size(), 0u);
+}
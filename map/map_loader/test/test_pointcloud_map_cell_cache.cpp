@@ -0,0 +1,151 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/binary_tile_io.hpp"
+#include "../src/pointcloud_map_loader/pointcloud_map_cell_cache.hpp"
+
+#include <gtest/gtest.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+std::string create_dummy_pcd(const std::string & name, const size_t num_points)
+{
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  cloud.width = num_points;
+  cloud.height = 1;
+  cloud.points.resize(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    cloud.points[i] = pcl::PointXYZ(i, 2.0 * i, 3.0 * i);
+  }
+  const auto path = (fs::temp_directory_path() / name).string();
+  pcl::io::savePCDFileASCII(path, cloud);
+  return path;
+}
+
+size_t cloud_size(const size_t num_points)
+{
+  // PointXYZ is stored as x, y, z in float32
+  return num_points * 3 * sizeof(float);
+}
+}  // namespace
+
+TEST(PointCloudMapCellCacheTest, DisabledCacheLoadsEveryTime)
+{
+  const auto path = create_dummy_pcd("cell_cache_disabled.pcd", 10);
+  PointCloudMapCellCache cache(rclcpp::get_logger("test"), 0, "");
+
+  const auto cloud = cache.get(path);
+  EXPECT_EQ(cloud->width, 10u);
+  EXPECT_FALSE(cache.contains(path));
+  EXPECT_EQ(cache.memory_usage(), 0u);
+}
+
+TEST(PointCloudMapCellCacheTest, EvictLeastRecentlyUsedCell)
+{
+  const auto path_a = create_dummy_pcd("cell_cache_a.pcd", 10);
+  const auto path_b = create_dummy_pcd("cell_cache_b.pcd", 10);
+  const auto path_c = create_dummy_pcd("cell_cache_c.pcd", 10);
+  PointCloudMapCellCache cache(rclcpp::get_logger("test"), 2 * cloud_size(10), "");
+
+  const auto cloud_a = cache.get(path_a);
+  cache.get(path_b);
+  EXPECT_EQ(cache.get(path_a), cloud_a);  // a is now the most recently used
+  cache.get(path_c);
+
+  EXPECT_TRUE(cache.contains(path_a));
+  EXPECT_FALSE(cache.contains(path_b));
+  EXPECT_TRUE(cache.contains(path_c));
+  EXPECT_EQ(cache.memory_usage(), 2 * cloud_size(10));
+}
+
+TEST(PointCloudMapCellCacheTest, PrefetchLoadsInBackground)
+{
+  const auto path = create_dummy_pcd("cell_cache_prefetch.pcd", 10);
+  PointCloudMapCellCache cache(rclcpp::get_logger("test"), cloud_size(100), "");
+
+  cache.prefetch({path});
+  for (int i = 0; i < 100 && !cache.contains(path); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(cache.contains(path));
+  EXPECT_EQ(cache.get(path)->width, 10u);
+}
+
+TEST(PointCloudMapCellCacheTest, BinaryTileRoundTrip)
+{
+  const auto path = create_dummy_pcd("cell_cache_binary.pcd", 10);
+  const auto tile_directory = (fs::temp_directory_path() / "cell_cache_binary_tiles").string();
+  fs::remove_all(tile_directory);
+
+  sensor_msgs::msg::PointCloud2 expected;
+  pcl::io::loadPCDFile(path, expected);
+
+  {
+    // the first load parses the PCD file and writes the binary tile
+    PointCloudMapCellCache cache(rclcpp::get_logger("test"), 0, tile_directory);
+    cache.get(path);
+  }
+  ASSERT_FALSE(fs::is_empty(tile_directory));
+
+  const auto tile_path = fs::directory_iterator(tile_directory)->path().string();
+  sensor_msgs::msg::PointCloud2 actual;
+  ASSERT_TRUE(load_binary_tile(tile_path, actual));
+  EXPECT_EQ(actual.width, expected.width);
+  EXPECT_EQ(actual.height, expected.height);
+  EXPECT_EQ(actual.point_step, expected.point_step);
+  ASSERT_EQ(actual.fields.size(), expected.fields.size());
+  for (size_t i = 0; i < actual.fields.size(); ++i) {
+    EXPECT_EQ(actual.fields[i].name, expected.fields[i].name);
+    EXPECT_EQ(actual.fields[i].offset, expected.fields[i].offset);
+  }
+  EXPECT_EQ(actual.data, expected.data);
+}
+
+TEST(PointCloudMapCellCacheTest, InvalidBinaryTileIsRejected)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  EXPECT_FALSE(load_binary_tile("/tmp/not_existing_tile.bin", cloud));
+
+  const auto path = create_dummy_pcd("cell_cache_not_a_tile.pcd", 1);
+  EXPECT_FALSE(load_binary_tile(path, cloud));
+}
+
+TEST(PointCloudMapCellCacheTest, FailedLoadIsNotCached)
+{
+  const auto path = (fs::temp_directory_path() / "cell_cache_not_existing.pcd").string();
+  fs::remove(path);
+  PointCloudMapCellCache cache(rclcpp::get_logger("test"), cloud_size(100), "");
+
+  const auto cloud = cache.get(path);
+  ASSERT_TRUE(cloud);
+  EXPECT_TRUE(cloud->data.empty());
+  EXPECT_FALSE(cache.contains(path));
+
+  // a failed prefetch does not block the next get(), which loads the file once it exists
+  cache.prefetch({path});
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(cache.contains(path));
+  create_dummy_pcd("cell_cache_not_existing.pcd", 10);
+  EXPECT_EQ(cache.get(path)->width, 10u);
+  EXPECT_TRUE(cache.contains(path));
+}
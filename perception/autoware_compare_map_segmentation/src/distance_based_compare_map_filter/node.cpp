@@ -21,11 +21,20 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <cmath>
+#include <memory>
 #include <vector>
 
 namespace autoware::compare_map_segmentation
 {
 
+std::shared_ptr<const MapOccupancyBitset> createMapOccupancy(
+  const PointCloud & map_points, const double squared_distance_threshold)
+{
+  const auto voxel_size = static_cast<float>(std::sqrt(squared_distance_threshold));
+  return std::make_shared<MapOccupancyBitset>(map_points, voxel_size, voxel_size);
+}
+
 void DistanceBasedStaticMapLoader::onMapCallback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr map)
 {
@@ -44,6 +53,8 @@ void DistanceBasedStaticMapLoader::onMapCallback(
     }
   }
   tree_->setInputCloud(map_ptr_);
+  // the filter component passes distance_threshold as the leaf size of this loader
+  map_occupancy_ = createMapOccupancy(*map_ptr_, voxel_leaf_size_);
 
   (*mutex_ptr_).unlock();
 }
@@ -58,6 +69,10 @@ bool DistanceBasedStaticMapLoader::is_close_to_map(
     return false;
   }
 
+  if (!may_be_close_to_map(map_occupancy_, point, distance_threshold)) {
+    return false;
+  }
+
   std::vector<int> nn_indices(1);
   std::vector<float> nn_distances(1);
   if (!isFinite(point)) {
@@ -93,6 +108,11 @@ bool DistanceBasedDynamicMapLoader::is_close_to_map(
     if (current_voxel_grid_array_.at(map_grid_index)->map_cell_kdtree == NULL) {
       return false;
     }
+    if (!may_be_close_to_map(
+          current_voxel_grid_array_.at(map_grid_index)->map_cell_occupancy, point,
+          distance_threshold)) {
+      return false;
+    }
     std::vector<int> nn_indices(1);
     std::vector<float> nn_distances(1);
     if (!current_voxel_grid_array_.at(map_grid_index)
@@ -145,18 +165,29 @@ void DistanceBasedCompareMapFilterComponent::filter(
   int offset_y = input->fields[pcl::getFieldIndex(*input, "y")].offset;
   int offset_z = input->fields[pcl::getFieldIndex(*input, "z")].offset;
 
-  output.data.resize(input->data.size());
-  output.point_step = point_step;
-  size_t output_size = 0;
-  for (size_t global_offset = 0; global_offset < input->data.size(); global_offset += point_step) {
+  // the points are classified in parallel, then the ones far from the map are copied in order
+  const int num_points = static_cast<int>(input->data.size() / point_step);
+  point_is_close_to_map_.resize(num_points);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < num_points; ++i) {
+    const size_t global_offset = static_cast<size_t>(i) * point_step;
     pcl::PointXYZ point{};
     std::memcpy(&point.x, &input->data[global_offset + offset_x], sizeof(float));
     std::memcpy(&point.y, &input->data[global_offset + offset_y], sizeof(float));
     std::memcpy(&point.z, &input->data[global_offset + offset_z], sizeof(float));
-    if (distance_based_map_loader_->is_close_to_map(point, distance_threshold_)) {
+    point_is_close_to_map_[i] =
+      distance_based_map_loader_->is_close_to_map(point, distance_threshold_);
+  }
+
+  output.data.resize(input->data.size());
+  output.point_step = point_step;
+  size_t output_size = 0;
+  for (int i = 0; i < num_points; ++i) {
+    if (point_is_close_to_map_[i]) {
       continue;
     }
-    std::memcpy(&output.data[output_size], &input->data[global_offset], point_step);
+    std::memcpy(
+      &output.data[output_size], &input->data[static_cast<size_t>(i) * point_step], point_step);
     output_size += point_step;
   }
   output.header = input->header;
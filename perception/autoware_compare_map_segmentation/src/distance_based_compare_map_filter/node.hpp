@@ -22,6 +22,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,6 +34,12 @@ typedef typename pcl::Filter<pcl::PointXYZ>::PointCloud PointCloud;
 typedef typename PointCloud::Ptr PointCloudPtr;
 typedef typename PointCloud::ConstPtr PointCloudConstPtr;
 
+/** \brief Occupancy of the map for the comparison of the squared distance to the nearest map point
+ * with squared_distance_threshold, whose voxels are sqrt(squared_distance_threshold) wide
+ */
+std::shared_ptr<const MapOccupancyBitset> createMapOccupancy(
+  const PointCloud & map_points, double squared_distance_threshold);
+
 class DistanceBasedStaticMapLoader : public VoxelGridStaticMapLoader
 {
 private:
@@ -92,6 +99,9 @@ public:
     }
     tree_tmp->setInputCloud(map_cell_voxel_input_tmp_ptr);
     current_voxel_grid_list_item.map_cell_kdtree = tree_tmp;
+    // the filter component passes distance_threshold as the leaf size of this loader
+    current_voxel_grid_list_item.map_cell_occupancy =
+      createMapOccupancy(*map_cell_voxel_input_tmp_ptr, voxel_leaf_size_);
 
     // add
     (*mutex_ptr_).lock();
@@ -109,6 +119,8 @@ protected:
 private:
   double distance_threshold_;
   std::unique_ptr<VoxelGridMapLoader> distance_based_map_loader_;
+  /** \brief Result of is_close_to_map for each input point, kept to reuse its memory */
+  std::vector<uint8_t> point_is_close_to_map_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -36,6 +36,8 @@ public:
     std::string * tf_map_input_frame, std::mutex * mutex)
   : VoxelGridStaticMapLoader(node, leaf_size, downsize_ratio_z_axis, tf_map_input_frame, mutex)
   {
+    // only the voxel of the point is looked up
+    use_map_occupancy_ = false;
     RCLCPP_INFO(logger_, "VoxelBasedApproximateStaticMapLoader initialized.\n");
   }
   bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
@@ -51,6 +53,8 @@ public:
   : VoxelGridDynamicMapLoader(
       node, leaf_size, downsize_ratio_z_axis, tf_map_input_frame, mutex, main_callback_group)
   {
+    // only the voxel of the point is looked up
+    use_map_occupancy_ = false;
     RCLCPP_INFO(logger_, "VoxelBasedApproximateDynamicMapLoader initialized.\n");
   }
   bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
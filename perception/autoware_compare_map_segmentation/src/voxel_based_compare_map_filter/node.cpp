@@ -75,18 +75,28 @@ void VoxelBasedCompareMapFilterComponent::filter(
   int offset_y = input->fields[pcl::getFieldIndex(*input, "y")].offset;
   int offset_z = input->fields[pcl::getFieldIndex(*input, "z")].offset;
 
-  output.data.resize(input->data.size());
-  output.point_step = point_step;
-  size_t output_size = 0;
-  for (size_t global_offset = 0; global_offset < input->data.size(); global_offset += point_step) {
+  // the points are classified in parallel, then the ones far from the map are copied in order
+  const int num_points = static_cast<int>(input->data.size() / point_step);
+  point_is_close_to_map_.resize(num_points);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int i = 0; i < num_points; ++i) {
+    const size_t global_offset = static_cast<size_t>(i) * point_step;
     pcl::PointXYZ point{};
     std::memcpy(&point.x, &input->data[global_offset + offset_x], sizeof(float));
     std::memcpy(&point.y, &input->data[global_offset + offset_y], sizeof(float));
     std::memcpy(&point.z, &input->data[global_offset + offset_z], sizeof(float));
-    if (voxel_grid_map_loader_->is_close_to_map(point, distance_threshold_)) {
+    point_is_close_to_map_[i] = voxel_grid_map_loader_->is_close_to_map(point, distance_threshold_);
+  }
+
+  output.data.resize(input->data.size());
+  output.point_step = point_step;
+  size_t output_size = 0;
+  for (int i = 0; i < num_points; ++i) {
+    if (point_is_close_to_map_[i]) {
       continue;
     }
-    std::memcpy(&output.data[output_size], &input->data[global_offset], point_step);
+    std::memcpy(
+      &output.data[output_size], &input->data[static_cast<size_t>(i) * point_step], point_step);
     output_size += point_step;
   }
   output.header = input->header;
@@ -21,6 +21,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -40,6 +41,8 @@ private:
   bool set_map_in_voxel_grid_;
 
   bool dynamic_map_load_enable_;
+  /** \brief Result of is_close_to_map for each input point, kept to reuse its memory */
+  std::vector<uint8_t> point_is_close_to_map_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -0,0 +1,86 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_occupancy_bitset.hpp"
+
+#include <pcl/common/point_tests.h>
+
+#include <cmath>
+
+namespace autoware::compare_map_segmentation
+{
+MapOccupancyBitset::MapOccupancyBitset(
+  const pcl::PointCloud<pcl::PointXYZ> & map_points, const float voxel_size_xy,
+  const float voxel_size_z)
+: inverse_voxel_size_(1.0f / voxel_size_xy, 1.0f / voxel_size_xy, 1.0f / voxel_size_z)
+{
+  blocks_.reserve(map_points.size());
+  // the neighbors of a voxel are mostly in its block, so the last block found is kept
+  uint64_t last_block_key = 0;
+  uint64_t * last_block = nullptr;
+  for (const auto & map_point : map_points) {
+    if (!pcl::isFinite(map_point)) {
+      continue;
+    }
+    const Eigen::Vector3i map_voxel = getVoxel(map_point);
+    for (int dz = -1; dz <= 1; ++dz) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          const Eigen::Vector3i voxel = map_voxel + Eigen::Vector3i(dx, dy, dz);
+          const uint64_t block_key = getBlockKey(voxel);
+          if (!last_block || block_key != last_block_key) {
+            last_block = &blocks_[block_key];
+            last_block_key = block_key;
+          }
+          *last_block |= getVoxelBit(voxel);
+        }
+      }
+    }
+  }
+}
+
+bool MapOccupancyBitset::contains(const pcl::PointXYZ & point) const
+{
+  if (!pcl::isFinite(point)) {
+    return false;
+  }
+  const Eigen::Vector3i voxel = getVoxel(point);
+  const auto block = blocks_.find(getBlockKey(voxel));
+  return block != blocks_.end() && (block->second & getVoxelBit(voxel)) != 0;
+}
+
+Eigen::Vector3i MapOccupancyBitset::getVoxel(const pcl::PointXYZ & point) const
+{
+  // same as pcl::VoxelGrid::getGridCoordinates
+  return Eigen::Vector3i(
+    static_cast<int>(std::floor(point.x * inverse_voxel_size_[0])),
+    static_cast<int>(std::floor(point.y * inverse_voxel_size_[1])),
+    static_cast<int>(std::floor(point.z * inverse_voxel_size_[2])));
+}
+
+uint64_t MapOccupancyBitset::getBlockKey(const Eigen::Vector3i & voxel)
+{
+  // 21 bits for each block coordinate, blocks far apart may share a key which only sets more bits
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(voxel.x() >> 2) & mask) << 42) |
+         ((static_cast<uint64_t>(voxel.y() >> 2) & mask) << 21) |
+         (static_cast<uint64_t>(voxel.z() >> 2) & mask);
+}
+
+uint64_t MapOccupancyBitset::getVoxelBit(const Eigen::Vector3i & voxel)
+{
+  return uint64_t{1} << ((voxel.x() & 3) | ((voxel.y() & 3) << 2) | ((voxel.z() & 3) << 4));
+}
+
+}  // namespace autoware::compare_map_segmentation
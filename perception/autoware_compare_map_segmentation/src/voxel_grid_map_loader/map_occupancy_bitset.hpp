@@ -0,0 +1,55 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VOXEL_GRID_MAP_LOADER__MAP_OCCUPANCY_BITSET_HPP_
+#define VOXEL_GRID_MAP_LOADER__MAP_OCCUPANCY_BITSET_HPP_
+
+#include <Eigen/Core>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace autoware::compare_map_segmentation
+{
+/** \brief Sparse bitset of the voxels containing a map point or next to one containing a map
+ * point, i.e. the occupied voxels dilated by one voxel. The voxels are grouped by blocks of
+ * 4 x 4 x 4, each stored as a 64-bit word in a hash map.
+ *
+ * A map point within one voxel size of a point along each axis is in one of the 27 voxels around
+ * the voxel of the point, so a point whose voxel is not set has no map point this close.
+ */
+class MapOccupancyBitset
+{
+public:
+  MapOccupancyBitset(
+    const pcl::PointCloud<pcl::PointXYZ> & map_points, float voxel_size_xy, float voxel_size_z);
+
+  /** \brief Whether the voxel of the point is set. False for a non-finite point */
+  bool contains(const pcl::PointXYZ & point) const;
+
+private:
+  Eigen::Vector3i getVoxel(const pcl::PointXYZ & point) const;
+  static uint64_t getBlockKey(const Eigen::Vector3i & voxel);
+  static uint64_t getVoxelBit(const Eigen::Vector3i & voxel);
+
+  Eigen::Array3f inverse_voxel_size_;
+  std::unordered_map<uint64_t, uint64_t> blocks_;
+};
+
+}  // namespace autoware::compare_map_segmentation
+
+#endif  // VOXEL_GRID_MAP_LOADER__MAP_OCCUPANCY_BITSET_HPP_
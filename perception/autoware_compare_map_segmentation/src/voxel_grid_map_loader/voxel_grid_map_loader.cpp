@@ -277,6 +277,10 @@ void VoxelGridStaticMapLoader::onMapCallback(
   voxel_grid_.setInputCloud(map_pcl_ptr);
   voxel_grid_.setSaveLeafLayout(true);
   voxel_grid_.filter(*voxel_map_ptr_);
+  if (use_map_occupancy_) {
+    map_occupancy_ =
+      std::make_shared<MapOccupancyBitset>(*voxel_map_ptr_, voxel_leaf_size_, voxel_leaf_size_z_);
+  }
   (*mutex_ptr_).unlock();
 
   if (debug_) {
@@ -286,6 +290,9 @@ void VoxelGridStaticMapLoader::onMapCallback(
 bool VoxelGridStaticMapLoader::is_close_to_map(
   const pcl::PointXYZ & point, const double distance_threshold)
 {
+  if (!may_be_close_to_map(map_occupancy_, point, distance_threshold)) {
+    return false;
+  }
   if (is_close_to_neighbor_voxels(point, distance_threshold, voxel_map_ptr_, voxel_grid_)) {
     return true;
   }
@@ -369,6 +376,9 @@ bool VoxelGridDynamicMapLoader::is_close_to_map(
   }
   if (
     current_voxel_grid_array_.at(map_grid_index) != NULL &&
+    may_be_close_to_map(
+      current_voxel_grid_array_.at(map_grid_index)->map_cell_occupancy, point,
+      distance_threshold) &&
     is_close_to_neighbor_voxels(
       point, distance_threshold, current_voxel_grid_array_.at(map_grid_index)->map_cell_pc_ptr,
       current_voxel_grid_array_.at(map_grid_index)->map_cell_voxel_grid)) {
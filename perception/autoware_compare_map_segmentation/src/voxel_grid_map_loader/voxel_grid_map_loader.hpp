@@ -15,6 +15,8 @@
 #ifndef VOXEL_GRID_MAP_LOADER__VOXEL_GRID_MAP_LOADER_HPP_
 #define VOXEL_GRID_MAP_LOADER__VOXEL_GRID_MAP_LOADER_HPP_
 
+#include "map_occupancy_bitset.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include "autoware_map_msgs/srv/get_differential_point_cloud_map.hpp"
@@ -101,6 +103,19 @@ protected:
   double downsize_ratio_z_axis_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr downsampled_map_pub_;
   bool debug_ = false;
+  /** \brief Whether to build the occupancy of the map voxels when the map is loaded */
+  bool use_map_occupancy_ = true;
+
+  /** \brief False if the occupancy tells that no map point is within distance_threshold of the
+   * point. The occupancy is dilated by one voxel, which covers distance thresholds up to the leaf
+   * size only.
+   */
+  bool may_be_close_to_map(
+    const std::shared_ptr<const MapOccupancyBitset> & occupancy, const pcl::PointXYZ & point,
+    const double distance_threshold) const
+  {
+    return !occupancy || distance_threshold > voxel_leaf_size_ || occupancy->contains(point);
+  }
 
 public:
   typedef VoxelGridEx<pcl::PointXYZ> VoxelGridPointXYZ;
@@ -133,6 +148,7 @@ protected:
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_map_;
   VoxelGridPointXYZ voxel_grid_;
   PointCloudPtr voxel_map_ptr_;
+  std::shared_ptr<const MapOccupancyBitset> map_occupancy_;
 
 public:
   explicit VoxelGridStaticMapLoader(
@@ -151,6 +167,7 @@ protected:
     PointCloudPtr map_cell_pc_ptr;
     float min_b_x, min_b_y, max_b_x, max_b_y;
     pcl::search::Search<pcl::PointXYZ>::Ptr map_cell_kdtree;
+    std::shared_ptr<const MapOccupancyBitset> map_cell_occupancy;
   };
 
   typedef typename std::map<std::string, struct MapGridVoxelInfo> VoxelGridDict;
@@ -313,6 +330,10 @@ public:
 
     current_voxel_grid_list_item.map_cell_pc_ptr.reset(new pcl::PointCloud<pcl::PointXYZ>);
     current_voxel_grid_list_item.map_cell_pc_ptr = std::move(map_cell_downsampled_pc_ptr_tmp);
+    if (use_map_occupancy_) {
+      current_voxel_grid_list_item.map_cell_occupancy = std::make_shared<MapOccupancyBitset>(
+        *current_voxel_grid_list_item.map_cell_pc_ptr, voxel_leaf_size_, voxel_leaf_size_z_);
+    }
     // add
     (*mutex_ptr_).lock();
     current_voxel_grid_dict_.insert({map_cell_to_add.cell_id, current_voxel_grid_list_item});
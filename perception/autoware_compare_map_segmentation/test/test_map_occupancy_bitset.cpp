@@ -0,0 +1,133 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_occupancy_bitset.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+using autoware::compare_map_segmentation::MapOccupancyBitset;
+
+namespace
+{
+bool isNeighborVoxel(const float a, const float b, const float voxel_size)
+{
+  const auto index = [voxel_size](const float coordinate) {
+    return static_cast<int>(std::floor(coordinate * (1.0f / voxel_size)));
+  };
+  return std::abs(index(a) - index(b)) <= 1;
+}
+
+// whether a map point is in one of the 27 voxels around the voxel of the point
+bool hasNeighborMapPoint(
+  const pcl::PointCloud<pcl::PointXYZ> & map_points, const pcl::PointXYZ & point,
+  const float voxel_size_xy, const float voxel_size_z)
+{
+  for (const auto & map_point : map_points) {
+    if (
+      isNeighborVoxel(map_point.x, point.x, voxel_size_xy) &&
+      isNeighborVoxel(map_point.y, point.y, voxel_size_xy) &&
+      isNeighborVoxel(map_point.z, point.z, voxel_size_z)) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+TEST(MapOccupancyBitsetTest, MatchesBruteForceOnRandomPoints)
+{
+  constexpr float voxel_size_xy = 0.5f;
+  constexpr float voxel_size_z = 0.3f;
+  // the points span blocks on both sides of zero, so that negative voxel indices are split into
+  // blocks and bits as well
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> map_distribution(-5.0f, 5.0f);
+  std::uniform_real_distribution<float> query_distribution(-7.0f, 7.0f);
+
+  pcl::PointCloud<pcl::PointXYZ> map_points;
+  for (int i = 0; i < 100; ++i) {
+    map_points.push_back(pcl::PointXYZ(
+      map_distribution(engine), map_distribution(engine), map_distribution(engine)));
+  }
+  const MapOccupancyBitset occupancy(map_points, voxel_size_xy, voxel_size_z);
+
+  int num_contained = 0;
+  for (int i = 0; i < 20000; ++i) {
+    const pcl::PointXYZ point(
+      query_distribution(engine), query_distribution(engine), query_distribution(engine));
+    const bool expected = hasNeighborMapPoint(map_points, point, voxel_size_xy, voxel_size_z);
+    EXPECT_EQ(occupancy.contains(point), expected)
+      << "point: " << point.x << ", " << point.y << ", " << point.z;
+    num_contained += expected;
+  }
+  // both results are checked
+  EXPECT_GT(num_contained, 0);
+  EXPECT_LT(num_contained, 20000);
+}
+
+TEST(MapOccupancyBitsetTest, DilatesByOneVoxelAcrossNegativeBlocks)
+{
+  // voxel (-1, -4, -5) is in block (-1, -1, -2), and its neighbors are split across the blocks
+  // around it
+  pcl::PointCloud<pcl::PointXYZ> map_points;
+  map_points.push_back(pcl::PointXYZ(-0.5f, -3.5f, -4.5f));
+  const MapOccupancyBitset occupancy(map_points, 1.0f, 1.0f);
+
+  for (int x = -4; x <= 2; ++x) {
+    for (int y = -7; y <= -1; ++y) {
+      for (int z = -8; z <= -2; ++z) {
+        const pcl::PointXYZ point(x + 0.5f, y + 0.5f, z + 0.5f);
+        const bool expected = std::abs(x + 1) <= 1 && std::abs(y + 4) <= 1 && std::abs(z + 5) <= 1;
+        EXPECT_EQ(occupancy.contains(point), expected) << "voxel: " << x << ", " << y << ", " << z;
+      }
+    }
+  }
+}
+
+TEST(MapOccupancyBitsetTest, BlockKeyWrapsAround)
+{
+  // the block coordinates are kept in 21 bits, so the voxels 2^23 apart share a key and a bit
+  constexpr float wrap_distance = static_cast<float>(1 << 23);
+  pcl::PointCloud<pcl::PointXYZ> map_points;
+  map_points.push_back(pcl::PointXYZ(0.5f, 0.5f, 0.5f));
+  const MapOccupancyBitset occupancy(map_points, 1.0f, 1.0f);
+
+  // a shared key only sets more bits, so the far voxels are reported as possibly close
+  EXPECT_TRUE(occupancy.contains(pcl::PointXYZ(wrap_distance, 0.5f, 0.5f)));
+  EXPECT_TRUE(occupancy.contains(pcl::PointXYZ(0.5f, -wrap_distance, 0.5f)));
+  EXPECT_TRUE(occupancy.contains(pcl::PointXYZ(0.5f, 0.5f, wrap_distance + 1.0f)));
+  // voxel -1 is in block -1, whose masked key is the largest one and does not wrap onto block 0
+  EXPECT_TRUE(occupancy.contains(pcl::PointXYZ(-0.5f, -0.5f, -0.5f)));
+  EXPECT_FALSE(occupancy.contains(pcl::PointXYZ(-1.5f, 0.5f, 0.5f)));
+  EXPECT_FALSE(occupancy.contains(pcl::PointXYZ(wrap_distance + 2.0f, 0.5f, 0.5f)));
+}
+
+TEST(MapOccupancyBitsetTest, NonFinitePoints)
+{
+  pcl::PointCloud<pcl::PointXYZ> map_points;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  map_points.push_back(pcl::PointXYZ(nan, 0.0f, 0.0f));
+  map_points.push_back(pcl::PointXYZ(0.5f, 0.5f, 0.5f));
+  const MapOccupancyBitset occupancy(map_points, 1.0f, 1.0f);
+
+  EXPECT_TRUE(occupancy.contains(pcl::PointXYZ(0.5f, 0.5f, 0.5f)));
+  EXPECT_FALSE(occupancy.contains(pcl::PointXYZ(nan, 0.5f, 0.5f)));
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_FALSE(occupancy.contains(pcl::PointXYZ(0.5f, inf, 0.5f)));
+}
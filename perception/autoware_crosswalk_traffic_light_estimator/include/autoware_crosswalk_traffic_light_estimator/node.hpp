@@ -17,6 +17,7 @@
 
 #include <autoware/universe_utils/ros/debug_publisher.hpp>
 #include <autoware/universe_utils/system/stop_watch.hpp>
+#include <map_loader/lanelet2_shared_map.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
@@ -63,9 +64,9 @@ private:
   rclcpp::Subscription<TrafficSignalArray>::SharedPtr sub_traffic_light_array_;
   rclcpp::Publisher<TrafficSignalArray>::SharedPtr pub_traffic_light_array_;
 
-  lanelet::LaneletMapPtr lanelet_map_ptr_;
-  lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
-  lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
+  map_loader::SharedLaneletMapConstPtr shared_map_ptr_;
+  lanelet::LaneletMapConstPtr lanelet_map_ptr_;
+  lanelet::routing::RoutingGraphConstPtr routing_graph_ptr_;
   std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_ptr_;
 
   lanelet::ConstLanelets conflicting_crosswalks_;
@@ -110,6 +110,7 @@ DetectionByTracker::DetectionByTracker(const rclcpp::NodeOptions & node_options)
   tracker_ignore_.MOTORCYCLE = declare_parameter<bool>("tracker_ignore_label.MOTORCYCLE");
   tracker_ignore_.BICYCLE = declare_parameter<bool>("tracker_ignore_label.BICYCLE");
   tracker_ignore_.PEDESTRIAN = declare_parameter<bool>("tracker_ignore_label.PEDESTRIAN");
+  use_dendrogram_for_divider_ = declare_parameter<bool>("use_dendrogram_for_divider");
 
   // set maximum search setting for merger/divider
   setMaxSearchRange();
@@ -212,52 +213,78 @@ void DetectionByTracker::divideUnderSegmentedObjects(
   out_objects.header = in_cluster_objects.header;
   out_no_found_tracked_objects.header = tracked_objects.header;
 
-  for (const auto & tracked_object : tracked_objects.objects) {
-    const auto & label = tracked_object.classification.front().label;
-    if (tracker_ignore_.isIgnore(label)) continue;
+  // the tracked objects are processed in parallel, and the results are stored in the input order
+  const auto & objects = tracked_objects.objects;
+  std::vector<std::optional<tier4_perception_msgs::msg::DetectedObjectWithFeature>>
+    divided_objects(objects.size());
+  std::vector<uint8_t> is_ignored(objects.size(), false);  // not vector<bool> to write in parallel
 
-    // change search range according to label type
-    const float max_search_range = max_search_distance_for_divider_[label];
-
-    std::optional<tier4_perception_msgs::msg::DetectedObjectWithFeature>
-      highest_score_divided_object = std::nullopt;
-    float highest_score = 0.0;
-
-    for (const auto & initial_object : in_cluster_objects.feature_objects) {
-      // search near object
-      const float distance = autoware::universe_utils::calcDistance2d(
-        tracked_object.kinematics.pose_with_covariance.pose,
-        initial_object.object.kinematics.pose_with_covariance.pose);
-      if (max_search_range < distance) {
-        continue;
-      }
-      // detect under segmented cluster
-      const float recall =
-        object_recognition_utils::get2dRecall(initial_object.object, tracked_object);
-      const float precision =
-        object_recognition_utils::get2dPrecision(initial_object.object, tracked_object);
-      const bool is_under_segmented =
-        (recall_min_threshold < recall && precision < precision_max_threshold);
-      if (!is_under_segmented) {
-        continue;
-      }
-      // optimize clustering
-      tier4_perception_msgs::msg::DetectedObjectWithFeature divided_object;
-      float score = optimizeUnderSegmentedObject(
-        tracked_object, initial_object.feature.cluster, divided_object);
-      if (score < min_score_threshold) {
+#pragma omp parallel
+  {
+    // ShapeEstimator::estimateShapeAndPose is not const, so each thread has its own estimator
+    autoware::shape_estimation::ShapeEstimator shape_estimator(true, true);
+#pragma omp for schedule(dynamic)
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      const auto & tracked_object = objects.at(i);
+      const auto & label = tracked_object.classification.front().label;
+      if (tracker_ignore_.isIgnore(label)) {
+        is_ignored.at(i) = true;
         continue;
       }
 
-      if (highest_score < score) {
-        highest_score = score;
-        highest_score_divided_object = divided_object;
+      // change search range according to label type
+      const auto search_distance_itr = max_search_distance_for_divider_.find(label);
+      const float max_search_range = search_distance_itr != max_search_distance_for_divider_.end()
+                                       ? search_distance_itr->second
+                                       : 0.0f;
+
+      std::optional<tier4_perception_msgs::msg::DetectedObjectWithFeature>
+        highest_score_divided_object = std::nullopt;
+      float highest_score = 0.0;
+
+      for (const auto & initial_object : in_cluster_objects.feature_objects) {
+        // search near object
+        const float distance = autoware::universe_utils::calcDistance2d(
+          tracked_object.kinematics.pose_with_covariance.pose,
+          initial_object.object.kinematics.pose_with_covariance.pose);
+        if (max_search_range < distance) {
+          continue;
+        }
+        // detect under segmented cluster
+        const float recall =
+          object_recognition_utils::get2dRecall(initial_object.object, tracked_object);
+        const float precision =
+          object_recognition_utils::get2dPrecision(initial_object.object, tracked_object);
+        const bool is_under_segmented =
+          (recall_min_threshold < recall && precision < precision_max_threshold);
+        if (!is_under_segmented) {
+          continue;
+        }
+        // optimize clustering
+        tier4_perception_msgs::msg::DetectedObjectWithFeature divided_object;
+        float score = optimizeUnderSegmentedObject(
+          tracked_object, initial_object.feature.cluster, shape_estimator, divided_object);
+        if (score < min_score_threshold) {
+          continue;
+        }
+
+        if (highest_score < score) {
+          highest_score = score;
+          highest_score_divided_object = divided_object;
+        }
       }
+      divided_objects.at(i) = highest_score_divided_object;
     }
-    if (highest_score_divided_object) {  // found
-      out_objects.feature_objects.push_back(highest_score_divided_object.value());
+  }
+
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    if (is_ignored.at(i)) {
+      continue;
+    }
+    if (divided_objects.at(i)) {  // found
+      out_objects.feature_objects.push_back(divided_objects.at(i).value());
     } else {  // not found
-      out_no_found_tracked_objects.objects.push_back(tracked_object);
+      out_no_found_tracked_objects.objects.push_back(objects.at(i));
     }
   }
 }
@@ -265,7 +292,8 @@ void DetectionByTracker::divideUnderSegmentedObjects(
 float DetectionByTracker::optimizeUnderSegmentedObject(
   const autoware_perception_msgs::msg::DetectedObject & target_object,
   const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
-  tier4_perception_msgs::msg::DetectedObjectWithFeature & output)
+  autoware::shape_estimation::ShapeEstimator & shape_estimator,
+  tier4_perception_msgs::msg::DetectedObjectWithFeature & output) const
 {
   constexpr float iter_rate = 0.8;
   constexpr int iter_max_count = 5;
@@ -284,6 +312,18 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_cluster(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(under_segmented_cluster, *pcl_cluster);
 
+  // with the dendrogram, the points are clustered once with the voxel size of the last iteration,
+  // and the clusters at each cluster range are read off from it
+  std::optional<autoware::euclidean_cluster::SingleLinkageDendrogram> dendrogram;
+  if (use_dendrogram_for_divider_) {
+    float last_voxel_size = initial_voxel_size;
+    for (int iter_count = 1; iter_count < iter_max_count; ++iter_count) {
+      last_voxel_size *= iter_rate;
+    }
+    dendrogram.emplace(false, initial_cluster_range, last_voxel_size);
+    dendrogram->build(pcl_cluster);
+  }
+
   // iterate to find best fit divided object
   float highest_iou = 0.0;
   tier4_perception_msgs::msg::DetectedObjectWithFeature highest_iou_object;
@@ -291,16 +331,20 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
        ++iter_count, cluster_range *= iter_rate, voxel_size *= iter_rate) {
     // divide under segmented cluster
     std::vector<pcl::PointCloud<pcl::PointXYZ>> divided_clusters;
-    cluster.setTolerance(cluster_range);
-    cluster.setVoxelLeafSize(voxel_size);
-    cluster.cluster(pcl_cluster, divided_clusters);
+    if (dendrogram) {
+      dendrogram->cluster(cluster_range, 4, 10000, divided_clusters);
+    } else {
+      cluster.setTolerance(cluster_range);
+      cluster.setVoxelLeafSize(voxel_size);
+      cluster.cluster(pcl_cluster, divided_clusters);
+    }
 
     // find highest iou object in divided clusters
     float highest_iou_in_current_iter = 0.0f;
     tier4_perception_msgs::msg::DetectedObjectWithFeature highest_iou_object_in_current_iter;
     highest_iou_object_in_current_iter.object.classification = target_object.classification;
     for (const auto & divided_cluster : divided_clusters) {
-      bool is_shape_estimated = shape_estimator_->estimateShapeAndPose(
+      bool is_shape_estimated = shape_estimator.estimateShapeAndPose(
         label, divided_cluster,
         getReferenceYawInfo(
           label, tf2::getYaw(target_object.kinematics.pose_with_covariance.pose.orientation)),
@@ -16,6 +16,7 @@
 #define DETECTION_BY_TRACKER_NODE_HPP_
 
 #include "autoware/euclidean_cluster/euclidean_cluster.hpp"
+#include "autoware/euclidean_cluster/single_linkage_dendrogram.hpp"
 #include "autoware/euclidean_cluster/utils.hpp"
 #include "autoware/euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
 #include "autoware/shape_estimation/shape_estimator.hpp"
@@ -75,6 +76,7 @@ private:
   std::map<uint8_t, int> max_search_distance_for_divider_;
 
   detection_by_tracker::utils::TrackerIgnoreLabel tracker_ignore_;
+  bool use_dendrogram_for_divider_;
 
   std::unique_ptr<autoware::universe_utils::PublishedTimePublisher> published_time_publisher_;
 
@@ -92,7 +94,8 @@ private:
   float optimizeUnderSegmentedObject(
     const autoware_perception_msgs::msg::DetectedObject & target_object,
     const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
-    tier4_perception_msgs::msg::DetectedObjectWithFeature & output);
+    autoware::shape_estimation::ShapeEstimator & shape_estimator,
+    tier4_perception_msgs::msg::DetectedObjectWithFeature & output) const;
 
   void mergeOverSegmentedObjects(
     const autoware_perception_msgs::msg::DetectedObjects & tracked_objects,
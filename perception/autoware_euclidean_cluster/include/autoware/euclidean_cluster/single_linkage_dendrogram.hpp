@@ -0,0 +1,78 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::euclidean_cluster
+{
+/**
+ * @brief Single-linkage dendrogram of a point cloud for euclidean clustering at many tolerances
+ *
+ * The points are grouped into voxels, and the minimum spanning tree of the voxel centroids is
+ * built from the neighbor pairs within max_tolerance. The euclidean clusters at any tolerance up
+ * to max_tolerance are the connected components of the tree edges not longer than the tolerance,
+ * so they can be read off without searching the neighbors again.
+ */
+class SingleLinkageDendrogram
+{
+public:
+  struct Edge
+  {
+    std::size_t from;
+    std::size_t to;
+    float distance;
+  };
+
+  /**
+   * @param use_height use z of the points for the distance. When false, the points are pressed to
+   * 2d as VoxelGridBasedEuclideanCluster does.
+   * @param max_tolerance the largest tolerance which can be queried
+   * @param voxel_leaf_size leaf size of the voxels. 0 makes a node for each point.
+   */
+  SingleLinkageDendrogram(bool use_height, float max_tolerance, float voxel_leaf_size);
+
+  void build(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud);
+
+  /**
+   * @brief get the euclidean clusters at the tolerance
+   * @param tolerance tolerance, which is clamped to max_tolerance
+   * @param min_cluster_size minimum number of the points in a cluster
+   * @param max_cluster_size maximum number of the points in a cluster
+   * @param clusters output clusters, ordered by the first point of each cluster
+   */
+  void cluster(
+    float tolerance, int min_cluster_size, int max_cluster_size,
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) const;
+
+  std::size_t getNumNodes() const { return node_points_->size(); }
+  const std::vector<Edge> & getTreeEdges() const { return tree_edges_; }
+
+private:
+  bool use_height_;
+  float max_tolerance_;
+  float voxel_leaf_size_;
+
+  pcl::PointCloud<pcl::PointXYZ>::ConstPtr pointcloud_;
+  std::vector<std::size_t> point_to_node_;
+  pcl::PointCloud<pcl::PointXYZ>::Ptr node_points_;
+  std::vector<Edge> tree_edges_;  // sorted by distance
+};
+
+}  // namespace autoware::euclidean_cluster
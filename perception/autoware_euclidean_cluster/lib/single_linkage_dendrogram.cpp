@@ -0,0 +1,214 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/euclidean_cluster/single_linkage_dendrogram.hpp"
+
+#include <pcl/search/kdtree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace autoware::euclidean_cluster
+{
+namespace
+{
+class UnionFind
+{
+public:
+  explicit UnionFind(const std::size_t size) : parents_(size)
+  {
+    std::iota(parents_.begin(), parents_.end(), 0);
+  }
+
+  std::size_t find(std::size_t i)
+  {
+    while (parents_[i] != i) {
+      parents_[i] = parents_[parents_[i]];
+      i = parents_[i];
+    }
+    return i;
+  }
+
+  bool unite(const std::size_t i, const std::size_t j)
+  {
+    const std::size_t root_i = find(i);
+    const std::size_t root_j = find(j);
+    if (root_i == root_j) {
+      return false;
+    }
+    // keep the smaller index as the root to make the result independent of the edge order
+    parents_[std::max(root_i, root_j)] = std::min(root_i, root_j);
+    return true;
+  }
+
+private:
+  std::vector<std::size_t> parents_;
+};
+
+uint64_t toVoxelKey(const int x, const int y, const int z)
+{
+  constexpr int offset = 1 << 20;
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(x + offset) & mask) << 42) |
+         ((static_cast<uint64_t>(y + offset) & mask) << 21) |
+         (static_cast<uint64_t>(z + offset) & mask);
+}
+}  // namespace
+
+SingleLinkageDendrogram::SingleLinkageDendrogram(
+  bool use_height, float max_tolerance, float voxel_leaf_size)
+: use_height_(use_height),
+  max_tolerance_(max_tolerance),
+  voxel_leaf_size_(voxel_leaf_size),
+  node_points_(new pcl::PointCloud<pcl::PointXYZ>)
+{
+}
+
+void SingleLinkageDendrogram::build(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud)
+{
+  pointcloud_ = pointcloud;
+  point_to_node_.clear();
+  node_points_->clear();
+  tree_edges_.clear();
+  if (!pointcloud_ || pointcloud_->empty()) {
+    return;
+  }
+
+  // create nodes at the centroids of the voxels
+  point_to_node_.reserve(pointcloud_->size());
+  std::vector<std::size_t> node_sizes;
+  std::unordered_map<uint64_t, std::size_t> voxel_to_node;
+  // multiplied by the inverse leaf size as pcl::VoxelGrid does, so that the voxels are the same
+  const float inverse_leaf_size = 0.0f < voxel_leaf_size_ ? 1.0f / voxel_leaf_size_ : 0.0f;
+  for (const auto & point : pointcloud_->points) {
+    const float z = use_height_ ? point.z : 0.0f;
+    std::size_t node_idx = node_points_->size();
+    if (0.0f < voxel_leaf_size_) {
+      const uint64_t key = toVoxelKey(
+        static_cast<int>(std::floor(point.x * inverse_leaf_size)),
+        static_cast<int>(std::floor(point.y * inverse_leaf_size)),
+        static_cast<int>(std::floor(z * inverse_leaf_size)));
+      node_idx = voxel_to_node.emplace(key, node_idx).first->second;
+    }
+    if (node_idx == node_points_->size()) {
+      node_points_->push_back(pcl::PointXYZ(0.0f, 0.0f, 0.0f));
+      node_sizes.push_back(0);
+    }
+    auto & node_point = node_points_->points.at(node_idx);
+    node_point.x += point.x;
+    node_point.y += point.y;
+    node_point.z += z;
+    node_sizes.at(node_idx)++;
+    point_to_node_.push_back(node_idx);
+  }
+  for (std::size_t i = 0; i < node_points_->size(); ++i) {
+    auto & node_point = node_points_->points.at(i);
+    const float size = static_cast<float>(node_sizes.at(i));
+    node_point.x /= size;
+    node_point.y /= size;
+    node_point.z /= size;
+  }
+
+  // collect the neighbor pairs within the max tolerance
+  std::vector<Edge> edges;
+  pcl::search::KdTree<pcl::PointXYZ> tree;
+  tree.setInputCloud(node_points_);
+  std::vector<int> indices;
+  std::vector<float> squared_distances;
+  for (std::size_t i = 0; i < node_points_->size(); ++i) {
+    tree.radiusSearch(static_cast<int>(i), max_tolerance_, indices, squared_distances);
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+      const auto j = static_cast<std::size_t>(indices.at(k));
+      if (i < j) {
+        edges.push_back(Edge{i, j, std::sqrt(squared_distances.at(k))});
+      }
+    }
+  }
+
+  // minimum spanning forest by Kruskal's algorithm
+  std::sort(edges.begin(), edges.end(), [](const Edge & a, const Edge & b) {
+    if (a.distance != b.distance) {
+      return a.distance < b.distance;
+    }
+    return a.from != b.from ? a.from < b.from : a.to < b.to;
+  });
+  UnionFind union_find(node_points_->size());
+  for (const auto & edge : edges) {
+    if (union_find.unite(edge.from, edge.to)) {
+      tree_edges_.push_back(edge);
+    }
+  }
+}
+
+void SingleLinkageDendrogram::cluster(
+  float tolerance, int min_cluster_size, int max_cluster_size,
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) const
+{
+  clusters.clear();
+  if (!pointcloud_ || pointcloud_->empty()) {
+    return;
+  }
+  tolerance = std::min(tolerance, max_tolerance_);
+
+  // the edges are sorted, so that only the prefix not longer than the tolerance is merged
+  UnionFind union_find(node_points_->size());
+  for (const auto & edge : tree_edges_) {
+    if (tolerance < edge.distance) {
+      break;
+    }
+    union_find.unite(edge.from, edge.to);
+  }
+
+  // number the clusters in the order of their first point
+  constexpr std::size_t invalid_index = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> root_to_cluster(node_points_->size(), invalid_index);
+  std::vector<std::size_t> point_to_cluster(pointcloud_->size());
+  std::vector<int> cluster_sizes;
+  for (std::size_t i = 0; i < pointcloud_->size(); ++i) {
+    auto & cluster_idx = root_to_cluster.at(union_find.find(point_to_node_.at(i)));
+    if (cluster_idx == invalid_index) {
+      cluster_idx = cluster_sizes.size();
+      cluster_sizes.push_back(0);
+    }
+    cluster_sizes.at(cluster_idx)++;
+    point_to_cluster.at(i) = cluster_idx;
+  }
+
+  // build output and check cluster size
+  std::vector<std::size_t> cluster_to_output(cluster_sizes.size(), invalid_index);
+  for (std::size_t i = 0; i < cluster_sizes.size(); ++i) {
+    if (min_cluster_size <= cluster_sizes.at(i) && cluster_sizes.at(i) <= max_cluster_size) {
+      cluster_to_output.at(i) = clusters.size();
+      clusters.emplace_back();
+      clusters.back().reserve(cluster_sizes.at(i));
+    }
+  }
+  for (std::size_t i = 0; i < pointcloud_->size(); ++i) {
+    const std::size_t output_idx = cluster_to_output.at(point_to_cluster.at(i));
+    if (output_idx != invalid_index) {
+      clusters.at(output_idx).push_back(pointcloud_->points.at(i));
+    }
+  }
+  for (auto & cluster : clusters) {
+    cluster.width = cluster.size();
+    cluster.height = 1;
+    cluster.is_dense = false;
+  }
+}
+
+}  // namespace autoware::euclidean_cluster
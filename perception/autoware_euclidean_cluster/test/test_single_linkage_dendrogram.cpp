@@ -0,0 +1,202 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/euclidean_cluster/single_linkage_dendrogram.hpp"
+#include "autoware/euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using autoware::euclidean_cluster::SingleLinkageDendrogram;
+using autoware::euclidean_cluster::VoxelGridBasedEuclideanCluster;
+
+namespace
+{
+pcl::PointCloud<pcl::PointXYZ>::Ptr generateBlobs(const int nb_blobs, const int nb_points)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> center_dist(-10.0f, 10.0f);
+  std::normal_distribution<float> point_dist(0.0f, 0.4f);
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
+  for (int i = 0; i < nb_blobs; ++i) {
+    const float center_x = center_dist(engine);
+    const float center_y = center_dist(engine);
+    for (int j = 0; j < nb_points; ++j) {
+      pointcloud->push_back(pcl::PointXYZ(
+        center_x + point_dist(engine), center_y + point_dist(engine), point_dist(engine)));
+    }
+  }
+  return pointcloud;
+}
+
+// euclidean clustering in 2d by breadth first search, ordered by the first point of each cluster
+std::vector<std::vector<std::size_t>> clusterByBruteForce(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud, const float tolerance)
+{
+  std::vector<std::vector<std::size_t>> clusters;
+  std::vector<bool> visited(pointcloud.size(), false);
+  for (std::size_t i = 0; i < pointcloud.size(); ++i) {
+    if (visited.at(i)) {
+      continue;
+    }
+    clusters.emplace_back();
+    std::queue<std::size_t> queue;
+    queue.push(i);
+    visited.at(i) = true;
+    while (!queue.empty()) {
+      const std::size_t j = queue.front();
+      queue.pop();
+      clusters.back().push_back(j);
+      for (std::size_t k = 0; k < pointcloud.size(); ++k) {
+        const float dx = pointcloud.points.at(j).x - pointcloud.points.at(k).x;
+        const float dy = pointcloud.points.at(j).y - pointcloud.points.at(k).y;
+        if (!visited.at(k) && dx * dx + dy * dy <= tolerance * tolerance) {
+          visited.at(k) = true;
+          queue.push(k);
+        }
+      }
+    }
+  }
+  return clusters;
+}
+
+using PointList = std::vector<std::tuple<float, float, float>>;
+
+PointList toPointList(const pcl::PointCloud<pcl::PointXYZ> & cluster)
+{
+  PointList points;
+  for (const auto & point : cluster.points) {
+    points.emplace_back(point.x, point.y, point.z);
+  }
+  return points;
+}
+
+// the clusters keep the input order of their points, and are sorted by their first point
+std::vector<PointList> sortClusters(std::vector<PointList> clusters)
+{
+  std::sort(clusters.begin(), clusters.end(), [](const PointList & a, const PointList & b) {
+    return a.front() < b.front();
+  });
+  return clusters;
+}
+}  // namespace
+
+TEST(SingleLinkageDendrogramTest, same_as_euclidean_cluster_at_each_tolerance)
+{
+  const auto pointcloud = generateBlobs(10, 30);
+  SingleLinkageDendrogram dendrogram(false, 0.7f, 0.0f);
+  dendrogram.build(pointcloud);
+  EXPECT_EQ(dendrogram.getNumNodes(), pointcloud->size());
+
+  for (const float tolerance : {0.7f, 0.56f, 0.448f, 0.3584f, 0.28672f, 0.1f}) {
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+    dendrogram.cluster(tolerance, 1, 10000, clusters);
+    const auto expected_clusters = clusterByBruteForce(*pointcloud, tolerance);
+    ASSERT_EQ(clusters.size(), expected_clusters.size());
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+      ASSERT_EQ(clusters.at(i).size(), expected_clusters.at(i).size());
+      const auto & expected_first_point = pointcloud->points.at(expected_clusters.at(i).front());
+      EXPECT_FLOAT_EQ(clusters.at(i).points.front().x, expected_first_point.x);
+      EXPECT_FLOAT_EQ(clusters.at(i).points.front().y, expected_first_point.y);
+    }
+  }
+}
+
+TEST(SingleLinkageDendrogramTest, cluster_size_and_voxel)
+{
+  const auto pointcloud = generateBlobs(5, 40);
+  SingleLinkageDendrogram dendrogram(false, 0.7f, 0.1f);
+  dendrogram.build(pointcloud);
+  EXPECT_LT(dendrogram.getNumNodes(), pointcloud->size());
+
+  // the clusters get smaller as the tolerance gets smaller
+  std::size_t previous_num_clusters = 0;
+  for (const float tolerance : {0.7f, 0.5f, 0.3f, 0.2f}) {
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+    dendrogram.cluster(tolerance, 1, 10000, clusters);
+    std::size_t num_points = 0;
+    for (const auto & cluster : clusters) {
+      num_points += cluster.size();
+    }
+    EXPECT_EQ(num_points, pointcloud->size());
+    EXPECT_LE(previous_num_clusters, clusters.size());
+    previous_num_clusters = clusters.size();
+  }
+
+  // clusters out of the size range are removed
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+  dendrogram.cluster(0.2f, 4, 30, clusters);
+  for (const auto & cluster : clusters) {
+    EXPECT_LE(4U, cluster.size());
+    EXPECT_LE(cluster.size(), 30U);
+  }
+
+  // empty input
+  dendrogram.build(pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>));
+  dendrogram.cluster(0.7f, 1, 10000, clusters);
+  EXPECT_TRUE(clusters.empty());
+}
+
+TEST(SingleLinkageDendrogramTest, same_as_voxel_grid_based_euclidean_cluster)
+{
+  // the points are above z = 0, where the voxel grid of VoxelGridBasedEuclideanCluster is split
+  auto pointcloud = generateBlobs(20, 50);
+  for (auto & point : pointcloud->points) {
+    point.z = std::abs(point.z);
+  }
+  sensor_msgs::msg::PointCloud2 pointcloud_msg;
+  pcl::toROSMsg(*pointcloud, pointcloud_msg);
+  const auto pointcloud_msg_ptr =
+    std::make_shared<const sensor_msgs::msg::PointCloud2>(pointcloud_msg);
+
+  constexpr int min_cluster_size = 4;
+  constexpr int max_cluster_size = 10000;
+  const std::vector<float> tolerances{0.7f, 0.56f, 0.448f, 0.3584f, 0.28672f};
+  for (const float voxel_leaf_size : {0.35f, 0.28f, 0.14336f}) {
+    SingleLinkageDendrogram dendrogram(false, tolerances.front(), voxel_leaf_size);
+    dendrogram.build(pointcloud);
+
+    for (const float tolerance : tolerances) {
+      VoxelGridBasedEuclideanCluster voxel_grid_cluster(
+        false, min_cluster_size, max_cluster_size, tolerance, voxel_leaf_size, 0);
+      tier4_perception_msgs::msg::DetectedObjectsWithFeature objects;
+      ASSERT_TRUE(voxel_grid_cluster.cluster(pointcloud_msg_ptr, objects));
+      std::vector<PointList> expected_clusters;
+      for (const auto & object : objects.feature_objects) {
+        pcl::PointCloud<pcl::PointXYZ> cluster;
+        pcl::fromROSMsg(object.feature.cluster, cluster);
+        expected_clusters.push_back(toPointList(cluster));
+      }
+
+      std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+      dendrogram.cluster(tolerance, min_cluster_size, max_cluster_size, clusters);
+      std::vector<PointList> actual_clusters;
+      for (const auto & cluster : clusters) {
+        actual_clusters.push_back(toPointList(cluster));
+      }
+
+      EXPECT_EQ(sortClusters(actual_clusters), sortClusters(expected_clusters))
+        << "voxel_leaf_size " << voxel_leaf_size << ", tolerance " << tolerance;
+    }
+  }
+}
@@ -16,6 +16,7 @@
 #define AUTOWARE__IMAGE_PROJECTION_BASED_FUSION__FUSION_NODE_HPP_
 
 #include <autoware/image_projection_based_fusion/debugger.hpp>
+#include <autoware/image_projection_based_fusion/utils/geometry.hpp>
 #include <autoware/universe_utils/ros/debug_publisher.hpp>
 #include <autoware/universe_utils/system/stop_watch.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -83,6 +84,12 @@ protected:
   virtual void roiCallback(
     const typename Msg2D::ConstSharedPtr input_roi_msg, const std::size_t roi_i);
 
+  // called for each matched image before fuseOnSingleImage(). When the debugger is disabled, this
+  // is called concurrently for all the matched images, so it must write only per-image state.
+  virtual void prepareOnSingleImage(
+    const TargetMsg3D & input_msg, const std::size_t image_id, const Msg2D & input_roi_msg,
+    const sensor_msgs::msg::CameraInfo & camera_info);
+
   virtual void fuseOnSingleImage(
     const TargetMsg3D & input_msg, const std::size_t image_id, const Msg2D & input_roi_msg,
     const sensor_msgs::msg::CameraInfo & camera_info, TargetMsg3D & output_msg) = 0;
@@ -101,6 +108,7 @@ protected:
 
   // camera_info
   std::map<std::size_t, sensor_msgs::msg::CameraInfo> camera_info_map_;
+  std::map<std::size_t, CameraProjector> camera_projectors_;
   std::vector<rclcpp::Subscription<sensor_msgs::msg::CameraInfo>::SharedPtr> camera_info_subs_;
 
   rclcpp::TimerBase::SharedPtr timer_;
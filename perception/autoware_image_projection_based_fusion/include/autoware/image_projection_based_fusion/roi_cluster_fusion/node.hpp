@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 namespace autoware::image_projection_based_fusion
 {
 const std::map<std::string, uint8_t> IOU_MODE_MAP{{"iou", 0}, {"iou_x", 1}, {"iou_y", 2}};
@@ -35,6 +36,11 @@ protected:
   void preprocess(DetectedObjectsWithFeature & output_cluster_msg) override;
   void postprocess(DetectedObjectsWithFeature & output_cluster_msg) override;
 
+  void prepareOnSingleImage(
+    const DetectedObjectsWithFeature & input_cluster_msg, const std::size_t image_id,
+    const DetectedObjectsWithFeature & input_roi_msg,
+    const sensor_msgs::msg::CameraInfo & camera_info) override;
+
   void fuseOnSingleImage(
     const DetectedObjectsWithFeature & input_cluster_msg, const std::size_t image_id,
     const DetectedObjectsWithFeature & input_roi_msg,
@@ -59,6 +65,10 @@ protected:
     const sensor_msgs::msg::RegionOfInterest & roi_1,
     const sensor_msgs::msg::RegionOfInterest & roi_2, const std::string iou_mode);
   // bool CheckUnknown(const DetectedObjectsWithFeature & obj);
+
+  // rois of the clusters projected on each image by prepareOnSingleImage()
+  std::vector<std::map<std::size_t, sensor_msgs::msg::RegionOfInterest>> cluster_rois_;
+  std::vector<ProjectedPoints> projected_points_;
 };
 
 }  // namespace autoware::image_projection_based_fusion
@@ -37,6 +37,7 @@ private:
   rclcpp::Publisher<PointCloud2>::SharedPtr pub_pointcloud_ptr_;
   std::vector<bool> filter_semantic_label_target_;
   float filter_distance_threshold_;
+  ProjectedPoints projected_points_;
   // declare list of semantic label target, depend on trained data of yolox segmentation model
   std::vector<std::pair<std::string, bool>> filter_semantic_label_target_list_ = {
     {"UNKNOWN", false},       {"BUILDING", false},     {"WALL", false},       {"OBSTACLE", false},
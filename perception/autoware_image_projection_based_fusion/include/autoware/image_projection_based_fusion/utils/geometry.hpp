@@ -22,8 +22,13 @@
 
 #include <autoware_perception_msgs/msg/shape.hpp>
 #include <geometry_msgs/msg/pose.hpp>
+#include <sensor_msgs/msg/camera_info.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 #include <sensor_msgs/msg/region_of_interest.hpp>
 
+#include <image_geometry/pinhole_camera_model.h>
+
+#include <cstddef>
 #include <vector>
 
 namespace autoware::image_projection_based_fusion
@@ -66,6 +71,99 @@ bool is_inside(
 
 void sanitizeROI(sensor_msgs::msg::RegionOfInterest & roi, const int width, const int height);
 
+/**
+ * @brief buffers of the points projected by CameraProjector. The buffers are kept to be reused
+ * for the next projection, so that no memory is allocated once they are large enough.
+ */
+struct ProjectedPoints
+{
+  std::vector<double> x;      // input point in the source frame
+  std::vector<double> y;      // input point in the source frame
+  std::vector<double> z;      // input point in the source frame
+  std::vector<double> depth;  // z in the camera optical frame
+  std::vector<double> u;      // x in the raw (distorted) image
+  std::vector<double> v;      // y in the raw (distorted) image
+
+  std::size_t size() const { return x.size(); }
+  void clear();
+  void resize(const std::size_t size);
+
+  // same condition as the one used with calcRawImageProjectedPoint() in the fusion nodes
+  bool is_inside_image(const std::size_t i, const int width, const int height) const
+  {
+    return depth[i] > 0.0 && 0 <= static_cast<int>(u[i]) &&
+           static_cast<int>(u[i]) <= width - 1 && 0 <= static_cast<int>(v[i]) &&
+           static_cast<int>(v[i]) <= height - 1;
+  }
+};
+
+/**
+ * @brief projector of whole point clouds into the raw image of a camera
+ *
+ * The transform to the camera optical frame and the projection matrix are combined into a 3x4
+ * matrix, which is applied to all the points in a vectorized loop. The distortion is applied with
+ * a lookup table of unrectifyPoint() on a grid of the rectified image, which is interpolated
+ * bilinearly. Points out of the grid fall back to image_geometry::PinholeCameraModel.
+ */
+class CameraProjector
+{
+public:
+  CameraProjector() = default;
+
+  /**
+   * @brief build the lookup table for the camera
+   * @param camera_info camera info
+   * @param lut_step grid interval of the lookup table [px]. 0 disables the lookup table and every
+   * point is unrectified by image_geometry::PinholeCameraModel.
+   */
+  explicit CameraProjector(
+    const sensor_msgs::msg::CameraInfo & camera_info, const int lut_step = 4);
+
+  /**
+   * @brief true if the projector was built from the same calibration as camera_info
+   */
+  bool isBuiltFrom(const sensor_msgs::msg::CameraInfo & camera_info) const;
+
+  /**
+   * @brief project all points of cloud, which must have float x, y and z fields
+   * @param cloud point cloud in the source frame
+   * @param transform transform from the source frame to the camera optical frame
+   * @param projected_points output buffers. The points are appended to the existing ones.
+   * @return index of the first point of cloud in projected_points
+   */
+  std::size_t project(
+    const sensor_msgs::msg::PointCloud2 & cloud, const Eigen::Affine3d & transform,
+    ProjectedPoints & projected_points) const;
+
+  /**
+   * @brief project the points in projected_points.x, y and z from the begin-th point
+   */
+  void project(
+    const Eigen::Affine3d & transform, ProjectedPoints & projected_points,
+    const std::size_t begin = 0) const;
+
+  int width() const { return static_cast<int>(camera_info_.width); }
+  int height() const { return static_cast<int>(camera_info_.height); }
+
+private:
+  Eigen::Vector2d unrectify(const double u, const double v) const;
+
+  sensor_msgs::msg::CameraInfo camera_info_;
+  image_geometry::PinholeCameraModel pinhole_camera_model_;
+  Eigen::Matrix<double, 3, 4> projection_matrix_{Eigen::Matrix<double, 3, 4>::Zero()};
+  bool has_distortion_{false};
+
+  // lookup table of the raw image point, whose (i, j) element is for the rectified image point
+  // (lut_min_u_ + j * lut_step_, lut_min_v_ + i * lut_step_)
+  int lut_step_{0};
+  int lut_cols_{0};
+  int lut_rows_{0};
+  double lut_min_u_{0.0};
+  double lut_min_v_{0.0};
+  std::vector<float> lut_u_;
+  std::vector<float> lut_v_;
+};
+
 }  // namespace autoware::image_projection_based_fusion
 
 #endif  // AUTOWARE__IMAGE_PROJECTION_BASED_FUSION__UTILS__GEOMETRY_HPP_
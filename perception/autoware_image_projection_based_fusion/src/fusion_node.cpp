@@ -152,6 +152,12 @@ void FusionNode<TargetMsg3D, Obj, Msg2D>::cameraInfoCallback(
   const std::size_t camera_id)
 {
   camera_info_map_[camera_id] = *input_camera_info_msg;
+
+  // rebuild the lookup table of the distortion only when the calibration changes
+  const auto itr = camera_projectors_.find(camera_id);
+  if (itr == camera_projectors_.end() || !itr->second.isBuiltFrom(*input_camera_info_msg)) {
+    camera_projectors_[camera_id] = CameraProjector(*input_camera_info_msg);
+  }
 }
 
 template <class TargetMsg3D, class Obj, class Msg2D>
@@ -161,6 +167,16 @@ void FusionNode<TargetMsg3D, Obj, Msg2D>::preprocess(TargetMsg3D & ouput_msg
   // do nothing by default
 }
 
+template <class TargetMsg3D, class Obj, class Msg2D>
+void FusionNode<TargetMsg3D, Obj, Msg2D>::prepareOnSingleImage(
+  const TargetMsg3D & input_msg __attribute__((unused)),
+  const std::size_t image_id __attribute__((unused)),
+  const Msg2D & input_roi_msg __attribute__((unused)),
+  const sensor_msgs::msg::CameraInfo & camera_info __attribute__((unused)))
+{
+  // do nothing by default
+}
+
 template <class TargetMsg3D, class Obj, class Msg2D>
 void FusionNode<TargetMsg3D, Obj, Msg2D>::subCallback(
   const typename TargetMsg3D::ConstSharedPtr input_msg)
@@ -213,7 +229,7 @@ void FusionNode<TargetMsg3D, Obj, Msg2D>::subCallback(
     (*output_msg).header.stamp.sec * (int64_t)1e9 + (*output_msg).header.stamp.nanosec;
 
   // if matching rois exist, fuseOnSingle
-  // please ask maintainers before parallelize this loop because debugger is not thread safe
+  std::vector<std::pair<std::size_t, int64_t>> matched_rois;  // roi index and matched stamp
   for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
     if (camera_info_map_.find(roi_i) == camera_info_map_.end()) {
       RCLCPP_WARN_THROTTLE(
@@ -243,28 +259,46 @@ void FusionNode<TargetMsg3D, Obj, Msg2D>::subCallback(
         (cached_roi_msgs_.at(roi_i)).erase(stamp);
       }
 
-      // fuseOnSingle
       if (matched_stamp != -1) {
-        if (debugger_) {
-          debugger_->clear();
-        }
+        matched_rois.emplace_back(roi_i, matched_stamp);
+      }
+    }
+  }
+
+  // the heavy per-camera part runs concurrently, while the debugger is not thread safe
+  if (!debugger_) {
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+      const auto & [roi_i, matched_stamp] = matched_rois.at(i);
+      prepareOnSingleImage(
+        *input_msg, roi_i, *(cached_roi_msgs_.at(roi_i).at(matched_stamp)),
+        camera_info_map_.at(roi_i));
+    }
+  }
 
-        fuseOnSingleImage(
-          *input_msg, roi_i, *((cached_roi_msgs_.at(roi_i))[matched_stamp]),
-          camera_info_map_.at(roi_i), *output_msg);
-        (cached_roi_msgs_.at(roi_i)).erase(matched_stamp);
-        is_fused_.at(roi_i) = true;
+  // fuseOnSingle in the order of the rois so that the output does not depend on the threads
+  for (const auto & [roi_i, matched_stamp] : matched_rois) {
+    if (debugger_) {
+      debugger_->clear();
+      prepareOnSingleImage(
+        *input_msg, roi_i, *(cached_roi_msgs_.at(roi_i).at(matched_stamp)),
+        camera_info_map_.at(roi_i));
+    }
 
-        // add timestamp interval for debug
-        if (debug_publisher_) {
-          double timestamp_interval_ms = (matched_stamp - timestamp_nsec) / 1e6;
-          debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-            "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_ms", timestamp_interval_ms);
-          debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-            "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_offset_ms",
-            timestamp_interval_ms - input_offset_ms_.at(roi_i));
-        }
-      }
+    fuseOnSingleImage(
+      *input_msg, roi_i, *((cached_roi_msgs_.at(roi_i))[matched_stamp]),
+      camera_info_map_.at(roi_i), *output_msg);
+    (cached_roi_msgs_.at(roi_i)).erase(matched_stamp);
+    is_fused_.at(roi_i) = true;
+
+    // add timestamp interval for debug
+    if (debug_publisher_) {
+      double timestamp_interval_ms = (matched_stamp - timestamp_nsec) / 1e6;
+      debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+        "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_ms", timestamp_interval_ms);
+      debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+        "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_offset_ms",
+        timestamp_interval_ms - input_offset_ms_.at(roi_i));
     }
   }
 
@@ -319,6 +353,8 @@ void FusionNode<TargetMsg3D, Obj, Msg2D>::roiCallback(
         debugger_->clear();
       }
 
+      prepareOnSingleImage(
+        *(cached_msg_.second), roi_i, *input_roi_msg, camera_info_map_.at(roi_i));
       fuseOnSingleImage(
         *(cached_msg_.second), roi_i, *input_roi_msg, camera_info_map_.at(roi_i),
         *(cached_msg_.second));
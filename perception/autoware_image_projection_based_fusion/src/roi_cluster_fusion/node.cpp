@@ -45,6 +45,9 @@ RoiClusterFusionNode::RoiClusterFusionNode(const rclcpp::NodeOptions & options)
   remove_unknown_ = declare_parameter<bool>("remove_unknown");
   fusion_distance_ = declare_parameter<double>("fusion_distance");
   trust_object_distance_ = declare_parameter<double>("trust_object_distance");
+
+  cluster_rois_.resize(rois_number_);
+  projected_points_.resize(rois_number_);
 }
 
 void RoiClusterFusionNode::preprocess(DetectedObjectsWithFeature & output_cluster_msg)
@@ -78,13 +81,13 @@ void RoiClusterFusionNode::postprocess(DetectedObjectsWithFeature & output_clust
   output_cluster_msg.feature_objects = known_objects.feature_objects;
 }
 
-void RoiClusterFusionNode::fuseOnSingleImage(
+void RoiClusterFusionNode::prepareOnSingleImage(
   const DetectedObjectsWithFeature & input_cluster_msg, const std::size_t image_id,
-  const DetectedObjectsWithFeature & input_roi_msg,
-  const sensor_msgs::msg::CameraInfo & camera_info, DetectedObjectsWithFeature & output_cluster_msg)
+  __attribute__((unused)) const DetectedObjectsWithFeature & input_roi_msg,
+  const sensor_msgs::msg::CameraInfo & camera_info)
 {
-  image_geometry::PinholeCameraModel pinhole_camera_model;
-  pinhole_camera_model.fromCameraInfo(camera_info);
+  auto & m_cluster_roi = cluster_rois_.at(image_id);
+  m_cluster_roi.clear();
 
   // get transform from cluster frame id to camera optical frame id
   geometry_msgs::msg::TransformStamped transform_stamped;
@@ -100,8 +103,10 @@ void RoiClusterFusionNode::fuseOnSingleImage(
     }
     transform_stamped = transform_stamped_optional.value();
   }
+  const Eigen::Affine3d transform = transformToEigen(transform_stamped.transform);
+  const auto & projector = camera_projectors_.at(image_id);
+  auto & projected_points = projected_points_.at(image_id);
 
-  std::map<std::size_t, RegionOfInterest> m_cluster_roi;
   for (std::size_t i = 0; i < input_cluster_msg.feature_objects.size(); ++i) {
     if (input_cluster_msg.feature_objects.at(i).feature.cluster.data.empty()) {
       continue;
@@ -116,37 +121,28 @@ void RoiClusterFusionNode::fuseOnSingleImage(
       continue;
     }
 
-    sensor_msgs::msg::PointCloud2 transformed_cluster;
-    tf2::doTransform(
-      input_cluster_msg.feature_objects.at(i).feature.cluster, transformed_cluster,
-      transform_stamped);
+    projected_points.clear();
+    projector.project(
+      input_cluster_msg.feature_objects.at(i).feature.cluster, transform, projected_points);
 
     int min_x(camera_info.width), min_y(camera_info.height), max_x(0), max_y(0);
-    std::vector<Eigen::Vector2d> projected_points;
-    projected_points.reserve(transformed_cluster.data.size());
-    for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-         iter_y(transformed_cluster, "y"), iter_z(transformed_cluster, "z");
-         iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
-      if (*iter_z <= 0.0) {
+    bool is_projected = false;
+    for (std::size_t j = 0; j < projected_points.size(); ++j) {
+      if (!projected_points.is_inside_image(j, camera_info.width, camera_info.height)) {
         continue;
       }
-
-      Eigen::Vector2d projected_point =
-        calcRawImageProjectedPoint(pinhole_camera_model, cv::Point3d(*iter_x, *iter_y, *iter_z));
-      if (
-        0 <= static_cast<int>(projected_point.x()) &&
-        static_cast<int>(projected_point.x()) <= static_cast<int>(camera_info.width) - 1 &&
-        0 <= static_cast<int>(projected_point.y()) &&
-        static_cast<int>(projected_point.y()) <= static_cast<int>(camera_info.height) - 1) {
-        min_x = std::min(static_cast<int>(projected_point.x()), min_x);
-        min_y = std::min(static_cast<int>(projected_point.y()), min_y);
-        max_x = std::max(static_cast<int>(projected_point.x()), max_x);
-        max_y = std::max(static_cast<int>(projected_point.y()), max_y);
-        projected_points.push_back(projected_point);
-        if (debugger_) debugger_->obstacle_points_.push_back(projected_point);
+      const int x = static_cast<int>(projected_points.u[j]);
+      const int y = static_cast<int>(projected_points.v[j]);
+      min_x = std::min(x, min_x);
+      min_y = std::min(y, min_y);
+      max_x = std::max(x, max_x);
+      max_y = std::max(y, max_y);
+      is_projected = true;
+      if (debugger_) {
+        debugger_->obstacle_points_.emplace_back(projected_points.u[j], projected_points.v[j]);
       }
     }
-    if (projected_points.empty()) {
+    if (!is_projected) {
       continue;
     }
 
@@ -159,6 +155,14 @@ void RoiClusterFusionNode::fuseOnSingleImage(
     m_cluster_roi.insert(std::make_pair(i, roi));
     if (debugger_) debugger_->obstacle_rois_.push_back(roi);
   }
+}
+
+void RoiClusterFusionNode::fuseOnSingleImage(
+  const DetectedObjectsWithFeature & input_cluster_msg, const std::size_t image_id,
+  const DetectedObjectsWithFeature & input_roi_msg,
+  const sensor_msgs::msg::CameraInfo & camera_info, DetectedObjectsWithFeature & output_cluster_msg)
+{
+  const auto & m_cluster_roi = cluster_rois_.at(image_id);
 
   for (const auto & feature_obj : input_roi_msg.feature_objects) {
     int index = -1;
@@ -50,7 +50,7 @@ void SegmentPointCloudFusionNode::postprocess(__attribute__((unused)) PointCloud
   return;
 }
 void SegmentPointCloudFusionNode::fuseOnSingleImage(
-  const PointCloud2 & input_pointcloud_msg, __attribute__((unused)) const std::size_t image_id,
+  const PointCloud2 & input_pointcloud_msg, const std::size_t image_id,
   [[maybe_unused]] const Image & input_mask, __attribute__((unused)) const CameraInfo & camera_info,
   __attribute__((unused)) PointCloud2 & output_cloud)
 {
@@ -74,8 +74,6 @@ void SegmentPointCloudFusionNode::fuseOnSingleImage(
   const int orig_height = camera_info.height;
   // resize mask to the same size as the camera image
   cv::resize(mask, mask, cv::Size(orig_width, orig_height), 0, 0, cv::INTER_NEAREST);
-  image_geometry::PinholeCameraModel pinhole_camera_model;
-  pinhole_camera_model.fromCameraInfo(camera_info);
 
   geometry_msgs::msg::TransformStamped transform_stamped;
   // transform pointcloud from frame id to camera optical frame id
@@ -89,13 +87,12 @@ void SegmentPointCloudFusionNode::fuseOnSingleImage(
     transform_stamped = transform_stamped_optional.value();
   }
 
-  PointCloud2 transformed_cloud;
-  tf2::doTransform(input_pointcloud_msg, transformed_cloud, transform_stamped);
+  // project all points at once
+  projected_points_.clear();
+  camera_projectors_.at(image_id).project(
+    input_pointcloud_msg, transformToEigen(transform_stamped.transform), projected_points_);
 
   int point_step = input_pointcloud_msg.point_step;
-  int x_offset = input_pointcloud_msg.fields[pcl::getFieldIndex(input_pointcloud_msg, "x")].offset;
-  int y_offset = input_pointcloud_msg.fields[pcl::getFieldIndex(input_pointcloud_msg, "y")].offset;
-  int z_offset = input_pointcloud_msg.fields[pcl::getFieldIndex(input_pointcloud_msg, "z")].offset;
   size_t output_pointcloud_size = 0;
   output_cloud.data.clear();
   output_cloud.data.resize(input_pointcloud_msg.data.size());
@@ -105,14 +102,9 @@ void SegmentPointCloudFusionNode::fuseOnSingleImage(
   output_cloud.point_step = input_pointcloud_msg.point_step;
   output_cloud.is_bigendian = input_pointcloud_msg.is_bigendian;
   output_cloud.is_dense = input_pointcloud_msg.is_dense;
-  for (size_t global_offset = 0; global_offset < transformed_cloud.data.size();
-       global_offset += point_step) {
-    float transformed_x =
-      *reinterpret_cast<float *>(&transformed_cloud.data[global_offset + x_offset]);
-    float transformed_y =
-      *reinterpret_cast<float *>(&transformed_cloud.data[global_offset + y_offset]);
-    float transformed_z =
-      *reinterpret_cast<float *>(&transformed_cloud.data[global_offset + z_offset]);
+  for (size_t point_i = 0; point_i < projected_points_.size(); ++point_i) {
+    const size_t global_offset = point_i * point_step;
+    const double transformed_z = projected_points_.depth[point_i];
     // skip filtering pointcloud behind the camera or too far from camera
     if (transformed_z <= 0.0 || transformed_z > filter_distance_threshold_) {
       copyPointCloud(
@@ -120,8 +112,8 @@ void SegmentPointCloudFusionNode::fuseOnSingleImage(
       continue;
     }
 
-    Eigen::Vector2d projected_point = calcRawImageProjectedPoint(
-      pinhole_camera_model, cv::Point3d(transformed_x, transformed_y, transformed_z));
+    const Eigen::Vector2d projected_point(
+      projected_points_.u[point_i], projected_points_.v[point_i]);
 
     bool is_inside_image = projected_point.x() > 0 && projected_point.x() < camera_info.width &&
                            projected_point.y() > 0 && projected_point.y() < camera_info.height;
@@ -14,8 +14,15 @@
 
 #include "autoware/image_projection_based_fusion/utils/geometry.hpp"
 
+#include <opencv2/calib3d.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
 namespace autoware::image_projection_based_fusion
 {
 
@@ -204,4 +211,174 @@ void sanitizeROI(sensor_msgs::msg::RegionOfInterest & roi, const int width_, con
   }
 }
 
+void ProjectedPoints::clear()
+{
+  resize(0);
+}
+
+void ProjectedPoints::resize(const std::size_t size)
+{
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  depth.resize(size);
+  u.resize(size);
+  v.resize(size);
+}
+
+CameraProjector::CameraProjector(
+  const sensor_msgs::msg::CameraInfo & camera_info, const int lut_step)
+: camera_info_(camera_info)
+{
+  pinhole_camera_model_.fromCameraInfo(camera_info);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      projection_matrix_(i, j) = camera_info.p.at(i * 4 + j);
+    }
+  }
+  has_distortion_ = std::any_of(
+    camera_info.d.begin(), camera_info.d.end(), [](const double d) { return d != 0.0; });
+
+  // the lookup table is built with the same computation as PinholeCameraModel::unrectifyPoint()
+  const bool is_supported_model = camera_info.distortion_model == "plumb_bob" ||
+                                  camera_info.distortion_model == "rational_polynomial";
+  if (!has_distortion_ || !is_supported_model || lut_step <= 0) {
+    return;
+  }
+
+  // cover a quarter of the image size outside the image as well
+  lut_step_ = lut_step;
+  lut_min_u_ = -0.25 * camera_info.width;
+  lut_min_v_ = -0.25 * camera_info.height;
+  lut_cols_ = static_cast<int>(std::ceil(1.5 * camera_info.width / lut_step_)) + 1;
+  lut_rows_ = static_cast<int>(std::ceil(1.5 * camera_info.height / lut_step_)) + 1;
+
+  std::vector<cv::Point3d> rays;
+  rays.reserve(static_cast<std::size_t>(lut_cols_) * lut_rows_);
+  for (int i = 0; i < lut_rows_; ++i) {
+    for (int j = 0; j < lut_cols_; ++j) {
+      rays.push_back(pinhole_camera_model_.projectPixelTo3dRay(
+        cv::Point2d(lut_min_u_ + j * lut_step_, lut_min_v_ + i * lut_step_)));
+    }
+  }
+  cv::Mat r_vec;
+  const cv::Mat t_vec = cv::Mat_<double>::zeros(3, 1);
+  cv::Rodrigues(cv::Mat(pinhole_camera_model_.rotationMatrix().t()), r_vec);
+  std::vector<cv::Point2d> image_points;
+  cv::projectPoints(
+    rays, r_vec, t_vec, cv::Mat(pinhole_camera_model_.intrinsicMatrix()),
+    pinhole_camera_model_.distortionCoeffs(), image_points);
+
+  lut_u_.resize(image_points.size());
+  lut_v_.resize(image_points.size());
+  for (std::size_t i = 0; i < image_points.size(); ++i) {
+    lut_u_[i] = static_cast<float>(image_points[i].x);
+    lut_v_[i] = static_cast<float>(image_points[i].y);
+  }
+}
+
+bool CameraProjector::isBuiltFrom(const sensor_msgs::msg::CameraInfo & camera_info) const
+{
+  return camera_info_.width == camera_info.width && camera_info_.height == camera_info.height &&
+         camera_info_.distortion_model == camera_info.distortion_model &&
+         camera_info_.d == camera_info.d && camera_info_.k == camera_info.k &&
+         camera_info_.r == camera_info.r && camera_info_.p == camera_info.p;
+}
+
+std::size_t CameraProjector::project(
+  const sensor_msgs::msg::PointCloud2 & cloud, const Eigen::Affine3d & transform,
+  ProjectedPoints & projected_points) const
+{
+  const auto find_offset = [&cloud](const std::string & name) {
+    for (const auto & field : cloud.fields) {
+      if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+        return static_cast<std::size_t>(field.offset);
+      }
+    }
+    throw std::invalid_argument("point cloud does not have float field " + name);
+  };
+  const std::size_t begin = projected_points.size();
+  if (cloud.point_step == 0 || cloud.data.empty()) {
+    return begin;
+  }
+  const std::size_t x_offset = find_offset("x");
+  const std::size_t y_offset = find_offset("y");
+  const std::size_t z_offset = find_offset("z");
+
+  const std::size_t num_points = cloud.data.size() / cloud.point_step;
+  projected_points.resize(begin + num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const uint8_t * point = &cloud.data[i * cloud.point_step];
+    float x, y, z;
+    std::memcpy(&x, point + x_offset, sizeof(float));
+    std::memcpy(&y, point + y_offset, sizeof(float));
+    std::memcpy(&z, point + z_offset, sizeof(float));
+    projected_points.x[begin + i] = x;
+    projected_points.y[begin + i] = y;
+    projected_points.z[begin + i] = z;
+  }
+
+  project(transform, projected_points, begin);
+  return begin;
+}
+
+void CameraProjector::project(
+  const Eigen::Affine3d & transform, ProjectedPoints & projected_points,
+  const std::size_t begin) const
+{
+  const Eigen::Matrix<double, 3, 4> m = projection_matrix_ * transform.matrix();
+  const Eigen::Matrix<double, 1, 4> d = transform.matrix().row(2);
+
+  const std::size_t size = projected_points.size();
+  const double * px = projected_points.x.data();
+  const double * py = projected_points.y.data();
+  const double * pz = projected_points.z.data();
+  double * depth = projected_points.depth.data();
+  double * u = projected_points.u.data();
+  double * v = projected_points.v.data();
+
+  // same as PinholeCameraModel::project3dToPixel() of the transformed point
+#pragma omp simd
+  for (std::size_t i = begin; i < size; ++i) {
+    depth[i] = d(0) * px[i] + d(1) * py[i] + d(2) * pz[i] + d(3);
+    u[i] = (m(0, 0) * px[i] + m(0, 1) * py[i] + m(0, 2) * pz[i] + m(0, 3)) / depth[i];
+    v[i] = (m(1, 0) * px[i] + m(1, 1) * py[i] + m(1, 2) * pz[i] + m(1, 3)) / depth[i];
+  }
+
+  if (!has_distortion_) {
+    return;
+  }
+  for (std::size_t i = begin; i < size; ++i) {
+    if (depth[i] <= 0.0) {
+      continue;
+    }
+    const Eigen::Vector2d raw_point = unrectify(u[i], v[i]);
+    u[i] = raw_point.x();
+    v[i] = raw_point.y();
+  }
+}
+
+Eigen::Vector2d CameraProjector::unrectify(const double u, const double v) const
+{
+  if (lut_step_ > 0) {
+    const double grid_u = (u - lut_min_u_) / lut_step_;
+    const double grid_v = (v - lut_min_v_) / lut_step_;
+    if (0.0 <= grid_u && grid_u < lut_cols_ - 1 && 0.0 <= grid_v && grid_v < lut_rows_ - 1) {
+      const int j = static_cast<int>(grid_u);
+      const int i = static_cast<int>(grid_v);
+      const double a = grid_u - j;
+      const double b = grid_v - i;
+      const std::size_t i00 = static_cast<std::size_t>(i) * lut_cols_ + j;
+      const std::size_t i10 = i00 + lut_cols_;
+      const auto interpolate = [&](const std::vector<float> & lut) {
+        return (1.0 - b) * ((1.0 - a) * lut[i00] + a * lut[i00 + 1]) +
+               b * ((1.0 - a) * lut[i10] + a * lut[i10 + 1]);
+      };
+      return Eigen::Vector2d(interpolate(lut_u_), interpolate(lut_v_));
+    }
+  }
+  const cv::Point2d raw_point = pinhole_camera_model_.unrectifyPoint(cv::Point2d(u, v));
+  return Eigen::Vector2d(raw_point.x, raw_point.y);
+}
+
 }  // namespace autoware::image_projection_based_fusion
@@ -16,6 +16,52 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+sensor_msgs::msg::CameraInfo createCameraInfo(const std::vector<double> & d)
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = 1280;
+  camera_info.height = 720;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = d;
+  camera_info.k = {1000.0, 0.0, 640.0, 0.0, 1000.0, 360.0, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {950.0, 0.0, 630.0, 0.0, 0.0, 950.0, 350.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  return camera_info;
+}
+
+sensor_msgs::msg::PointCloud2 createPointCloud(const std::vector<Eigen::Vector3d> & points)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  cloud.height = 1;
+  cloud.width = points.size();
+  cloud.point_step = 16;  // x, y, z and intensity
+  cloud.row_step = cloud.point_step * cloud.width;
+  for (const auto & [name, offset] :
+       std::vector<std::pair<std::string, uint32_t>>{{"x", 0}, {"y", 4}, {"z", 8}}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = offset;
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    cloud.fields.push_back(field);
+  }
+  cloud.data.resize(cloud.row_step);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const float xyz[3] = {
+      static_cast<float>(points.at(i).x()), static_cast<float>(points.at(i).y()),
+      static_cast<float>(points.at(i).z())};
+    std::memcpy(&cloud.data[i * cloud.point_step], xyz, sizeof(xyz));
+  }
+  return cloud;
+}
+}  // namespace
+
 TEST(objectToVertices, test_objectToVertices)
 {
   // Test `boundingBoxToVertices()` and `cylinderToVertices()` simultaneously
@@ -200,6 +246,64 @@ TEST(sanitizeROI, test_sanitizeROI)
   }
 }
 
+TEST(CameraProjector, test_project)
+{
+  using autoware::image_projection_based_fusion::CameraProjector;
+  using autoware::image_projection_based_fusion::ProjectedPoints;
+
+  // points in the base frame, which is x-forward while the optical frame is z-forward
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-20.0, 20.0);
+  std::vector<Eigen::Vector3d> points;
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(dist(engine), dist(engine), 0.1 * dist(engine));
+  }
+  const auto cloud = createPointCloud(points);
+
+  Eigen::Affine3d transform = Eigen::Affine3d::Identity();
+  transform.linear() << 0.0, -1.0, 0.0, 0.0, 0.0, -1.0, 1.0, 0.0, 0.0;
+  transform.translation() << 0.1, 0.2, -0.3;
+
+  for (const auto & d : std::vector<std::vector<double>>{
+         {0.0, 0.0, 0.0, 0.0, 0.0}, {-0.3, 0.1, 0.001, -0.002, 0.0}}) {
+    const auto camera_info = createCameraInfo(d);
+    image_geometry::PinholeCameraModel pinhole_camera_model;
+    pinhole_camera_model.fromCameraInfo(camera_info);
+
+    for (const int lut_step : {0, 4}) {
+      const CameraProjector projector(camera_info, lut_step);
+      EXPECT_TRUE(projector.isBuiltFrom(camera_info));
+
+      // the points are appended to the existing ones
+      ProjectedPoints projected_points;
+      EXPECT_EQ(projector.project(cloud, transform, projected_points), 0U);
+      EXPECT_EQ(projector.project(cloud, transform, projected_points), points.size());
+      ASSERT_EQ(projected_points.size(), 2 * points.size());
+
+      for (std::size_t i = 0; i < projected_points.size(); ++i) {
+        // the cloud stores the points in float
+        const Eigen::Vector3d point =
+          transform * points.at(i % points.size()).cast<float>().cast<double>();
+        EXPECT_NEAR(projected_points.depth.at(i), point.z(), 1e-6);
+        if (point.z() <= 0.0) {
+          EXPECT_FALSE(projected_points.is_inside_image(i, projector.width(), projector.height()));
+          continue;
+        }
+        const auto expected = pinhole_camera_model.unrectifyPoint(
+          pinhole_camera_model.project3dToPixel(cv::Point3d(point.x(), point.y(), point.z())));
+        // the lookup table is interpolated within the rectified image
+        const double tolerance = lut_step > 0 && !d.empty() && d.front() != 0.0 ? 0.01 : 1e-6;
+        EXPECT_NEAR(projected_points.u.at(i), expected.x, tolerance);
+        EXPECT_NEAR(projected_points.v.at(i), expected.y, tolerance);
+      }
+    }
+  }
+
+  // the calibration is compared to rebuild the projector
+  const CameraProjector projector(createCameraInfo({0.0, 0.0, 0.0, 0.0, 0.0}));
+  EXPECT_FALSE(projector.isBuiltFrom(createCameraInfo({-0.3, 0.1, 0.001, -0.002, 0.0})));
+}
+
 int main(int argc, char * argv[])
 {
   testing::InitGoogleTest(&argc, argv);
@@ -112,6 +112,9 @@ private:
 
   grid_map::GridMap costmap_;
 
+  // primitives filled in the region around the costmap, reused while the costmap is inside it
+  grid_map::GridMap primitives_region_;
+
   rclcpp::Publisher<grid_map_msgs::msg::GridMap>::SharedPtr pub_costmap_;
   rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr pub_occupancy_grid_;
 
@@ -193,11 +196,11 @@ private:
   grid_map::Matrix generateObjectsCostmap(
     const autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects);
 
-  /// \brief calculate cost from lanelet2 map
-  grid_map::Matrix generatePrimitivesCostmap();
+  /// \brief calculate cost from lanelet2 map, copying it from the cached primitives region
+  void updatePrimitivesCostmap();
 
-  /// \brief calculate cost for final output
-  grid_map::Matrix generateCombinedCostmap();
+  /// \brief calculate cost for final output in place
+  void updateCombinedCostmap();
 };
 }  // namespace autoware::costmap_generator
 
@@ -96,6 +96,20 @@ void FillPolygonAreas(
   const std::string & in_tf_target_frame, const std::string & in_tf_source_frame,
   const tf2_ros::Buffer & in_tf_buffer);
 
+/*!
+ * Copies the part of in_region_map covered by out_grid_map to the layer of out_grid_map.
+ * The maps must have the same resolution and their cells must be aligned, i.e. their positions
+ * differ by whole cells and their sizes differ by even numbers of cells. Neither map may be
+ * moved with grid_map::GridMap::move.
+ * @param[in] in_region_map GridMap object covering out_grid_map
+ * @param[in] in_grid_layer_name Name of the layer to copy
+ * @param[out] out_grid_map GridMap object to copy the layer to
+ * @return false if out_grid_map is not fully inside in_region_map, and nothing is copied
+ */
+bool CopyAlignedRegion(
+  const grid_map::GridMap & in_region_map, const std::string & in_grid_layer_name,
+  grid_map::GridMap & out_grid_map);
+
 }  // namespace object_map
 
 #endif  // AUTOWARE_COSTMAP_GENERATOR__OBJECT_MAP_UTILS_HPP_
@@ -59,6 +59,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -275,6 +276,9 @@ void CostmapGenerator::onLaneletMapBin(
   if (use_parkinglot_) {
     loadParkingAreasFromLaneletMap(lanelet_map_, &primitives_points_);
   }
+
+  // the cached primitives are made from the previous map
+  primitives_region_ = grid_map::GridMap();
 }
 
 void CostmapGenerator::onObjects(
@@ -309,14 +313,18 @@ void CostmapGenerator::onTimer()
     return;
   }
 
-  // Set grid center
+  // Set grid center. It is moved by whole cells from the initial position, so that the cached
+  // primitives can be copied by an integer offset
+  const double resolution = costmap_.getResolution();
   grid_map::Position p;
-  p.x() = tf.transform.translation.x;
-  p.y() = tf.transform.translation.y;
+  p.x() = grid_position_x_ +
+          std::round((tf.transform.translation.x - grid_position_x_) / resolution) * resolution;
+  p.y() = grid_position_y_ +
+          std::round((tf.transform.translation.y - grid_position_y_) / resolution) * resolution;
   costmap_.setPosition(p);
 
   if ((use_wayarea_ || use_parkinglot_) && lanelet_map_) {
-    costmap_[LayerName::primitives] = generatePrimitivesCostmap();
+    updatePrimitivesCostmap();
   }
 
   if (use_objects_ && objects_) {
@@ -327,7 +335,7 @@ void CostmapGenerator::onTimer()
     costmap_[LayerName::points] = generatePointsCostmap(points_);
   }
 
-  costmap_[LayerName::combined] = generateCombinedCostmap();
+  updateCombinedCostmap();
 
   publishCostmap(costmap_);
 }
@@ -427,34 +435,50 @@ grid_map::Matrix CostmapGenerator::generateObjectsCostmap(
   return objects_costmap;
 }
 
-grid_map::Matrix CostmapGenerator::generatePrimitivesCostmap()
+void CostmapGenerator::updatePrimitivesCostmap()
 {
-  grid_map::GridMap lanelet2_costmap = costmap_;
-  if (!primitives_points_.empty()) {
+  if (primitives_points_.empty()) {
+    return;
+  }
+
+  // the primitives move in the costmap frame, so that they are filled in the costmap every time
+  if (costmap_frame_ != map_frame_) {
+    grid_map::GridMap lanelet2_costmap({LayerName::primitives});
+    lanelet2_costmap.setFrameId(costmap_frame_);
+    lanelet2_costmap.setGeometry(
+      costmap_.getLength(), costmap_.getResolution(), costmap_.getPosition());
     object_map::FillPolygonAreas(
       lanelet2_costmap, primitives_points_, LayerName::primitives, grid_max_value_, grid_min_value_,
       grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
+    costmap_[LayerName::primitives] = lanelet2_costmap[LayerName::primitives];
+    return;
+  }
+
+  if (object_map::CopyAlignedRegion(primitives_region_, LayerName::primitives, costmap_)) {
+    return;
   }
-  return lanelet2_costmap[LayerName::primitives];
+
+  // fill the primitives in the region twice as large as the costmap, which is reused until the
+  // costmap goes out of it. The size difference is kept even to align the cells with the costmap.
+  const grid_map::Size region_size = costmap_.getSize() + (costmap_.getSize() / 2) * 2;
+  primitives_region_ = grid_map::GridMap({LayerName::primitives});
+  primitives_region_.setFrameId(costmap_frame_);
+  primitives_region_.setGeometry(
+    grid_map::Length(region_size.cast<double>() * costmap_.getResolution()),
+    costmap_.getResolution(), costmap_.getPosition());
+  object_map::FillPolygonAreas(
+    primitives_region_, primitives_points_, LayerName::primitives, grid_max_value_,
+    grid_min_value_, grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
+  object_map::CopyAlignedRegion(primitives_region_, LayerName::primitives, costmap_);
 }
 
-grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
+void CostmapGenerator::updateCombinedCostmap()
 {
   // assuming combined_costmap is calculated by element wise max operation
-  grid_map::GridMap combined_costmap = costmap_;
-
-  combined_costmap[LayerName::combined].setConstant(grid_min_value_);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::points]);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::primitives]);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::objects]);
-
-  return combined_costmap[LayerName::combined];
+  costmap_[LayerName::combined] = costmap_[LayerName::points]
+                                    .cwiseMax(costmap_[LayerName::primitives])
+                                    .cwiseMax(costmap_[LayerName::objects])
+                                    .cwiseMax(static_cast<float>(grid_min_value_));
 }
 
 void CostmapGenerator::publishCostmap(const grid_map::GridMap & costmap)
@@ -75,7 +75,11 @@ void FillPolygonAreas(
     out_grid_map, in_grid_layer_name, CV_8UC1, in_layer_min_value, in_layer_max_value,
     original_image);
 
-  cv::Mat merged_filled_image = original_image.clone();
+  // filling each polygon on the same image gives the same result as filling each one on its own
+  // copy and merging the copies with a bitwise AND, only when the fill color has no bit that the
+  // background lacks in the image, which holds for the callers filling the max value (255) with
+  // the min value (0)
+  cv::Mat merged_filled_image = original_image;
 
   geometry_msgs::msg::TransformStamped transform;
   transform = in_tf_buffer.lookupTransform(
@@ -105,13 +109,9 @@ void FillPolygonAreas(
       cv_polygon.emplace_back(cv_x, cv_y);
     }
 
-    cv::Mat filled_image = original_image.clone();
-
     std::vector<std::vector<cv::Point>> cv_polygons;
     cv_polygons.push_back(cv_polygon);
-    cv::fillPoly(filled_image, cv_polygons, cv::Scalar(in_fill_color));
-
-    merged_filled_image &= filled_image;
+    cv::fillPoly(merged_filled_image, cv_polygons, cv::Scalar(in_fill_color));
   }
 
   // convert to ROS msg
@@ -119,4 +119,26 @@ void FillPolygonAreas(
     merged_filled_image, in_grid_layer_name, out_grid_map, in_layer_min_value, in_layer_max_value);
 }
 
+bool CopyAlignedRegion(
+  const grid_map::GridMap & in_region_map, const std::string & in_grid_layer_name,
+  grid_map::GridMap & out_grid_map)
+{
+  const grid_map::Size & out_size = out_grid_map.getSize();
+  const grid_map::Size & region_size = in_region_map.getSize();
+
+  // the cell i of out_grid_map is the cell i + offset of in_region_map
+  const Eigen::Array2d offset_position =
+    (in_region_map.getPosition() - out_grid_map.getPosition()).array() /
+      out_grid_map.getResolution() +
+    (region_size - out_size).cast<double>() / 2.0;
+  const grid_map::Index offset = offset_position.round().cast<int>();
+  if ((offset < 0).any() || (region_size < offset + out_size).any()) {
+    return false;
+  }
+
+  out_grid_map[in_grid_layer_name] = in_region_map[in_grid_layer_name].block(
+    offset.x(), offset.y(), out_size.x(), out_size.y());
+  return true;
+}
+
 }  // namespace object_map
@@ -0,0 +1,60 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_costmap_generator/object_map_utils.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+grid_map::GridMap constructGridmap(
+  const double length_x, const double length_y, const double resolution,
+  const grid_map::Position & position)
+{
+  grid_map::GridMap gm;
+  gm.setFrameId("map");
+  gm.setGeometry(grid_map::Length(length_x, length_y), resolution, position);
+  gm.add("primitives", 0.0);
+  return gm;
+}
+}  // namespace
+
+TEST(ObjectMapUtilsTest, CopyAlignedRegion)
+{
+  // region of 20 x 16 cells and the costmap of 10 x 8 cells
+  auto region = constructGridmap(10.0, 8.0, 0.5, grid_map::Position(1.0, -2.0));
+  for (grid_map::GridMapIterator itr(region); !itr.isPastEnd(); ++itr) {
+    grid_map::Position position;
+    region.getPosition(*itr, position);
+    region.at("primitives", *itr) = static_cast<float>(position.x() * 100.0 + position.y());
+  }
+
+  for (const auto & costmap_position :
+       {grid_map::Position(1.0, -2.0), grid_map::Position(3.5, -0.5),
+        grid_map::Position(-1.5, -4.0)}) {
+    auto costmap = constructGridmap(5.0, 4.0, 0.5, costmap_position);
+    ASSERT_TRUE(object_map::CopyAlignedRegion(region, "primitives", costmap));
+    for (grid_map::GridMapIterator itr(costmap); !itr.isPastEnd(); ++itr) {
+      grid_map::Position position;
+      costmap.getPosition(*itr, position);
+      EXPECT_FLOAT_EQ(
+        costmap.at("primitives", *itr), static_cast<float>(position.x() * 100.0 + position.y()));
+    }
+  }
+
+  // out of the region
+  auto costmap = constructGridmap(5.0, 4.0, 0.5, grid_map::Position(4.0, -2.0));
+  EXPECT_FALSE(object_map::CopyAlignedRegion(region, "primitives", costmap));
+  EXPECT_FALSE(object_map::CopyAlignedRegion(grid_map::GridMap(), "primitives", costmap));
+}
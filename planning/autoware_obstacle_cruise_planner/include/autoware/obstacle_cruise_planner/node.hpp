@@ -18,6 +18,7 @@
 #include "autoware/obstacle_cruise_planner/common_structs.hpp"
 #include "autoware/obstacle_cruise_planner/optimization_based_planner/optimization_based_planner.hpp"
 #include "autoware/obstacle_cruise_planner/pid_based_planner/pid_based_planner.hpp"
+#include "autoware/obstacle_cruise_planner/polygon_utils.hpp"
 #include "autoware/obstacle_cruise_planner/type_alias.hpp"
 #include "autoware/universe_utils/ros/logger_level_configure.hpp"
 #include "autoware/universe_utils/ros/polling_subscriber.hpp"
@@ -189,6 +190,9 @@ private:
     stop_watch_;
   mutable std::shared_ptr<DebugData> debug_data_ptr_{nullptr};
 
+  // one step polygons reused across the calls and the planning cycles
+  mutable polygon_utils::OneStepPolygonCache one_step_polygon_cache_;
+
   // planner
   std::unique_ptr<PlannerInterface> planner_ptr_{nullptr};
 
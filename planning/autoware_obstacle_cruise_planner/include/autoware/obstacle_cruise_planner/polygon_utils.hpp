@@ -22,17 +22,76 @@
 
 #include <boost/geometry.hpp>
 
+#include <array>
 #include <limits>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace polygon_utils
 {
 namespace bg = boost::geometry;
+using autoware::universe_utils::Box2d;
 using autoware::universe_utils::Point2d;
 using autoware::universe_utils::Polygon2d;
 
+/**
+ * @brief cache of the one step polygons across the planning cycles
+ *
+ * A polygon is keyed by everything it is made from, i.e. the footprint poses of the trajectory
+ * point and its previous point and the vehicle shape with the lateral margin. The polygons found or
+ * inserted since the last startNewCycle() are kept for one more cycle, and the others are removed.
+ */
+class OneStepPolygonCache
+{
+public:
+  static constexpr size_t key_size = 26;
+  using Key = std::array<double, key_size>;
+
+  const Polygon2d * find(const Key & key);
+  void insert(const Key & key, const Polygon2d & polygon);
+  void startNewCycle();
+  size_t size() const { return current_polygons_.size() + previous_polygons_.size(); }
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(const Key & key) const;
+  };
+
+  std::unordered_map<Key, Polygon2d, KeyHash> current_polygons_;
+  std::unordered_map<Key, Polygon2d, KeyHash> previous_polygons_;
+};
+
+/**
+ * @brief bounding box hierarchy of the trajectory polygons for the broad phase of the obstacle
+ * checks
+ *
+ * The boxes are stored in a complete binary tree whose leaves are the boxes of the polygons in the
+ * order of the trajectory. The polygons must outlive the tree.
+ */
+class PolygonBoxTree
+{
+public:
+  explicit PolygonBoxTree(const std::vector<Polygon2d> & polygons);
+
+  const Box2d & getBox(const size_t polygon_idx) const
+  {
+    return boxes_.at(leaf_offset_ + polygon_idx);
+  }
+
+  // same as the minimum of boost::geometry::distance to all the polygons
+  double calcMinDistance(const Polygon2d & polygon) const;
+
+private:
+  const std::vector<Polygon2d> & polygons_;
+  size_t leaf_offset_{1};
+  std::vector<Box2d> boxes_;
+};
+
+bool intersectsBox(const Box2d & box1, const Box2d & box2);
+
 Polygon2d createOneStepPolygon(
   const std::vector<geometry_msgs::msg::Pose> & last_poses,
   const std::vector<geometry_msgs::msg::Pose> & current_poses,
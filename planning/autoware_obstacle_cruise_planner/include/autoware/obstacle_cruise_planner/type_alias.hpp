@@ -67,6 +67,7 @@ using tier4_planning_msgs::msg::VelocityLimitClearCommand;
 using visualization_msgs::msg::Marker;
 using visualization_msgs::msg::MarkerArray;
 namespace bg = boost::geometry;
+using autoware::universe_utils::Box2d;
 using autoware::universe_utils::Point2d;
 using autoware::universe_utils::Polygon2d;
 
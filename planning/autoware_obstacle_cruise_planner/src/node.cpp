@@ -33,6 +33,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 
 namespace
@@ -573,6 +574,7 @@ void ObstacleCruisePlannerNode::onTrajectory(const Trajectory::ConstSharedPtr ms
 
   stop_watch_.tic(__func__);
   *debug_data_ptr_ = DebugData();
+  one_step_polygon_cache_.startNewCycle();
 
   const auto is_driving_forward = autoware::motion_utils::isDrivingForwardWithTwist(traj_points);
   is_driving_forward_ = is_driving_forward ? is_driving_forward.value() : is_driving_forward_;
@@ -667,10 +669,19 @@ std::vector<Polygon2d> ObstacleCruisePlannerNode::createOneStepPolygons(
   const double current_ego_yaw_error = tf2::getYaw(current_ego_pose_error.orientation);
   double time_elapsed{0.0};
 
-  std::vector<Polygon2d> output_polygons;
-  Polygon2d tmp_polys{};
+  // 1. calculate the footprint poses of each point, and the cache key parts made from them
+  constexpr size_t point_key_size = 11;
+  static_assert(4 + 2 * point_key_size == polygon_utils::OneStepPolygonCache::key_size);
+  std::vector<std::vector<geometry_msgs::msg::Pose>> footprint_poses(traj_points.size());
+  std::vector<std::array<double, point_key_size>> point_keys(traj_points.size());
   for (size_t i = 0; i < traj_points.size(); ++i) {
-    std::vector<geometry_msgs::msg::Pose> current_poses = {traj_points.at(i).pose};
+    const auto & pose = traj_points.at(i).pose;
+    auto & current_poses = footprint_poses.at(i);
+    current_poses.push_back(pose);
+    point_keys.at(i) = {pose.position.x,    pose.position.y,    pose.position.z,
+                        pose.orientation.x, pose.orientation.y, pose.orientation.z,
+                        pose.orientation.w, 0.0,                0.0,
+                        0.0,                0.0};
 
     // estimate the future ego pose with assuming that the pose error against the reference path
     // will decrease to zero by the time_to_convergence
@@ -681,8 +692,10 @@ std::vector<Polygon2d> ObstacleCruisePlannerNode::createOneStepPolygons(
         autoware::universe_utils::createQuaternionFromYaw(current_ego_yaw_error * rem_ratio));
       indexed_pose_err.set__position(
         autoware::universe_utils::createPoint(0.0, current_ego_lat_error * rem_ratio, 0.0));
-      current_poses.push_back(
-        autoware::universe_utils::transformPose(indexed_pose_err, traj_points.at(i).pose));
+      current_poses.push_back(autoware::universe_utils::transformPose(indexed_pose_err, pose));
+      point_keys.at(i).at(7) = 1.0;
+      point_keys.at(i).at(8) = current_ego_lat_error * rem_ratio;
+      point_keys.at(i).at(9) = current_ego_yaw_error * rem_ratio;
       if (traj_points.at(i).longitudinal_velocity_mps != 0.0) {
         time_elapsed +=
           p.decimate_trajectory_step_length / std::abs(traj_points.at(i).longitudinal_velocity_mps);
@@ -690,9 +703,14 @@ std::vector<Polygon2d> ObstacleCruisePlannerNode::createOneStepPolygons(
         time_elapsed = std::numeric_limits<double>::max();
       }
     }
+    if (i == 0 && traj_points.at(i).longitudinal_velocity_mps > 1e-3) {
+      point_keys.at(i).at(10) = 1.0;
+    }
+  }
 
+  const auto create_idx_poly = [&](const size_t i) {
     Polygon2d idx_poly{};
-    for (const auto & pose : current_poses) {
+    for (const auto & pose : footprint_poses.at(i)) {
       if (i == 0 && traj_points.at(i).longitudinal_velocity_mps > 1e-3) {
         boost::geometry::append(
           idx_poly,
@@ -717,14 +735,50 @@ std::vector<Polygon2d> ObstacleCruisePlannerNode::createOneStepPolygons(
                       .outer());
       }
     }
+    return idx_poly;
+  };
+
+  // 2. create the convex hull of the footprints at the point and the previous point, or reuse it
+  //    when the footprints are unchanged
+  std::vector<Polygon2d> output_polygons;
+  output_polygons.reserve(traj_points.size());
+  std::optional<std::pair<size_t, Polygon2d>> last_idx_poly{};
+  const auto get_idx_poly = [&](const size_t i) -> const Polygon2d & {
+    if (!last_idx_poly || last_idx_poly->first != i) {
+      last_idx_poly = std::make_pair(i, create_idx_poly(i));
+    }
+    return last_idx_poly->second;
+  };
+  for (size_t i = 0; i < traj_points.size(); ++i) {
+    polygon_utils::OneStepPolygonCache::Key key{};
+    key.at(0) = lat_margin;
+    key.at(1) = front_length;
+    key.at(2) = rear_length;
+    key.at(3) = vehicle_width;
+    if (i == 0) {
+      key.at(4 + 7) = -1.0;  // no previous point
+    } else {
+      std::copy(point_keys.at(i - 1).begin(), point_keys.at(i - 1).end(), key.begin() + 4);
+    }
+    std::copy(
+      point_keys.at(i).begin(), point_keys.at(i).end(), key.begin() + 4 + point_key_size);
+
+    if (const auto * cached_polygon = one_step_polygon_cache_.find(key)) {
+      output_polygons.push_back(*cached_polygon);
+      continue;
+    }
 
-    boost::geometry::append(tmp_polys, idx_poly.outer());
+    Polygon2d tmp_polys{};
+    if (i != 0) {
+      tmp_polys = get_idx_poly(i - 1);
+    }
+    boost::geometry::append(tmp_polys, get_idx_poly(i).outer());
     Polygon2d hull_polygon;
     boost::geometry::convex_hull(tmp_polys, hull_polygon);
     boost::geometry::correct(hull_polygon);
 
+    one_step_polygon_cache_.insert(key, hull_polygon);
     output_polygons.push_back(hull_polygon);
-    tmp_polys = std::move(idx_poly);
   }
   return output_polygons;
 }
@@ -981,15 +1035,12 @@ ObstacleCruisePlannerNode::determineEgoBehaviorAgainstPredictedObjectObstacles(
   std::vector<CruiseObstacle> cruise_obstacles;
   std::vector<SlowDownObstacle> slow_down_obstacles;
   slow_down_condition_counter_.resetCurrentUuids();
+  const polygon_utils::PolygonBoxTree decimated_traj_poly_tree(decimated_traj_polys);
   for (const auto & obstacle : obstacles) {
     const auto obstacle_poly = autoware::universe_utils::toPolygon2d(obstacle.pose, obstacle.shape);
 
     // Calculate distance between trajectory and obstacle first
-    double precise_lat_dist = std::numeric_limits<double>::max();
-    for (const auto & traj_poly : decimated_traj_polys) {
-      const double current_precise_lat_dist = bg::distance(traj_poly, obstacle_poly);
-      precise_lat_dist = std::min(precise_lat_dist, current_precise_lat_dist);
-    }
+    const double precise_lat_dist = decimated_traj_poly_tree.calcMinDistance(obstacle_poly);
 
     // Filter obstacles for cruise, stop and slow down
     const auto cruise_obstacle =
@@ -1634,13 +1685,20 @@ std::optional<SlowDownObstacle> ObstacleCruisePlannerNode::createSlowDownObstacl
     traj_points, vehicle_info_, odometry.pose.pose,
     p.max_lat_margin_for_slow_down + p.lat_hysteresis_margin_for_slow_down);
 
+  Box2d obstacle_box;
+  bg::envelope(obstacle_poly, obstacle_box);
+
   std::vector<Polygon2d> front_collision_polygons;
   size_t front_seg_idx = 0;
   std::vector<Polygon2d> back_collision_polygons;
   size_t back_seg_idx = 0;
   for (size_t i = 0; i < traj_polys_with_lat_margin.size(); ++i) {
     std::vector<Polygon2d> collision_polygons;
-    bg::intersection(traj_polys_with_lat_margin.at(i), obstacle_poly, collision_polygons);
+    Box2d traj_box;
+    bg::envelope(traj_polys_with_lat_margin.at(i), traj_box);
+    if (polygon_utils::intersectsBox(traj_box, obstacle_box)) {
+      bg::intersection(traj_polys_with_lat_margin.at(i), obstacle_poly, collision_polygons);
+    }
 
     if (!collision_polygons.empty()) {
       if (front_collision_polygons.empty()) {
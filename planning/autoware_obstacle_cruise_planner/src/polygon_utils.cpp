@@ -18,8 +18,41 @@
 #include "autoware/universe_utils/geometry/boost_polygon_utils.hpp"
 #include "autoware/universe_utils/geometry/geometry.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
 namespace
 {
+using autoware::universe_utils::Box2d;
+
+Box2d createEmptyBox()
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  return Box2d{{inf, inf}, {-inf, -inf}};
+}
+
+void expandBox(Box2d & box, const Box2d & other)
+{
+  box.min_corner().x() = std::min(box.min_corner().x(), other.min_corner().x());
+  box.min_corner().y() = std::min(box.min_corner().y(), other.min_corner().y());
+  box.max_corner().x() = std::max(box.max_corner().x(), other.max_corner().x());
+  box.max_corner().y() = std::max(box.max_corner().y(), other.max_corner().y());
+}
+
+// lower bound of the distance between the geometries in the boxes
+double calcBoxDistance(const Box2d & box1, const Box2d & box2)
+{
+  const double dx = std::max(
+    {0.0, box1.min_corner().x() - box2.max_corner().x(),
+     box2.min_corner().x() - box1.max_corner().x()});
+  const double dy = std::max(
+    {0.0, box1.min_corner().y() - box2.max_corner().y(),
+     box2.min_corner().y() - box1.max_corner().y()});
+  return std::hypot(dx, dy);
+}
+
 PointWithStamp calcNearestCollisionPoint(
   const size_t first_within_idx, const std::vector<PointWithStamp> & collision_points,
   const std::vector<TrajectoryPoint> & decimated_traj_points, const bool is_driving_forward)
@@ -52,6 +85,8 @@ std::optional<std::pair<size_t, std::vector<PointWithStamp>>> getCollisionIndex(
   const Shape & object_shape, const double max_dist = std::numeric_limits<double>::max())
 {
   const auto obj_polygon = autoware::universe_utils::toPolygon2d(object_pose, object_shape);
+  Box2d obj_box;
+  boost::geometry::envelope(obj_polygon, obj_box);
   for (size_t i = 0; i < traj_polygons.size(); ++i) {
     const double approximated_dist =
       autoware::universe_utils::calcDistance2d(traj_points.at(i).pose, object_pose);
@@ -59,6 +94,13 @@ std::optional<std::pair<size_t, std::vector<PointWithStamp>>> getCollisionIndex(
       continue;
     }
 
+    // the polygons do not collide when their bounding boxes are apart
+    Box2d traj_box;
+    boost::geometry::envelope(traj_polygons.at(i), traj_box);
+    if (!polygon_utils::intersectsBox(traj_box, obj_box)) {
+      continue;
+    }
+
     std::vector<Polygon2d> collision_polygons;
     boost::geometry::intersection(traj_polygons.at(i), obj_polygon, collision_polygons);
 
@@ -92,6 +134,103 @@ std::optional<std::pair<size_t, std::vector<PointWithStamp>>> getCollisionIndex(
 
 namespace polygon_utils
 {
+const Polygon2d * OneStepPolygonCache::find(const Key & key)
+{
+  const auto current_itr = current_polygons_.find(key);
+  if (current_itr != current_polygons_.end()) {
+    return &current_itr->second;
+  }
+
+  // keep the polygon used in this cycle for the next cycle
+  const auto previous_itr = previous_polygons_.find(key);
+  if (previous_itr == previous_polygons_.end()) {
+    return nullptr;
+  }
+  const auto inserted_itr =
+    current_polygons_.emplace(key, std::move(previous_itr->second)).first;
+  previous_polygons_.erase(previous_itr);
+  return &inserted_itr->second;
+}
+
+void OneStepPolygonCache::insert(const Key & key, const Polygon2d & polygon)
+{
+  current_polygons_.emplace(key, polygon);
+}
+
+void OneStepPolygonCache::startNewCycle()
+{
+  previous_polygons_.clear();
+  std::swap(current_polygons_, previous_polygons_);
+}
+
+size_t OneStepPolygonCache::KeyHash::operator()(const Key & key) const
+{
+  size_t seed = 0;
+  for (const double value : key) {
+    seed ^= std::hash<double>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+PolygonBoxTree::PolygonBoxTree(const std::vector<Polygon2d> & polygons) : polygons_(polygons)
+{
+  while (leaf_offset_ < polygons_.size()) {
+    leaf_offset_ *= 2;
+  }
+  boxes_.assign(2 * leaf_offset_, createEmptyBox());
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    bg::envelope(polygons_.at(i), boxes_.at(leaf_offset_ + i));
+  }
+  for (size_t i = leaf_offset_ - 1; 0 < i; --i) {
+    boxes_.at(i) = boxes_.at(2 * i);
+    expandBox(boxes_.at(i), boxes_.at(2 * i + 1));
+  }
+}
+
+double PolygonBoxTree::calcMinDistance(const Polygon2d & polygon) const
+{
+  double min_dist = std::numeric_limits<double>::max();
+  if (polygons_.empty()) {
+    return min_dist;
+  }
+
+  Box2d box;
+  bg::envelope(polygon, box);
+
+  // depth first search visiting the nearer child first, skipping the boxes farther than the
+  // nearest polygon found so far
+  std::vector<size_t> node_stack{1};
+  while (!node_stack.empty()) {
+    const size_t node_idx = node_stack.back();
+    node_stack.pop_back();
+    if (min_dist < calcBoxDistance(boxes_.at(node_idx), box)) {
+      continue;
+    }
+    if (leaf_offset_ <= node_idx) {
+      min_dist = std::min(min_dist, bg::distance(polygons_.at(node_idx - leaf_offset_), polygon));
+      continue;
+    }
+    const size_t left_idx = 2 * node_idx;
+    const size_t right_idx = 2 * node_idx + 1;
+    if (calcBoxDistance(boxes_.at(left_idx), box) < calcBoxDistance(boxes_.at(right_idx), box)) {
+      node_stack.push_back(right_idx);
+      node_stack.push_back(left_idx);
+    } else {
+      node_stack.push_back(left_idx);
+      node_stack.push_back(right_idx);
+    }
+  }
+  return min_dist;
+}
+
+bool intersectsBox(const Box2d & box1, const Box2d & box2)
+{
+  return box1.min_corner().x() <= box2.max_corner().x() &&
+         box2.min_corner().x() <= box1.max_corner().x() &&
+         box1.min_corner().y() <= box2.max_corner().y() &&
+         box2.min_corner().y() <= box1.max_corner().y();
+}
+
 std::optional<std::pair<geometry_msgs::msg::Point, double>> getCollisionPoint(
   const std::vector<TrajectoryPoint> & traj_points, const std::vector<Polygon2d> & traj_polygons,
   const Obstacle & obstacle, const bool is_driving_forward,
@@ -0,0 +1,121 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/obstacle_cruise_planner/polygon_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using polygon_utils::OneStepPolygonCache;
+using polygon_utils::PolygonBoxTree;
+
+namespace
+{
+Polygon2d createRectangle(const double x, const double y, const double yaw, const double length)
+{
+  Polygon2d polygon;
+  for (const auto & [lon, lat] : {std::pair{1.0, 1.0}, {1.0, -1.0}, {-1.0, -1.0}, {-1.0, 1.0}}) {
+    const double dx = lon * length * 0.5;
+    const double dy = lat;
+    polygon.outer().emplace_back(
+      x + dx * std::cos(yaw) - dy * std::sin(yaw), y + dx * std::sin(yaw) + dy * std::cos(yaw));
+  }
+  polygon.outer().push_back(polygon.outer().front());
+  bg::correct(polygon);
+  return polygon;
+}
+}  // namespace
+
+TEST(PolygonBoxTree, calcMinDistance)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> pos_dist(-50.0, 50.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+
+  // polygons along a curve
+  std::vector<Polygon2d> traj_polys;
+  for (size_t i = 0; i < 37; ++i) {
+    const double yaw = 0.02 * static_cast<double>(i);
+    traj_polys.push_back(createRectangle(
+      30.0 * std::sin(yaw), 30.0 * (1.0 - std::cos(yaw)) - 10.0, yaw, 2.0));
+  }
+  const PolygonBoxTree tree(traj_polys);
+
+  for (size_t i = 0; i < 200; ++i) {
+    const auto obstacle_poly =
+      createRectangle(pos_dist(engine), pos_dist(engine), yaw_dist(engine), 4.0);
+    double expected_dist = std::numeric_limits<double>::max();
+    for (const auto & traj_poly : traj_polys) {
+      expected_dist = std::min(expected_dist, bg::distance(traj_poly, obstacle_poly));
+    }
+    EXPECT_DOUBLE_EQ(tree.calcMinDistance(obstacle_poly), expected_dist);
+  }
+
+  for (size_t i = 0; i < traj_polys.size(); ++i) {
+    Box2d expected_box;
+    bg::envelope(traj_polys.at(i), expected_box);
+    EXPECT_TRUE(bg::equals(tree.getBox(i), expected_box));
+  }
+
+  // empty polygons
+  const std::vector<Polygon2d> empty_polys;
+  EXPECT_EQ(
+    PolygonBoxTree(empty_polys).calcMinDistance(createRectangle(0.0, 0.0, 0.0, 1.0)),
+    std::numeric_limits<double>::max());
+}
+
+TEST(PolygonBoxTree, intersectsBox)
+{
+  const Box2d box{{0.0, 0.0}, {1.0, 1.0}};
+  EXPECT_TRUE(polygon_utils::intersectsBox(box, Box2d{{0.5, 0.5}, {2.0, 2.0}}));
+  EXPECT_TRUE(polygon_utils::intersectsBox(box, Box2d{{1.0, 0.0}, {2.0, 1.0}}));
+  EXPECT_FALSE(polygon_utils::intersectsBox(box, Box2d{{1.1, 0.0}, {2.0, 1.0}}));
+  EXPECT_FALSE(polygon_utils::intersectsBox(box, Box2d{{0.0, -2.0}, {1.0, -0.1}}));
+}
+
+TEST(OneStepPolygonCache, keepUsedPolygonsForOneCycle)
+{
+  OneStepPolygonCache cache;
+  OneStepPolygonCache::Key key1{};
+  OneStepPolygonCache::Key key2{};
+  key2.at(0) = 1.0;
+  const auto polygon1 = createRectangle(0.0, 0.0, 0.0, 1.0);
+  const auto polygon2 = createRectangle(1.0, 0.0, 0.0, 1.0);
+
+  EXPECT_EQ(cache.find(key1), nullptr);
+  cache.insert(key1, polygon1);
+  cache.insert(key2, polygon2);
+  ASSERT_NE(cache.find(key1), nullptr);
+  EXPECT_TRUE(bg::equals(*cache.find(key1), polygon1));
+
+  // only key1 is used in the next cycle
+  cache.startNewCycle();
+  ASSERT_NE(cache.find(key1), nullptr);
+  EXPECT_TRUE(bg::equals(*cache.find(key1), polygon1));
+  EXPECT_EQ(cache.size(), 2U);
+
+  cache.startNewCycle();
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_EQ(cache.find(key2), nullptr);
+  ASSERT_NE(cache.find(key1), nullptr);
+
+  cache.startNewCycle();
+  cache.startNewCycle();
+  EXPECT_EQ(cache.size(), 0U);
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
@@ -27,6 +28,7 @@
 #include <Eigen/Geometry>
 
 #include <pcl/filters/voxel_grid.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <tf2/utils.h>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -397,19 +399,32 @@ void ObstacleStopPlannerNode::searchObstacle(
   PlannerData & planner_data, const Header & trajectory_header, const VehicleInfo & vehicle_info,
   const StopParam & stop_param, const PointCloud2::SharedPtr obstacle_ros_pointcloud_ptr)
 {
-  // search candidate obstacle pointcloud
-  PointCloud::Ptr slow_down_pointcloud_ptr(new PointCloud);
-  PointCloud::Ptr obstacle_candidate_pointcloud_ptr(new PointCloud);
+  // search candidate obstacle pointcloud and bin it by the trajectory segments
   if (!searchPointcloudNearTrajectory(
-        decimate_trajectory, obstacle_ros_pointcloud_ptr, obstacle_candidate_pointcloud_ptr,
+        decimate_trajectory, obstacle_ros_pointcloud_ptr, segment_binned_points_,
         trajectory_header, vehicle_info, stop_param)) {
     return;
   }
+  const auto & candidate_points = segment_binned_points_.getPoints();
 
   const auto now = this->now();
 
   updateObstacleHistory(now);
 
+  // the collision points are searched from the slow down points found so far
+  std::vector<uint8_t> is_slow_down_point(
+    candidate_points.size(), node_param_.enable_slow_down ? 0 : 1);
+  std::vector<size_t> within_point_indices;
+  const auto to_pointcloud = [&](const std::vector<size_t> & indices) {
+    PointCloud pointcloud;
+    pointcloud.header = candidate_points.header;
+    pointcloud.reserve(indices.size());
+    for (const size_t idx : indices) {
+      pointcloud.push_back(candidate_points.points.at(idx));
+    }
+    return pointcloud;
+  };
+
   for (size_t i = 0; i < decimate_trajectory.size() - 1; ++i) {
     // create one step circle center for vehicle
     const auto & p_front = decimate_trajectory.at(i).pose;
@@ -421,6 +436,10 @@ void ObstacleStopPlannerNode::searchObstacle(
     const Point2d prev_center_point(prev_center_pose.position.x, prev_center_pose.position.y);
     const auto next_center_pose = getVehicleCenterFromBase(p_back, vehicle_info);
     const Point2d next_center_point(next_center_pose.position.x, next_center_pose.position.y);
+    const auto within_z_range = [&](const size_t idx) {
+      const auto z = candidate_points.points.at(idx).z;
+      return !node_param_.enable_z_axis_obstacle_filtering || (z < z_axis_max && z > z_axis_min);
+    };
 
     if (node_param_.enable_slow_down) {
       Polygon2d one_step_move_slow_down_range_polygon;
@@ -431,38 +450,31 @@ void ObstacleStopPlannerNode::searchObstacle(
       debug_ptr_->pushPolygon(
         one_step_move_slow_down_range_polygon, p_front.position.z, PolygonType::SlowDownRange);
 
-      if (node_param_.enable_z_axis_obstacle_filtering) {
-        planner_data.found_slow_down_points = withinPolyhedron(
-          one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
-          prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
-          slow_down_pointcloud_ptr, z_axis_min, z_axis_max);
-      } else {
-        planner_data.found_slow_down_points = withinPolygon(
-          one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
-          prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
-          slow_down_pointcloud_ptr);
+      planner_data.found_slow_down_points = segment_binned_points_.findWithinPoints(
+        i, one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
+        prev_center_point, next_center_point, within_z_range, within_point_indices);
+      for (const size_t idx : within_point_indices) {
+        is_slow_down_point.at(idx) = 1;
       }
       const auto found_first_slow_down_points =
         planner_data.found_slow_down_points && !planner_data.slow_down_require;
 
       if (found_first_slow_down_points) {
         // found nearest slow down obstacle
+        const auto slow_down_pointcloud = to_pointcloud(within_point_indices);
         planner_data.decimate_trajectory_slow_down_index = i;
         planner_data.slow_down_require = true;
         getNearestPoint(
-          *slow_down_pointcloud_ptr, p_front, &planner_data.nearest_slow_down_point,
+          slow_down_pointcloud, p_front, &planner_data.nearest_slow_down_point,
           &planner_data.nearest_collision_point_time);
         getLateralNearestPoint(
-          *slow_down_pointcloud_ptr, p_front, &planner_data.lateral_nearest_slow_down_point,
+          slow_down_pointcloud, p_front, &planner_data.lateral_nearest_slow_down_point,
           &planner_data.lateral_deviation);
 
         debug_ptr_->pushObstaclePoint(planner_data.nearest_slow_down_point, PointType::SlowDown);
         debug_ptr_->pushPolygon(
           one_step_move_slow_down_range_polygon, p_front.position.z, PolygonType::SlowDown);
       }
-
-    } else {
-      slow_down_pointcloud_ptr = obstacle_candidate_pointcloud_ptr;
     }
 
     {
@@ -478,25 +490,18 @@ void ObstacleStopPlannerNode::searchObstacle(
           one_step_move_vehicle_polygon, p_front.position.z, PolygonType::Vehicle);
       }
 
-      PointCloud::Ptr collision_pointcloud_ptr(new PointCloud);
-      collision_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
-
-      const auto found_collision_points =
-        node_param_.enable_z_axis_obstacle_filtering
-          ? withinPolyhedron(
-              one_step_move_vehicle_polygon, stop_param.stop_search_radius, prev_center_point,
-              next_center_point, slow_down_pointcloud_ptr, collision_pointcloud_ptr, z_axis_min,
-              z_axis_max)
-          : withinPolygon(
-              one_step_move_vehicle_polygon, stop_param.stop_search_radius, prev_center_point,
-              next_center_point, slow_down_pointcloud_ptr, collision_pointcloud_ptr);
+      const auto found_collision_points = segment_binned_points_.findWithinPoints(
+        i, one_step_move_vehicle_polygon, stop_param.stop_search_radius, prev_center_point,
+        next_center_point,
+        [&](const size_t idx) { return is_slow_down_point.at(idx) && within_z_range(idx); },
+        within_point_indices);
 
       if (found_collision_points) {
         pcl::PointXYZ nearest_collision_point;
         rclcpp::Time nearest_collision_point_time;
 
         getNearestPoint(
-          *collision_pointcloud_ptr, p_front, &nearest_collision_point,
+          to_pointcloud(within_point_indices), p_front, &nearest_collision_point,
           &nearest_collision_point_time);
 
         obstacle_history_.emplace_back(now, nearest_collision_point);
@@ -530,7 +535,7 @@ void ObstacleStopPlannerNode::searchObstacle(
       p_front, p_back, one_step_move_vehicle_polygon, vehicle_info, stop_param.lateral_margin);
 
     PointCloud::Ptr collision_pointcloud_ptr(new PointCloud);
-    collision_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
+    collision_pointcloud_ptr->header = candidate_points.header;
 
     // check new collision points
     if (node_param_.enable_z_axis_obstacle_filtering) {
@@ -1447,7 +1452,7 @@ TrajectoryPoints ObstacleStopPlannerNode::trimTrajectoryWithIndexFromSelfPose(
 
 bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
   const TrajectoryPoints & trajectory, const PointCloud2::ConstSharedPtr & input_points_ptr,
-  PointCloud::Ptr output_points_ptr, const Header & trajectory_header,
+  SegmentBinnedPoints & output_points, const Header & trajectory_header,
   const VehicleInfo & vehicle_info, const StopParam & stop_param)
 {
   // transform pointcloud
@@ -1463,36 +1468,35 @@ bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
     return false;
   }
 
-  PointCloud2 transformed_points{};
   const Eigen::Matrix4f affine_matrix =
     tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
-  pcl_ros::transformPointCloud(affine_matrix, *input_points_ptr, transformed_points);
-  PointCloud::Ptr transformed_points_ptr(new PointCloud);
-  pcl::fromROSMsg(transformed_points, *transformed_points_ptr);
-
-  output_points_ptr->header = transformed_points_ptr->header;
 
   // search obstacle candidate pointcloud to reduce calculation cost
   const double search_radius = node_param_.enable_slow_down
                                  ? slow_down_param_.slow_down_search_radius
                                  : stop_param.stop_search_radius;
-  const double squared_radius = search_radius * search_radius;
-  std::vector<geometry_msgs::msg::Point> center_points;
+  std::vector<Point2d> center_points;
   center_points.reserve(trajectory.size());
   for (const auto & trajectory_point : trajectory) {
-    center_points.push_back(getVehicleCenterFromBase(trajectory_point.pose, vehicle_info).position);
+    const auto center_pose = getVehicleCenterFromBase(trajectory_point.pose, vehicle_info);
+    center_points.emplace_back(center_pose.position.x, center_pose.position.y);
   }
-  for (const auto & point : transformed_points_ptr->points) {
-    for (const auto & center_point : center_points) {
-      const double x = center_point.x - point.x;
-      const double y = center_point.y - point.y;
-      const double squared_distance = x * x + y * y;
-      if (squared_distance < squared_radius) {
-        output_points_ptr->points.push_back(point);
-        break;
-      }
+  output_points.reset(center_points, search_radius);
+
+  // transform the points while reading the message, without intermediate pointclouds
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(*input_points_ptr, "x"),
+       iter_y(*input_points_ptr, "y"), iter_z(*input_points_ptr, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    if (!std::isfinite(*iter_x) || !std::isfinite(*iter_y) || !std::isfinite(*iter_z)) {
+      continue;
     }
+    const Eigen::Vector4f point = affine_matrix * Eigen::Vector4f(*iter_x, *iter_y, *iter_z, 1.0f);
+    output_points.addPoint(pcl::PointXYZ(point.x(), point.y(), point.z()));
   }
+  output_points.build();
+
+  // same header as pcl_ros::transformPointCloud() gives
+  pcl_conversions::toPCL(input_points_ptr->header, output_points.getPoints().header);
   return true;
 }
 
@@ -20,6 +20,7 @@
 #include "autoware/universe_utils/system/stop_watch.hpp"
 #include "debug_marker.hpp"
 #include "planner_data.hpp"
+#include "segment_binned_points.hpp"
 
 #include <autoware/motion_utils/trajectory/conversion.hpp>
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
@@ -172,6 +173,7 @@ private:
   std::optional<SlowDownSection> latest_slow_down_section_{std::nullopt};
   std::vector<ObstacleWithDetectionTime> obstacle_history_{};
   std::vector<PredictedObjectWithDetectionTime> predicted_object_history_{};
+  SegmentBinnedPoints segment_binned_points_{};  // kept to reuse the buffers between the cycles
   tf2_ros::Buffer tf_buffer_{get_clock()};
   tf2_ros::TransformListener tf_listener_{tf_buffer_};
   PointCloud2::SharedPtr obstacle_ros_pointcloud_ptr_{nullptr};
@@ -214,7 +216,7 @@ private:
 
   bool searchPointcloudNearTrajectory(
     const TrajectoryPoints & trajectory, const PointCloud2::ConstSharedPtr & input_points_ptr,
-    PointCloud::Ptr output_points_ptr, const Header & trajectory_header,
+    SegmentBinnedPoints & output_points, const Header & trajectory_header,
     const VehicleInfo & vehicle_info, const StopParam & stop_param);
 
   StopPoint createTargetPoint(
@@ -0,0 +1,118 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segment_binned_points.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace autoware::motion_planning
+{
+namespace
+{
+constexpr size_t invalid_index = std::numeric_limits<size_t>::max();
+constexpr double min_cell_size = 1e-3;
+}  // namespace
+
+std::pair<int64_t, int64_t> SegmentBinnedPoints::toCell(const double x, const double y) const
+{
+  return {
+    static_cast<int64_t>(std::floor(x / cell_size_)),
+    static_cast<int64_t>(std::floor(y / cell_size_))};
+}
+
+uint64_t SegmentBinnedPoints::toCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffffULL);
+}
+
+void SegmentBinnedPoints::reset(const std::vector<Point2d> & centers, const double search_radius)
+{
+  search_radius_ = search_radius;
+  cell_size_ = std::max(search_radius, min_cell_size);
+  num_segments_ = centers.size() < 2 ? 0 : centers.size() - 1;
+  centers_ = centers;
+
+  sorted_center_keys_.clear();
+  for (size_t i = 0; i < centers_.size(); ++i) {
+    const auto cell = toCell(centers_.at(i).x(), centers_.at(i).y());
+    sorted_center_keys_.emplace_back(toCellKey(cell.first, cell.second), i);
+  }
+  std::sort(sorted_center_keys_.begin(), sorted_center_keys_.end());
+
+  points_.clear();
+  segment_point_pairs_.clear();
+  last_point_of_segment_.assign(num_segments_, invalid_index);
+  segment_offsets_.clear();
+  sorted_point_indices_.clear();
+}
+
+bool SegmentBinnedPoints::addPoint(const pcl::PointXYZ & point)
+{
+  const double squared_radius = search_radius_ * search_radius_;
+  const size_t point_idx = points_.size();
+  const auto cell = toCell(point.x, point.y);
+  bool is_near = false;
+
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      const uint64_t key = toCellKey(cell.first + dx, cell.second + dy);
+      auto itr = std::lower_bound(
+        sorted_center_keys_.begin(), sorted_center_keys_.end(), std::make_pair(key, size_t{0}));
+      for (; itr != sorted_center_keys_.end() && itr->first == key; ++itr) {
+        const size_t center_idx = itr->second;
+        const double x = centers_.at(center_idx).x() - point.x;
+        const double y = centers_.at(center_idx).y() - point.y;
+        if (squared_radius <= x * x + y * y) {
+          continue;
+        }
+        is_near = true;
+        // the center is the back of the previous segment and the front of the next segment
+        const size_t first_segment_idx = center_idx == 0 ? 0 : center_idx - 1;
+        const size_t last_segment_idx = std::min(center_idx + 1, num_segments_);
+        for (size_t seg_idx = first_segment_idx; seg_idx < last_segment_idx; ++seg_idx) {
+          if (last_point_of_segment_.at(seg_idx) != point_idx) {
+            last_point_of_segment_.at(seg_idx) = point_idx;
+            segment_point_pairs_.emplace_back(seg_idx, point_idx);
+          }
+        }
+      }
+    }
+  }
+
+  if (is_near) {
+    points_.push_back(point);
+  }
+  return is_near;
+}
+
+void SegmentBinnedPoints::build()
+{
+  // counting sort by the segment, which keeps the point order in each segment
+  segment_offsets_.assign(num_segments_ + 1, 0);
+  for (const auto & pair : segment_point_pairs_) {
+    segment_offsets_.at(pair.first + 1)++;
+  }
+  for (size_t i = 0; i < num_segments_; ++i) {
+    segment_offsets_.at(i + 1) += segment_offsets_.at(i);
+  }
+  segment_cursors_.assign(segment_offsets_.begin(), segment_offsets_.end() - 1);
+  sorted_point_indices_.resize(segment_point_pairs_.size());
+  for (const auto & pair : segment_point_pairs_) {
+    sorted_point_indices_.at(segment_cursors_.at(pair.first)++) = pair.second;
+  }
+}
+
+}  // namespace autoware::motion_planning
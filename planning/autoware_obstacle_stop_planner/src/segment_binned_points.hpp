@@ -0,0 +1,136 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SEGMENT_BINNED_POINTS_HPP_
+#define SEGMENT_BINNED_POINTS_HPP_
+
+#include <autoware/universe_utils/geometry/boost_geometry.hpp>
+
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::motion_planning
+{
+
+using autoware::universe_utils::Point2d;
+using autoware::universe_utils::Polygon2d;
+
+/**
+ * @brief obstacle points binned by the segments of the decimated trajectory
+ *
+ * The segment i is between the vehicle centers i and i + 1. A point is put in the bins of the
+ * segments whose front or back center is closer than the search radius, which is the same condition
+ * as withinPolygon() and withinPolyhedron() check before the polygon, so that the collision check
+ * of each segment only has to look at its own bin instead of the whole candidate pointcloud. The
+ * centers around a point are looked up from a grid whose cell size is the search radius.
+ *
+ * The buffers are kept between the cycles, so that no allocation happens once they are warmed up.
+ */
+class SegmentBinnedPoints
+{
+public:
+  struct IndexRange
+  {
+    const size_t * first;
+    const size_t * last;
+    const size_t * begin() const { return first; }
+    const size_t * end() const { return last; }
+    bool empty() const { return first == last; }
+  };
+
+  /**
+   * @brief clear the points and set the vehicle centers of the trajectory points
+   * @param centers vehicle centers of the decimated trajectory points
+   * @param search_radius points farther than this from all the centers are dropped
+   */
+  void reset(const std::vector<Point2d> & centers, const double search_radius);
+
+  /**
+   * @brief add the point if it is within the search radius of any center
+   * @return true if the point is added
+   */
+  bool addPoint(const pcl::PointXYZ & point);
+
+  // sort the added points by the segments. must be called after all the points are added
+  void build();
+
+  // candidate points, which are the added points in the order of addPoint()
+  const pcl::PointCloud<pcl::PointXYZ> & getPoints() const { return points_; }
+  pcl::PointCloud<pcl::PointXYZ> & getPoints() { return points_; }
+
+  size_t getNumSegments() const { return num_segments_; }
+
+  // indices of the candidate points in the bin of the segment, in ascending order
+  IndexRange getSegmentPointIndices(const size_t segment_idx) const
+  {
+    const size_t * data = sorted_point_indices_.data();
+    return {
+      data + segment_offsets_.at(segment_idx), data + segment_offsets_.at(segment_idx + 1)};
+  }
+
+  /**
+   * @brief same as withinPolygon() on the points of the segment bin
+   * @param filter predicate on the point index to check in addition to the polygon
+   * @param within_point_indices output indices of the points within the polygon
+   * @return true if any point is within the polygon
+   */
+  template <class Filter>
+  bool findWithinPoints(
+    const size_t segment_idx, const Polygon2d & polygon, const double radius,
+    const Point2d & prev_point, const Point2d & next_point, const Filter & filter,
+    std::vector<size_t> & within_point_indices) const
+  {
+    namespace bg = boost::geometry;
+    within_point_indices.clear();
+    for (const size_t idx : getSegmentPointIndices(segment_idx)) {
+      const auto & candidate_point = points_.points[idx];
+      const Point2d point(candidate_point.x, candidate_point.y);
+      if (bg::distance(prev_point, point) < radius || bg::distance(next_point, point) < radius) {
+        if (filter(idx) && bg::within(point, polygon)) {
+          within_point_indices.push_back(idx);
+        }
+      }
+    }
+    return !within_point_indices.empty();
+  }
+
+private:
+  std::pair<int64_t, int64_t> toCell(const double x, const double y) const;
+  static uint64_t toCellKey(const int64_t cell_x, const int64_t cell_y);
+
+  double search_radius_{0.0};
+  double cell_size_{1.0};
+  size_t num_segments_{0};
+  std::vector<Point2d> centers_;
+  std::vector<std::pair<uint64_t, size_t>> sorted_center_keys_;  // (cell key, center index)
+
+  pcl::PointCloud<pcl::PointXYZ> points_;
+  std::vector<std::pair<size_t, size_t>> segment_point_pairs_;  // (segment index, point index)
+  std::vector<size_t> last_point_of_segment_;  // to add a point to each segment only once
+  std::vector<size_t> segment_offsets_;
+  std::vector<size_t> segment_cursors_;
+  std::vector<size_t> sorted_point_indices_;
+};
+
+}  // namespace autoware::motion_planning
+
+#endif  // SEGMENT_BINNED_POINTS_HPP_
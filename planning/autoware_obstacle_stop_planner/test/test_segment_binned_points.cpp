@@ -0,0 +1,116 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "planner_utils.hpp"
+#include "segment_binned_points.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using autoware::motion_planning::PointCloud;
+using autoware::motion_planning::SegmentBinnedPoints;
+using autoware::universe_utils::Point2d;
+using autoware::universe_utils::Polygon2d;
+
+namespace
+{
+std::vector<Point2d> generateCenters(const size_t num_points)
+{
+  std::vector<Point2d> centers;
+  double yaw = 0.0;
+  Point2d center(0.0, 0.0);
+  for (size_t i = 0; i < num_points; ++i) {
+    centers.push_back(center);
+    yaw += 0.05;
+    center = Point2d(center.x() + 1.5 * std::cos(yaw), center.y() + 1.5 * std::sin(yaw));
+  }
+  return centers;
+}
+
+// rectangle along the segment, which is wider than the segment by the margin
+Polygon2d createSegmentPolygon(const Point2d & front, const Point2d & back, const double margin)
+{
+  const double yaw = std::atan2(back.y() - front.y(), back.x() - front.x());
+  const double dx = margin * std::cos(yaw);
+  const double dy = margin * std::sin(yaw);
+  Polygon2d polygon;
+  polygon.outer().emplace_back(front.x() - dx + dy, front.y() - dy - dx);
+  polygon.outer().emplace_back(front.x() - dx - dy, front.y() - dy + dx);
+  polygon.outer().emplace_back(back.x() + dx - dy, back.y() + dy + dx);
+  polygon.outer().emplace_back(back.x() + dx + dy, back.y() + dy - dx);
+  polygon.outer().push_back(polygon.outer().front());
+  return polygon;
+}
+}  // namespace
+
+TEST(SegmentBinnedPoints, same_as_within_polygon)
+{
+  const auto centers = generateCenters(40);
+  const double search_radius = 3.0;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> x_dist(-10.0f, 40.0f);
+  std::uniform_real_distribution<float> y_dist(-5.0f, 40.0f);
+  std::uniform_real_distribution<float> z_dist(-1.0f, 3.0f);
+  PointCloud::Ptr all_points_ptr(new PointCloud);
+  for (size_t i = 0; i < 5000; ++i) {
+    all_points_ptr->push_back(pcl::PointXYZ(x_dist(engine), y_dist(engine), z_dist(engine)));
+  }
+
+  SegmentBinnedPoints binned_points;
+  binned_points.reset(centers, search_radius);
+  for (const auto & point : *all_points_ptr) {
+    binned_points.addPoint(point);
+  }
+  binned_points.build();
+  ASSERT_EQ(binned_points.getNumSegments(), centers.size() - 1);
+  EXPECT_LT(binned_points.getPoints().size(), all_points_ptr->size());
+
+  std::vector<size_t> within_point_indices;
+  for (size_t i = 0; i + 1 < centers.size(); ++i) {
+    const auto polygon = createSegmentPolygon(centers.at(i), centers.at(i + 1), 1.0);
+    for (const double radius : {search_radius, 2.0}) {
+      PointCloud::Ptr expected_points_ptr(new PointCloud);
+      const bool expected = autoware::motion_planning::withinPolyhedron(
+        polygon, radius, centers.at(i), centers.at(i + 1), all_points_ptr, expected_points_ptr,
+        0.0, 2.0);
+      const bool actual = binned_points.findWithinPoints(
+        i, polygon, radius, centers.at(i), centers.at(i + 1),
+        [&](const size_t idx) {
+          const auto z = binned_points.getPoints().points.at(idx).z;
+          return z < 2.0 && z > 0.0;
+        },
+        within_point_indices);
+
+      EXPECT_EQ(expected, actual);
+      ASSERT_EQ(expected_points_ptr->size(), within_point_indices.size());
+      for (size_t j = 0; j < within_point_indices.size(); ++j) {
+        const auto & actual_point = binned_points.getPoints().points.at(within_point_indices.at(j));
+        EXPECT_EQ(expected_points_ptr->points.at(j).x, actual_point.x);
+        EXPECT_EQ(expected_points_ptr->points.at(j).y, actual_point.y);
+        EXPECT_EQ(expected_points_ptr->points.at(j).z, actual_point.z);
+      }
+    }
+  }
+
+  // no points are kept when the trajectory has no segment
+  binned_points.reset({}, search_radius);
+  EXPECT_FALSE(binned_points.addPoint(pcl::PointXYZ(0.0f, 0.0f, 0.0f)));
+  binned_points.build();
+  EXPECT_EQ(binned_points.getNumSegments(), 0U);
+  EXPECT_TRUE(binned_points.getPoints().empty());
+}
@@ -0,0 +1,149 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+#include "qp_interface/proxqp_interface.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using autoware::common::ProxQPInterface;
+using autoware::velocity_smoother::JerkFilteredSmoother;
+
+namespace
+{
+constexpr double interval = 0.5;
+constexpr size_t num_cycles = 20;
+
+// velocity limit with a slow down section and a stop at the end
+std::vector<double> generateVelocityLimit(const size_t size, const size_t offset)
+{
+  std::vector<double> v_max_arr(size);
+  for (size_t i = 0; i < size; ++i) {
+    const double s = static_cast<double>(i + offset) * interval;
+    v_max_arr.at(i) = std::fmod(s, 100.0) < 20.0 ? 5.0 : 15.0;
+  }
+  v_max_arr.back() = 0.0;
+  return v_max_arr;
+}
+
+double toMilliseconds(
+  const std::chrono::system_clock::time_point & start,
+  const std::chrono::system_clock::time_point & end)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1.0e-6;
+}
+}  // namespace
+
+int main()
+{
+  JerkFilteredSmoother::BaseParam base_param{};
+  base_param.max_accel = 1.0;
+  base_param.min_decel = -0.5;
+  base_param.stop_decel = 0.0;
+  base_param.max_jerk = 1.0;
+  base_param.min_jerk = -0.5;
+  JerkFilteredSmoother::Param param{};
+  param.jerk_weight = 10.0;
+  param.over_v_weight = 100000.0;
+  param.over_a_weight = 5000.0;
+  param.over_j_weight = 2000.0;
+
+  std::cout << "N, dense [ms], sparse [ms], sparse with warm start [ms], "
+               "iterations (cold), iterations (warm start)"
+            << std::endl;
+  for (size_t N = 50; N <= 800; N *= 2) {
+    const std::vector<double> interval_dist_arr(N - 1, interval);
+    ProxQPInterface dense_qp(false, 20000, 1.0e-8, 1.0e-6, false);
+    ProxQPInterface sparse_qp(false, 20000, 1.0e-8, 1.0e-6, false);
+    ProxQPInterface warm_qp(false, 20000, 1.0e-8, 1.0e-6, false);
+
+    double dense_time = 0.0;
+    double sparse_time = 0.0;
+    double warm_time = 0.0;
+    int cold_iterations = 0;
+    int warm_iterations = 0;
+    double v0 = 0.0;
+    double a0 = 0.0;
+    std::vector<double> prev_solution;
+    for (size_t cycle = 0; cycle < num_cycles; ++cycle) {
+      // the ego moves forward by one point in each cycle
+      const auto v_max_arr = generateVelocityLimit(N, cycle);
+
+      // the dense matrices built and converted as before
+      const auto dense_start = std::chrono::system_clock::now();
+      {
+        const auto problem = JerkFilteredSmoother::buildOptimizationProblem(
+          v0, a0, v_max_arr, interval_dist_arr, param, base_param);
+        const Eigen::MatrixXd P = problem.P.toDense();
+        const Eigen::MatrixXd A = problem.A.toDense();
+        dense_qp.optimize(P, A, problem.q, problem.lower_bound, problem.upper_bound);
+      }
+      const auto dense_end = std::chrono::system_clock::now();
+
+      const auto sparse_start = std::chrono::system_clock::now();
+      {
+        const auto problem = JerkFilteredSmoother::buildOptimizationProblem(
+          v0, a0, v_max_arr, interval_dist_arr, param, base_param);
+        sparse_qp.optimize(
+          problem.P, problem.A, problem.q, problem.lower_bound, problem.upper_bound);
+      }
+      const auto sparse_end = std::chrono::system_clock::now();
+
+      const auto warm_start = std::chrono::system_clock::now();
+      std::vector<double> solution;
+      {
+        const auto problem = JerkFilteredSmoother::buildOptimizationProblem(
+          v0, a0, v_max_arr, interval_dist_arr, param, base_param);
+        if (!prev_solution.empty()) {
+          // shift b and a of the previous solution by one point
+          std::vector<double> initial_guess(5 * N, 0.0);
+          for (size_t i = 0; i < N; ++i) {
+            const size_t j = std::min(i + 1, N - 1);
+            initial_guess.at(i) = prev_solution.at(j);
+            initial_guess.at(N + i) = prev_solution.at(N + j);
+          }
+          warm_qp.setPrimalInitialGuess(initial_guess);
+        }
+        solution = warm_qp.optimize(
+          problem.P, problem.A, problem.q, problem.lower_bound, problem.upper_bound);
+      }
+      const auto warm_end = std::chrono::system_clock::now();
+
+      dense_time += toMilliseconds(dense_start, dense_end);
+      sparse_time += toMilliseconds(sparse_start, sparse_end);
+      cold_iterations += sparse_qp.getIterationNumber();
+      if (cycle != 0) {
+        warm_time += toMilliseconds(warm_start, warm_end);
+        warm_iterations += warm_qp.getIterationNumber();
+      }
+
+      // follow the optimized velocity
+      v0 = std::sqrt(std::max(solution.at(1), 0.0));
+      a0 = solution.at(N + 1);
+      prev_solution = solution;
+    }
+
+    std::cout << N << ", " << dense_time / num_cycles << ", " << sparse_time / num_cycles << ", "
+              << warm_time / (num_cycles - 1) << ", "
+              << static_cast<double>(cold_iterations) / num_cycles << ", "
+              << static_cast<double>(warm_iterations) / (num_cycles - 1) << std::endl;
+  }
+  return 0;
+}
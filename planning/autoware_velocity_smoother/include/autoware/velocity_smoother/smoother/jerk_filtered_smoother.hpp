@@ -25,7 +25,10 @@
 
 #include "boost/optional.hpp"
 
+#include <Eigen/SparseCore>
+
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace autoware::velocity_smoother
@@ -40,6 +43,16 @@ public:
     double over_a_weight;
     double over_j_weight;
     double jerk_filter_ds;
+    bool enable_warm_start;  // only for an instance whose apply() is called with one path sequence
+  };
+
+  struct OptimizationProblem
+  {
+    Eigen::SparseMatrix<double> P;
+    Eigen::SparseMatrix<double> A;
+    std::vector<double> q;
+    std::vector<double> lower_bound;
+    std::vector<double> upper_bound;
   };
 
   explicit JerkFilteredSmoother(
@@ -58,9 +71,27 @@ public:
   void setParam(const Param & param);
   Param getParam() const;
 
+  /**
+   * @brief build the QP of the velocity optimization over the N points
+   * @param v_max_arr velocity limits of the N points
+   * @param interval_dist_arr distances between the points
+   */
+  static OptimizationProblem buildOptimizationProblem(
+    const double v0, const double a0, const std::vector<double> & v_max_arr,
+    const std::vector<double> & interval_dist_arr, const Param & smoother_param,
+    const BaseParam & base_param);
+
 private:
+  struct Solution
+  {
+    TrajectoryPoints points;
+    std::vector<double> b;  // velocity^2
+    std::vector<double> a;  // acceleration
+  };
+
   Param smoother_param_;
   std::shared_ptr<autoware::common::QPInterface> qp_interface_;
+  std::optional<Solution> prev_solution_{std::nullopt};
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   TrajectoryPoints forwardJerkFilter(
@@ -72,6 +103,8 @@ private:
   TrajectoryPoints mergeFilteredTrajectory(
     const double v0, const double a0, const double a_min, const double j_min,
     const TrajectoryPoints & forward_filtered, const TrajectoryPoints & backward_filtered) const;
+  std::optional<std::vector<double>> calcInitialGuess(
+    const double v0, const double a0, const TrajectoryPoints & trajectory, const size_t N) const;
 };
 }  // namespace autoware::velocity_smoother
 
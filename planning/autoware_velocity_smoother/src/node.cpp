@@ -106,7 +106,12 @@ void VelocitySmootherNode::setupSmoother(const double wheelbase)
 {
   switch (node_param_.algorithm_type) {
     case AlgorithmType::JERK_FILTERED: {
-      smoother_ = std::make_shared<JerkFilteredSmoother>(*this, time_keeper_);
+      auto jerk_filtered_smoother = std::make_shared<JerkFilteredSmoother>(*this, time_keeper_);
+      // this node is the only caller of its smoother, so that the previous solution can be reused
+      auto smoother_param = jerk_filtered_smoother->getParam();
+      smoother_param.enable_warm_start = declare_parameter<bool>("enable_warm_start");
+      jerk_filtered_smoother->setParam(smoother_param);
+      smoother_ = jerk_filtered_smoother;
 
       // Set Publisher for jerk filtered algorithm
       pub_forward_filtered_trajectory_ =
@@ -219,6 +224,7 @@ rcl_interfaces::msg::SetParametersResult VelocitySmootherNode::onParameter(
       update_param("over_a_weight", p.over_a_weight);
       update_param("over_j_weight", p.over_j_weight);
       update_param("jerk_filter_ds", p.jerk_filter_ds);
+      update_param_bool("enable_warm_start", p.enable_warm_start);
       std::dynamic_pointer_cast<JerkFilteredSmoother>(smoother_)->setParam(p);
       break;
     }
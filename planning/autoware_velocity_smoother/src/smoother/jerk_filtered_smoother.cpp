@@ -15,9 +15,11 @@
 #include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
 
 #include "autoware/velocity_smoother/trajectory_utils.hpp"
+#include "interpolation/linear_interpolation.hpp"
 #include "qp_interface/proxqp_interface.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -40,6 +42,9 @@ JerkFilteredSmoother::JerkFilteredSmoother(
   p.over_a_weight = node.declare_parameter<double>("over_a_weight");
   p.over_j_weight = node.declare_parameter<double>("over_j_weight");
   p.jerk_filter_ds = node.declare_parameter<double>("jerk_filter_ds");
+  // the warm start keeps the previous solution between the calls of apply(), which is wrong when
+  // the instance is shared by callers planning different paths, so that only its owner enables it
+  p.enable_warm_start = false;
 
   qp_interface_ =
     std::make_shared<autoware::common::ProxQPInterface>(false, 20000, 1.0e-8, 1.0e-6, false);
@@ -87,9 +92,6 @@ bool JerkFilteredSmoother::apply(
   const double a_stop_decel = base_param_.stop_decel;
   const double j_max = base_param_.max_jerk;
   const double j_min = base_param_.min_jerk;
-  const double over_j_weight = smoother_param_.over_j_weight;
-  const double over_v_weight = smoother_param_.over_v_weight;
-  const double over_a_weight = smoother_param_.over_a_weight;
 
   // jerk filter
   const auto forward_filtered =
@@ -162,6 +164,94 @@ bool JerkFilteredSmoother::apply(
   }
 
   time_keeper_->start_track("initOptimization");
+  const auto problem =
+    buildOptimizationProblem(v0, a0, v_max_arr, interval_dist_arr, smoother_param_, base_param_);
+  if (smoother_param_.enable_warm_start) {
+    const auto initial_guess = calcInitialGuess(v0, a0, opt_resampled_trajectory, N);
+    if (initial_guess) {
+      qp_interface_->setPrimalInitialGuess(*initial_guess);
+    }
+  }
+  time_keeper_->end_track("initOptimization");
+
+  // execute optimization
+  time_keeper_->start_track("optimize");
+  const auto optval = qp_interface_->optimize(
+    problem.P, problem.A, problem.q, problem.lower_bound, problem.upper_bound);
+  time_keeper_->end_track("optimize");
+  prev_solution_ = std::nullopt;
+  if (!qp_interface_->isSolved()) {
+    RCLCPP_WARN(logger_, "optimization failed : %s", qp_interface_->getStatus().c_str());
+    return false;
+  }
+
+  const auto has_nan =
+    std::any_of(optval.begin(), optval.end(), [](const auto v) { return std::isnan(v); });
+  if (has_nan) {
+    RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
+    return false;
+  }
+
+  const auto tf1 = std::chrono::system_clock::now();
+  const double dt_ms1 =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
+  RCLCPP_DEBUG(logger_, "optimization time = %f [ms]", dt_ms1);
+
+  // get velocity & acceleration
+  const size_t IDX_B0 = 0;
+  const size_t IDX_A0 = N;
+  for (size_t i = 0; i < N; ++i) {
+    double b = optval.at(IDX_B0 + i);
+    output.at(i).longitudinal_velocity_mps = std::sqrt(std::max(b, 0.0));
+    output.at(i).acceleration_mps2 = optval.at(IDX_A0 + i);
+  }
+
+  // keep the solution for the initial guess of the next optimization
+  prev_solution_ = Solution{
+    TrajectoryPoints(opt_resampled_trajectory.begin(), opt_resampled_trajectory.begin() + N),
+    std::vector<double>(optval.begin() + IDX_B0, optval.begin() + IDX_B0 + N),
+    std::vector<double>(optval.begin() + IDX_A0, optval.begin() + IDX_A0 + N)};
+  for (size_t i = N; i < output.size(); ++i) {
+    output.at(i).longitudinal_velocity_mps = 0.0;
+    output.at(i).acceleration_mps2 = a_stop_decel;
+  }
+
+  if (VERBOSE_TRAJECTORY_VELOCITY) {
+    const auto s_output = trajectory_utils::calcArclengthArray(output);
+
+    std::cerr << "\n\n" << std::endl;
+    for (size_t i = 0; i < N; ++i) {
+      const auto v_opt = output.at(i).longitudinal_velocity_mps;
+      const auto a_opt = output.at(i).acceleration_mps2;
+      const auto ds = i < interval_dist_arr.size() ? interval_dist_arr.at(i) : 0.0;
+      const auto v_rs = i < opt_resampled_trajectory.size()
+                          ? opt_resampled_trajectory.at(i).longitudinal_velocity_mps
+                          : 0.0;
+      RCLCPP_INFO(
+        logger_, "i =  %4lu | s: %5f | ds: %5f | rs: %9f | op_v: %10f | op_a: %10f |", i,
+        s_output.at(i), ds, v_rs, v_opt, a_opt);
+    }
+  }
+
+  return true;
+}
+
+JerkFilteredSmoother::OptimizationProblem JerkFilteredSmoother::buildOptimizationProblem(
+  const double v0, const double a0, const std::vector<double> & v_max_arr,
+  const std::vector<double> & interval_dist_arr, const Param & smoother_param,
+  const BaseParam & base_param)
+{
+  const size_t N = v_max_arr.size();
+
+  const double a_max = base_param.max_accel;
+  const double a_min = base_param.min_decel;
+  const double a_stop_decel = base_param.stop_decel;
+  const double j_max = base_param.max_jerk;
+  const double j_min = base_param.min_jerk;
+  const double over_j_weight = smoother_param.over_j_weight;
+  const double over_v_weight = smoother_param.over_v_weight;
+  const double over_a_weight = smoother_param.over_a_weight;
+
   /*
    * x = [
    *      b[0], b[1], ..., b[N],               : 0~N
@@ -185,14 +275,21 @@ bool JerkFilteredSmoother::apply(
   const uint32_t l_variables = 5 * N;
   const uint32_t l_constraints = 4 * N + 1;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
-
-  std::vector<double> lower_bound(l_constraints, 0.0);
-  std::vector<double> upper_bound(l_constraints, 0.0);
-
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
-  std::vector<double> q(l_variables, 0.0);
+  // NOTE: Each row of the constraints and the cost depends only on the neighboring points, so the
+  //       matrices are built from the O(N) non-zero elements instead of the dense (4N+1)x5N and
+  //       5Nx5N matrices.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(8 * N);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(7 * N);
+
+  OptimizationProblem problem;
+  auto & lower_bound = problem.lower_bound;
+  auto & upper_bound = problem.upper_bound;
+  auto & q = problem.q;
+  lower_bound.resize(l_constraints, 0.0);
+  upper_bound.resize(l_constraints, 0.0);
+  q.resize(l_variables, 0.0);
 
   /**************************************************************/
   /**************************************************************/
@@ -201,15 +298,16 @@ bool JerkFilteredSmoother::apply(
   /**************************************************************/
 
   // jerk: d(ai)/ds * v_ref -> minimize weight * ((a1 - a0) / ds * v_ref)^2 * ds
-  const double smooth_weight = smoother_param_.jerk_weight;
+  const double smooth_weight = smoother_param.jerk_weight;
   for (size_t i = 0; i < N - 1; ++i) {
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
     const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    const double weight = smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i, weight);
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i + 1, -weight);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i, -weight);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i + 1, weight);
   }
 
   // |v_max_i^2 - b_i|/v_max^2 -> minimize (-bi) * ds / v_max^2
@@ -222,9 +320,9 @@ bool JerkFilteredSmoother::apply(
       }
       q.at(IDX_B0 + i) += v_weight_term;
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+    P_triplets.emplace_back(IDX_DELTA0 + i, IDX_DELTA0 + i, over_v_weight);  // over velocity cost
+    P_triplets.emplace_back(IDX_SIGMA0 + i, IDX_SIGMA0 + i, over_a_weight);  // over accel cost
+    P_triplets.emplace_back(IDX_GAMMA0 + i, IDX_GAMMA0 + i, over_j_weight);  // over jerk cost
   }
 
   /**************************************************************/
@@ -245,16 +343,16 @@ bool JerkFilteredSmoother::apply(
 
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 1.0);       // b_i
+    A_triplets.emplace_back(constr_idx, IDX_DELTA0 + i, -1.0);  // -delta_i
     upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
     lower_bound[constr_idx] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);       // a_i
+    A_triplets.emplace_back(constr_idx, IDX_SIGMA0 + i, -1.0);  // -sigma_i
 
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
@@ -272,86 +370,86 @@ bool JerkFilteredSmoother::apply(
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
-    upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
-    lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -ref_vel);     // -a[i] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, ref_vel);  //  a[i+1] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_GAMMA0 + i, -ds);      // -gamma[i] * ds
+    upper_bound[constr_idx] = j_max * ds;                          //  jerk_max * ds
+    lower_bound[constr_idx] = j_min * ds;                          //  jerk_min * ds
   }
 
   // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, -1.0);                            // b(i)
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i + 1, 1.0);                         // b(i+1)
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -2.0 * interval_dist_arr.at(i));  // a(i) * ds
     upper_bound[constr_idx] = 0.0;
     lower_bound[constr_idx] = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
+    A_triplets.emplace_back(constr_idx, IDX_B0, 1.0);  // b0
     upper_bound[constr_idx] = v0 * v0;
     lower_bound[constr_idx] = v0 * v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
+    A_triplets.emplace_back(constr_idx, IDX_A0, 1.0);  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
     ++constr_idx;
   }
-  time_keeper_->end_track("initOptimization");
 
-  // execute optimization
-  time_keeper_->start_track("optimize");
-  const auto optval = qp_interface_->optimize(P, A, q, lower_bound, upper_bound);
-  time_keeper_->end_track("optimize");
-  if (!qp_interface_->isSolved()) {
-    RCLCPP_WARN(logger_, "optimization failed : %s", qp_interface_->getStatus().c_str());
-    return false;
-  }
+  // the duplicated elements of P are summed up, and the zero elements are removed as the dense
+  // matrices were converted by sparseView()
+  problem.P.resize(l_variables, l_variables);
+  problem.P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  problem.P.prune(0.0);
+  problem.A.resize(l_constraints, l_variables);
+  problem.A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  problem.A.prune(0.0);
 
-  const auto has_nan =
-    std::any_of(optval.begin(), optval.end(), [](const auto v) { return std::isnan(v); });
-  if (has_nan) {
-    RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
-    return false;
-  }
+  return problem;
+}
 
-  const auto tf1 = std::chrono::system_clock::now();
-  const double dt_ms1 =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
-  RCLCPP_DEBUG(logger_, "optimization time = %f [ms]", dt_ms1);
+std::optional<std::vector<double>> JerkFilteredSmoother::calcInitialGuess(
+  const double v0, const double a0, const TrajectoryPoints & trajectory, const size_t N) const
+{
+  autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
-  // get velocity & acceleration
-  for (size_t i = 0; i < N; ++i) {
-    double b = optval.at(IDX_B0 + i);
-    output.at(i).longitudinal_velocity_mps = std::sqrt(std::max(b, 0.0));
-    output.at(i).acceleration_mps2 = optval.at(IDX_A0 + i);
-  }
-  for (size_t i = N; i < output.size(); ++i) {
-    output.at(i).longitudinal_velocity_mps = 0.0;
-    output.at(i).acceleration_mps2 = a_stop_decel;
+  if (!prev_solution_ || prev_solution_->points.size() < 2) {
+    return std::nullopt;
   }
-
-  if (VERBOSE_TRAJECTORY_VELOCITY) {
-    const auto s_output = trajectory_utils::calcArclengthArray(output);
-
-    std::cerr << "\n\n" << std::endl;
-    for (size_t i = 0; i < N; ++i) {
-      const auto v_opt = output.at(i).longitudinal_velocity_mps;
-      const auto a_opt = output.at(i).acceleration_mps2;
-      const auto ds = i < interval_dist_arr.size() ? interval_dist_arr.at(i) : 0.0;
-      const auto v_rs = i < opt_resampled_trajectory.size()
-                          ? opt_resampled_trajectory.at(i).longitudinal_velocity_mps
-                          : 0.0;
-      RCLCPP_INFO(
-        logger_, "i =  %4lu | s: %5f | ds: %5f | rs: %9f | op_v: %10f | op_a: %10f |", i,
-        s_output.at(i), ds, v_rs, v_opt, a_opt);
+  const auto & prev_points = prev_solution_->points;
+  const auto & prev_b = prev_solution_->b;
+  const auto & prev_a = prev_solution_->a;
+
+  // the previous solution is shifted by the distance travelled since the previous cycle
+  const double travelled_dist = autoware::motion_utils::calcSignedArcLength(
+    prev_points, size_t{0}, trajectory.front().pose.position);
+  const auto prev_arclength = trajectory_utils::calcArclengthArray(prev_points);
+  const auto arclength = trajectory_utils::calcArclengthArray(trajectory);
+
+  const size_t IDX_B0 = 0;
+  const size_t IDX_A0 = N;
+  std::vector<double> initial_guess(5 * N, 0.0);  // the slack variables start from zero
+  size_t j = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const double s = std::clamp(
+      arclength.at(i) + travelled_dist, prev_arclength.front(), prev_arclength.back());
+    while (j + 2 < prev_arclength.size() && prev_arclength.at(j + 1) < s) {
+      ++j;
     }
+    const double ds = prev_arclength.at(j + 1) - prev_arclength.at(j);
+    const double ratio = ds < 1e-6 ? 0.0 : std::clamp((s - prev_arclength.at(j)) / ds, 0.0, 1.0);
+    initial_guess.at(IDX_B0 + i) = interpolation::lerp(prev_b.at(j), prev_b.at(j + 1), ratio);
+    initial_guess.at(IDX_A0 + i) = interpolation::lerp(prev_a.at(j), prev_a.at(j + 1), ratio);
   }
 
-  return true;
+  // the initial condition is known
+  initial_guess.at(IDX_B0) = v0 * v0;
+  initial_guess.at(IDX_A0) = a0;
+
+  return initial_guess;
 }
 
 TrajectoryPoints JerkFilteredSmoother::forwardJerkFilter(
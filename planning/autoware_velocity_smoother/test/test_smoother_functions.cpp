@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
 #include "autoware/velocity_smoother/trajectory_utils.hpp"
 
 #include <gtest/gtest.h>
@@ -61,3 +62,48 @@ TEST(TestTrajectoryUtils, CalcTrajectoryCurvatureFrom3Points)
     }
   }
 }
+
+TEST(TestJerkFilteredSmoother, BuildOptimizationProblem)
+{
+  using autoware::velocity_smoother::JerkFilteredSmoother;
+
+  JerkFilteredSmoother::BaseParam base_param{};
+  base_param.max_accel = 1.0;
+  base_param.min_decel = -0.5;
+  base_param.max_jerk = 1.0;
+  base_param.min_jerk = -0.5;
+  JerkFilteredSmoother::Param param{};
+  param.jerk_weight = 10.0;
+  param.over_v_weight = 100000.0;
+  param.over_a_weight = 5000.0;
+  param.over_j_weight = 2000.0;
+
+  for (const size_t N : {2, 10, 300}) {
+    std::vector<double> v_max_arr(N, 10.0);
+    v_max_arr.back() = 0.0;
+    const std::vector<double> interval_dist_arr(N - 1, 1.0);
+    const auto problem = JerkFilteredSmoother::buildOptimizationProblem(
+      3.0, 0.5, v_max_arr, interval_dist_arr, param, base_param);
+
+    const auto l_variables = static_cast<Eigen::Index>(5 * N);
+    const auto l_constraints = static_cast<Eigen::Index>(4 * N + 1);
+    EXPECT_EQ(problem.P.rows(), l_variables);
+    EXPECT_EQ(problem.P.cols(), l_variables);
+    EXPECT_EQ(problem.A.rows(), l_constraints);
+    EXPECT_EQ(problem.A.cols(), l_variables);
+    EXPECT_EQ(problem.q.size(), 5 * N);
+    EXPECT_EQ(problem.lower_bound.size(), 4 * N + 1);
+    EXPECT_EQ(problem.upper_bound.size(), 4 * N + 1);
+
+    // the number of the non-zero elements grows linearly
+    EXPECT_LE(problem.P.nonZeros(), static_cast<Eigen::Index>(7 * N));
+    EXPECT_LE(problem.A.nonZeros(), static_cast<Eigen::Index>(10 * N));
+    EXPECT_TRUE(problem.P.isApprox(Eigen::SparseMatrix<double>(problem.P.transpose())));
+
+    // initial condition
+    EXPECT_DOUBLE_EQ(problem.lower_bound.at(4 * N - 2), 9.0);
+    EXPECT_DOUBLE_EQ(problem.upper_bound.at(4 * N - 2), 9.0);
+    EXPECT_DOUBLE_EQ(problem.lower_bound.at(4 * N - 1), 0.5);
+    EXPECT_DOUBLE_EQ(problem.upper_bound.at(4 * N - 1), 0.5);
+  }
+}
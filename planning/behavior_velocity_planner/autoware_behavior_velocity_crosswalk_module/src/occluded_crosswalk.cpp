@@ -20,6 +20,7 @@
 #include <grid_map_ros/GridMapRosConverter.hpp>
 
 #include <algorithm>
+#include <optional>
 #include <vector>
 
 namespace autoware::behavior_velocity_planner
@@ -145,20 +146,35 @@ bool is_crosswalk_occluded(
 {
   grid_map::GridMap grid_map;
   grid_map::GridMapRosConverter::fromOccupancyGrid(occupancy_grid, "layer", grid_map);
+  return is_crosswalk_occluded(
+    crosswalk_lanelet, grid_map, path_intersection, detection_range, dynamic_objects, params);
+}
 
+bool is_crosswalk_occluded(
+  const lanelet::ConstLanelet & crosswalk_lanelet, const grid_map::GridMap & grid_map,
+  const geometry_msgs::msg::Point & path_intersection, const double detection_range,
+  const std::vector<autoware_perception_msgs::msg::PredictedObject> & dynamic_objects,
+  const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params)
+{
+  // the occlusions behind the objects are cleared on a copy as the grid map may be shared
+  std::optional<grid_map::GridMap> cleared_grid_map;
   if (params.occlusion_ignore_behind_predicted_objects) {
     const auto objects = select_and_inflate_objects(
       dynamic_objects, params.occlusion_ignore_velocity_thresholds,
       params.occlusion_extra_objects_size);
-    clear_occlusions_behind_objects(grid_map, objects);
+    cleared_grid_map = grid_map;
+    clear_occlusions_behind_objects(*cleared_grid_map, objects);
   }
-  const auto min_nb_of_cells = std::ceil(params.occlusion_min_size / grid_map.getResolution());
+  const auto & occlusion_grid_map = cleared_grid_map ? *cleared_grid_map : grid_map;
+  const auto min_nb_of_cells =
+    std::ceil(params.occlusion_min_size / occlusion_grid_map.getResolution());
   for (const auto & detection_area : calculate_detection_areas(
          crosswalk_lanelet, {path_intersection.x, path_intersection.y}, detection_range)) {
     grid_map::Polygon poly;
     for (const auto & p : detection_area) poly.addVertex(grid_map::Position(p.x(), p.y()));
-    for (autoware::grid_map_utils::PolygonIterator iter(grid_map, poly); !iter.isPastEnd(); ++iter)
-      if (is_occluded(grid_map, min_nb_of_cells, *iter, params)) return true;
+    for (autoware::grid_map_utils::PolygonIterator iter(occlusion_grid_map, poly);
+         !iter.isPastEnd(); ++iter)
+      if (is_occluded(occlusion_grid_map, min_nb_of_cells, *iter, params)) return true;
   }
   return false;
 }
@@ -64,6 +64,20 @@ bool is_crosswalk_occluded(
   const std::vector<autoware_perception_msgs::msg::PredictedObject> & dynamic_objects,
   const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params);
 
+/// @brief check if the crosswalk is occluded
+/// @param crosswalk_lanelet lanelet of the crosswalk
+/// @param grid_map occupancy grid converted to a grid map with a "layer" layer, left unchanged
+/// @param path_intersection intersection between the crosswalk and the ego path
+/// @param detection_range range away from the crosswalk until occlusions are considered
+/// @param dynamic_objects dynamic objects
+/// @param params parameters
+/// @return true if the crosswalk is occluded
+bool is_crosswalk_occluded(
+  const lanelet::ConstLanelet & crosswalk_lanelet, const grid_map::GridMap & grid_map,
+  const geometry_msgs::msg::Point & path_intersection, const double detection_range,
+  const std::vector<autoware_perception_msgs::msg::PredictedObject> & dynamic_objects,
+  const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params);
+
 /// @brief calculate the distance away from the crosswalk that should be checked for occlusions
 /// @param occluded_objects_velocity assumed velocity of the objects coming out of occlusions
 /// @param dist_ego_to_crosswalk distance between ego and the crosswalk
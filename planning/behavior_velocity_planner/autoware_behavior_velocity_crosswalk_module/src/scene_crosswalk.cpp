@@ -24,6 +24,7 @@
 #include <autoware/universe_utils/geometry/boost_geometry.hpp>
 #include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware/universe_utils/ros/uuid_helper.hpp>
+#include <grid_map_ros/GridMapRosConverter.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <lanelet2_core/geometry/LineString.h>
@@ -871,9 +872,16 @@ void CrosswalkModule::applySlowDownByOcclusion(
     const auto is_ego_on_the_crosswalk =
       dist_ego_to_crosswalk <= planner_data_->vehicle_info_.max_longitudinal_offset_m;
     if (!is_ego_on_the_crosswalk) {
+      // the conversion of the grid is shared by the crosswalk modules
+      const auto grid_map_ptr = planner_data_->getOccupancyGridProduct<grid_map::GridMap>(
+        "crosswalk_grid_map", [](const nav_msgs::msg::OccupancyGrid & occupancy_grid) {
+          grid_map::GridMap grid_map;
+          grid_map::GridMapRosConverter::fromOccupancyGrid(occupancy_grid, "layer", grid_map);
+          return grid_map;
+        });
       if (is_crosswalk_occluded(
-            crosswalk_, *planner_data_->occupancy_grid, first_path_point_on_crosswalk,
-            detection_range, objects_ptr->objects, planner_param_)) {
+            crosswalk_, *grid_map_ptr, first_path_point_on_crosswalk, detection_range,
+            objects_ptr->objects, planner_param_)) {
         if (!current_initial_occlusion_time_) current_initial_occlusion_time_ = now;
         if (cmp_with_time_buffer(current_initial_occlusion_time_, std::greater_equal<double>{}))
           most_recent_occlusion_time_ = now;
@@ -58,6 +58,12 @@ LineString2d DetectionAreaModule::getStopLineGeometry2d() const
     stop_line[0], stop_line[1], planner_data_->stop_line_extend_length);
 }
 
+void DetectionAreaModule::analyze([[maybe_unused]] const PathWithLaneId & path)
+{
+  // the search of the obstacle points does not depend on the path, and is the costly part
+  analyzed_obstacle_points_ = getObstaclePoints();
+}
+
 bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
 {
   // Store original path
@@ -69,7 +75,9 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
   *stop_reason = planning_utils::initializeStopReason(StopReason::DETECTION_AREA);
 
   // Find obstacles in detection area
-  const auto obstacle_points = getObstaclePoints();
+  const auto obstacle_points =
+    analyzed_obstacle_points_ ? std::move(*analyzed_obstacle_points_) : getObstaclePoints();
+  analyzed_obstacle_points_.reset();
   debug_data_.obstacle_points = obstacle_points;
   if (!obstacle_points.empty()) {
     last_obstacle_found_time_ = std::make_shared<const rclcpp::Time>(clock_->now());
@@ -18,6 +18,7 @@
 #include <boost/optional.hpp>
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -70,6 +71,9 @@ public:
     const PlannerParam & planner_param, const rclcpp::Logger logger,
     const rclcpp::Clock::SharedPtr clock);
 
+  void analyze(const PathWithLaneId & path) override;
+  bool hasAnalysis() const override { return true; }
+
   bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) override;
 
   visualization_msgs::msg::MarkerArray createDebugMarkerArray() override;
@@ -95,6 +99,9 @@ private:
   State state_;
   std::shared_ptr<const rclcpp::Time> last_obstacle_found_time_;
 
+  // Obstacle points found by analyze, used by the next modifyPathVelocity
+  std::optional<std::vector<geometry_msgs::msg::Point>> analyzed_obstacle_points_;
+
   // Parameter
   PlannerParam planner_param_;
 
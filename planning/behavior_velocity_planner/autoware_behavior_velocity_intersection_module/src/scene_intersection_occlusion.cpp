@@ -23,6 +23,7 @@
 
 #include <lanelet2_core/geometry/Polygon.h>
 
+#include <string>
 #include <tuple>
 
 namespace autoware::behavior_velocity_planner
@@ -205,24 +206,32 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
   // In OpenCV the pixel at (X=x, Y=y) (with left-upper origin) is accessed by img[y, x]
   // unknown: 255
   // not-unknown: 0
-  cv::Mat unknown_mask_raw(width, height, CV_8UC1, cv::Scalar(0));
-  cv::Mat unknown_mask(width, height, CV_8UC1, cv::Scalar(0));
-  for (int x = 0; x < width; x++) {
-    for (int y = 0; y < height; y++) {
-      const int idx = y * width + x;
-      const unsigned char intensity = occ_grid.data.at(idx);
-      if (
-        planner_param_.occlusion.free_space_max <= intensity &&
-        intensity < planner_param_.occlusion.occupied_min) {
-        unknown_mask_raw.at<unsigned char>(height - 1 - y, x) = 255;
-      }
-    }
-  }
-  // (2.1) apply morphologyEx
+  // NOTE: the mask only depends on the grid and the parameters, so it is shared by the modules
+  const int free_space_max = planner_param_.occlusion.free_space_max;
+  const int occupied_min = planner_param_.occlusion.occupied_min;
   const int morph_size = static_cast<int>(planner_param_.occlusion.denoise_kernel / resolution);
-  cv::morphologyEx(
-    unknown_mask_raw, unknown_mask, cv::MORPH_OPEN,
-    cv::getStructuringElement(cv::MORPH_RECT, cv::Size(morph_size, morph_size)));
+  const auto unknown_mask_ptr = planner_data_->getOccupancyGridProduct<cv::Mat>(
+    "intersection_unknown_mask_" + std::to_string(free_space_max) + "_" +
+      std::to_string(occupied_min) + "_" + std::to_string(morph_size),
+    [&](const nav_msgs::msg::OccupancyGrid & grid) {
+      cv::Mat unknown_mask_raw(width, height, CV_8UC1, cv::Scalar(0));
+      cv::Mat unknown_mask(width, height, CV_8UC1, cv::Scalar(0));
+      for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+          const int idx = y * width + x;
+          const unsigned char intensity = grid.data.at(idx);
+          if (free_space_max <= intensity && intensity < occupied_min) {
+            unknown_mask_raw.at<unsigned char>(height - 1 - y, x) = 255;
+          }
+        }
+      }
+      // (2.1) apply morphologyEx
+      cv::morphologyEx(
+        unknown_mask_raw, unknown_mask, cv::MORPH_OPEN,
+        cv::getStructuringElement(cv::MORPH_RECT, cv::Size(morph_size, morph_size)));
+      return unknown_mask;
+    });
+  const cv::Mat & unknown_mask = *unknown_mask_ptr;
 
   // (3) occlusion mask
   static constexpr unsigned char OCCLUDED = 255;
@@ -327,20 +327,30 @@ void toQuantizedImage(
   }
 }
 
-void denoiseOccupancyGridCV(
-  const OccupancyGrid::ConstSharedPtr occupancy_grid_ptr,
-  const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
-  grid_map::GridMap & grid_map, const GridParam & param, const bool is_show_debug_window,
-  const int num_iter, const bool use_object_footprints, const bool use_object_ray_casts)
+QuantizedImages toQuantizedImages(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid, const GridParam & param)
 {
-  OccupancyGrid occupancy_grid = *occupancy_grid_ptr;
-  cv::Mat border_image(
+  QuantizedImages images;
+  images.border_image = cv::Mat(
     occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1,
     cv::Scalar(grid_utils::occlusion_cost_value::FREE_SPACE));
-  cv::Mat occlusion_image(
+  images.occlusion_image = cv::Mat(
     occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1,
     cv::Scalar(grid_utils::occlusion_cost_value::FREE_SPACE));
-  toQuantizedImage(occupancy_grid, &border_image, &occlusion_image, param);
+  toQuantizedImage(occupancy_grid, &images.border_image, &images.occlusion_image, param);
+  return images;
+}
+
+void denoiseOccupancyGridCV(
+  const OccupancyGrid::ConstSharedPtr occupancy_grid_ptr, const QuantizedImages & quantized_images,
+  const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
+  grid_map::GridMap & grid_map, const bool is_show_debug_window, const int num_iter,
+  const bool use_object_footprints, const bool use_object_ray_casts)
+{
+  OccupancyGrid occupancy_grid = *occupancy_grid_ptr;
+  // the quantized images may be shared, so they are copied before drawing on them
+  cv::Mat border_image = quantized_images.border_image.clone();
+  cv::Mat occlusion_image = quantized_images.occlusion_image.clone();
 
   //! show original occupancy grid to compare difference
   if (is_show_debug_window) {
@@ -115,12 +115,21 @@ cv::Point toCVPoint(
   const Point & geom_point, const double width_m, const double height_m, const double resolution);
 void imageToOccupancyGrid(const cv::Mat & cv_image, nav_msgs::msg::OccupancyGrid * occupancy_grid);
 void toQuantizedImage(
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid, cv::Mat * cv_image, const GridParam & param);
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid, cv::Mat * border_image,
+  cv::Mat * occlusion_image, const GridParam & param);
+//!< @brief images of the occupied and of the unknown cells of an occupancy grid
+struct QuantizedImages
+{
+  cv::Mat border_image;
+  cv::Mat occlusion_image;
+};
+QuantizedImages toQuantizedImages(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid, const GridParam & param);
 void denoiseOccupancyGridCV(
-  const OccupancyGrid::ConstSharedPtr occupancy_grid_ptr,
+  const OccupancyGrid::ConstSharedPtr occupancy_grid_ptr, const QuantizedImages & quantized_images,
   const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
-  grid_map::GridMap & grid_map, const GridParam & param, const bool is_show_debug_window,
-  const int num_iter, const bool use_object_footprints, const bool use_object_ray_casts);
+  grid_map::GridMap & grid_map, const bool is_show_debug_window, const int num_iter,
+  const bool use_object_footprints, const bool use_object_ray_casts);
 }  // namespace grid_utils
 }  // namespace autoware::behavior_velocity_planner
 
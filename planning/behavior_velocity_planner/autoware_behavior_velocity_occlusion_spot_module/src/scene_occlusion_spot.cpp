@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 // turn on only when debugging.
@@ -163,9 +164,17 @@ bool OcclusionSpotModule::modifyPathVelocity(
     // find out occlusion from erode occlusion candidate num iter is strength of filter
     const int num_iter = static_cast<int>(
       (param_.detection_area.min_occlusion_spot_size / occ_grid_ptr->info.resolution) - 1);
+    const auto & grid_param = param_.grid;
+    const auto quantized_images =
+      planner_data_->getOccupancyGridProduct<grid_utils::QuantizedImages>(
+        "occlusion_spot_quantized_images_" + std::to_string(grid_param.free_space_max) + "_" +
+          std::to_string(grid_param.occupied_min),
+        [&grid_param](const nav_msgs::msg::OccupancyGrid & occupancy_grid) {
+          return grid_utils::toQuantizedImages(occupancy_grid, grid_param);
+        });
     grid_utils::denoiseOccupancyGridCV(
-      occ_grid_ptr, stuck_vehicle_foot_prints, moving_vehicle_foot_prints, grid_map, param_.grid,
-      param_.is_show_cv_window, num_iter, param_.use_object_info,
+      occ_grid_ptr, *quantized_images, stuck_vehicle_foot_prints, moving_vehicle_foot_prints,
+      grid_map, param_.is_show_cv_window, num_iter, param_.use_object_info,
       param_.use_moving_object_ray_cast);
     DEBUG_PRINT(show_time, "grid [ms]: ", stop_watch_.toc("processing_time", true));
     // Note: Don't consider offset from path start to ego here
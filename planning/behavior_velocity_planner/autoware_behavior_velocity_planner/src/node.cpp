@@ -288,6 +288,13 @@ bool BehaviorVelocityPlannerNode::processData(rclcpp::Clock clock)
   is_ready &= getData(planner_data_.current_acceleration, sub_acceleration_, "acceleration");
   is_ready &= getData(planner_data_.predicted_objects, sub_predicted_objects_, "predicted_objects");
   is_ready &= getData(planner_data_.occupancy_grid, sub_occupancy_grid_, "occupancy_grid");
+  if (
+    planner_data_.occupancy_grid &&
+    (!planner_data_.occupancy_grid_cache ||
+     planner_data_.occupancy_grid_cache->occupancy_grid() != planner_data_.occupancy_grid)) {
+    planner_data_.occupancy_grid_cache =
+      std::make_shared<const OccupancyGridCache>(planner_data_.occupancy_grid);
+  }
 
   const auto odometry = sub_vehicle_odometry_.takeData();
   if (odometry) {
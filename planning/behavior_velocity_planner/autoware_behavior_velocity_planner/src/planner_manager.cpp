@@ -16,8 +16,10 @@
 
 #include <boost/format.hpp>
 
+#include <exception>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace autoware::behavior_velocity_planner
 {
@@ -62,22 +64,30 @@ void BehaviorVelocityPlannerManager::launchScenePlugin(
     const auto plugin = plugin_loader_.createSharedInstance(name);
     plugin->init(node);
 
-    // Check if the plugin is already registered.
-    for (const auto & running_plugin : scene_manager_plugins_) {
-      if (plugin->getModuleName() == running_plugin->getModuleName()) {
-        RCLCPP_WARN_STREAM(node.get_logger(), "The plugin '" << name << "' is already loaded.");
-        return;
-      }
+    if (!registerScenePlugin(plugin)) {
+      RCLCPP_WARN_STREAM(node.get_logger(), "The plugin '" << name << "' is already loaded.");
+      return;
     }
-
-    // register
-    scene_manager_plugins_.push_back(plugin);
     RCLCPP_DEBUG_STREAM(node.get_logger(), "The scene plugin '" << name << "' is loaded.");
   } else {
     RCLCPP_ERROR_STREAM(node.get_logger(), "The scene plugin '" << name << "' is not available.");
   }
 }
 
+bool BehaviorVelocityPlannerManager::registerScenePlugin(
+  const std::shared_ptr<PluginInterface> & plugin)
+{
+  // Check if the plugin is already registered.
+  for (const auto & running_plugin : scene_manager_plugins_) {
+    if (std::string(plugin->getModuleName()) == running_plugin->getModuleName()) {
+      return false;
+    }
+  }
+
+  scene_manager_plugins_.push_back(plugin);
+  return true;
+}
+
 void BehaviorVelocityPlannerManager::removeScenePlugin(
   rclcpp::Node & node, const std::string & name)
 {
@@ -108,6 +118,34 @@ tier4_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager::planPat
 
   for (const auto & plugin : scene_manager_plugins_) {
     plugin->updateSceneModuleInstances(planner_data, input_path_msg);
+  }
+
+  // the analyses only read the input path, so the plugins having one run them concurrently before
+  // the path is modified by each plugin in turn
+  std::vector<std::shared_ptr<PluginInterface>> analyzing_plugins;
+  for (const auto & plugin : scene_manager_plugins_) {
+    if (plugin->hasAnalysis()) {
+      analyzing_plugins.push_back(plugin);
+    }
+  }
+  if (!analyzing_plugins.empty()) {
+    std::vector<std::exception_ptr> analysis_exceptions(analyzing_plugins.size());
+#pragma omp parallel for schedule(dynamic, 1) if (analyzing_plugins.size() > 1)
+    for (size_t i = 0; i < analyzing_plugins.size(); ++i) {
+      try {
+        analyzing_plugins[i]->analyze(input_path_msg);
+      } catch (...) {
+        analysis_exceptions[i] = std::current_exception();
+      }
+    }
+    for (const auto & analysis_exception : analysis_exceptions) {
+      if (analysis_exception) {
+        std::rethrow_exception(analysis_exception);
+      }
+    }
+  }
+
+  for (const auto & plugin : scene_manager_plugins_) {
     plugin->plan(&output_path_msg);
     const auto firstStopPathPointIndex = plugin->getFirstStopPathPointIndex();
 
@@ -44,6 +44,11 @@ class BehaviorVelocityPlannerManager
 public:
   BehaviorVelocityPlannerManager();
   void launchScenePlugin(rclcpp::Node & node, const std::string & name);
+  /**
+   * @brief register an initialized plugin, which plans after the registered ones
+   * @return false if a plugin of the same module name is already registered
+   */
+  bool registerScenePlugin(const std::shared_ptr<PluginInterface> & plugin);
   void removeScenePlugin(rclcpp::Node & node, const std::string & name);
 
   tier4_planning_msgs::msg::PathWithLaneId planPathVelocity(
@@ -0,0 +1,161 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "planner_manager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::behavior_velocity_planner::BehaviorVelocityPlannerManager;
+using autoware::behavior_velocity_planner::PlannerData;
+using autoware::behavior_velocity_planner::PluginInterface;
+using tier4_planning_msgs::msg::PathWithLaneId;
+
+namespace
+{
+// calls of the plugins, in the order they are made
+class CallLog
+{
+public:
+  void add(const std::string & call)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls_.push_back(call);
+  }
+  std::vector<std::string> calls() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return calls_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::string> calls_;
+};
+
+class FakePlugin : public PluginInterface
+{
+public:
+  FakePlugin(
+    std::string name, const bool has_analysis, CallLog & log, const bool throws_in_analyze = false)
+  : name_(std::move(name)),
+    has_analysis_(has_analysis),
+    throws_in_analyze_(throws_in_analyze),
+    log_(log)
+  {
+  }
+
+  void init(rclcpp::Node &) override {}
+  void updateSceneModuleInstances(
+    const std::shared_ptr<const PlannerData> &, const PathWithLaneId &) override
+  {
+    log_.add("update " + name_);
+  }
+  void analyze(const PathWithLaneId & path) override
+  {
+    log_.add("analyze " + name_);
+    if (throws_in_analyze_) {
+      throw std::runtime_error(name_ + " failed");
+    }
+    analyzed_path_size_ = path.points.size();
+  }
+  bool hasAnalysis() const override { return has_analysis_; }
+  void plan(PathWithLaneId * path) override
+  {
+    log_.add("plan " + name_);
+    // the next plugins receive the path modified by this one
+    path->points.push_back(path->points.back());
+  }
+  std::optional<int> getFirstStopPathPointIndex() override { return std::nullopt; }
+  const char * getModuleName() override { return name_.c_str(); }
+
+  std::optional<size_t> analyzed_path_size_;
+
+private:
+  std::string name_;
+  bool has_analysis_;
+  bool throws_in_analyze_;
+  CallLog & log_;
+};
+
+PathWithLaneId createPath()
+{
+  PathWithLaneId path;
+  path.points.resize(3);
+  for (size_t i = 0; i < path.points.size(); ++i) {
+    path.points.at(i).point.pose.position.x = static_cast<double>(i);
+  }
+  return path;
+}
+}  // namespace
+
+TEST(BehaviorVelocityPlannerManager, analyzeBeforePlan)
+{
+  CallLog log;
+  BehaviorVelocityPlannerManager manager;
+  const auto plugin_a = std::make_shared<FakePlugin>("a", true, log);
+  const auto plugin_b = std::make_shared<FakePlugin>("b", false, log);
+  const auto plugin_c = std::make_shared<FakePlugin>("c", true, log);
+  EXPECT_TRUE(manager.registerScenePlugin(plugin_a));
+  EXPECT_TRUE(manager.registerScenePlugin(plugin_b));
+  EXPECT_TRUE(manager.registerScenePlugin(plugin_c));
+  EXPECT_FALSE(manager.registerScenePlugin(std::make_shared<FakePlugin>("a", true, log)));
+
+  const auto path = createPath();
+  const auto output_path = manager.planPathVelocity(nullptr, path);
+  EXPECT_EQ(output_path.points.size(), path.points.size() + 3);
+
+  // the analyses run on the input path after all updates, in any order, and before any plan
+  const auto calls = log.calls();
+  ASSERT_EQ(calls.size(), 8U);
+  EXPECT_EQ(
+    std::vector<std::string>(calls.begin(), calls.begin() + 3),
+    (std::vector<std::string>{"update a", "update b", "update c"}));
+  std::vector<std::string> analyses(calls.begin() + 3, calls.begin() + 5);
+  std::sort(analyses.begin(), analyses.end());
+  EXPECT_EQ(analyses, (std::vector<std::string>{"analyze a", "analyze c"}));
+  EXPECT_EQ(
+    std::vector<std::string>(calls.begin() + 5, calls.end()),
+    (std::vector<std::string>{"plan a", "plan b", "plan c"}));
+  EXPECT_EQ(plugin_a->analyzed_path_size_, path.points.size());
+  EXPECT_EQ(plugin_c->analyzed_path_size_, path.points.size());
+  EXPECT_FALSE(plugin_b->analyzed_path_size_);
+}
+
+TEST(BehaviorVelocityPlannerManager, analysisExceptionIsRethrown)
+{
+  CallLog log;
+  BehaviorVelocityPlannerManager manager;
+  manager.registerScenePlugin(std::make_shared<FakePlugin>("a", true, log));
+  manager.registerScenePlugin(std::make_shared<FakePlugin>("b", true, log, true));
+  manager.registerScenePlugin(std::make_shared<FakePlugin>("c", true, log));
+
+  EXPECT_THROW(manager.planPathVelocity(nullptr, createPath()), std::runtime_error);
+
+  // the other analyses are completed, and no plugin plans
+  const auto calls = log.calls();
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), "analyze a"), 1);
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), "analyze c"), 1);
+  for (const auto & call : calls) {
+    EXPECT_NE(call.rfind("plan ", 0), 0U) << call;
+  }
+}
@@ -17,6 +17,7 @@
 
 #include "autoware/route_handler/route_handler.hpp"
 
+#include <autoware/behavior_velocity_planner_common/utilization/occupancy_grid_cache.hpp>
 #include <autoware/behavior_velocity_planner_common/utilization/util.hpp>
 #include <autoware/velocity_smoother/smoother/smoother_base.hpp>
 #include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
@@ -43,6 +44,8 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::behavior_velocity_planner
@@ -70,6 +73,8 @@ struct PlannerData
   pcl::PointCloud<pcl::PointXYZ>::ConstPtr no_ground_pointcloud;
   // occupancy grid
   nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid;
+  // products of occupancy_grid shared by the modules, renewed with the grid
+  std::shared_ptr<const OccupancyGridCache> occupancy_grid_cache;
 
   // nearest search
   double ego_nearest_dist_threshold;
@@ -88,8 +93,13 @@ struct PlannerData
   bool is_simulation = false;
 
   // velocity smoother
+  // NOTE: not thread safe although reached through const PlannerData, as the smoothers keep the
+  // state of their solver between the calls. It must not be used in SceneModuleInterface::analyze.
   std::shared_ptr<autoware::velocity_smoother::SmootherBase> velocity_smoother_;
   // route handler
+  // NOTE: not thread safe although reached through const PlannerData, as the lanelets fill their
+  // geometry caches (e.g. centerline, polygon) lazily without a lock. It must not be used, nor the
+  // lanelets of its map, in SceneModuleInterface::analyze.
   std::shared_ptr<autoware::route_handler::RouteHandler> route_handler_;
   // parameters
   autoware::vehicle_info_utils::VehicleInfo vehicle_info_;
@@ -147,6 +157,22 @@ struct PlannerData
     }
     return std::make_optional<TrafficSignalStamped>(traffic_light_id_map.at(id));
   }
+
+  /**
+   *@fn
+   *@brief returns the product of occupancy_grid computed by compute(*occupancy_grid), which is
+   *computed at most once per grid and shared by the modules. The key should contain the parameters
+   *used by compute
+   */
+  template <class T, class ComputeFunc>
+  std::shared_ptr<const T> getOccupancyGridProduct(
+    const std::string & key, ComputeFunc && compute) const
+  {
+    if (!occupancy_grid_cache || occupancy_grid_cache->occupancy_grid() != occupancy_grid) {
+      return std::make_shared<const T>(compute(*occupancy_grid));
+    }
+    return occupancy_grid_cache->getOrCompute<T>(key, std::forward<ComputeFunc>(compute));
+  }
 };
 }  // namespace autoware::behavior_velocity_planner
 
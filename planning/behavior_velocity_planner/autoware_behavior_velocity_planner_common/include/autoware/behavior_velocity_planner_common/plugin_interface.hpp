@@ -31,6 +31,8 @@ public:
   virtual ~PluginInterface() = default;
   virtual void init(rclcpp::Node & node) = 0;
   virtual void plan(tier4_planning_msgs::msg::PathWithLaneId * path) = 0;
+  virtual void analyze([[maybe_unused]] const tier4_planning_msgs::msg::PathWithLaneId & path) {}
+  virtual bool hasAnalysis() const { return false; }
   virtual void updateSceneModuleInstances(
     const std::shared_ptr<const PlannerData> & planner_data,
     const tier4_planning_msgs::msg::PathWithLaneId & path) = 0;
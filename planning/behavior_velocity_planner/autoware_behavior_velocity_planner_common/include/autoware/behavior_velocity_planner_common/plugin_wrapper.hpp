@@ -32,6 +32,11 @@ public:
   {
     scene_manager_->plan(path);
   };
+  void analyze(const tier4_planning_msgs::msg::PathWithLaneId & path) override
+  {
+    scene_manager_->analyze(path);
+  }
+  bool hasAnalysis() const override { return scene_manager_->hasAnalysis(); }
   void updateSceneModuleInstances(
     const std::shared_ptr<const PlannerData> & planner_data,
     const tier4_planning_msgs::msg::PathWithLaneId & path) override
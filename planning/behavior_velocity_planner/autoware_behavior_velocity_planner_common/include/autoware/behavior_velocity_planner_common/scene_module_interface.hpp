@@ -88,6 +88,19 @@ public:
 
   virtual bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) = 0;
 
+  /**
+   * @brief optional analysis of the path given to the planner, run before modifyPathVelocity on
+   * which it only keeps its results. Modules overriding it also override hasAnalysis.
+   * @details the analyses of the modules of different managers run concurrently, so that:
+   * - it may only read the path and the planner data, except velocity_smoother_ and
+   *   route_handler_ (and the lanelets of its map) whose lazily updated state is not thread safe.
+   * - the results are expressed as arc lengths or positions, not as path indices, since
+   *   modifyPathVelocity receives the path after the modules planned before it inserted points.
+   * - it must not depend on the activation, which is updated afterwards.
+   */
+  virtual void analyze([[maybe_unused]] const PathWithLaneId & path) {}
+  virtual bool hasAnalysis() const { return false; }
+
   virtual visualization_msgs::msg::MarkerArray createDebugMarkerArray() = 0;
   virtual std::vector<autoware::motion_utils::VirtualWall> createVirtualWalls() = 0;
 
@@ -181,6 +194,17 @@ public:
 
   virtual void plan(tier4_planning_msgs::msg::PathWithLaneId * path) { modifyPathVelocity(path); }
 
+  /**
+   * @brief run the analysis of the modules on the path given to the planner, before plan. It may
+   * run concurrently with the analysis of the other managers
+   */
+  virtual void analyze(const tier4_planning_msgs::msg::PathWithLaneId & path);
+
+  /**
+   * @brief whether one of the modules has an analysis, analyze doing nothing otherwise
+   */
+  bool hasAnalysis() const;
+
 protected:
   virtual void modifyPathVelocity(tier4_planning_msgs::msg::PathWithLaneId * path);
 
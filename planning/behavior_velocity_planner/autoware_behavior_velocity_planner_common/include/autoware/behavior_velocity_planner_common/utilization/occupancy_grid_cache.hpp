@@ -0,0 +1,89 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_CACHE_HPP_
+#define AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_CACHE_HPP_
+
+#include <nav_msgs/msg/occupancy_grid.hpp>
+
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+namespace autoware::behavior_velocity_planner
+{
+/**
+ * @brief products derived from one occupancy grid, such as the images of its unknown cells,
+ * computed at most once and shared by the scene modules. A product is identified by its type and
+ * by a key, which should contain the parameters it is computed with.
+ */
+class OccupancyGridCache
+{
+public:
+  explicit OccupancyGridCache(nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid)
+  : occupancy_grid_(std::move(occupancy_grid))
+  {
+  }
+
+  const nav_msgs::msg::OccupancyGrid::ConstSharedPtr & occupancy_grid() const
+  {
+    return occupancy_grid_;
+  }
+
+  /**
+   * @brief return the product of the given key, computed by compute(occupancy_grid) for the first
+   * call. The concurrent calls for the same product wait for it instead of computing it again.
+   */
+  template <class T, class ComputeFunc>
+  std::shared_ptr<const T> getOrCompute(const std::string & key, ComputeFunc && compute) const
+  {
+    std::shared_future<std::shared_ptr<const void>> product;
+    std::optional<std::promise<std::shared_ptr<const void>>> promise;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto product_key = std::make_pair(std::type_index(typeid(T)), key);
+      auto it = products_.find(product_key);
+      if (it == products_.end()) {
+        promise.emplace();
+        it = products_.emplace(product_key, promise->get_future().share()).first;
+      }
+      product = it->second;
+    }
+    // computed out of the lock so that the other products can be accessed meanwhile
+    if (promise) {
+      try {
+        promise->set_value(std::make_shared<const T>(compute(*occupancy_grid_)));
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    }
+    return std::static_pointer_cast<const T>(product.get());
+  }
+
+private:
+  nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid_;
+  mutable std::mutex mutex_;
+  mutable std::map<
+    std::pair<std::type_index, std::string>, std::shared_future<std::shared_ptr<const void>>>
+    products_;
+};
+}  // namespace autoware::behavior_velocity_planner
+
+#endif  // AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_CACHE_HPP_
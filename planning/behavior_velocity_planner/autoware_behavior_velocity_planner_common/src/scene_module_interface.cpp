@@ -99,6 +99,29 @@ void SceneModuleManagerInterface::updateSceneModuleInstances(
   deleteExpiredModules(path);
 }
 
+bool SceneModuleManagerInterface::hasAnalysis() const
+{
+  return std::any_of(
+    scene_modules_.begin(), scene_modules_.end(),
+    [](const auto & scene_module) { return scene_module->hasAnalysis(); });
+}
+
+void SceneModuleManagerInterface::analyze(const tier4_planning_msgs::msg::PathWithLaneId & path)
+{
+  // no time track without analysis, as it would publish the processing time of nothing
+  if (!hasAnalysis()) {
+    return;
+  }
+  universe_utils::ScopedTimeTrack st("SceneModuleManagerInterface::analyze", *time_keeper_);
+  for (const auto & scene_module : scene_modules_) {
+    if (!scene_module->hasAnalysis()) {
+      continue;
+    }
+    scene_module->setPlannerData(planner_data_);
+    scene_module->analyze(path);
+  }
+}
+
 void SceneModuleManagerInterface::modifyPathVelocity(
   tier4_planning_msgs::msg::PathWithLaneId * path)
 {
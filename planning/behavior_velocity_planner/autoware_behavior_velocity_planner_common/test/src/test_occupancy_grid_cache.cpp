@@ -0,0 +1,102 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/behavior_velocity_planner_common/utilization/occupancy_grid_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using autoware::behavior_velocity_planner::OccupancyGridCache;
+using nav_msgs::msg::OccupancyGrid;
+
+namespace
+{
+OccupancyGrid::ConstSharedPtr createGrid()
+{
+  auto grid = std::make_shared<OccupancyGrid>();
+  grid->info.width = 3;
+  grid->info.height = 2;
+  grid->data = {0, 50, 100, 50, 50, 0};
+  return grid;
+}
+
+int countUnknownCells(const OccupancyGrid & grid)
+{
+  int count = 0;
+  for (const auto value : grid.data) {
+    count += value == 50;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(occupancy_grid_cache, compute_once_per_key)
+{
+  const OccupancyGridCache cache(createGrid());
+  int num_computations = 0;
+  const auto compute = [&](const OccupancyGrid & grid) {
+    ++num_computations;
+    return countUnknownCells(grid);
+  };
+  const auto first = cache.getOrCompute<int>("unknown", compute);
+  const auto second = cache.getOrCompute<int>("unknown", compute);
+  EXPECT_EQ(*first, 3);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(num_computations, 1);
+
+  // another key or another type is another product
+  cache.getOrCompute<int>("unknown_2", compute);
+  EXPECT_EQ(num_computations, 2);
+  const auto as_double = cache.getOrCompute<double>(
+    "unknown", [](const OccupancyGrid & grid) { return countUnknownCells(grid) * 0.5; });
+  EXPECT_DOUBLE_EQ(*as_double, 1.5);
+}
+
+TEST(occupancy_grid_cache, concurrent_access)
+{
+  const OccupancyGridCache cache(createGrid());
+  std::atomic<int> num_computations{0};
+  std::vector<std::shared_ptr<const int>> results(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = cache.getOrCompute<int>("unknown", [&](const OccupancyGrid & grid) {
+        ++num_computations;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return countUnknownCells(grid);
+      });
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(num_computations, 1);
+  for (const auto & result : results) {
+    EXPECT_EQ(result, results.front());
+  }
+}
+
+TEST(occupancy_grid_cache, exception_is_rethrown)
+{
+  const OccupancyGridCache cache(createGrid());
+  const auto compute = [](const OccupancyGrid &) -> int { throw std::runtime_error("failed"); };
+  EXPECT_THROW(cache.getOrCompute<int>("failing", compute), std::runtime_error);
+  EXPECT_THROW(cache.getOrCompute<int>("failing", compute), std::runtime_error);
+}
@@ -38,6 +38,20 @@ const Eigen::Matrix<double, 4, 6> quintic_bezier_acceleration_coefficients(
    quintic_bezier_velocity_coefficients.row(4) * 4)
     .finished());
 
+/// @brief bezier coefficients multiplied by the powers of some values of the parameter t
+/// @details one row per value of t. The curves sampled at the same values of t share this basis and
+/// are evaluated at all these values with one matrix product
+struct BezierBasis
+{
+  Eigen::Matrix<double, Eigen::Dynamic, 6> value;
+  Eigen::Matrix<double, Eigen::Dynamic, 6> velocity;
+  Eigen::Matrix<double, Eigen::Dynamic, 6> acceleration;
+
+  /// @brief constructor from the values of the parameter t
+  explicit BezierBasis(const std::vector<double> & ts);
+  [[nodiscard]] Eigen::Index size() const { return value.rows(); }
+};
+
 /// @brief Quintic Bezier curve
 class Bezier
 {
@@ -69,6 +83,12 @@ public:
   [[nodiscard]] double heading(const double t) const;
   /// @brief calculate the curvature for the given parameter t
   [[nodiscard]] double curvature(const double t) const;
+  /// @brief calculate the curve values at the parameters of the basis (one row per parameter)
+  [[nodiscard]] Eigen::Matrix<double, Eigen::Dynamic, 2> values(const BezierBasis & basis) const;
+  /// @brief return the headings (in radians) of the tangent at the parameters of the basis
+  [[nodiscard]] std::vector<double> headings(const BezierBasis & basis) const;
+  /// @brief calculate the curvatures at the parameters of the basis
+  [[nodiscard]] std::vector<double> curvatures(const BezierBasis & basis) const;
 };
 }  // namespace autoware::bezier_sampler
 
@@ -14,10 +14,25 @@
 
 #include <autoware_bezier_sampler/bezier.hpp>
 
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace autoware::bezier_sampler
 {
+BezierBasis::BezierBasis(const std::vector<double> & ts)
+{
+  const auto nb_ts = static_cast<Eigen::Index>(ts.size());
+  Eigen::Matrix<double, Eigen::Dynamic, 6> powers(nb_ts, 6);
+  for (Eigen::Index i = 0; i < nb_ts; ++i) {
+    const double t = ts[i];
+    powers.row(i) << 1, t, t * t, t * t * t, t * t * t * t, t * t * t * t * t;
+  }
+  value = powers * quintic_bezier_coefficients;
+  velocity = powers.leftCols<5>() * quintic_bezier_velocity_coefficients;
+  acceleration = powers.leftCols<4>() * quintic_bezier_acceleration_coefficients;
+}
+
 Bezier::Bezier(Eigen::Matrix<double, 6, 2> control_points)
 : control_points_(std::move(control_points))
 {
@@ -117,4 +132,39 @@ double Bezier::heading(const double t) const
   return std::atan2(vel.y(), vel.x());
 }
 
+Eigen::Matrix<double, Eigen::Dynamic, 2> Bezier::values(const BezierBasis & basis) const
+{
+  return basis.value * control_points_;
+}
+
+std::vector<double> Bezier::headings(const BezierBasis & basis) const
+{
+  const Eigen::Matrix<double, Eigen::Dynamic, 2> velocities = basis.velocity * control_points_;
+  std::vector<double> headings;
+  headings.reserve(velocities.rows());
+  for (Eigen::Index i = 0; i < velocities.rows(); ++i)
+    headings.push_back(std::atan2(velocities(i, 1), velocities(i, 0)));
+  return headings;
+}
+
+std::vector<double> Bezier::curvatures(const BezierBasis & basis) const
+{
+  const Eigen::Matrix<double, Eigen::Dynamic, 2> velocities = basis.velocity * control_points_;
+  const Eigen::Matrix<double, Eigen::Dynamic, 2> accelerations =
+    basis.acceleration * control_points_;
+  std::vector<double> curvatures;
+  curvatures.reserve(velocities.rows());
+  for (Eigen::Index i = 0; i < velocities.rows(); ++i) {
+    // same as curvature(t)
+    const double vel_x = velocities(i, 0);
+    const double vel_y = velocities(i, 1);
+    double curvature = std::numeric_limits<double>::infinity();
+    const double denominator = std::pow(vel_x * vel_x + vel_y * vel_y, 3.0 / 2.0);
+    if (denominator != 0)
+      curvature = (vel_x * accelerations(i, 1) - accelerations(i, 0) * vel_y) / denominator;
+    curvatures.push_back(curvature);
+  }
+  return curvatures;
+}
+
 }  // namespace autoware::bezier_sampler
@@ -16,6 +16,7 @@
 #define AUTOWARE_FRENET_PLANNER__FRENET_PLANNER_HPP_
 
 #include "autoware/universe_utils/geometry/geometry.hpp"
+#include "autoware_frenet_planner/polynomials.hpp"
 #include "autoware_frenet_planner/structures.hpp"
 #include "autoware_sampler_common/structures.hpp"
 #include "autoware_sampler_common/transform/spline_transform.hpp"
@@ -45,12 +46,23 @@ std::vector<Path> generatePaths(
 /// (s): d(s).
 Path generateCandidate(
   const FrenetState & initial_state, const FrenetState & target_state, const double s_resolution);
+/// @brief generate a candidate path sampled at the arc lengths of the grid lower or equal to its
+/// target arc length
+/// @details the arc lengths of the grid are relative to the initial state
+Path generateCandidate(
+  const FrenetState & initial_state, const FrenetState & target_state,
+  const PolynomialGrid & s_grid);
 /// @brief generate a candidate trajectory
 /// @details the polynomials for lateral motion (d) and longitudinal motion (s) are calculated over
 /// time: d(t) and s(t).
 Trajectory generateCandidate(
   const FrenetState & initial_state, const FrenetState & target_state, const double duration,
   const double time_resolution);
+/// @brief generate a candidate trajectory sampled at the times of the grid lower or equal to its
+/// duration
+Trajectory generateCandidate(
+  const FrenetState & initial_state, const FrenetState & target_state, const double duration,
+  const PolynomialGrid & time_grid);
 /// @brief generate a low velocity candidate trajectory
 /// @details the polynomial for lateral motion (d) is calculated over the longitudinal displacement
 /// (s) rather than over time: d(s) and s(t).
@@ -60,6 +72,10 @@ Trajectory generateLowVelocityCandidate(
 /// @brief calculate the cartesian frame of the given path
 void calculateCartesian(
   const autoware::sampler_common::transform::Spline2D & reference, Path & path);
+/// @brief calculate the cartesian frame of the given path whose i-th frenet point is at the i-th
+/// arc length of the lookup table
+void calculateCartesian(
+  const autoware::sampler_common::transform::SplineLookupTable & reference, Path & path);
 /// @brief calculate the cartesian frame of the given trajectory
 void calculateCartesian(
   const autoware::sampler_common::transform::Spline2D & reference, Trajectory & trajectory);
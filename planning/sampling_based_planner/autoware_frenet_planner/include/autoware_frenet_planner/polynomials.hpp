@@ -15,8 +15,27 @@
 #ifndef AUTOWARE_FRENET_PLANNER__POLYNOMIALS_HPP_
 #define AUTOWARE_FRENET_PLANNER__POLYNOMIALS_HPP_
 
+#include <cstddef>
+#include <vector>
+
 namespace autoware::frenet_planner
 {
+/// @brief powers of the parameter values (time or arc length) of a sampling grid
+/// @details stored as one vector per power so that the polynomials of all the candidates sampled on
+/// the same grid reuse them
+struct PolynomialGrid
+{
+  std::vector<double> t{};
+  std::vector<double> t2{};
+  std::vector<double> t3{};
+  std::vector<double> t4{};
+  std::vector<double> t5{};
+
+  PolynomialGrid() = default;
+  explicit PolynomialGrid(const std::vector<double> & values);
+  [[nodiscard]] size_t size() const { return t.size(); }
+};
+
 class Polynomial
 {
   /// @brief polynomial coefficients
@@ -49,6 +68,12 @@ public:
   [[nodiscard]] double acceleration(const double t) const;
   /// @brief Get the jerk at the given time
   [[nodiscard]] double jerk(const double t) const;
+  /// @brief Get the position at the i-th value of the given grid
+  [[nodiscard]] double position(const PolynomialGrid & grid, const size_t i) const
+  {
+    return a_ * grid.t5[i] + b_ * grid.t4[i] + c_ * grid.t3[i] + d_ * grid.t2[i] +
+           e_ * grid.t[i] + f_;
+  }
 };
 }  // namespace autoware::frenet_planner
 
@@ -30,19 +30,81 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <iterator>
 
 namespace autoware::frenet_planner
 {
+namespace
+{
+/// @brief sampled values from start to end, accumulated like the sampling loops of the candidates
+std::vector<double> sampleGrid(const double start, const double end, const double resolution)
+{
+  std::vector<double> values;
+  for (double value = start; value <= end; value += resolution) values.push_back(value);
+  return values;
+}
+
+/// @brief number of grid values lower or equal to the given end, which are the values that a
+/// candidate ending at this value samples
+size_t countGridValues(const PolynomialGrid & grid, const double end)
+{
+  return std::distance(grid.t.begin(), std::upper_bound(grid.t.begin(), grid.t.end(), end));
+}
+
+/// @brief calculate the yaws, lengths, poses, and curvatures from the cartesian points of the path
+void calculateYawsAndCurvatures(Path & path)
+{
+  if (!path.points.empty()) {
+    path.yaws.reserve(path.points.size());
+    path.lengths.reserve(path.points.size());
+    path.curvatures.reserve(path.points.size());
+    path.poses.reserve(path.points.size());
+    // TODO(Maxime CLEMENT): more precise calculations are proposed in Appendix I of the paper:
+    // Optimal path Generation for Dynamic Street Scenarios in a Frenet Frame (Werling2010)
+    // Calculate cartesian yaw and interval values
+    path.lengths.push_back(0.0);
+    for (auto it = path.points.begin(); it != std::prev(path.points.end()); ++it) {
+      const auto dx = std::next(it)->x() - it->x();
+      const auto dy = std::next(it)->y() - it->y();
+      const auto yaw = std::atan2(dy, dx);
+      path.yaws.push_back(yaw);
+      path.lengths.push_back(path.lengths.back() + std::hypot(dx, dy));
+
+      geometry_msgs::msg::Pose pose;
+      pose.position.x = it->x();
+      pose.position.y = it->y();
+      pose.position.z = 0.0;
+      pose.orientation = autoware::universe_utils::createQuaternionFromRPY(0.0, 0.0, yaw);
+      path.poses.push_back(pose);
+    }
+    path.yaws.push_back(path.yaws.back());
+    path.poses.push_back(path.poses.back());
+
+    // Calculate curvatures
+    for (size_t i = 1; i < path.yaws.size(); ++i) {
+      const auto dyaw =
+        autoware::common::helper_functions::wrap_angle(path.yaws[i] - path.yaws[i - 1]);
+      path.curvatures.push_back(dyaw / (path.lengths[i] - path.lengths[i - 1]));
+    }
+    path.curvatures.push_back(path.curvatures.back());
+  }
+}
+}  // namespace
+
 std::vector<Trajectory> generateTrajectories(
   const autoware::sampler_common::transform::Spline2D & reference_spline,
   const FrenetState & initial_state, const SamplingParameters & sampling_parameters)
 {
   std::vector<Trajectory> trajectories;
   trajectories.reserve(sampling_parameters.parameters.size());
+  // all candidates are sampled at the same times, only their durations differ
+  double max_duration = 0.0;
+  for (const auto & parameter : sampling_parameters.parameters)
+    max_duration = std::max(max_duration, parameter.target_duration);
+  const PolynomialGrid time_grid(sampleGrid(0.0, max_duration, sampling_parameters.resolution));
   for (const auto & parameter : sampling_parameters.parameters) {
     auto trajectory = generateCandidate(
-      initial_state, parameter.target_state, parameter.target_duration,
-      sampling_parameters.resolution);
+      initial_state, parameter.target_state, parameter.target_duration, time_grid);
     trajectory.sampling_parameter = parameter;
     calculateCartesian(reference_spline, trajectory);
     std::stringstream ss;
@@ -78,10 +140,21 @@ std::vector<Path> generatePaths(
 {
   std::vector<Path> candidates;
   candidates.reserve(sampling_parameters.parameters.size());
-  for (const auto parameter : sampling_parameters.parameters) {
-    auto candidate =
-      generateCandidate(initial_state, parameter.target_state, sampling_parameters.resolution);
-    calculateCartesian(reference_spline, candidate);
+  // all candidates are sampled at the same arc lengths from the initial state, so the powers of the
+  // arc lengths and the reference frames at these arc lengths are only calculated once
+  double max_delta_s = 0.0;
+  for (const auto & parameter : sampling_parameters.parameters)
+    max_delta_s =
+      std::max(max_delta_s, parameter.target_state.position.s - initial_state.position.s);
+  const PolynomialGrid s_grid(
+    sampleGrid(sampling_parameters.resolution, max_delta_s, sampling_parameters.resolution));
+  std::vector<double> reference_s;
+  reference_s.reserve(s_grid.size());
+  for (const auto s : s_grid.t) reference_s.push_back(initial_state.position.s + s);
+  const auto reference_table = reference_spline.lookupTable(reference_s);
+  for (const auto & parameter : sampling_parameters.parameters) {
+    auto candidate = generateCandidate(initial_state, parameter.target_state, s_grid);
+    calculateCartesian(reference_table, candidate);
     candidates.push_back(candidate);
   }
   return candidates;
@@ -90,6 +163,15 @@ std::vector<Path> generatePaths(
 Trajectory generateCandidate(
   const FrenetState & initial_state, const FrenetState & target_state, const double duration,
   const double time_resolution)
+{
+  return generateCandidate(
+    initial_state, target_state, duration,
+    PolynomialGrid(sampleGrid(0.0, duration, time_resolution)));
+}
+
+Trajectory generateCandidate(
+  const FrenetState & initial_state, const FrenetState & target_state, const double duration,
+  const PolynomialGrid & time_grid)
 {
   Trajectory trajectory;
   trajectory.longitudinal_polynomial = Polynomial(
@@ -100,10 +182,13 @@ Trajectory generateCandidate(
     initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
     target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
     duration);
-  for (double t = 0.0; t <= duration; t += time_resolution) {
-    trajectory.times.push_back(t);
+  const auto nb_points = countGridValues(time_grid, duration);
+  trajectory.times.assign(time_grid.t.begin(), std::next(time_grid.t.begin(), nb_points));
+  trajectory.frenet_points.reserve(nb_points);
+  for (size_t i = 0; i < nb_points; ++i) {
     trajectory.frenet_points.emplace_back(
-      trajectory.longitudinal_polynomial->position(t), trajectory.lateral_polynomial->position(t));
+      trajectory.longitudinal_polynomial->position(time_grid, i),
+      trajectory.lateral_polynomial->position(time_grid, i));
   }
   return trajectory;
 }
@@ -134,6 +219,15 @@ Trajectory generateLowVelocityCandidate(
 
 Path generateCandidate(
   const FrenetState & initial_state, const FrenetState & target_state, const double s_resolution)
+{
+  const auto delta_s = target_state.position.s - initial_state.position.s;
+  return generateCandidate(
+    initial_state, target_state, PolynomialGrid(sampleGrid(s_resolution, delta_s, s_resolution)));
+}
+
+Path generateCandidate(
+  const FrenetState & initial_state, const FrenetState & target_state,
+  const PolynomialGrid & s_grid)
 {
   const auto delta_s = target_state.position.s - initial_state.position.s;
   Path path;
@@ -141,9 +235,11 @@ Path generateCandidate(
     initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
     target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
     delta_s);
-  for (double s = s_resolution; s <= delta_s; s += s_resolution) {
+  const auto nb_points = countGridValues(s_grid, delta_s);
+  path.frenet_points.reserve(nb_points);
+  for (size_t i = 0; i < nb_points; ++i) {
     path.frenet_points.emplace_back(
-      initial_state.position.s + s, path.lateral_polynomial->position(s));
+      initial_state.position.s + s_grid.t[i], path.lateral_polynomial->position(s_grid, i));
   }
   return path;
 }
@@ -153,44 +249,27 @@ void calculateCartesian(
 {
   if (!path.frenet_points.empty()) {
     path.points.reserve(path.frenet_points.size());
-    path.yaws.reserve(path.frenet_points.size());
-    path.lengths.reserve(path.frenet_points.size());
-    path.curvatures.reserve(path.frenet_points.size());
-    path.poses.reserve(path.frenet_points.size());
     // Calculate cartesian positions
     for (const auto & fp : path.frenet_points) {
       path.points.push_back(reference.cartesian(fp));
     }
-    // TODO(Maxime CLEMENT): more precise calculations are proposed in Appendix I of the paper:
-    // Optimal path Generation for Dynamic Street Scenarios in a Frenet Frame (Werling2010)
-    // Calculate cartesian yaw and interval values
-    path.lengths.push_back(0.0);
-    for (auto it = path.points.begin(); it != std::prev(path.points.end()); ++it) {
-      const auto dx = std::next(it)->x() - it->x();
-      const auto dy = std::next(it)->y() - it->y();
-      const auto yaw = std::atan2(dy, dx);
-      path.yaws.push_back(yaw);
-      path.lengths.push_back(path.lengths.back() + std::hypot(dx, dy));
-
-      geometry_msgs::msg::Pose pose;
-      pose.position.x = it->x();
-      pose.position.y = it->y();
-      pose.position.z = 0.0;
-      pose.orientation = autoware::universe_utils::createQuaternionFromRPY(0.0, 0.0, yaw);
-      path.poses.push_back(pose);
-    }
-    path.yaws.push_back(path.yaws.back());
-    path.poses.push_back(path.poses.back());
+    calculateYawsAndCurvatures(path);
+  }
+}
 
-    // Calculate curvatures
-    for (size_t i = 1; i < path.yaws.size(); ++i) {
-      const auto dyaw =
-        autoware::common::helper_functions::wrap_angle(path.yaws[i] - path.yaws[i - 1]);
-      path.curvatures.push_back(dyaw / (path.lengths[i] - path.lengths[i - 1]));
+void calculateCartesian(
+  const autoware::sampler_common::transform::SplineLookupTable & reference, Path & path)
+{
+  if (!path.frenet_points.empty()) {
+    path.points.reserve(path.frenet_points.size());
+    // Calculate cartesian positions (the i-th frenet point is at the i-th arc length of the table)
+    for (size_t i = 0; i < path.frenet_points.size(); ++i) {
+      path.points.push_back(reference.cartesian(i, path.frenet_points[i].d));
     }
-    path.curvatures.push_back(path.curvatures.back());
+    calculateYawsAndCurvatures(path);
   }
 }
+
 void calculateCartesian(
   const autoware::sampler_common::transform::Spline2D & reference, Trajectory & trajectory)
 {
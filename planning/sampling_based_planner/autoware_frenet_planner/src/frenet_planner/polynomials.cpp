@@ -17,6 +17,20 @@
 
 namespace autoware::frenet_planner
 {
+PolynomialGrid::PolynomialGrid(const std::vector<double> & values) : t(values)
+{
+  t2.reserve(t.size());
+  t3.reserve(t.size());
+  t4.reserve(t.size());
+  t5.reserve(t.size());
+  for (const auto value : t) {
+    t2.push_back(value * value);
+    t3.push_back(t2.back() * value);
+    t4.push_back(t3.back() * value);
+    t5.push_back(t4.back() * value);
+  }
+}
+
 // @brief Create a polynomial connecting the given initial and target configuration over the given
 // duration
 Polynomial::Polynomial(
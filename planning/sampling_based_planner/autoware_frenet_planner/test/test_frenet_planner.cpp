@@ -0,0 +1,126 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_frenet_planner/frenet_planner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+using autoware::frenet_planner::FrenetState;
+using autoware::frenet_planner::Polynomial;
+using autoware::frenet_planner::SamplingParameter;
+using autoware::frenet_planner::SamplingParameters;
+using autoware::sampler_common::transform::Spline2D;
+
+Spline2D createReferenceSpline()
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (double x = 0.0; x <= 60.0; x += 2.0) {
+    xs.push_back(x);
+    ys.push_back(0.002 * x * x);
+  }
+  return {xs, ys};
+}
+
+FrenetState createInitialState()
+{
+  FrenetState state;
+  state.position = {1.3, 0.4};
+  state.lateral_velocity = 0.1;
+  state.lateral_acceleration = -0.05;
+  state.longitudinal_velocity = 3.0;
+  state.longitudinal_acceleration = 0.2;
+  return state;
+}
+
+SamplingParameters createSamplingParameters()
+{
+  SamplingParameters sampling_parameters;
+  sampling_parameters.resolution = 0.5;
+  for (const auto target_s : {10.0, 17.3, 25.0}) {
+    for (const auto target_d : {-1.0, 0.0, 0.8}) {
+      SamplingParameter parameter;
+      parameter.target_duration = target_s / 3.0;
+      parameter.target_state.position = {target_s, target_d};
+      parameter.target_state.longitudinal_velocity = 3.0;
+      sampling_parameters.parameters.push_back(parameter);
+    }
+  }
+  return sampling_parameters;
+}
+}  // namespace
+
+TEST(FrenetPlanner, generatePathsOnSharedGrid)
+{
+  const auto reference = createReferenceSpline();
+  const auto initial_state = createInitialState();
+  const auto sampling_parameters = createSamplingParameters();
+
+  const auto paths =
+    autoware::frenet_planner::generatePaths(reference, initial_state, sampling_parameters);
+  ASSERT_EQ(paths.size(), sampling_parameters.parameters.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const auto & target_state = sampling_parameters.parameters[i].target_state;
+    const auto delta_s = target_state.position.s - initial_state.position.s;
+    const Polynomial lateral_polynomial(
+      initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
+      target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
+      delta_s);
+    size_t j = 0;
+    for (double s = sampling_parameters.resolution; s <= delta_s;
+         s += sampling_parameters.resolution, ++j) {
+      ASSERT_LT(j, paths[i].points.size());
+      const autoware::sampler_common::FrenetPoint fp{
+        initial_state.position.s + s, lateral_polynomial.position(s)};
+      EXPECT_DOUBLE_EQ(paths[i].frenet_points[j].s, fp.s);
+      EXPECT_DOUBLE_EQ(paths[i].frenet_points[j].d, fp.d);
+      const auto expected_point = reference.cartesian(fp);
+      EXPECT_DOUBLE_EQ(paths[i].points[j].x(), expected_point.x());
+      EXPECT_DOUBLE_EQ(paths[i].points[j].y(), expected_point.y());
+    }
+    EXPECT_EQ(paths[i].points.size(), j);
+    EXPECT_EQ(paths[i].yaws.size(), j);
+    EXPECT_EQ(paths[i].curvatures.size(), j);
+  }
+}
+
+TEST(FrenetPlanner, generateTrajectoriesOnSharedGrid)
+{
+  const auto reference = createReferenceSpline();
+  const auto initial_state = createInitialState();
+  const auto sampling_parameters = createSamplingParameters();
+
+  const auto trajectories =
+    autoware::frenet_planner::generateTrajectories(reference, initial_state, sampling_parameters);
+  ASSERT_EQ(trajectories.size(), sampling_parameters.parameters.size());
+  for (size_t i = 0; i < trajectories.size(); ++i) {
+    const auto & parameter = sampling_parameters.parameters[i];
+    const auto & trajectory = trajectories[i];
+    size_t j = 0;
+    for (double t = 0.0; t <= parameter.target_duration;
+         t += sampling_parameters.resolution, ++j) {
+      ASSERT_LT(j, trajectory.times.size());
+      EXPECT_DOUBLE_EQ(trajectory.times[j], t);
+      EXPECT_DOUBLE_EQ(
+        trajectory.frenet_points[j].s, trajectory.longitudinal_polynomial->position(t));
+      EXPECT_DOUBLE_EQ(trajectory.frenet_points[j].d, trajectory.lateral_polynomial->position(t));
+    }
+    EXPECT_EQ(trajectory.times.size(), j);
+    EXPECT_EQ(trajectory.points.size(), j);
+  }
+}
@@ -475,12 +475,16 @@ autoware::sampler_common::Path PathSampler::generatePath(const PlannerData & pla
     generateCandidatesFromPreviousPath(planner_data, path_spline);
   candidate_paths.insert(
     candidate_paths.end(), candidates_from_prev_path.begin(), candidates_from_prev_path.end());
-  debug_data_.footprints.clear();
-  for (auto & path : candidate_paths) {
-    const auto footprint =
+  debug_data_.footprints.assign(candidate_paths.size(), {});
+  // candidates are checked independently of each other
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < candidate_paths.size(); ++i) {
+    auto & path = candidate_paths[i];
+    debug_data_.footprints[i] =
       autoware::sampler_common::constraints::checkHardConstraints(path, params_.constraints);
-    debug_data_.footprints.push_back(footprint);
-    autoware::sampler_common::constraints::calculateCost(path, params_.constraints, path_spline);
+    // the cost is only used to select among the valid candidates
+    if (path.constraint_results.isValid())
+      autoware::sampler_common::constraints::calculateCost(path, params_.constraints, path_spline);
   }
   const auto best_path_idx = [](const auto & paths) {
     auto min_cost = std::numeric_limits<double>::max();
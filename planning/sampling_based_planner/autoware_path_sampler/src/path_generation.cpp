@@ -72,15 +72,19 @@ std::vector<autoware::sampler_common::Path> generateBezierPaths(
       autoware::bezier_sampler::sample(initial_state, target_state, params.sampling.bezier);
 
     const auto step = std::min(0.1, params.sampling.resolution / target_length);
+    // the samples of this target are evaluated at the same parameters and share the bezier basis
+    std::vector<double> ts;
+    for (double t = 0.0; t <= 1.0; t += step) ts.push_back(t);
+    const autoware::bezier_sampler::BezierBasis basis(ts);
     for (const auto & bezier : bezier_samples) {
       autoware::sampler_common::Path path;
       path.lengths.push_back(0.0);
-      for (double t = 0.0; t <= 1.0; t += step) {
-        const auto x_y = bezier.valueM(t);
-        path.points.emplace_back(x_y[0], x_y[1]);
-        path.yaws.emplace_back(bezier.heading(t));
-        path.curvatures.push_back(bezier.curvature(t));
-      }
+      const auto values = bezier.values(basis);
+      path.points.reserve(values.rows());
+      for (Eigen::Index i = 0; i < values.rows(); ++i)
+        path.points.emplace_back(values(i, 0), values(i, 1));
+      path.yaws = bezier.headings(basis);
+      path.curvatures = bezier.curvatures(basis);
       for (size_t i = 0; i + 1 < path.points.size(); ++i) {
         path.lengths.push_back(
           path.lengths.back() + std::hypot(
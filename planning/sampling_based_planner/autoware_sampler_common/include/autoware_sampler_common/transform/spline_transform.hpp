@@ -56,6 +56,25 @@ private:
     const std::vector<double> & r1, const std::vector<double> & r2, const double converge_range);
 };
 
+/// @brief reference points and normals of a Spline2D precomputed at some arc lengths
+/// @details used to convert many frenet points that share the same arc lengths (e.g., candidate
+/// paths sampled on the same grid) with one spline evaluation per arc length
+struct SplineLookupTable
+{
+  std::vector<double> s{};
+  std::vector<double> x{};
+  std::vector<double> y{};
+  std::vector<double> normal_x{};
+  std::vector<double> normal_y{};
+
+  /// @brief cartesian point at the i-th arc length of the table and the lateral offset d
+  [[nodiscard]] Point2d cartesian(const size_t i, const double d) const
+  {
+    return {x[i] + d * normal_x[i], y[i] + d * normal_y[i]};
+  }
+  [[nodiscard]] size_t size() const { return s.size(); }
+};
+
 class Spline2D
 {
   std::vector<double> s_{};
@@ -71,6 +90,8 @@ public:
   [[nodiscard]] FrenetPoint frenet(const Point2d & p, const double precision = 0.01) const;
   [[nodiscard]] Point2d cartesian(const double s) const;
   [[nodiscard]] Point2d cartesian(const FrenetPoint & fp) const;
+  /// @brief precompute the points and normals at the given arc lengths
+  [[nodiscard]] SplineLookupTable lookupTable(const std::vector<double> & s) const;
   [[nodiscard]] double curvature(const double s) const;
   [[nodiscard]] double yaw(const double s) const;
   [[nodiscard]] double firstS() const { return s_.empty() ? 0.0 : s_.front(); }
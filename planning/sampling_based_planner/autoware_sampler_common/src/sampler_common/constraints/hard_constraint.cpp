@@ -19,6 +19,7 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/algorithms/within.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace autoware::sampler_common::constraints
@@ -35,8 +36,20 @@ bool has_collision(
   const MultiPoint2d & footprint, const MultiPolygon2d & obstacles, const double min_distance)
 {
   if (footprint.empty()) return false;
-  for (const auto & o : obstacles)
+  const auto footprint_box =
+    boost::geometry::return_envelope<autoware::universe_utils::Box2d>(footprint);
+  for (const auto & o : obstacles) {
+    // the distance to the obstacle is at least the distance between the bounding boxes
+    const auto obstacle_box = boost::geometry::return_envelope<autoware::universe_utils::Box2d>(o);
+    const auto dx = std::max(
+      {0.0, obstacle_box.min_corner().x() - footprint_box.max_corner().x(),
+       footprint_box.min_corner().x() - obstacle_box.max_corner().x()});
+    const auto dy = std::max(
+      {0.0, obstacle_box.min_corner().y() - footprint_box.max_corner().y(),
+       footprint_box.min_corner().y() - obstacle_box.max_corner().y()});
+    if (dx * dx + dy * dy > min_distance * min_distance) continue;
     if (boost::geometry::distance(o, footprint) <= min_distance) return true;
+  }
   return false;
 }
 
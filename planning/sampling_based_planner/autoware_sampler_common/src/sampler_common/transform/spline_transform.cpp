@@ -295,6 +295,25 @@ Point2d Spline2D::cartesian(const FrenetPoint & fp) const
   return {x + fp.d * std::cos(heading + M_PI_2), y + fp.d * std::sin(heading + M_PI_2)};
 }
 
+SplineLookupTable Spline2D::lookupTable(const std::vector<double> & s) const
+{
+  SplineLookupTable table;
+  table.s = s;
+  table.x.reserve(s.size());
+  table.y.reserve(s.size());
+  table.normal_x.reserve(s.size());
+  table.normal_y.reserve(s.size());
+  for (const auto query : s) {
+    // same calculation as cartesian(const FrenetPoint &)
+    const auto heading = yaw(query);
+    table.x.push_back(x_spline_.value(query, s_));
+    table.y.push_back(y_spline_.value(query, s_));
+    table.normal_x.push_back(std::cos(heading + M_PI_2));
+    table.normal_y.push_back(std::sin(heading + M_PI_2));
+  }
+  return table;
+}
+
 double Spline2D::curvature(const double s) const
 {
   // TODO(Maxime CLEMENT) search for s in s_ here and pass index
@@ -0,0 +1,56 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_sampler_common/constraints/hard_constraint.hpp>
+
+#include <boost/geometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+TEST(hardConstraints, hasCollision)
+{
+  using autoware::sampler_common::MultiPoint2d;
+  using autoware::sampler_common::MultiPolygon2d;
+  using autoware::sampler_common::Polygon2d;
+  using autoware::sampler_common::constraints::has_collision;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> size(0.1, 3.0);
+  for (auto iteration = 0; iteration < 100; ++iteration) {
+    MultiPoint2d footprint;
+    for (auto i = 0; i < 20; ++i) footprint.emplace_back(position(engine), 0.1 * position(engine));
+    MultiPolygon2d obstacles;
+    for (auto i = 0; i < 5; ++i) {
+      const auto x = position(engine);
+      const auto y = position(engine);
+      const auto length = size(engine);
+      const auto width = size(engine);
+      Polygon2d obstacle;
+      obstacle.outer() = {
+        {x, y}, {x + length, y}, {x + length, y + width}, {x, y + width}, {x, y}};
+      boost::geometry::correct(obstacle);
+      obstacles.push_back(obstacle);
+    }
+    for (const auto min_distance : {0.0, 0.5, 2.0}) {
+      bool expected = false;
+      for (const auto & o : obstacles)
+        expected |= boost::geometry::distance(o, footprint) <= min_distance;
+      EXPECT_EQ(has_collision(footprint, obstacles, min_distance), expected);
+    }
+  }
+  EXPECT_FALSE(has_collision(MultiPoint2d{}, MultiPolygon2d{}, 1.0));
+}
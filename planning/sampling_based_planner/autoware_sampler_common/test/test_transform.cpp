@@ -70,6 +70,24 @@ TEST(splineTransform, toCartesian)
   EXPECT_NEAR(cart.y(), 0.0, TOL);
 }
 
+TEST(splineTransform, lookupTable)
+{
+  autoware::sampler_common::transform::Spline2D spline(
+    {0.0, 1.0, 2.0, 4.0, 5.0}, {0.0, 0.5, 0.0, -1.0, 1.0});
+  std::vector<double> s;
+  for (double query = 0.0; query < spline.lastS(); query += 0.3) s.push_back(query);
+  const auto table = spline.lookupTable(s);
+  ASSERT_EQ(table.size(), s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    for (const auto d : {-2.0, 0.0, 0.7}) {
+      const auto expected = spline.cartesian({s[i], d});
+      const auto cart = table.cartesian(i, d);
+      EXPECT_DOUBLE_EQ(cart.x(), expected.x());
+      EXPECT_DOUBLE_EQ(cart.y(), expected.y());
+    }
+  }
+}
+
 TEST(splineTransform, benchFrenet)
 {
   GTEST_SKIP() << "Skipping benchmark test";
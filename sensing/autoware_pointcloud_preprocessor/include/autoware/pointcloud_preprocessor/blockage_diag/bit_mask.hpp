@@ -0,0 +1,120 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BIT_MASK_HPP_
+#define AUTOWARE__POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BIT_MASK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+/** \brief Binary image whose rows are packed in 64-bit words, bit i of word j being column
+ * 64 * j + i. The bits past the last column are always zero.
+ */
+class BitMask
+{
+public:
+  /** \brief Resize to rows x cols with every bit set to value, keeping the allocated memory */
+  void reset(int rows, int cols, bool value);
+
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+  size_t wordsPerRow() const { return words_per_row_; }
+  const uint64_t * rowWords(int row) const { return &words_[wordIndex(row, 0)]; }
+
+  bool get(int row, int col) const { return (words_[wordIndex(row, col)] >> (col % 64)) & 1U; }
+
+  void set(int row, int col, bool value)
+  {
+    const uint64_t bit = uint64_t{1} << (col % 64);
+    auto & word = words_[wordIndex(row, col)];
+    word = value ? (word | bit) : (word & ~bit);
+  }
+
+  /** \brief Clear the rows [row_begin, row_end) */
+  void clearRows(int row_begin, int row_end);
+
+  /** \brief Number of set bits in the rows [row_begin, row_end) */
+  size_t count(int row_begin, int row_end) const;
+
+  /** \brief Columns [begin, end) spanned by the set bits of the rows [row_begin, row_end), as the
+   * x range of cv::boundingRect. (0, 0) if no bit is set.
+   */
+  std::pair<int, int> columnRange(int row_begin, int row_end) const;
+
+  /** \brief Erode the rows [row_begin, row_end) with a (2 * radius + 1) square, as cv::erode
+   * with the default border does on the image made of these rows only.
+   */
+  void erode(int radius, int row_begin, int row_end) { morph(radius, row_begin, row_end, true); }
+
+  /** \brief Dilate the rows [row_begin, row_end) with a (2 * radius + 1) square, as cv::dilate
+   * with the default border does on the image made of these rows only.
+   */
+  void dilate(int radius, int row_begin, int row_end) { morph(radius, row_begin, row_end, false); }
+
+private:
+  size_t wordIndex(int row, int col) const
+  {
+    return static_cast<size_t>(row) * words_per_row_ + static_cast<size_t>(col / 64);
+  }
+  uint64_t paddingBits() const;
+  void morph(int radius, int row_begin, int row_end, bool erode);
+
+  int rows_ = 0;
+  int cols_ = 0;
+  size_t words_per_row_ = 0;
+  std::vector<uint64_t> words_;
+  std::vector<uint64_t> previous_row_;
+  std::vector<uint64_t> current_row_;
+};
+
+/** \brief The last masks pushed, and for each bit the number of these masks in which it is set.
+ * The counts are updated when a mask is pushed or evicted, instead of summing the masks.
+ */
+class BitMaskTimeSeries
+{
+public:
+  /** \brief Set the number of masks kept, clearing the buffer */
+  void setCapacity(size_t capacity);
+  size_t size() const { return size_; }
+
+  /** \brief Push a mask, evicting the oldest one if the buffer is full. The buffer is cleared first
+   * if the mask size changed.
+   */
+  void push(const BitMask & mask);
+
+  /** \brief Reset result to rows x cols and set the bits set in at least size() - 1 of the
+   * buffered masks, as cv::inRange(sum of the masks, size() - 1, size()) does. Nothing is set if
+   * the buffer is empty or its masks are of another size.
+   */
+  void getResult(int rows, int cols, BitMask & result) const;
+
+private:
+  void addCounts(const BitMask & mask, int increment);
+
+  std::vector<BitMask> masks_;
+  size_t capacity_ = 1;
+  size_t next_index_ = 0;
+  size_t size_ = 0;
+  int rows_ = 0;
+  int cols_ = 0;
+  std::vector<uint16_t> counts_;
+};
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#endif  // AUTOWARE__POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BIT_MASK_HPP_
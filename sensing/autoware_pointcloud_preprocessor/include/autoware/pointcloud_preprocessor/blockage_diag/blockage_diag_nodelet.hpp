@@ -15,6 +15,7 @@
 #ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BLOCKAGE_DIAG_NODELET_HPP_
 #define AUTOWARE__POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BLOCKAGE_DIAG_NODELET_HPP_
 
+#include "autoware/pointcloud_preprocessor/blockage_diag/bit_mask.hpp"
 #include "autoware/pointcloud_preprocessor/filter.hpp"
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -64,6 +65,23 @@ protected:
   rclcpp::Publisher<tier4_debug_msgs::msg::StringStamped>::SharedPtr blockage_type_pub_;
 
 private:
+  /** \brief Bin the points directly from the buffer into bit masks, and do the morphology and the
+   * time series on these masks. The input must be of the PointXYZIRCAEDT layout.
+   */
+  void filterWithBitMasks(
+    const PointCloud2 & input, int ideal_horizontal_bins, double compensate_angle);
+  void setEmptyInputBlockage();
+  void updateBlockageState(
+    float blockage_ratio, int blockage_begin_col, int blockage_end_col,
+    std::vector<float> & blockage_range_deg, int & blockage_count) const;
+  void updateGroundDustRatio(float ground_dust_ratio);
+  void publishBlockageRatios();
+  void publishDustDebugImages(
+    const std_msgs::msg::Header & header, const cv::Mat & single_dust_img,
+    const cv::Mat & time_series_blockage_result, const cv::Mat & multi_frame_ground_dust_result);
+  void publishBlockageDebugImages(
+    const std_msgs::msg::Header & header, const cv::Mat & full_size_depth_map,
+    const cv::Mat & time_series_blockage_result);
   void onBlockageChecker(DiagnosticStatusWrapper & stat);
   void dustChecker(DiagnosticStatusWrapper & stat);
   Updater updater_{this};
@@ -98,6 +116,15 @@ private:
   boost::circular_buffer<cv::Mat> no_return_mask_buffer{1};
   boost::circular_buffer<cv::Mat> dust_mask_buffer{1};
 
+  bool use_bit_packed_masks_ = false;
+  BitMask no_return_mask_;
+  BitMask blockage_mask_;
+  BitMask dust_mask_;
+  BitMask time_series_blockage_result_;
+  BitMask multi_frame_dust_result_;
+  BitMaskTimeSeries no_return_mask_time_series_;
+  BitMaskTimeSeries dust_mask_time_series_;
+
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
   explicit BlockageDiagComponent(const rclcpp::NodeOptions & options);
@@ -64,6 +64,29 @@
 
 namespace autoware::pointcloud_preprocessor
 {
+struct CropBoxParam
+{
+  float min_x;
+  float max_x;
+  float min_y;
+  float max_y;
+  float min_z;
+  float max_z;
+  bool negative{false};
+};
+
+/** \brief Keep the points of the input inside the box (or outside if negative) in the output.
+ * The output can be the input itself, in which case the points are compacted in place.
+ * \param input the input point cloud dataset
+ * \param param the box
+ * \param transform_info the transformation from the input frame to the frame of the box
+ * \param output the resultant point cloud, whose header is left unchanged
+ * \return the number of points ignored because they contain NaN values
+ */
+int cropBox(
+  const sensor_msgs::msg::PointCloud2 & input, const CropBoxParam & param,
+  const TransformInfo & transform_info, sensor_msgs::msg::PointCloud2 & output);
+
 class CropBoxFilterComponent : public autoware::pointcloud_preprocessor::Filter
 {
 protected:
@@ -79,16 +102,7 @@ protected:
   void publishCropBoxPolygon();
 
 private:
-  struct CropBoxParam
-  {
-    float min_x;
-    float max_x;
-    float min_y;
-    float max_y;
-    float min_z;
-    float max_z;
-    bool negative{false};
-  } param_;
+  CropBoxParam param_;
 
   rclcpp::Publisher<geometry_msgs::msg::PolygonStamped>::SharedPtr crop_box_polygon_pub_;
 
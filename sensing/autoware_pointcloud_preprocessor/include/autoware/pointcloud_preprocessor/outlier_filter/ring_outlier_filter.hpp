@@ -0,0 +1,123 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_HPP_
+#define AUTOWARE__POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_HPP_
+
+#include "autoware/pointcloud_preprocessor/transform_info.hpp"
+#include "autoware_point_types/types.hpp"
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_cloud.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+
+struct RingOutlierFilterParam
+{
+  double distance_ratio{1.03};
+  double object_length_threshold{0.1};
+  int num_points_threshold{4};
+  uint16_t max_rings_num{128};
+  size_t max_points_num_per_ring{4000};
+
+  // for visibility score
+  int vertical_bins{128};
+  int horizontal_bins{36};
+  float min_azimuth_deg{0.0};
+  float max_azimuth_deg{360.0};
+  float max_distance{12.0};
+};
+
+/** \brief Ring outlier filter without ROS interface, shared by RingOutlierFilterComponent and the
+ * preprocessing pipeline.
+ *
+ * The points of each ring are split into walks of consecutive points at similar distances, and the
+ * walks that are too short to be an object are removed.
+ *
+ * The points are bucketed by ring with a counting sort into buffers kept across the calls, and the
+ * rings are walked in parallel. Each ring writes its points to its own range of the output, and the
+ * ranges are then concatenated in ring order, so the output does not depend on the thread count.
+ */
+class RingOutlierFilter
+{
+public:
+  using PointCloud2 = sensor_msgs::msg::PointCloud2;
+  using InputPointIndex = autoware_point_types::PointXYZIRCAEDTIndex;
+  using InputPointType = autoware_point_types::PointXYZIRCAEDT;
+  using OutputPointType = autoware_point_types::PointXYZIRC;
+
+  RingOutlierFilter();
+
+  void setParam(const RingOutlierFilterParam & param) { param_ = param; }
+  const RingOutlierFilterParam & getParam() const { return param_; }
+
+  /** \brief Filter the input points.
+   * \param input the input points of InputPointType
+   * \param transform_info the transformation applied to the output points
+   * \param output the kept points of OutputPointType, whose header is left unchanged. It must not
+   * be the input
+   * \param outlier_points if not null, the removed points are added to it
+   * \param visibility_score if not null, set to the visibility score calculated from the removed
+   * points
+   */
+  void filter(
+    const PointCloud2 & input, const TransformInfo & transform_info, PointCloud2 & output,
+    pcl::PointCloud<InputPointType> * outlier_points = nullptr, float * visibility_score = nullptr);
+
+private:
+  RingOutlierFilterParam param_;
+  std::vector<sensor_msgs::msg::PointField> output_fields_;
+
+  // buffers kept across the calls
+  /** \brief ring_begins_[ring] is the first index of the ring in sorted_data_indices_ */
+  std::vector<size_t> ring_begins_;
+  /** \brief data index of each input point, sorted by ring and then by input order */
+  std::vector<size_t> sorted_data_indices_;
+  /** \brief data indices of the removed points, in the range of the ring in sorted_data_indices_ */
+  std::vector<size_t> outlier_data_indices_;
+  std::vector<size_t> kept_counts_;
+  std::vector<size_t> outlier_counts_;
+  /** \brief flag of each visibility bin with a removed point, indexed by ring * horizontal_bins */
+  std::vector<uint8_t> occupied_bins_;
+
+  void bucketPointsByRing(const PointCloud2 & input, size_t channel_offset);
+
+  bool isCluster(
+    const PointCloud2 & input, std::pair<int, int> data_idx_both_ends, int walk_size) const
+  {
+    if (walk_size > param_.num_points_threshold) return true;
+
+    auto first_point =
+      reinterpret_cast<const InputPointType *>(&input.data[data_idx_both_ends.first]);
+    auto last_point =
+      reinterpret_cast<const InputPointType *>(&input.data[data_idx_both_ends.second]);
+
+    const auto x = first_point->x - last_point->x;
+    const auto y = first_point->y - last_point->y;
+    const auto z = first_point->z - last_point->z;
+
+    return x * x + y * y + z * z >=
+           param_.object_length_threshold * param_.object_length_threshold;
+  }
+};
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#endif  // AUTOWARE__POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_HPP_
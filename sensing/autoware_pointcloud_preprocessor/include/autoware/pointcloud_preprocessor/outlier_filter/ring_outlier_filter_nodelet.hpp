@@ -16,6 +16,7 @@
 #define AUTOWARE__POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RING_OUTLIER_FILTER_NODELET_HPP_
 
 #include "autoware/pointcloud_preprocessor/filter.hpp"
+#include "autoware/pointcloud_preprocessor/outlier_filter/ring_outlier_filter.hpp"
 #include "autoware/pointcloud_preprocessor/transform_info.hpp"
 #include "autoware_point_types/types.hpp"
 
@@ -30,7 +31,6 @@
 
 #include <memory>
 #include <string>
-#include <utility>
 #include <vector>
 
 namespace autoware::pointcloud_preprocessor
@@ -59,21 +59,11 @@ private:
   /** \brief publisher of excluded pointcloud for debug reason. **/
   rclcpp::Publisher<PointCloud2>::SharedPtr outlier_pointcloud_publisher_;
 
-  double distance_ratio_;
-  double object_length_threshold_;
-  int num_points_threshold_;
-  uint16_t max_rings_num_;
-  size_t max_points_num_per_ring_;
+  RingOutlierFilter ring_outlier_filter_;
   bool publish_outlier_pointcloud_;
 
   // for visibility score
   int noise_threshold_;
-  int vertical_bins_;
-  int horizontal_bins_;
-
-  float min_azimuth_deg_;
-  float max_azimuth_deg_;
-  float max_distance_;
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -81,26 +71,6 @@ private:
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
-  bool isCluster(
-    const PointCloud2ConstPtr & input, std::pair<int, int> data_idx_both_ends, int walk_size)
-  {
-    if (walk_size > num_points_threshold_) return true;
-
-    auto first_point =
-      reinterpret_cast<const InputPointType *>(&input->data[data_idx_both_ends.first]);
-    auto last_point =
-      reinterpret_cast<const InputPointType *>(&input->data[data_idx_both_ends.second]);
-
-    const auto x = first_point->x - last_point->x;
-    const auto y = first_point->y - last_point->y;
-    const auto z = first_point->z - last_point->z;
-
-    return x * x + y * y + z * z >= object_length_threshold_ * object_length_threshold_;
-  }
-
-  void setUpPointCloudFormat(
-    const PointCloud2ConstPtr & input, PointCloud2 & formatted_points, size_t points_size);
-  float calculateVisibilityScore(const PointCloud2 & input);
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -17,8 +17,6 @@
 
 #include "autoware/pointcloud_preprocessor/filter.hpp"
 
-#include <boost/circular_buffer.hpp>
-
 #include <vector>
 
 namespace autoware::pointcloud_preprocessor
@@ -36,8 +34,24 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
+  struct PointcloudSlice
+  {
+    rclcpp::Time stamp;
+    pcl::PointCloud<pcl::PointXYZ> cloud;
+  };
+
+  /** \brief Index in slices_ of the slice received age messages before the newest one */
+  size_t getSliceIndex(size_t age) const;
+
+  /** \brief Change the number of slices, keeping the newest ones */
+  void setSliceCapacity(size_t capacity);
+
   double accumulation_time_sec_;
-  boost::circular_buffer<PointCloud2ConstPtr> pointcloud_buffer_;
+  // ring of the received pointclouds, converted once on arrival. The slots are reused so that the
+  // points of a new pointcloud are written in the memory of the evicted one.
+  std::vector<PointcloudSlice> slices_;
+  size_t newest_slice_index_{0};
+  size_t num_slices_{0};
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
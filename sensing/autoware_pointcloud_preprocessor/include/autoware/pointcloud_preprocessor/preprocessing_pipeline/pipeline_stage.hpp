@@ -0,0 +1,77 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PIPELINE_STAGE_HPP_
+#define AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PIPELINE_STAGE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <memory>
+#include <string>
+
+namespace autoware::pointcloud_preprocessor
+{
+
+/** \brief A filter stage of PreprocessingPipelineComponent.
+ *
+ * A stage works on the points of the pipeline without publishing them. The stages keeping the
+ * point layout filter the points in place, and the others write the result to the scratch buffer
+ * and swap it with the points. As the points are moved into the published message, only the
+ * scratch buffer is reused across the frames.
+ */
+class PipelineStage
+{
+public:
+  using PointCloud2 = sensor_msgs::msg::PointCloud2;
+
+  explicit PipelineStage(std::string name);
+  virtual ~PipelineStage() = default;
+
+  const std::string & name() const { return name_; }
+  /** \brief The name usable in a topic name, where '.' and the other characters not allowed in a
+   * topic name are replaced by '_', e.g. `crop_box_self` for `crop_box.self`.
+   */
+  const std::string & topic_name() const { return topic_name_; }
+
+  /** \brief Filter the points, whose header must be kept.
+   * \param points the points of the pipeline, replaced by the result
+   * \param scratch a buffer the stage can write to, whose content is undefined
+   */
+  virtual void process(
+    std::unique_ptr<PointCloud2> & points, std::unique_ptr<PointCloud2> & scratch) = 0;
+
+  virtual void processTwistMessage(
+    const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr & /*twist_msg*/)
+  {
+  }
+  virtual void processIMUMessage(const sensor_msgs::msg::Imu::ConstSharedPtr & /*imu_msg*/) {}
+
+private:
+  std::string name_;
+  std::string topic_name_;
+};
+
+/** \brief Create the stage declared by the parameters under `<name>.` of the node.
+ * The type of the stage is the part of the name before the first '.', e.g. `crop_box.self` is a
+ * crop box stage. Throws std::invalid_argument for an unknown type.
+ */
+std::unique_ptr<PipelineStage> createPipelineStage(rclcpp::Node & node, const std::string & name);
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#endif  // AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PIPELINE_STAGE_HPP_
@@ -0,0 +1,78 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PREPROCESSING_PIPELINE_NODE_HPP_
+#define AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PREPROCESSING_PIPELINE_NODE_HPP_
+
+#include "autoware/pointcloud_preprocessor/preprocessing_pipeline/pipeline_stage.hpp"
+
+#include <autoware/universe_utils/ros/debug_publisher.hpp>
+#include <autoware/universe_utils/ros/static_transform_buffer.hpp>
+#include <autoware/universe_utils/system/stop_watch.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+
+/** \brief Run the filter stages listed in the `stages` parameter on each input point cloud in
+ * the same process, publishing only the result of the last stage.
+ */
+class PreprocessingPipelineComponent : public rclcpp::Node
+{
+public:
+  using PointCloud2 = sensor_msgs::msg::PointCloud2;
+
+  explicit PreprocessingPipelineComponent(const rclcpp::NodeOptions & options);
+
+private:
+  rclcpp::Subscription<geometry_msgs::msg::TwistWithCovarianceStamped>::SharedPtr twist_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_;
+  rclcpp::Subscription<PointCloud2>::SharedPtr pointcloud_sub_;
+
+  rclcpp::Publisher<PointCloud2>::SharedPtr pointcloud_pub_;
+
+  std::unique_ptr<autoware::universe_utils::StopWatch<std::chrono::milliseconds>> stop_watch_ptr_;
+  std::unique_ptr<autoware::universe_utils::DebugPublisher> debug_publisher_;
+  std::unique_ptr<autoware::universe_utils::StaticTransformBuffer> static_tf_buffer_;
+
+  /** \brief The frame the stages work in, or empty to keep the frame of the input. */
+  std::string input_frame_;
+  /** \brief The frame of the output, or empty to keep the frame of the stages. */
+  std::string output_frame_;
+
+  std::vector<std::unique_ptr<PipelineStage>> stages_;
+
+  /** \brief Buffer swapped with the points by the stages changing the point layout, the only one
+   * kept across the frames.
+   */
+  std::unique_ptr<PointCloud2> scratch_;
+
+  bool transformPointCloud(const std::string & target_frame, PointCloud2 & points);
+
+  void onPointCloud(PointCloud2::UniquePtr points_msg);
+  void onTwist(const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_msg);
+  void onImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg);
+};
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#endif  // AUTOWARE__POINTCLOUD_PREPROCESSOR__PREPROCESSING_PIPELINE__PREPROCESSING_PIPELINE_NODE_HPP_
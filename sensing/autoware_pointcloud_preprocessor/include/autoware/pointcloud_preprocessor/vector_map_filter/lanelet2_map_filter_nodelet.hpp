@@ -15,6 +15,8 @@
 #ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 #define AUTOWARE__POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 
+#include "autoware/pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
 #include <autoware/universe_utils/geometry/boost_geometry.hpp>
 #include <autoware_lanelet2_extension/utility/message_conversion.hpp>
 #include <autoware_lanelet2_extension/utility/query.hpp>
@@ -35,6 +37,7 @@
 
 #include <tf2_ros/transform_listener.h>
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -43,6 +46,7 @@
 using autoware::universe_utils::LinearRing2d;
 using autoware::universe_utils::MultiPoint2d;
 using autoware::universe_utils::Point2d;
+using autoware::universe_utils::Polygon2d;
 
 namespace autoware::pointcloud_preprocessor
 {
@@ -65,9 +69,14 @@ private:
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::ConstLanelets road_lanelets_;
+  // raster of the road lanelets, built on each map when use_raster_mask_ is set
+  std::unique_ptr<LaneletRasterMask> raster_mask_;
+  std::vector<uint8_t> point_is_within_;
 
   float voxel_size_x_;
   float voxel_size_y_;
+  bool use_raster_mask_;
+  double raster_mask_resolution_;
 
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
@@ -86,6 +95,9 @@ private:
     const lanelet::ConstLanelets & joint_lanelets,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
 
+  pcl::PointCloud<pcl::PointXYZ> getRasterFilteredPointCloud(
+    const pcl::PointCloud<pcl::PointXYZ> & cloud);
+
   bool pointWithinLanelets(const Point2d & point, const lanelet::ConstLanelets & joint_lanelets);
 
   /** \brief Parameter service callback result : needed to be hold */
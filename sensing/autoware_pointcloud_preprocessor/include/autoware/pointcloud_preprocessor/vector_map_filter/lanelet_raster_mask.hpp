@@ -0,0 +1,88 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
+#define AUTOWARE__POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
+
+#include <autoware/universe_utils/geometry/boost_geometry.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+/** \brief Raster of the union of polygons, built once to classify many points.
+ *
+ * The cells of the polygons bounding box are grouped by tiles of 64 x 64, each keeping one bit
+ * per cell for the cells inside a polygon and for the cells crossed by a polygon edge. A point in
+ * an inside cell is within the union, a point in a cell that is neither inside nor crossed is
+ * out of it, and only the points in crossed cells are tested against the polygons of their tile.
+ */
+class LaneletRasterMask
+{
+public:
+  using Point2d = autoware::universe_utils::Point2d;
+  using Polygon2d = autoware::universe_utils::Polygon2d;
+
+  /** \brief Rasterize the outer rings of the polygons, resolution is the cell size in meters */
+  LaneletRasterMask(std::vector<Polygon2d> polygons, double resolution);
+
+  /** \brief Whether the point is within one of the polygons, same as boost::geometry::within */
+  bool isWithin(double x, double y) const;
+
+  double resolution() const { return resolution_; }
+
+private:
+  static constexpr int tile_size = 64;
+
+  struct Tile
+  {
+    std::array<uint64_t, tile_size> inside{};
+    std::array<uint64_t, tile_size> boundary{};
+    std::vector<size_t> polygon_indices;
+  };
+
+  struct CellRange
+  {
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+  };
+
+  void rasterizePolygon(size_t polygon_index);
+  Tile & getOrCreateTile(int tile_x, int tile_y);
+  bool withinPolygons(const Tile & tile, const Point2d & point) const;
+
+  int toCellX(double x) const;
+  int toCellY(double y) const;
+
+  std::vector<Polygon2d> polygons_;
+  std::vector<autoware::universe_utils::Box2d> envelopes_;
+  double resolution_;
+  double inverse_resolution_;
+  // min corner of the polygons bounding box, i.e. of the cell (0, 0)
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+  int tiles_x_{0};
+  int tiles_y_{0};
+  // index in tiles_ of each tile of the bounding box, -1 when no polygon overlaps the tile
+  std::vector<int32_t> tile_indices_;
+  std::vector<Tile> tiles_;
+};
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#endif  // AUTOWARE__POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET_RASTER_MASK_HPP_
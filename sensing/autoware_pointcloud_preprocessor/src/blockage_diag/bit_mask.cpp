@@ -0,0 +1,190 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/blockage_diag/bit_mask.hpp"
+
+#include <algorithm>
+
+namespace autoware::pointcloud_preprocessor
+{
+
+void BitMask::reset(const int rows, const int cols, const bool value)
+{
+  rows_ = rows;
+  cols_ = cols;
+  words_per_row_ = (static_cast<size_t>(cols) + 63) / 64;
+  words_.assign(static_cast<size_t>(rows) * words_per_row_, value ? ~uint64_t{0} : uint64_t{0});
+  if (value && words_per_row_ > 0) {
+    for (int row = 0; row < rows_; ++row) {
+      words_[wordIndex(row, cols_ - 1)] &= ~paddingBits();
+    }
+  }
+}
+
+uint64_t BitMask::paddingBits() const
+{
+  return cols_ % 64 == 0 ? uint64_t{0} : ~uint64_t{0} << (cols_ % 64);
+}
+
+void BitMask::clearRows(const int row_begin, const int row_end)
+{
+  if (row_begin >= row_end) return;
+  std::fill(
+    words_.begin() + static_cast<std::ptrdiff_t>(row_begin * words_per_row_),
+    words_.begin() + static_cast<std::ptrdiff_t>(row_end * words_per_row_), uint64_t{0});
+}
+
+size_t BitMask::count(const int row_begin, const int row_end) const
+{
+  size_t count = 0;
+  for (size_t i = row_begin * words_per_row_; i < row_end * words_per_row_; ++i) {
+    count += static_cast<size_t>(__builtin_popcountll(words_[i]));
+  }
+  return count;
+}
+
+std::pair<int, int> BitMask::columnRange(const int row_begin, const int row_end) const
+{
+  const auto column_word = [&](const size_t word_idx) {
+    uint64_t word = 0;
+    for (int row = row_begin; row < row_end; ++row) {
+      word |= words_[static_cast<size_t>(row) * words_per_row_ + word_idx];
+    }
+    return word;
+  };
+
+  size_t first_word_idx = 0;
+  uint64_t first_word = 0;
+  for (; first_word_idx < words_per_row_; ++first_word_idx) {
+    first_word = column_word(first_word_idx);
+    if (first_word != 0) break;
+  }
+  if (first_word == 0) {
+    return {0, 0};
+  }
+  size_t last_word_idx = words_per_row_ - 1;
+  uint64_t last_word = column_word(last_word_idx);
+  while (last_word == 0) {
+    last_word = column_word(--last_word_idx);
+  }
+  return {
+    static_cast<int>(first_word_idx * 64 + __builtin_ctzll(first_word)),
+    static_cast<int>(last_word_idx * 64 + 64 - __builtin_clzll(last_word))};
+}
+
+void BitMask::morph(const int radius, const int row_begin, const int row_end, const bool erode)
+{
+  if (radius <= 0 || row_begin >= row_end || words_per_row_ == 0) return;
+  // the pixels out of the image are neutral: set for erosion and cleared for dilation
+  const uint64_t fill = erode ? ~uint64_t{0} : uint64_t{0};
+  const uint64_t padding = paddingBits();
+  const size_t last_word_idx = words_per_row_ - 1;
+
+  // a square is the product of a horizontal and a vertical segment, each of which is applied as
+  // radius passes of a 3 pixels segment
+  for (int row = row_begin; row < row_end; ++row) {
+    uint64_t * words = &words_[wordIndex(row, 0)];
+    for (int pass = 0; pass < radius; ++pass) {
+      words[last_word_idx] = (words[last_word_idx] & ~padding) | (fill & padding);
+      uint64_t previous = fill;
+      for (size_t i = 0; i < words_per_row_; ++i) {
+        const uint64_t current = words[i];
+        const uint64_t next = i < last_word_idx ? words[i + 1] : fill;
+        // bit j of left and right is the column on the left and on the right of column j
+        const uint64_t left = (current << 1) | (previous >> 63);
+        const uint64_t right = (current >> 1) | (next << 63);
+        words[i] = erode ? (current & left & right) : (current | left | right);
+        previous = current;
+      }
+    }
+    words[last_word_idx] &= ~padding;
+  }
+
+  previous_row_.resize(words_per_row_);
+  current_row_.resize(words_per_row_);
+  for (int pass = 0; pass < radius; ++pass) {
+    std::fill(previous_row_.begin(), previous_row_.end(), fill);
+    for (int row = row_begin; row < row_end; ++row) {
+      uint64_t * words = &words_[wordIndex(row, 0)];
+      const uint64_t * next_words = row + 1 < row_end ? words + words_per_row_ : nullptr;
+      for (size_t i = 0; i < words_per_row_; ++i) {
+        const uint64_t current = words[i];
+        const uint64_t next = next_words ? next_words[i] : fill;
+        current_row_[i] = current;
+        const uint64_t previous = previous_row_[i];
+        words[i] = erode ? (previous & current & next) : (previous | current | next);
+      }
+      std::swap(previous_row_, current_row_);
+    }
+  }
+}
+
+void BitMaskTimeSeries::setCapacity(const size_t capacity)
+{
+  capacity_ = capacity;
+  masks_.resize(capacity);
+  next_index_ = 0;
+  size_ = 0;
+  std::fill(counts_.begin(), counts_.end(), 0);
+}
+
+void BitMaskTimeSeries::addCounts(const BitMask & mask, const int increment)
+{
+  for (int row = 0; row < rows_; ++row) {
+    const uint64_t * words = mask.rowWords(row);
+    uint16_t * row_counts = &counts_[static_cast<size_t>(row) * cols_];
+    for (size_t i = 0; i < mask.wordsPerRow(); ++i) {
+      for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+        row_counts[i * 64 + __builtin_ctzll(word)] += increment;
+      }
+    }
+  }
+}
+
+void BitMaskTimeSeries::push(const BitMask & mask)
+{
+  if (capacity_ == 0) return;
+  if (mask.rows() != rows_ || mask.cols() != cols_) {
+    rows_ = mask.rows();
+    cols_ = mask.cols();
+    next_index_ = 0;
+    size_ = 0;
+    counts_.assign(static_cast<size_t>(rows_) * cols_, 0);
+  }
+
+  if (size_ == capacity_) {
+    addCounts(masks_[next_index_], -1);
+  } else {
+    ++size_;
+  }
+  masks_[next_index_] = mask;
+  addCounts(mask, 1);
+  next_index_ = (next_index_ + 1) % capacity_;
+}
+
+void BitMaskTimeSeries::getResult(const int rows, const int cols, BitMask & result) const
+{
+  result.reset(rows, cols, false);
+  if (size_ == 0 || rows != rows_ || cols != cols_) return;
+  for (int row = 0; row < rows_; ++row) {
+    const uint16_t * row_counts = &counts_[static_cast<size_t>(row) * cols_];
+    for (int col = 0; col < cols_; ++col) {
+      if (row_counts[col] + 1U >= size_) {
+        result.set(row, col, true);
+      }
+    }
+  }
+}
+
+}  // namespace autoware::pointcloud_preprocessor
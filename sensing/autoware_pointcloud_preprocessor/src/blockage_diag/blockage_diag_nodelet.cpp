@@ -14,9 +14,11 @@
 
 #include "autoware/pointcloud_preprocessor/blockage_diag/blockage_diag_nodelet.hpp"
 
+#include "autoware/pointcloud_preprocessor/utility/memory.hpp"
 #include "autoware_point_types/types.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <numeric>
 
 namespace autoware::pointcloud_preprocessor
@@ -24,6 +26,22 @@ namespace autoware::pointcloud_preprocessor
 using autoware_point_types::PointXYZIRCAEDT;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
+namespace
+{
+cv::Mat toImage(const BitMask & mask)
+{
+  cv::Mat image(cv::Size(mask.cols(), mask.rows()), CV_8UC1, cv::Scalar(0));
+  for (int row = 0; row < mask.rows(); ++row) {
+    for (int col = 0; col < mask.cols(); ++col) {
+      if (mask.get(row, col)) {
+        image.at<uint8_t>(row, col) = 255;
+      }
+    }
+  }
+  return image;
+}
+}  // namespace
+
 BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options)
 : Filter("BlockageDiag", options)
 {
@@ -47,9 +65,12 @@ BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options
     max_distance_range_ = declare_parameter<double>("max_distance_range");
     horizontal_resolution_ = declare_parameter<double>("horizontal_resolution");
     blockage_kernel_ = declare_parameter<int>("blockage_kernel");
+    use_bit_packed_masks_ = declare_parameter<bool>("use_bit_packed_masks", false);
   }
   dust_mask_buffer.set_capacity(dust_buffering_frames_);
   no_return_mask_buffer.set_capacity(blockage_buffering_frames_);
+  dust_mask_time_series_.setCapacity(dust_buffering_frames_);
+  no_return_mask_time_series_.setCapacity(blockage_buffering_frames_);
   if (vertical_bins_ <= horizontal_ring_id_) {
     RCLCPP_ERROR(
       this->get_logger(),
@@ -169,6 +190,11 @@ void BlockageDiagComponent::filter(
   }
   ideal_horizontal_bins = static_cast<int>(
     (angle_range_deg_[1] + compensate_angle - angle_range_deg_[0]) / horizontal_resolution_);
+  if (use_bit_packed_masks_ && utils::is_data_layout_compatible_with_point_xyzircaedt(*input)) {
+    filterWithBitMasks(*input, ideal_horizontal_bins, compensate_angle);
+    output = *input;
+    return;
+  }
   pcl::PointCloud<PointXYZIRCAEDT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRCAEDT>);
   pcl::fromROSMsg(*input, *pcl_input);
   cv::Mat full_size_depth_map(
@@ -176,18 +202,7 @@ void BlockageDiagComponent::filter(
   cv::Mat lidar_depth_map_8u(
     cv::Size(ideal_horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
   if (pcl_input->points.empty()) {
-    ground_blockage_ratio_ = 1.0f;
-    sky_blockage_ratio_ = 1.0f;
-    if (ground_blockage_count_ <= 2 * blockage_count_threshold_) {
-      ground_blockage_count_ += 1;
-    }
-    if (sky_blockage_count_ <= 2 * blockage_count_threshold_) {
-      sky_blockage_count_ += 1;
-    }
-    ground_blockage_range_deg_[0] = angle_range_deg_[0];
-    ground_blockage_range_deg_[1] = angle_range_deg_[1];
-    sky_blockage_range_deg_[0] = angle_range_deg_[0];
-    sky_blockage_range_deg_[1] = angle_range_deg_[1];
+    setEmptyInputBlockage();
   } else {
     for (const auto p : pcl_input->points) {
       double azimuth_deg = p.azimuth * (180.0 / M_PI);
@@ -261,30 +276,18 @@ void BlockageDiagComponent::filter(
                           static_cast<float>(ideal_horizontal_bins * horizontal_ring_id_);
   }
 
-  if (ground_blockage_ratio_ > blockage_ratio_threshold_) {
-    cv::Rect ground_blockage_bb = cv::boundingRect(ground_no_return_mask);
-    ground_blockage_range_deg_[0] =
-      ground_blockage_bb.x * horizontal_resolution_ + angle_range_deg_[0];
-    ground_blockage_range_deg_[1] =
-      (ground_blockage_bb.x + ground_blockage_bb.width) * horizontal_resolution_ +
-      angle_range_deg_[0];
-    if (ground_blockage_count_ <= 2 * blockage_count_threshold_) {
-      ground_blockage_count_ += 1;
-    }
-  } else {
-    ground_blockage_count_ = 0;
-  }
-  if (sky_blockage_ratio_ > blockage_ratio_threshold_) {
-    cv::Rect sky_blockage_bx = cv::boundingRect(sky_no_return_mask);
-    sky_blockage_range_deg_[0] = sky_blockage_bx.x * horizontal_resolution_ + angle_range_deg_[0];
-    sky_blockage_range_deg_[1] =
-      (sky_blockage_bx.x + sky_blockage_bx.width) * horizontal_resolution_ + angle_range_deg_[0];
-    if (sky_blockage_count_ <= 2 * blockage_count_threshold_) {
-      sky_blockage_count_ += 1;
-    }
-  } else {
-    sky_blockage_count_ = 0;
-  }
+  const cv::Rect ground_blockage_bb = ground_blockage_ratio_ > blockage_ratio_threshold_
+                                        ? cv::boundingRect(ground_no_return_mask)
+                                        : cv::Rect();
+  updateBlockageState(
+    ground_blockage_ratio_, ground_blockage_bb.x, ground_blockage_bb.x + ground_blockage_bb.width,
+    ground_blockage_range_deg_, ground_blockage_count_);
+  const cv::Rect sky_blockage_bx = sky_blockage_ratio_ > blockage_ratio_threshold_
+                                     ? cv::boundingRect(sky_no_return_mask)
+                                     : cv::Rect();
+  updateBlockageState(
+    sky_blockage_ratio_, sky_blockage_bx.x, sky_blockage_bx.x + sky_blockage_bx.width,
+    sky_blockage_range_deg_, sky_blockage_count_);
   // dust
   if (enable_dust_diag_) {
     cv::Mat ground_depth_map = lidar_depth_map_8u(
@@ -305,19 +308,9 @@ void BlockageDiagComponent::filter(
     cv::Mat ground_mask(cv::Size(ideal_horizontal_bins, horizontal_ring_id_), CV_8UC1);
     cv::vconcat(sky_blank, single_dust_ground_img, single_dust_img);
 
-    tier4_debug_msgs::msg::Float32Stamped ground_dust_ratio_msg;
-    ground_dust_ratio_ = static_cast<float>(cv::countNonZero(single_dust_ground_img)) /
-                         (single_dust_ground_img.cols * single_dust_ground_img.rows);
-    ground_dust_ratio_msg.data = ground_dust_ratio_;
-    ground_dust_ratio_msg.stamp = now();
-    ground_dust_ratio_pub_->publish(ground_dust_ratio_msg);
-    if (ground_dust_ratio_ > dust_ratio_threshold_) {
-      if (dust_frame_count_ < 2 * dust_count_threshold_) {
-        dust_frame_count_++;
-      }
-    } else {
-      dust_frame_count_ = 0;
-    }
+    updateGroundDustRatio(
+      static_cast<float>(cv::countNonZero(single_dust_ground_img)) /
+      (single_dust_ground_img.cols * single_dust_ground_img.rows));
 
     if (publish_debug_image_) {
       cv::Mat binarized_dust_mask_(
@@ -345,37 +338,198 @@ void BlockageDiagComponent::filter(
           multi_frame_dust_mask, dust_mask_buffer.size() - 1, dust_mask_buffer.size(),
           multi_frame_ground_dust_result);
       }
-      cv::Mat single_frame_ground_dust_colorized(
-        cv::Size(ideal_horizontal_bins, vertical_bins), CV_8UC3, cv::Scalar(0, 0, 0));
-      cv::applyColorMap(single_dust_img, single_frame_ground_dust_colorized, cv::COLORMAP_JET);
-      cv::Mat multi_frame_ground_dust_colorized;
-      cv::Mat blockage_dust_merged_img(
-        cv::Size(ideal_horizontal_bins, vertical_bins), CV_8UC3, cv::Scalar(0, 0, 0));
-      cv::Mat blockage_dust_merged_mask(
-        cv::Size(ideal_horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-      blockage_dust_merged_img.setTo(
-        cv::Vec3b(0, 0, 255), time_series_blockage_result);  // red:blockage
-      blockage_dust_merged_img.setTo(
-        cv::Vec3b(0, 255, 255), multi_frame_ground_dust_result);  // yellow:dust
-      sensor_msgs::msg::Image::SharedPtr single_frame_dust_mask_msg =
-        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", single_frame_ground_dust_colorized)
-          .toImageMsg();
-      single_frame_dust_mask_pub.publish(single_frame_dust_mask_msg);
-      sensor_msgs::msg::Image::SharedPtr multi_frame_dust_mask_msg =
-        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", multi_frame_ground_dust_colorized)
-          .toImageMsg();
-      multi_frame_dust_mask_pub.publish(multi_frame_dust_mask_msg);
-      cv::Mat blockage_dust_merged_colorized(
-        cv::Size(ideal_horizontal_bins, vertical_bins), CV_8UC3, cv::Scalar(0, 0, 0));
-      blockage_dust_merged_img.copyTo(blockage_dust_merged_colorized);
-      sensor_msgs::msg::Image::SharedPtr blockage_dust_merged_msg =
-        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_dust_merged_colorized)
-          .toImageMsg();
-      blockage_dust_merged_msg->header = input->header;
-      blockage_dust_merged_pub.publish(blockage_dust_merged_msg);
+      publishDustDebugImages(
+        input->header, single_dust_img, time_series_blockage_result,
+        multi_frame_ground_dust_result);
     }
   }
 
+  publishBlockageRatios();
+  if (publish_debug_image_) {
+    publishBlockageDebugImages(input->header, full_size_depth_map, time_series_blockage_result);
+  }
+
+  pcl::toROSMsg(*pcl_input, output);
+  output.header = input->header;
+}
+
+void BlockageDiagComponent::filterWithBitMasks(
+  const PointCloud2 & input, const int ideal_horizontal_bins, const double compensate_angle)
+{
+  using PointIndex = autoware_point_types::PointXYZIRCAEDTIndex;
+  const int vertical_bins = vertical_bins_;
+  const int ground_area = ideal_horizontal_bins * (vertical_bins - horizontal_ring_id_);
+
+  // a bin is set when it has no return, that is when its pixel of lidar_depth_map_8u in the image
+  // mode, depth_intensity / 300 rounded, is 0 or 1
+  no_return_mask_.reset(vertical_bins, ideal_horizontal_bins, true);
+  cv::Mat full_size_depth_map;
+  if (publish_debug_image_) {
+    full_size_depth_map =
+      cv::Mat(cv::Size(ideal_horizontal_bins, vertical_bins), CV_16UC1, cv::Scalar(0));
+  }
+  if (input.data.empty()) {
+    setEmptyInputBlockage();
+  }
+  const auto azimuth_offset = input.fields.at(static_cast<size_t>(PointIndex::Azimuth)).offset;
+  const auto distance_offset = input.fields.at(static_cast<size_t>(PointIndex::Distance)).offset;
+  const auto channel_offset = input.fields.at(static_cast<size_t>(PointIndex::Channel)).offset;
+  for (size_t data_idx = 0; data_idx + input.point_step <= input.data.size();
+       data_idx += input.point_step) {
+    float azimuth;
+    float distance;
+    uint16_t channel;
+    std::memcpy(&azimuth, &input.data[data_idx + azimuth_offset], sizeof(float));
+    std::memcpy(&distance, &input.data[data_idx + distance_offset], sizeof(float));
+    std::memcpy(&channel, &input.data[data_idx + channel_offset], sizeof(uint16_t));
+    const double azimuth_deg = azimuth * (180.0 / M_PI);
+    if (!(((azimuth_deg > angle_range_deg_[0]) &&
+           (azimuth_deg <= angle_range_deg_[1] + compensate_angle)) ||
+          ((azimuth_deg + compensate_angle > angle_range_deg_[0]) &&
+           (azimuth_deg < angle_range_deg_[1])))) {
+      continue;
+    }
+    const double current_angle_range = (azimuth_deg + compensate_angle - angle_range_deg_[0]);
+    const int horizontal_bin_index =
+      static_cast<int>(current_angle_range / horizontal_resolution_) %
+      static_cast<int>(360.0 / horizontal_resolution_);
+    const int row = is_channel_order_top2down_ ? channel : vertical_bins - channel - 1;
+    if (row < 0 || row >= vertical_bins || horizontal_bin_index >= ideal_horizontal_bins) {
+      continue;
+    }
+    const uint16_t depth_intensity =
+      UINT16_MAX * (1.0 - std::min(distance / max_distance_range_, 1.0));
+    no_return_mask_.set(row, horizontal_bin_index, depth_intensity / 300.0 < 1.5);
+    if (publish_debug_image_) {
+      full_size_depth_map.at<uint16_t>(row, horizontal_bin_index) = depth_intensity;
+    }
+  }
+
+  // opening
+  blockage_mask_ = no_return_mask_;
+  blockage_mask_.erode(blockage_kernel_, 0, vertical_bins);
+  blockage_mask_.dilate(blockage_kernel_, 0, vertical_bins);
+
+  // the time series is only shown in the debug images
+  if (blockage_buffering_interval_ == 0) {
+    time_series_blockage_result_ = blockage_mask_;
+  } else {
+    if (blockage_frame_count_ >= blockage_buffering_interval_) {
+      no_return_mask_time_series_.push(blockage_mask_);
+      blockage_frame_count_ = 0;
+    } else {
+      blockage_frame_count_++;
+    }
+    if (publish_debug_image_) {
+      no_return_mask_time_series_.getResult(
+        vertical_bins, ideal_horizontal_bins, time_series_blockage_result_);
+    }
+  }
+
+  ground_blockage_ratio_ =
+    static_cast<float>(blockage_mask_.count(horizontal_ring_id_, vertical_bins)) /
+    static_cast<float>(ground_area);
+  if (horizontal_ring_id_ == 0) {
+    sky_blockage_ratio_ = 0.0f;
+  } else {
+    sky_blockage_ratio_ = static_cast<float>(blockage_mask_.count(0, horizontal_ring_id_)) /
+                          static_cast<float>(ideal_horizontal_bins * horizontal_ring_id_);
+  }
+  const auto ground_blockage_columns =
+    blockage_mask_.columnRange(horizontal_ring_id_, vertical_bins);
+  updateBlockageState(
+    ground_blockage_ratio_, ground_blockage_columns.first, ground_blockage_columns.second,
+    ground_blockage_range_deg_, ground_blockage_count_);
+  const auto sky_blockage_columns = blockage_mask_.columnRange(0, horizontal_ring_id_);
+  updateBlockageState(
+    sky_blockage_ratio_, sky_blockage_columns.first, sky_blockage_columns.second,
+    sky_blockage_range_deg_, sky_blockage_count_);
+
+  if (enable_dust_diag_) {
+    // closing of the ground rows
+    dust_mask_ = no_return_mask_;
+    dust_mask_.clearRows(0, horizontal_ring_id_);
+    dust_mask_.dilate(dust_kernel_size_, horizontal_ring_id_, vertical_bins);
+    dust_mask_.erode(dust_kernel_size_, horizontal_ring_id_, vertical_bins);
+    updateGroundDustRatio(
+      static_cast<float>(dust_mask_.count(horizontal_ring_id_, vertical_bins)) / ground_area);
+
+    if (publish_debug_image_) {
+      if (dust_buffering_interval_ == 0) {
+        multi_frame_dust_result_ = dust_mask_;
+        dust_buffering_frame_counter_ = 0;
+      } else {
+        if (dust_buffering_frame_counter_ >= dust_buffering_interval_) {
+          dust_mask_time_series_.push(dust_mask_);
+          dust_buffering_frame_counter_ = 0;
+        } else {
+          dust_buffering_frame_counter_++;
+        }
+        dust_mask_time_series_.getResult(
+          vertical_bins, ideal_horizontal_bins, multi_frame_dust_result_);
+      }
+      publishDustDebugImages(
+        input.header, toImage(dust_mask_), toImage(time_series_blockage_result_),
+        toImage(multi_frame_dust_result_));
+    }
+  }
+
+  publishBlockageRatios();
+  if (publish_debug_image_) {
+    publishBlockageDebugImages(
+      input.header, full_size_depth_map, toImage(time_series_blockage_result_));
+  }
+}
+
+void BlockageDiagComponent::setEmptyInputBlockage()
+{
+  ground_blockage_ratio_ = 1.0f;
+  sky_blockage_ratio_ = 1.0f;
+  if (ground_blockage_count_ <= 2 * blockage_count_threshold_) {
+    ground_blockage_count_ += 1;
+  }
+  if (sky_blockage_count_ <= 2 * blockage_count_threshold_) {
+    sky_blockage_count_ += 1;
+  }
+  ground_blockage_range_deg_[0] = angle_range_deg_[0];
+  ground_blockage_range_deg_[1] = angle_range_deg_[1];
+  sky_blockage_range_deg_[0] = angle_range_deg_[0];
+  sky_blockage_range_deg_[1] = angle_range_deg_[1];
+}
+
+void BlockageDiagComponent::updateBlockageState(
+  const float blockage_ratio, const int blockage_begin_col, const int blockage_end_col,
+  std::vector<float> & blockage_range_deg, int & blockage_count) const
+{
+  if (blockage_ratio > blockage_ratio_threshold_) {
+    blockage_range_deg[0] = blockage_begin_col * horizontal_resolution_ + angle_range_deg_[0];
+    blockage_range_deg[1] = blockage_end_col * horizontal_resolution_ + angle_range_deg_[0];
+    if (blockage_count <= 2 * blockage_count_threshold_) {
+      blockage_count += 1;
+    }
+  } else {
+    blockage_count = 0;
+  }
+}
+
+void BlockageDiagComponent::updateGroundDustRatio(const float ground_dust_ratio)
+{
+  tier4_debug_msgs::msg::Float32Stamped ground_dust_ratio_msg;
+  ground_dust_ratio_ = ground_dust_ratio;
+  ground_dust_ratio_msg.data = ground_dust_ratio_;
+  ground_dust_ratio_msg.stamp = now();
+  ground_dust_ratio_pub_->publish(ground_dust_ratio_msg);
+  if (ground_dust_ratio_ > dust_ratio_threshold_) {
+    if (dust_frame_count_ < 2 * dust_count_threshold_) {
+      dust_frame_count_++;
+    }
+  } else {
+    dust_frame_count_ = 0;
+  }
+}
+
+void BlockageDiagComponent::publishBlockageRatios()
+{
   tier4_debug_msgs::msg::Float32Stamped ground_blockage_ratio_msg;
   ground_blockage_ratio_msg.data = ground_blockage_ratio_;
   ground_blockage_ratio_msg.stamp = now();
@@ -385,22 +539,53 @@ void BlockageDiagComponent::filter(
   sky_blockage_ratio_msg.data = sky_blockage_ratio_;
   sky_blockage_ratio_msg.stamp = now();
   sky_blockage_ratio_pub_->publish(sky_blockage_ratio_msg);
-  if (publish_debug_image_) {
-    sensor_msgs::msg::Image::SharedPtr lidar_depth_map_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "mono16", full_size_depth_map).toImageMsg();
-    lidar_depth_map_msg->header = input->header;
-    lidar_depth_map_pub_.publish(lidar_depth_map_msg);
-    cv::Mat blockage_mask_colorized;
-    cv::applyColorMap(time_series_blockage_result, blockage_mask_colorized, cv::COLORMAP_JET);
-    sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
-    blockage_mask_msg->header = input->header;
-    blockage_mask_pub_.publish(blockage_mask_msg);
-  }
+}
 
-  pcl::toROSMsg(*pcl_input, output);
-  output.header = input->header;
+void BlockageDiagComponent::publishDustDebugImages(
+  const std_msgs::msg::Header & header, const cv::Mat & single_dust_img,
+  const cv::Mat & time_series_blockage_result, const cv::Mat & multi_frame_ground_dust_result)
+{
+  cv::Mat single_frame_ground_dust_colorized(single_dust_img.size(), CV_8UC3, cv::Scalar(0, 0, 0));
+  cv::applyColorMap(single_dust_img, single_frame_ground_dust_colorized, cv::COLORMAP_JET);
+  cv::Mat multi_frame_ground_dust_colorized;
+  cv::Mat blockage_dust_merged_img(single_dust_img.size(), CV_8UC3, cv::Scalar(0, 0, 0));
+  blockage_dust_merged_img.setTo(
+    cv::Vec3b(0, 0, 255), time_series_blockage_result);  // red:blockage
+  blockage_dust_merged_img.setTo(
+    cv::Vec3b(0, 255, 255), multi_frame_ground_dust_result);  // yellow:dust
+  sensor_msgs::msg::Image::SharedPtr single_frame_dust_mask_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", single_frame_ground_dust_colorized)
+      .toImageMsg();
+  single_frame_dust_mask_pub.publish(single_frame_dust_mask_msg);
+  sensor_msgs::msg::Image::SharedPtr multi_frame_dust_mask_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", multi_frame_ground_dust_colorized)
+      .toImageMsg();
+  multi_frame_dust_mask_pub.publish(multi_frame_dust_mask_msg);
+  cv::Mat blockage_dust_merged_colorized(single_dust_img.size(), CV_8UC3, cv::Scalar(0, 0, 0));
+  blockage_dust_merged_img.copyTo(blockage_dust_merged_colorized);
+  sensor_msgs::msg::Image::SharedPtr blockage_dust_merged_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_dust_merged_colorized)
+      .toImageMsg();
+  blockage_dust_merged_msg->header = header;
+  blockage_dust_merged_pub.publish(blockage_dust_merged_msg);
+}
+
+void BlockageDiagComponent::publishBlockageDebugImages(
+  const std_msgs::msg::Header & header, const cv::Mat & full_size_depth_map,
+  const cv::Mat & time_series_blockage_result)
+{
+  sensor_msgs::msg::Image::SharedPtr lidar_depth_map_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "mono16", full_size_depth_map).toImageMsg();
+  lidar_depth_map_msg->header = header;
+  lidar_depth_map_pub_.publish(lidar_depth_map_msg);
+  cv::Mat blockage_mask_colorized;
+  cv::applyColorMap(time_series_blockage_result, blockage_mask_colorized, cv::COLORMAP_JET);
+  sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
+  blockage_mask_msg->header = header;
+  blockage_mask_pub_.publish(blockage_mask_msg);
 }
+
 rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
@@ -451,6 +636,9 @@ rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
       get_logger(), "Setting new dust_buffering_interval_ to: %d.", dust_buffering_interval_);
     dust_buffering_frame_counter_ = 0;
   }
+  if (get_param(p, "use_bit_packed_masks", use_bit_packed_masks_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new use_bit_packed_masks to: %d.", use_bit_packed_masks_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
@@ -0,0 +1,241 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/outlier_filter/ring_outlier_filter.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+
+RingOutlierFilter::RingOutlierFilter()
+{
+  // This is a hack to get the correct fields in the output point cloud without creating the fields
+  // manually
+  sensor_msgs::msg::PointCloud2 msg_aux;
+  pcl::toROSMsg(pcl::PointCloud<OutputPointType>(), msg_aux);
+  output_fields_ = msg_aux.fields;
+}
+
+void RingOutlierFilter::bucketPointsByRing(const PointCloud2 & input, const size_t channel_offset)
+{
+  // count the points of each ring, at ring + 1 so that the prefix sum gives the beginnings
+  ring_begins_.assign(static_cast<size_t>(param_.max_rings_num) + 1, 0);
+  for (size_t data_idx = 0; data_idx + input.point_step <= input.data.size();
+       data_idx += input.point_step) {
+    const uint16_t ring =
+      *reinterpret_cast<const uint16_t *>(&input.data[data_idx + channel_offset]);
+    if (ring + 1U >= ring_begins_.size()) {
+      ring_begins_.resize(ring + 2U, 0);
+    }
+    ++ring_begins_[ring + 1U];
+  }
+  for (size_t ring = 1; ring < ring_begins_.size(); ++ring) {
+    ring_begins_[ring] += ring_begins_[ring - 1];
+  }
+
+  // kept_counts_ is used as the insertion position of each ring here
+  kept_counts_.assign(ring_begins_.begin(), ring_begins_.end() - 1);
+  sorted_data_indices_.resize(ring_begins_.back());
+  for (size_t data_idx = 0; data_idx + input.point_step <= input.data.size();
+       data_idx += input.point_step) {
+    const uint16_t ring =
+      *reinterpret_cast<const uint16_t *>(&input.data[data_idx + channel_offset]);
+    sorted_data_indices_[kept_counts_[ring]++] = data_idx;
+  }
+}
+
+void RingOutlierFilter::filter(
+  const PointCloud2 & input, const TransformInfo & transform_info, PointCloud2 & output,
+  pcl::PointCloud<InputPointType> * outlier_points, float * visibility_score)
+{
+  const auto input_channel_offset =
+    input.fields.at(static_cast<size_t>(InputPointIndex::Channel)).offset;
+  const auto input_azimuth_offset =
+    input.fields.at(static_cast<size_t>(InputPointIndex::Azimuth)).offset;
+  const auto input_distance_offset =
+    input.fields.at(static_cast<size_t>(InputPointIndex::Distance)).offset;
+  const auto input_intensity_offset =
+    input.fields.at(static_cast<size_t>(InputPointIndex::Intensity)).offset;
+  const auto input_return_type_offset =
+    input.fields.at(static_cast<size_t>(InputPointIndex::ReturnType)).offset;
+
+  bucketPointsByRing(input, input_channel_offset);
+  const size_t num_rings = ring_begins_.size() - 1;
+
+  output.point_step = sizeof(OutputPointType);
+  output.data.resize(output.point_step * sorted_data_indices_.size());
+  kept_counts_.assign(num_rings, 0);
+  outlier_counts_.assign(num_rings, 0);
+  if (outlier_points) {
+    outlier_data_indices_.resize(sorted_data_indices_.size());
+  }
+
+  const int vertical_bins = param_.vertical_bins;
+  const int horizontal_bins = param_.horizontal_bins;
+  const float max_azimuth = param_.max_azimuth_deg * (M_PI / 180.f);
+  const float min_azimuth = param_.min_azimuth_deg * (M_PI / 180.f);
+  const uint32_t horizontal_resolution =
+    static_cast<uint32_t>((max_azimuth - min_azimuth) / horizontal_bins);
+  if (visibility_score) {
+    occupied_bins_.assign(static_cast<size_t>(vertical_bins) * horizontal_bins, 0);
+  }
+
+  const auto get_float = [&](const size_t data_idx, const size_t offset) {
+    return *reinterpret_cast<const float *>(&input.data[data_idx + offset]);
+  };
+
+#pragma omp parallel for schedule(dynamic)
+  for (int ring = 0; ring < static_cast<int>(num_rings); ++ring) {
+    const size_t * indices = sorted_data_indices_.data() + ring_begins_[ring];
+    const size_t num_points = ring_begins_[ring + 1] - ring_begins_[ring];
+    if (num_points < 2) continue;
+
+    auto output_ptr =
+      reinterpret_cast<OutputPointType *>(&output.data[ring_begins_[ring] * output.point_step]);
+    size_t * outlier_indices =
+      outlier_points ? outlier_data_indices_.data() + ring_begins_[ring] : nullptr;
+    uint8_t * ring_bins = visibility_score && ring < vertical_bins
+                            ? occupied_bins_.data() + static_cast<size_t>(ring) * horizontal_bins
+                            : nullptr;
+    size_t kept_count = 0;
+    size_t outlier_count = 0;
+
+    // handle the walk range [walk_first_idx, walk_last_idx]
+    const auto handle_walk = [&](const size_t walk_first_idx, const size_t walk_last_idx) {
+      if (isCluster(
+            input, std::make_pair(indices[walk_first_idx], indices[walk_last_idx]),
+            static_cast<int>(walk_last_idx - walk_first_idx + 1))) {
+        for (size_t i = walk_first_idx; i <= walk_last_idx; i++) {
+          auto input_ptr = reinterpret_cast<const InputPointType *>(&input.data[indices[i]]);
+          if (transform_info.need_transform) {
+            Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
+            p = transform_info.eigen_transform * p;
+            output_ptr->x = p[0];
+            output_ptr->y = p[1];
+            output_ptr->z = p[2];
+          } else {
+            output_ptr->x = input_ptr->x;
+            output_ptr->y = input_ptr->y;
+            output_ptr->z = input_ptr->z;
+          }
+          output_ptr->intensity = input.data[indices[i] + input_intensity_offset];
+          output_ptr->return_type = input.data[indices[i] + input_return_type_offset];
+          output_ptr->channel = static_cast<uint16_t>(ring);
+          ++output_ptr;
+        }
+        kept_count += walk_last_idx - walk_first_idx + 1;
+        return;
+      }
+
+      for (size_t i = walk_first_idx; i <= walk_last_idx; i++) {
+        if (outlier_indices) {
+          outlier_indices[outlier_count++] = indices[i];
+        }
+        if (!ring_bins) continue;
+        const float azimuth = get_float(indices[i], input_azimuth_offset);
+        if (azimuth < min_azimuth || azimuth >= max_azimuth) continue;
+        if (get_float(indices[i], input_distance_offset) >= param_.max_distance) continue;
+        const uint bin_index = static_cast<uint>((azimuth - min_azimuth) / horizontal_resolution);
+        if (bin_index < static_cast<uint>(horizontal_bins)) {
+          ring_bins[bin_index] = 1;
+        }
+      }
+    };
+
+    size_t walk_first_idx = 0;
+    for (size_t idx = 0U; idx < num_points - 1; ++idx) {
+      const size_t current_data_idx = indices[idx];
+      const size_t next_data_idx = indices[idx + 1];
+
+      // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
+
+      const float current_azimuth = get_float(current_data_idx, input_azimuth_offset);
+      const float next_azimuth = get_float(next_data_idx, input_azimuth_offset);
+      float azimuth_diff = next_azimuth - current_azimuth;
+      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 2 * M_PI : azimuth_diff;
+
+      const float current_distance = get_float(current_data_idx, input_distance_offset);
+      const float next_distance = get_float(next_data_idx, input_distance_offset);
+
+      if (
+        std::max(current_distance, next_distance) <
+          std::min(current_distance, next_distance) * param_.distance_ratio &&
+        azimuth_diff < 1.0 * (180.0 / M_PI)) {  // one degree
+        continue;                               // Determined to be included in the same walk
+      }
+
+      handle_walk(walk_first_idx, idx);
+      walk_first_idx = idx + 1;
+    }
+
+    // the last walk ends before the last point of the ring
+    if (walk_first_idx <= num_points - 2) {
+      handle_walk(walk_first_idx, num_points - 2);
+    }
+
+    kept_counts_[ring] = kept_count;
+    outlier_counts_[ring] = outlier_count;
+  }
+
+  // concatenate the ranges of the rings
+  size_t output_size = 0;
+  for (size_t ring = 0; ring < num_rings; ++ring) {
+    const size_t ring_size = kept_counts_[ring] * output.point_step;
+    const size_t ring_offset = ring_begins_[ring] * output.point_step;
+    if (ring_size > 0 && ring_offset != output_size) {
+      std::memmove(&output.data[output_size], &output.data[ring_offset], ring_size);
+    }
+    output_size += ring_size;
+  }
+
+  if (outlier_points) {
+    for (size_t ring = 0; ring < num_rings; ++ring) {
+      for (size_t i = 0; i < outlier_counts_[ring]; ++i) {
+        auto input_ptr = reinterpret_cast<const InputPointType *>(
+          &input.data[outlier_data_indices_[ring_begins_[ring] + i]]);
+        InputPointType outlier_point = *input_ptr;
+        if (transform_info.need_transform) {
+          Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
+          p = transform_info.eigen_transform * p;
+          outlier_point.x = p[0];
+          outlier_point.y = p[1];
+          outlier_point.z = p[2];
+        }
+        outlier_points->push_back(outlier_point);
+      }
+    }
+  }
+
+  if (visibility_score) {
+    const auto num_filled_bins = std::count(occupied_bins_.begin(), occupied_bins_.end(), 1);
+    *visibility_score = 1.0f - static_cast<float>(num_filled_bins) /
+                                 static_cast<float>(vertical_bins * horizontal_bins);
+  }
+
+  output.data.resize(output_size);
+  output.height = 1;
+  output.width = static_cast<uint32_t>(output.data.size() / output.point_step);
+  output.row_step = static_cast<uint32_t>(output.data.size());
+  output.is_bigendian = input.is_bigendian;
+  output.is_dense = input.is_dense;
+  output.fields = output_fields_;
+}
+
+}  // namespace autoware::pointcloud_preprocessor
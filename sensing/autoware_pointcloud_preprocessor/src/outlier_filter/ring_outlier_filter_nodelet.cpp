@@ -47,22 +47,24 @@ RingOutlierFilterComponent::RingOutlierFilterComponent(const rclcpp::NodeOptions
 
   // set initial parameters
   {
-    distance_ratio_ = static_cast<double>(declare_parameter("distance_ratio", 1.03));
-    object_length_threshold_ =
+    RingOutlierFilterParam param;
+    param.distance_ratio = static_cast<double>(declare_parameter("distance_ratio", 1.03));
+    param.object_length_threshold =
       static_cast<double>(declare_parameter("object_length_threshold", 0.1));
-    num_points_threshold_ = static_cast<int>(declare_parameter("num_points_threshold", 4));
-    max_rings_num_ = static_cast<uint16_t>(declare_parameter("max_rings_num", 128));
-    max_points_num_per_ring_ =
+    param.num_points_threshold = static_cast<int>(declare_parameter("num_points_threshold", 4));
+    param.max_rings_num = static_cast<uint16_t>(declare_parameter("max_rings_num", 128));
+    param.max_points_num_per_ring =
       static_cast<size_t>(declare_parameter("max_points_num_per_ring", 4000));
     publish_outlier_pointcloud_ =
       static_cast<bool>(declare_parameter("publish_outlier_pointcloud", false));
 
-    min_azimuth_deg_ = static_cast<float>(declare_parameter("min_azimuth_deg", 0.0));
-    max_azimuth_deg_ = static_cast<float>(declare_parameter("max_azimuth_deg", 360.0));
-    max_distance_ = static_cast<float>(declare_parameter("max_distance", 12.0));
-    vertical_bins_ = static_cast<int>(declare_parameter("vertical_bins", 128));
-    horizontal_bins_ = static_cast<int>(declare_parameter("horizontal_bins", 36));
+    param.min_azimuth_deg = static_cast<float>(declare_parameter("min_azimuth_deg", 0.0));
+    param.max_azimuth_deg = static_cast<float>(declare_parameter("max_azimuth_deg", 360.0));
+    param.max_distance = static_cast<float>(declare_parameter("max_distance", 12.0));
+    param.vertical_bins = static_cast<int>(declare_parameter("vertical_bins", 128));
+    param.horizontal_bins = static_cast<int>(declare_parameter("horizontal_bins", 36));
     noise_threshold_ = static_cast<int>(declare_parameter("noise_threshold", 2));
+    ring_outlier_filter_.setParam(param);
   }
 
   using std::placeholders::_1;
@@ -82,178 +84,17 @@ void RingOutlierFilterComponent::faster_filter(
   }
   stop_watch_ptr_->toc("processing_time", true);
 
-  output.point_step = sizeof(OutputPointType);
-  output.data.resize(output.point_step * input->width);
-  size_t output_size = 0;
-
   pcl::PointCloud<InputPointType>::Ptr outlier_pcl(new pcl::PointCloud<InputPointType>);
-
-  const auto input_channel_offset =
-    input->fields.at(static_cast<size_t>(InputPointIndex::Channel)).offset;
-  const auto input_azimuth_offset =
-    input->fields.at(static_cast<size_t>(InputPointIndex::Azimuth)).offset;
-  const auto input_distance_offset =
-    input->fields.at(static_cast<size_t>(InputPointIndex::Distance)).offset;
-  const auto input_intensity_offset =
-    input->fields.at(static_cast<size_t>(InputPointIndex::Intensity)).offset;
-  const auto input_return_type_offset =
-    input->fields.at(static_cast<size_t>(InputPointIndex::ReturnType)).offset;
-
-  std::vector<std::vector<size_t>> ring2indices;
-  ring2indices.reserve(max_rings_num_);
-
-  for (uint16_t i = 0; i < max_rings_num_; i++) {
-    ring2indices.push_back(std::vector<size_t>());
-    ring2indices.back().reserve(max_points_num_per_ring_);
-  }
-
-  for (size_t data_idx = 0; data_idx < input->data.size(); data_idx += input->point_step) {
-    const uint16_t ring =
-      *reinterpret_cast<const uint16_t *>(&input->data[data_idx + input_channel_offset]);
-    ring2indices[ring].push_back(data_idx);
-  }
-
-  // walk range: [walk_first_idx, walk_last_idx]
-  int walk_first_idx = 0;
-  int walk_last_idx = -1;
-
-  for (const auto & indices : ring2indices) {
-    if (indices.size() < 2) continue;
-
-    walk_first_idx = 0;
-    walk_last_idx = -1;
-
-    for (size_t idx = 0U; idx < indices.size() - 1; ++idx) {
-      const size_t & current_data_idx = indices[idx];
-      const size_t & next_data_idx = indices[idx + 1];
-      walk_last_idx = idx;
-
-      // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
-
-      const float & current_azimuth =
-        *reinterpret_cast<const float *>(&input->data[current_data_idx + input_azimuth_offset]);
-      const float & next_azimuth =
-        *reinterpret_cast<const float *>(&input->data[next_data_idx + input_azimuth_offset]);
-      float azimuth_diff = next_azimuth - current_azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 2 * M_PI : azimuth_diff;
-
-      const float & current_distance =
-        *reinterpret_cast<const float *>(&input->data[current_data_idx + input_distance_offset]);
-      const float & next_distance =
-        *reinterpret_cast<const float *>(&input->data[next_data_idx + input_distance_offset]);
-
-      if (
-        std::max(current_distance, next_distance) <
-          std::min(current_distance, next_distance) * distance_ratio_ &&
-        azimuth_diff < 1.0 * (180.0 / M_PI)) {  // one degree
-        continue;                               // Determined to be included in the same walk
-      }
-
-      if (isCluster(
-            input, std::make_pair(indices[walk_first_idx], indices[walk_last_idx]),
-            walk_last_idx - walk_first_idx + 1)) {
-        for (int i = walk_first_idx; i <= walk_last_idx; i++) {
-          auto output_ptr = reinterpret_cast<OutputPointType *>(&output.data[output_size]);
-          auto input_ptr = reinterpret_cast<const InputPointType *>(&input->data[indices[i]]);
-
-          if (transform_info.need_transform) {
-            Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
-            p = transform_info.eigen_transform * p;
-            output_ptr->x = p[0];
-            output_ptr->y = p[1];
-            output_ptr->z = p[2];
-          } else {
-            output_ptr->x = input_ptr->x;
-            output_ptr->y = input_ptr->y;
-            output_ptr->z = input_ptr->z;
-          }
-          const std::uint8_t & intensity = *reinterpret_cast<const std::uint8_t *>(
-            &input->data[indices[i] + input_intensity_offset]);
-          output_ptr->intensity = intensity;
-
-          const std::uint8_t & return_type = *reinterpret_cast<const std::uint8_t *>(
-            &input->data[indices[i] + input_return_type_offset]);
-          output_ptr->return_type = return_type;
-
-          const std::uint8_t & channel = *reinterpret_cast<const std::uint8_t *>(
-            &input->data[indices[i] + input_channel_offset]);
-          output_ptr->channel = channel;
-
-          output_size += output.point_step;
-        }
-      } else if (publish_outlier_pointcloud_) {
-        for (int i = walk_first_idx; i <= walk_last_idx; i++) {
-          auto input_ptr =
-            reinterpret_cast<const InputPointType *>(&input->data[indices[walk_first_idx]]);
-          InputPointType outlier_point = *input_ptr;
-
-          if (transform_info.need_transform) {
-            Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
-            p = transform_info.eigen_transform * p;
-            outlier_point.x = p[0];
-            outlier_point.y = p[1];
-            outlier_point.z = p[2];
-          }
-
-          outlier_pcl->push_back(outlier_point);
-        }
-      }
-
-      walk_first_idx = idx + 1;
-    }
-
-    if (walk_first_idx > walk_last_idx) continue;
-
-    if (isCluster(
-          input, std::make_pair(indices[walk_first_idx], indices[walk_last_idx]),
-          walk_last_idx - walk_first_idx + 1)) {
-      for (int i = walk_first_idx; i <= walk_last_idx; i++) {
-        auto output_ptr = reinterpret_cast<OutputPointType *>(&output.data[output_size]);
-        auto input_ptr = reinterpret_cast<const InputPointType *>(&input->data[indices[i]]);
-
-        if (transform_info.need_transform) {
-          Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
-          p = transform_info.eigen_transform * p;
-          output_ptr->x = p[0];
-          output_ptr->y = p[1];
-          output_ptr->z = p[2];
-        } else {
-          output_ptr->x = input_ptr->x;
-          output_ptr->y = input_ptr->y;
-          output_ptr->z = input_ptr->z;
-        }
-        const float & intensity =
-          *reinterpret_cast<const float *>(&input->data[indices[i] + input_intensity_offset]);
-        output_ptr->intensity = intensity;
-
-        const std::uint8_t & return_type = *reinterpret_cast<const std::uint8_t *>(
-          &input->data[indices[i] + input_return_type_offset]);
-        output_ptr->return_type = return_type;
-
-        const std::uint8_t & channel =
-          *reinterpret_cast<const std::uint8_t *>(&input->data[indices[i] + input_channel_offset]);
-        output_ptr->channel = channel;
-
-        output_size += output.point_step;
-      }
-    } else if (publish_outlier_pointcloud_) {
-      for (int i = walk_first_idx; i < walk_last_idx; i++) {
-        auto input_ptr = reinterpret_cast<const InputPointType *>(&input->data[indices[i]]);
-        InputPointType outlier_point = *input_ptr;
-        if (transform_info.need_transform) {
-          Eigen::Vector4f p(input_ptr->x, input_ptr->y, input_ptr->z, 1);
-          p = transform_info.eigen_transform * p;
-          outlier_point.x = p[0];
-          outlier_point.y = p[1];
-          outlier_point.z = p[2];
-        }
-
-        outlier_pcl->push_back(outlier_point);
-      }
-    }
+  float visibility_score = 0.0f;
+  if (publish_outlier_pointcloud_) {
+    ring_outlier_filter_.filter(
+      *input, transform_info, output, outlier_pcl.get(), &visibility_score);
+  } else {
+    ring_outlier_filter_.filter(*input, transform_info, output);
   }
-
-  setUpPointCloudFormat(input, output, output_size);
+  // Note that `input->header.frame_id` is data before converted when `transform_info.need_transform
+  // == true`
+  output.header.frame_id = !tf_input_frame_.empty() ? tf_input_frame_ : tf_input_orig_frame_;
 
   if (publish_outlier_pointcloud_) {
     PointCloud2 outlier;
@@ -262,7 +103,7 @@ void RingOutlierFilterComponent::faster_filter(
     outlier_pointcloud_publisher_->publish(outlier);
 
     tier4_debug_msgs::msg::Float32Stamped visibility_msg;
-    visibility_msg.data = calculateVisibilityScore(outlier);
+    visibility_msg.data = visibility_score;
     visibility_msg.stamp = input->header.stamp;
     visibility_pub_->publish(visibility_msg);
   }
@@ -302,38 +143,41 @@ rcl_interfaces::msg::SetParametersResult RingOutlierFilterComponent::paramCallba
 {
   std::scoped_lock lock(mutex_);
 
-  if (get_param(p, "distance_ratio", distance_ratio_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new distance ratio to: %f.", distance_ratio_);
+  auto param = ring_outlier_filter_.getParam();
+  if (get_param(p, "distance_ratio", param.distance_ratio)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new distance ratio to: %f.", param.distance_ratio);
   }
-  if (get_param(p, "object_length_threshold", object_length_threshold_)) {
+  if (get_param(p, "object_length_threshold", param.object_length_threshold)) {
     RCLCPP_DEBUG(
-      get_logger(), "Setting new object length threshold to: %f.", object_length_threshold_);
+      get_logger(), "Setting new object length threshold to: %f.", param.object_length_threshold);
   }
-  if (get_param(p, "num_points_threshold", num_points_threshold_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new num_points_threshold to: %d.", num_points_threshold_);
+  if (get_param(p, "num_points_threshold", param.num_points_threshold)) {
+    RCLCPP_DEBUG(
+      get_logger(), "Setting new num_points_threshold to: %d.", param.num_points_threshold);
   }
   if (get_param(p, "publish_outlier_pointcloud", publish_outlier_pointcloud_)) {
     RCLCPP_DEBUG(
       get_logger(), "Setting new publish_outlier_pointcloud to: %d.", publish_outlier_pointcloud_);
   }
-  if (get_param(p, "vertical_bins", vertical_bins_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new vertical_bins to: %d.", vertical_bins_);
+  if (get_param(p, "vertical_bins", param.vertical_bins)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new vertical_bins to: %d.", param.vertical_bins);
   }
-  if (get_param(p, "horizontal_bins", horizontal_bins_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new horizontal_bins to: %d.", horizontal_bins_);
+  if (get_param(p, "horizontal_bins", param.horizontal_bins)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new horizontal_bins to: %d.", param.horizontal_bins);
   }
   if (get_param(p, "noise_threshold", noise_threshold_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new noise_threshold to: %d.", noise_threshold_);
   }
-  if (get_param(p, "max_azimuth_deg", max_azimuth_deg_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new max_azimuth_deg to: %f.", max_azimuth_deg_);
+  if (get_param(p, "max_azimuth_deg", param.max_azimuth_deg)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new max_azimuth_deg to: %f.", param.max_azimuth_deg);
   }
-  if (get_param(p, "min_azimuth_deg", min_azimuth_deg_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new min_azimuth_deg to: %f.", min_azimuth_deg_);
+  if (get_param(p, "min_azimuth_deg", param.min_azimuth_deg)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new min_azimuth_deg to: %f.", param.min_azimuth_deg);
   }
-  if (get_param(p, "max_distance", max_distance_)) {
-    RCLCPP_DEBUG(get_logger(), "Setting new max_distance to: %f.", max_distance_);
+  if (get_param(p, "max_distance", param.max_distance)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new max_distance to: %f.", param.max_distance);
   }
+  ring_outlier_filter_.setParam(param);
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
@@ -342,82 +186,6 @@ rcl_interfaces::msg::SetParametersResult RingOutlierFilterComponent::paramCallba
   return result;
 }
 
-void RingOutlierFilterComponent::setUpPointCloudFormat(
-  const PointCloud2ConstPtr & input, PointCloud2 & formatted_points, size_t points_size)
-{
-  formatted_points.data.resize(points_size);
-  // Note that `input->header.frame_id` is data before converted when `transform_info.need_transform
-  // == true`
-  formatted_points.header.frame_id =
-    !tf_input_frame_.empty() ? tf_input_frame_ : tf_input_orig_frame_;
-  formatted_points.height = 1;
-  formatted_points.width =
-    static_cast<uint32_t>(formatted_points.data.size() / formatted_points.point_step);
-  formatted_points.is_bigendian = input->is_bigendian;
-  formatted_points.is_dense = input->is_dense;
-
-  // This is a hack to get the correct fields in the output point cloud without creating the fields
-  // manually
-  sensor_msgs::msg::PointCloud2 msg_aux;
-  pcl::toROSMsg(pcl::PointCloud<OutputPointType>(), msg_aux);
-  formatted_points.fields = msg_aux.fields;
-}
-
-float RingOutlierFilterComponent::calculateVisibilityScore(
-  const sensor_msgs::msg::PointCloud2 & input)
-{
-  pcl::PointCloud<InputPointType>::Ptr input_cloud(new pcl::PointCloud<InputPointType>);
-  pcl::fromROSMsg(input, *input_cloud);
-
-  const uint32_t vertical_bins = vertical_bins_;
-  const uint32_t horizontal_bins = horizontal_bins_;
-  const float max_azimuth = max_azimuth_deg_ * (M_PI / 180.f);
-  const float min_azimuth = min_azimuth_deg_ * (M_PI / 180.f);
-
-  const uint32_t horizontal_resolution =
-    static_cast<uint32_t>((max_azimuth - min_azimuth) / horizontal_bins);
-
-  std::vector<pcl::PointCloud<InputPointType>> ring_point_clouds(vertical_bins);
-  cv::Mat frequency_image(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-
-  // Split points into rings
-  for (const auto & point : input_cloud->points) {
-    ring_point_clouds.at(point.channel).push_back(point);
-  }
-
-  // Calculate frequency for each bin in each ring
-  for (const auto & ring_points : ring_point_clouds) {
-    if (ring_points.empty()) continue;
-
-    const uint ring_id = ring_points.front().channel;
-    std::vector<int> frequency_in_ring(horizontal_bins, 0);
-
-    for (const auto & point : ring_points.points) {
-      if (point.azimuth < min_azimuth || point.azimuth >= max_azimuth) continue;
-      if (point.distance >= max_distance_) continue;
-
-      const uint bin_index =
-        static_cast<uint>((point.azimuth - min_azimuth) / horizontal_resolution);
-
-      frequency_in_ring[bin_index]++;
-      frequency_in_ring[bin_index] =
-        std::min(frequency_in_ring[bin_index], 255);  // Ensure value is within uchar range
-
-      frequency_image.at<uchar>(ring_id, bin_index) =
-        static_cast<uchar>(frequency_in_ring[bin_index]);
-    }
-  }
-
-  cv::Mat binary_image;
-  cv::inRange(frequency_image, noise_threshold_, 255, binary_image);
-
-  const int num_pixels = cv::countNonZero(frequency_image);
-  const float num_filled_pixels =
-    static_cast<float>(num_pixels) / static_cast<float>(vertical_bins * horizontal_bins);
-
-  return 1.0f - num_filled_pixels;
-}
-
 }  // namespace autoware::pointcloud_preprocessor
 
 #include <rclcpp_components/register_node_macro.hpp>
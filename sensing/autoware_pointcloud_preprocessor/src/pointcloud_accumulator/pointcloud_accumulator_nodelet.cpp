@@ -14,6 +14,9 @@
 
 #include "autoware/pointcloud_preprocessor/pointcloud_accumulator/pointcloud_accumulator_nodelet.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
 #include <vector>
 
 namespace autoware::pointcloud_preprocessor
@@ -24,8 +27,7 @@ PointcloudAccumulatorComponent::PointcloudAccumulatorComponent(const rclcpp::Nod
   // set initial parameters
   {
     accumulation_time_sec_ = static_cast<double>(declare_parameter("accumulation_time_sec", 2.0));
-    pointcloud_buffer_.set_capacity(
-      static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50)));
+    setSliceCapacity(static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50)));
   }
 
   using std::placeholders::_1;
@@ -33,6 +35,23 @@ PointcloudAccumulatorComponent::PointcloudAccumulatorComponent(const rclcpp::Nod
     std::bind(&PointcloudAccumulatorComponent::paramCallback, this, _1));
 }
 
+size_t PointcloudAccumulatorComponent::getSliceIndex(const size_t age) const
+{
+  return (newest_slice_index_ + slices_.size() - age) % slices_.size();
+}
+
+void PointcloudAccumulatorComponent::setSliceCapacity(const size_t capacity)
+{
+  std::vector<PointcloudSlice> slices(capacity);
+  const size_t num_kept_slices = std::min(num_slices_, capacity);
+  for (size_t age = 0; age < num_kept_slices; ++age) {
+    slices[num_kept_slices - 1 - age] = std::move(slices_[getSliceIndex(age)]);
+  }
+  slices_ = std::move(slices);
+  num_slices_ = num_kept_slices;
+  newest_slice_index_ = num_kept_slices == 0 ? 0 : num_kept_slices - 1;
+}
+
 void PointcloudAccumulatorComponent::filter(
   const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output)
 {
@@ -40,19 +59,43 @@ void PointcloudAccumulatorComponent::filter(
   if (indices) {
     RCLCPP_WARN(get_logger(), "Indices are not supported and will be ignored");
   }
-  pointcloud_buffer_.push_front(input);
-  rclcpp::Time last_time = input->header.stamp;
-  pcl::PointCloud<pcl::PointXYZ> pcl_input;
-  pcl::PointCloud<pcl::PointXYZ> pcl_output;
-  for (size_t i = 0; i < pointcloud_buffer_.size(); i++) {
-    if (accumulation_time_sec_ < (last_time - pointcloud_buffer_.at(i)->header.stamp).seconds()) {
+  // fields and point step of pcl::PointXYZ, as the points are copied as they are
+  pcl::toROSMsg(pcl::PointCloud<pcl::PointXYZ>(), output);
+  output.header = input->header;
+  if (slices_.empty()) {
+    return;
+  }
+
+  newest_slice_index_ = num_slices_ == 0 ? 0 : (newest_slice_index_ + 1) % slices_.size();
+  num_slices_ = std::min(num_slices_ + 1, slices_.size());
+  auto & newest_slice = slices_[newest_slice_index_];
+  newest_slice.stamp = input->header.stamp;
+  pcl::fromROSMsg(*input, newest_slice.cloud);
+
+  // the slices within the accumulation time, from the newest one
+  size_t num_accumulated_slices = 0;
+  size_t num_points = 0;
+  bool is_dense = true;
+  for (; num_accumulated_slices < num_slices_; ++num_accumulated_slices) {
+    const auto & slice = slices_[getSliceIndex(num_accumulated_slices)];
+    if (accumulation_time_sec_ < (newest_slice.stamp - slice.stamp).seconds()) {
       break;
     }
-    pcl::fromROSMsg(*pointcloud_buffer_.at(i), pcl_input);
-    pcl_output += pcl_input;
+    num_points += slice.cloud.points.size();
+    is_dense = is_dense && slice.cloud.is_dense;
   }
-  pcl::toROSMsg(pcl_output, output);
-  output.header = input->header;
+
+  output.data.resize(num_points * sizeof(pcl::PointXYZ));
+  auto * output_data = output.data.data();
+  for (size_t age = 0; age < num_accumulated_slices; ++age) {
+    const auto & points = slices_[getSliceIndex(age)].cloud.points;
+    std::memcpy(output_data, points.data(), points.size() * sizeof(pcl::PointXYZ));
+    output_data += points.size() * sizeof(pcl::PointXYZ);
+  }
+  output.height = 1;
+  output.width = static_cast<uint32_t>(num_points);
+  output.row_step = output.width * output.point_step;
+  output.is_dense = is_dense;
 }
 
 rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCallback(
@@ -65,7 +108,7 @@ rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCa
   }
   int pointcloud_buffer_size;
   if (get_param(p, "pointcloud_buffer_size", pointcloud_buffer_size)) {
-    pointcloud_buffer_.set_capacity((size_t)pointcloud_buffer_size);
+    setSliceCapacity(static_cast<size_t>(pointcloud_buffer_size));
     RCLCPP_DEBUG(get_logger(), "Setting new buffer size to: %d.", pointcloud_buffer_size);
   }
 
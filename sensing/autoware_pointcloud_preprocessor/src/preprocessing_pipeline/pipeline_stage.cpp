@@ -0,0 +1,195 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/preprocessing_pipeline/pipeline_stage.hpp"
+
+#include "autoware/pointcloud_preprocessor/crop_box_filter/crop_box_filter_nodelet.hpp"
+#include "autoware/pointcloud_preprocessor/distortion_corrector/distortion_corrector.hpp"
+#include "autoware/pointcloud_preprocessor/downsample_filter/faster_voxel_grid_downsample_filter.hpp"
+#include "autoware/pointcloud_preprocessor/outlier_filter/ring_outlier_filter.hpp"
+
+#include <cctype>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace autoware::pointcloud_preprocessor
+{
+PipelineStage::PipelineStage(std::string name) : name_(std::move(name)), topic_name_(name_)
+{
+  for (auto & c : topic_name_) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+      c = '_';
+    }
+  }
+  // a token of a topic name cannot start with a digit
+  if (topic_name_.empty() || std::isdigit(static_cast<unsigned char>(topic_name_.front()))) {
+    topic_name_.insert(0, "_");
+  }
+}
+
+namespace
+{
+class CropBoxStage : public PipelineStage
+{
+public:
+  CropBoxStage(rclcpp::Node & node, const std::string & name) : PipelineStage(name), node_(node)
+  {
+    param_.min_x = static_cast<float>(node.declare_parameter(name + ".min_x", -1.0));
+    param_.min_y = static_cast<float>(node.declare_parameter(name + ".min_y", -1.0));
+    param_.min_z = static_cast<float>(node.declare_parameter(name + ".min_z", -1.0));
+    param_.max_x = static_cast<float>(node.declare_parameter(name + ".max_x", 1.0));
+    param_.max_y = static_cast<float>(node.declare_parameter(name + ".max_y", 1.0));
+    param_.max_z = static_cast<float>(node.declare_parameter(name + ".max_z", 1.0));
+    param_.negative = static_cast<bool>(node.declare_parameter(name + ".negative", false));
+  }
+
+  void process(
+    std::unique_ptr<PointCloud2> & points, std::unique_ptr<PointCloud2> & /*scratch*/) override
+  {
+    // the points are already in the frame of the box
+    const int skipped_count = cropBox(*points, param_, TransformInfo(), *points);
+    if (skipped_count > 0) {
+      RCLCPP_WARN_THROTTLE(
+        node_.get_logger(), *node_.get_clock(), 1000, "%s: %d points contained NaN values",
+        name().c_str(), skipped_count);
+    }
+  }
+
+private:
+  rclcpp::Node & node_;
+  CropBoxParam param_;
+};
+
+class DistortionCorrectorStage : public PipelineStage
+{
+public:
+  DistortionCorrectorStage(rclcpp::Node & node, const std::string & name) : PipelineStage(name)
+  {
+    base_frame_ = node.declare_parameter<std::string>(name + ".base_frame");
+    use_imu_ = node.declare_parameter<bool>(name + ".use_imu");
+    if (node.declare_parameter<bool>(name + ".use_3d_distortion_correction")) {
+      distortion_corrector_ = std::make_unique<DistortionCorrector3D>(&node);
+    } else {
+      distortion_corrector_ = std::make_unique<DistortionCorrector2D>(&node);
+    }
+  }
+
+  void process(
+    std::unique_ptr<PointCloud2> & points, std::unique_ptr<PointCloud2> & /*scratch*/) override
+  {
+    distortion_corrector_->setPointCloudTransform(base_frame_, points->header.frame_id);
+    distortion_corrector_->initialize();
+    distortion_corrector_->undistortPointCloud(use_imu_, *points);
+  }
+
+  void processTwistMessage(
+    const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr & twist_msg) override
+  {
+    distortion_corrector_->processTwistMessage(twist_msg);
+  }
+
+  void processIMUMessage(const sensor_msgs::msg::Imu::ConstSharedPtr & imu_msg) override
+  {
+    if (!use_imu_) {
+      return;
+    }
+    distortion_corrector_->processIMUMessage(base_frame_, imu_msg);
+  }
+
+private:
+  std::string base_frame_;
+  bool use_imu_;
+  std::unique_ptr<DistortionCorrectorBase> distortion_corrector_;
+};
+
+class RingOutlierFilterStage : public PipelineStage
+{
+public:
+  RingOutlierFilterStage(rclcpp::Node & node, const std::string & name) : PipelineStage(name)
+  {
+    RingOutlierFilterParam param;
+    param.distance_ratio = node.declare_parameter(name + ".distance_ratio", 1.03);
+    param.object_length_threshold = node.declare_parameter(name + ".object_length_threshold", 0.1);
+    param.num_points_threshold =
+      static_cast<int>(node.declare_parameter(name + ".num_points_threshold", 4));
+    param.max_rings_num =
+      static_cast<uint16_t>(node.declare_parameter(name + ".max_rings_num", 128));
+    param.max_points_num_per_ring =
+      static_cast<size_t>(node.declare_parameter(name + ".max_points_num_per_ring", 4000));
+    ring_outlier_filter_.setParam(param);
+  }
+
+  void process(
+    std::unique_ptr<PointCloud2> & points, std::unique_ptr<PointCloud2> & scratch) override
+  {
+    ring_outlier_filter_.filter(*points, TransformInfo(), *scratch);
+    scratch->header = points->header;
+    std::swap(points, scratch);
+  }
+
+private:
+  RingOutlierFilter ring_outlier_filter_;
+};
+
+class VoxelGridDownsampleFilterStage : public PipelineStage
+{
+public:
+  VoxelGridDownsampleFilterStage(rclcpp::Node & node, const std::string & name)
+  : PipelineStage(name), logger_(node.get_logger())
+  {
+    voxel_filter_.set_voxel_size(
+      static_cast<float>(node.declare_parameter(name + ".voxel_size_x", 0.3)),
+      static_cast<float>(node.declare_parameter(name + ".voxel_size_y", 0.3)),
+      static_cast<float>(node.declare_parameter(name + ".voxel_size_z", 0.1)));
+  }
+
+  void process(
+    std::unique_ptr<PointCloud2> & points, std::unique_ptr<PointCloud2> & scratch) override
+  {
+    // non-owning pointer, as the filter takes its input as a shared pointer
+    const PointCloud2::ConstSharedPtr input(std::shared_ptr<void>(), points.get());
+    voxel_filter_.set_field_offsets(input, logger_);
+    // only x, y, z and intensity are written, the other fields are left zero as in a new buffer
+    scratch->data.clear();
+    voxel_filter_.filter(input, *scratch, TransformInfo(), logger_);
+    std::swap(points, scratch);
+  }
+
+private:
+  rclcpp::Logger logger_;
+  FasterVoxelGridDownsampleFilter voxel_filter_;
+};
+}  // namespace
+
+std::unique_ptr<PipelineStage> createPipelineStage(rclcpp::Node & node, const std::string & name)
+{
+  const auto type = name.substr(0, name.find('.'));
+  if (type == "crop_box") {
+    return std::make_unique<CropBoxStage>(node, name);
+  }
+  if (type == "distortion_corrector") {
+    return std::make_unique<DistortionCorrectorStage>(node, name);
+  }
+  if (type == "ring_outlier_filter") {
+    return std::make_unique<RingOutlierFilterStage>(node, name);
+  }
+  if (type == "voxel_grid_downsample_filter") {
+    return std::make_unique<VoxelGridDownsampleFilterStage>(node, name);
+  }
+  throw std::invalid_argument("unknown preprocessing stage type: " + type);
+}
+
+}  // namespace autoware::pointcloud_preprocessor
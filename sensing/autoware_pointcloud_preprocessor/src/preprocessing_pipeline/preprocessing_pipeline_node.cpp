@@ -0,0 +1,175 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/preprocessing_pipeline/preprocessing_pipeline_node.hpp"
+
+#include <Eigen/Core>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::pointcloud_preprocessor
+{
+PreprocessingPipelineComponent::PreprocessingPipelineComponent(const rclcpp::NodeOptions & options)
+: Node("preprocessing_pipeline_node", options), scratch_(std::make_unique<PointCloud2>())
+{
+  // initialize debug tool
+  using autoware::universe_utils::DebugPublisher;
+  using autoware::universe_utils::StopWatch;
+  stop_watch_ptr_ = std::make_unique<StopWatch<std::chrono::milliseconds>>();
+  debug_publisher_ = std::make_unique<DebugPublisher>(this, "preprocessing_pipeline");
+  stop_watch_ptr_->tic("cyclic_time");
+  stop_watch_ptr_->tic("processing_time");
+
+  static_tf_buffer_ = std::make_unique<autoware::universe_utils::StaticTransformBuffer>();
+
+  // Parameter
+  input_frame_ = declare_parameter<std::string>("input_frame", "");
+  output_frame_ = declare_parameter<std::string>("output_frame", "");
+  for (const auto & stage_name : declare_parameter<std::vector<std::string>>("stages")) {
+    stages_.push_back(createPipelineStage(*this, stage_name));
+  }
+
+  // Publisher
+  {
+    rclcpp::PublisherOptions pub_options;
+    pub_options.qos_overriding_options = rclcpp::QosOverridingOptions::with_default_policies();
+    pointcloud_pub_ = this->create_publisher<PointCloud2>(
+      "~/output/pointcloud", rclcpp::SensorDataQoS(), pub_options);
+  }
+
+  // Subscriber
+  twist_sub_ = this->create_subscription<geometry_msgs::msg::TwistWithCovarianceStamped>(
+    "~/input/twist", 10,
+    std::bind(&PreprocessingPipelineComponent::onTwist, this, std::placeholders::_1));
+  imu_sub_ = this->create_subscription<sensor_msgs::msg::Imu>(
+    "~/input/imu", 10,
+    std::bind(&PreprocessingPipelineComponent::onImu, this, std::placeholders::_1));
+  pointcloud_sub_ = this->create_subscription<PointCloud2>(
+    "~/input/pointcloud", rclcpp::SensorDataQoS(),
+    std::bind(&PreprocessingPipelineComponent::onPointCloud, this, std::placeholders::_1));
+}
+
+void PreprocessingPipelineComponent::onTwist(
+  const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_msg)
+{
+  for (auto & stage : stages_) {
+    stage->processTwistMessage(twist_msg);
+  }
+}
+
+void PreprocessingPipelineComponent::onImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg)
+{
+  for (auto & stage : stages_) {
+    stage->processIMUMessage(imu_msg);
+  }
+}
+
+bool PreprocessingPipelineComponent::transformPointCloud(
+  const std::string & target_frame, PointCloud2 & points)
+{
+  if (target_frame.empty() || points.header.frame_id == target_frame) return true;
+
+  Eigen::Matrix4f eigen_transform;
+  if (!static_tf_buffer_->getTransform(
+        this, target_frame, points.header.frame_id, eigen_transform)) {
+    return false;
+  }
+
+  const auto x_offset = points.fields[pcl::getFieldIndex(points, "x")].offset;
+  const auto y_offset = points.fields[pcl::getFieldIndex(points, "y")].offset;
+  const auto z_offset = points.fields[pcl::getFieldIndex(points, "z")].offset;
+  for (size_t offset = 0; offset + points.point_step <= points.data.size();
+       offset += points.point_step) {
+    Eigen::Vector4f point;
+    std::memcpy(&point[0], &points.data[offset + x_offset], sizeof(float));
+    std::memcpy(&point[1], &points.data[offset + y_offset], sizeof(float));
+    std::memcpy(&point[2], &points.data[offset + z_offset], sizeof(float));
+    point[3] = 1;
+    point = eigen_transform * point;
+    std::memcpy(&points.data[offset + x_offset], &point[0], sizeof(float));
+    std::memcpy(&points.data[offset + y_offset], &point[1], sizeof(float));
+    std::memcpy(&points.data[offset + z_offset], &point[2], sizeof(float));
+  }
+  points.header.frame_id = target_frame;
+  return true;
+}
+
+void PreprocessingPipelineComponent::onPointCloud(PointCloud2::UniquePtr points_msg)
+{
+  stop_watch_ptr_->toc("processing_time", true);
+  const auto points_sub_count = pointcloud_pub_->get_subscription_count() +
+                                pointcloud_pub_->get_intra_process_subscription_count();
+
+  if (points_sub_count < 1) {
+    return;
+  }
+
+  // the received message is the working buffer of the stages, moved into the published message
+  std::unique_ptr<PointCloud2> points = std::move(points_msg);
+
+  if (!transformPointCloud(input_frame_, *points)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "Failed to transform the input from %s to %s.",
+      points->header.frame_id.c_str(), input_frame_.c_str());
+    return;
+  }
+
+  for (auto & stage : stages_) {
+    stop_watch_ptr_->tic(stage->name());
+    stage->process(points, scratch_);
+    if (debug_publisher_) {
+      debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+        "debug/" + stage->topic_name() + "/processing_time_ms",
+        stop_watch_ptr_->toc(stage->name()));
+    }
+  }
+
+  if (!transformPointCloud(output_frame_, *points)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "Failed to transform the output from %s to %s.",
+      points->header.frame_id.c_str(), output_frame_.c_str());
+    return;
+  }
+
+  if (debug_publisher_) {
+    auto pipeline_latency_ms =
+      std::chrono::duration<double, std::milli>(
+        std::chrono::nanoseconds((this->get_clock()->now() - points->header.stamp).nanoseconds()))
+        .count();
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/pipeline_latency_ms", pipeline_latency_ms);
+  }
+
+  pointcloud_pub_->publish(std::move(points));
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
+
+}  // namespace autoware::pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::pointcloud_preprocessor::PreprocessingPipelineComponent)
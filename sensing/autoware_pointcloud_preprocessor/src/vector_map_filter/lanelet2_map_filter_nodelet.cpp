@@ -19,6 +19,7 @@
 #include <pcl_ros/transforms.hpp>
 
 #include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
@@ -41,6 +42,13 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    use_raster_mask_ = declare_parameter("use_raster_mask", true);
+    raster_mask_resolution_ = declare_parameter("raster_mask_resolution", 0.5);
+    if (raster_mask_resolution_ <= 0.0) {
+      RCLCPP_ERROR(
+        get_logger(), "raster_mask_resolution must be positive, the raster mask is disabled.");
+      use_raster_mask_ = false;
+    }
   }
 
   // Set publisher
@@ -218,6 +226,32 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
   return filtered_cloud;
 }
 
+pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getRasterFilteredPointCloud(
+  const pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  // each point is classified on its own, whereas getLaneFilteredPointCloud keeps or removes all the
+  // points of a voxel with its centroid, so the outputs differ for the points near lanelet bounds
+  const auto num_points = static_cast<int64_t>(cloud.points.size());
+  point_is_within_.resize(cloud.points.size());
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t i = 0; i < num_points; ++i) {
+    const auto & p = cloud.points[i];
+    point_is_within_[i] = raster_mask_->isWithin(p.x, p.y);
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  filtered_cloud.header = cloud.header;
+  filtered_cloud.points.reserve(cloud.points.size());
+  for (size_t i = 0; i < cloud.points.size(); ++i) {
+    if (point_is_within_[i]) {
+      filtered_cloud.points.push_back(cloud.points[i]);
+    }
+  }
+  filtered_cloud.width = static_cast<uint32_t>(filtered_cloud.points.size());
+  filtered_cloud.height = 1;
+  return filtered_cloud;
+}
+
 void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cloud_msg)
 {
   if (!lanelet_map_ptr_) {
@@ -238,12 +272,18 @@ void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cl
   if (cloud->points.empty()) {
     return;
   }
-  // calculate convex hull
-  const auto convex_hull = getConvexHull(cloud);
-  // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
-  // filter pointcloud by lanelet
-  const auto filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  if (raster_mask_) {
+    filtered_cloud = getRasterFilteredPointCloud(*cloud);
+  } else {
+    // calculate convex hull
+    const auto convex_hull = getConvexHull(cloud);
+    // get intersected lanelets
+    lanelet::ConstLanelets intersected_lanelets =
+      getIntersectedLanelets(convex_hull, road_lanelets_);
+    // filter pointcloud by lanelet
+    filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  }
   // transform pointcloud to input frame
   PointCloud2Ptr output_cloud_ptr(new sensor_msgs::msg::PointCloud2);
   pcl::toROSMsg(filtered_cloud, *output_cloud_ptr);
@@ -267,6 +307,23 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+
+  // the raster covers the same road lanelets as the voxel based filter, so that use_raster_mask
+  // changes how the points are classified but not the area they are kept in
+  if (use_raster_mask_) {
+    std::vector<Polygon2d> polygons;
+    polygons.reserve(road_lanelets_.size());
+    for (const auto & road_lanelet : road_lanelets_) {
+      Polygon2d polygon;
+      for (const auto & point : road_lanelet.polygon2d().basicPolygon()) {
+        polygon.outer().emplace_back(point.x(), point.y());
+      }
+      boost::geometry::correct(polygon);
+      polygons.push_back(std::move(polygon));
+    }
+    raster_mask_ =
+      std::make_unique<LaneletRasterMask>(std::move(polygons), raster_mask_resolution_);
+  }
 }
 
 }  // namespace autoware::pointcloud_preprocessor
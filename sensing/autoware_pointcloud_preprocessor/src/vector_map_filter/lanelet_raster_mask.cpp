@@ -0,0 +1,213 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace autoware::pointcloud_preprocessor
+{
+LaneletRasterMask::LaneletRasterMask(std::vector<Polygon2d> polygons, const double resolution)
+: polygons_(std::move(polygons)), resolution_(resolution), inverse_resolution_(1.0 / resolution)
+{
+  origin_x_ = std::numeric_limits<double>::max();
+  origin_y_ = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  envelopes_.resize(polygons_.size());
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    if (polygons_[i].outer().size() < 3) {
+      continue;
+    }
+    boost::geometry::envelope(polygons_[i], envelopes_[i]);
+    origin_x_ = std::min(origin_x_, envelopes_[i].min_corner().x());
+    origin_y_ = std::min(origin_y_, envelopes_[i].min_corner().y());
+    max_x = std::max(max_x, envelopes_[i].max_corner().x());
+    max_y = std::max(max_y, envelopes_[i].max_corner().y());
+  }
+  if (origin_x_ > max_x) {
+    return;
+  }
+
+  tiles_x_ = toCellX(max_x) / tile_size + 1;
+  tiles_y_ = toCellY(max_y) / tile_size + 1;
+  tile_indices_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, -1);
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    rasterizePolygon(i);
+  }
+}
+
+int LaneletRasterMask::toCellX(const double x) const
+{
+  return static_cast<int>(std::floor((x - origin_x_) * inverse_resolution_));
+}
+
+int LaneletRasterMask::toCellY(const double y) const
+{
+  return static_cast<int>(std::floor((y - origin_y_) * inverse_resolution_));
+}
+
+LaneletRasterMask::Tile & LaneletRasterMask::getOrCreateTile(const int tile_x, const int tile_y)
+{
+  auto & tile_index = tile_indices_[static_cast<size_t>(tile_y) * tiles_x_ + tile_x];
+  if (tile_index < 0) {
+    tile_index = static_cast<int32_t>(tiles_.size());
+    tiles_.emplace_back();
+  }
+  return tiles_[tile_index];
+}
+
+void LaneletRasterMask::rasterizePolygon(const size_t polygon_index)
+{
+  const auto & ring = polygons_[polygon_index].outer();
+  if (ring.size() < 3) {
+    return;
+  }
+  // the crossed cells are marked with a margin so that rounding never misses one
+  const double margin = resolution_ * 1e-3;
+  const auto clamp_range = [&](const CellRange & range) {
+    return CellRange{
+      std::max(range.min_x, 0), std::max(range.min_y, 0),
+      std::min(range.max_x, tiles_x_ * tile_size - 1),
+      std::min(range.max_y, tiles_y_ * tile_size - 1)};
+  };
+  const auto & envelope = envelopes_[polygon_index];
+  const CellRange range = clamp_range(
+    {toCellX(envelope.min_corner().x() - margin), toCellY(envelope.min_corner().y() - margin),
+     toCellX(envelope.max_corner().x() + margin), toCellY(envelope.max_corner().y() + margin)});
+  const int width = range.max_x - range.min_x + 1;
+  const int height = range.max_y - range.min_y + 1;
+  std::vector<uint8_t> is_boundary(static_cast<size_t>(width) * height, 0);
+
+  // mark the cells crossed by the edges, split in pieces shorter than a cell
+  for (size_t i = 0; i < ring.size(); ++i) {
+    const auto & start = ring[i];
+    const auto & end = ring[(i + 1) % ring.size()];
+    const int steps =
+      static_cast<int>(std::ceil((end - start).norm() * inverse_resolution_)) + 1;
+    Point2d previous = start;
+    for (int step = 1; step <= steps; ++step) {
+      const double ratio = static_cast<double>(step) / steps;
+      const Point2d current(
+        start.x() + (end.x() - start.x()) * ratio, start.y() + (end.y() - start.y()) * ratio);
+      const CellRange piece = clamp_range(
+        {toCellX(std::min(previous.x(), current.x()) - margin),
+         toCellY(std::min(previous.y(), current.y()) - margin),
+         toCellX(std::max(previous.x(), current.x()) + margin),
+         toCellY(std::max(previous.y(), current.y()) + margin)});
+      for (int cell_y = piece.min_y; cell_y <= piece.max_y; ++cell_y) {
+        for (int cell_x = piece.min_x; cell_x <= piece.max_x; ++cell_x) {
+          is_boundary[(cell_y - range.min_y) * width + (cell_x - range.min_x)] = 1;
+        }
+      }
+      previous = current;
+    }
+  }
+
+  // a cell not crossed by an edge is entirely inside or outside, as its center
+  std::vector<double> crossings;
+  for (int cell_y = range.min_y; cell_y <= range.max_y; ++cell_y) {
+    const double y = origin_y_ + (cell_y + 0.5) * resolution_;
+    crossings.clear();
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto & start = ring[i];
+      const auto & end = ring[(i + 1) % ring.size()];
+      if ((start.y() <= y) != (end.y() <= y)) {
+        crossings.push_back(
+          start.x() + (y - start.y()) * (end.x() - start.x()) / (end.y() - start.y()));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+      const int first_x = std::max(
+        range.min_x,
+        static_cast<int>(std::ceil((crossings[i] - origin_x_) * inverse_resolution_ - 0.5)));
+      const int last_x = std::min(
+        range.max_x,
+        static_cast<int>(std::floor((crossings[i + 1] - origin_x_) * inverse_resolution_ - 0.5)));
+      for (int cell_x = first_x; cell_x <= last_x; ++cell_x) {
+        if (!is_boundary[(cell_y - range.min_y) * width + (cell_x - range.min_x)]) {
+          auto & tile = getOrCreateTile(cell_x / tile_size, cell_y / tile_size);
+          tile.inside[cell_y % tile_size] |= uint64_t{1} << (cell_x % tile_size);
+        }
+      }
+    }
+  }
+
+  for (int cell_y = range.min_y; cell_y <= range.max_y; ++cell_y) {
+    for (int cell_x = range.min_x; cell_x <= range.max_x; ++cell_x) {
+      if (!is_boundary[(cell_y - range.min_y) * width + (cell_x - range.min_x)]) {
+        continue;
+      }
+      auto & tile = getOrCreateTile(cell_x / tile_size, cell_y / tile_size);
+      tile.boundary[cell_y % tile_size] |= uint64_t{1} << (cell_x % tile_size);
+      if (tile.polygon_indices.empty() || tile.polygon_indices.back() != polygon_index) {
+        tile.polygon_indices.push_back(polygon_index);
+      }
+    }
+  }
+}
+
+bool LaneletRasterMask::withinPolygons(const Tile & tile, const Point2d & point) const
+{
+  for (const auto polygon_index : tile.polygon_indices) {
+    const auto & envelope = envelopes_[polygon_index];
+    if (
+      point.x() < envelope.min_corner().x() || point.x() > envelope.max_corner().x() ||
+      point.y() < envelope.min_corner().y() || point.y() > envelope.max_corner().y()) {
+      continue;
+    }
+    if (boost::geometry::within(point, polygons_[polygon_index])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LaneletRasterMask::isWithin(const double x, const double y) const
+{
+  // compared as double first so that far or non-finite points are not cast to int
+  const double cell_x = std::floor((x - origin_x_) * inverse_resolution_);
+  const double cell_y = std::floor((y - origin_y_) * inverse_resolution_);
+  if (
+    tiles_.empty() || !(cell_x >= 0.0 && cell_x < tiles_x_ * tile_size) ||
+    !(cell_y >= 0.0 && cell_y < tiles_y_ * tile_size)) {
+    return false;
+  }
+  const int column = static_cast<int>(cell_x);
+  const int row = static_cast<int>(cell_y);
+  const int32_t tile_index =
+    tile_indices_[static_cast<size_t>(row / tile_size) * tiles_x_ + column / tile_size];
+  if (tile_index < 0) {
+    return false;
+  }
+  const auto & tile = tiles_[tile_index];
+  const uint64_t bit = uint64_t{1} << (column % tile_size);
+  if (tile.inside[row % tile_size] & bit) {
+    return true;
+  }
+  if (!(tile.boundary[row % tile_size] & bit)) {
+    return false;
+  }
+  return withinPolygons(tile, Point2d(x, y));
+}
+
+}  // namespace autoware::pointcloud_preprocessor
@@ -0,0 +1,170 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/blockage_diag/bit_mask.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using autoware::pointcloud_preprocessor::BitMask;
+using autoware::pointcloud_preprocessor::BitMaskTimeSeries;
+
+namespace
+{
+using Image = std::vector<std::vector<bool>>;
+
+Image createRandomImage(
+  const int rows, const int cols, const double probability, std::mt19937 & rng)
+{
+  std::bernoulli_distribution distribution(probability);
+  Image image(rows, std::vector<bool>(cols));
+  for (auto & row : image) {
+    for (int col = 0; col < cols; ++col) {
+      row[col] = distribution(rng);
+    }
+  }
+  return image;
+}
+
+BitMask toBitMask(const Image & image)
+{
+  BitMask mask;
+  mask.reset(static_cast<int>(image.size()), static_cast<int>(image.front().size()), false);
+  for (int row = 0; row < mask.rows(); ++row) {
+    for (int col = 0; col < mask.cols(); ++col) {
+      mask.set(row, col, image[row][col]);
+    }
+  }
+  return mask;
+}
+
+// minimum or maximum over the square window clipped to the rows [row_begin, row_end)
+Image morphReference(
+  const Image & image, const int radius, const int row_begin, const int row_end, const bool erode)
+{
+  Image result = image;
+  const int cols = static_cast<int>(image.front().size());
+  for (int row = row_begin; row < row_end; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      bool value = erode;
+      const int last_row = std::min(row + radius, row_end - 1);
+      const int last_col = std::min(col + radius, cols - 1);
+      for (int r = std::max(row - radius, row_begin); r <= last_row; ++r) {
+        for (int c = std::max(col - radius, 0); c <= last_col; ++c) {
+          value = erode ? (value && image[r][c]) : (value || image[r][c]);
+        }
+      }
+      result[row][col] = value;
+    }
+  }
+  return result;
+}
+
+void expectEqual(const BitMask & mask, const Image & image)
+{
+  for (int row = 0; row < mask.rows(); ++row) {
+    for (int col = 0; col < mask.cols(); ++col) {
+      ASSERT_EQ(mask.get(row, col), image[row][col]) << "row " << row << ", col " << col;
+    }
+  }
+}
+}  // namespace
+
+TEST(BlockageBitMask, morphology)
+{
+  std::mt19937 rng(0);
+  for (const int cols : {1, 63, 64, 65, 200, 900}) {
+    for (const int radius : {1, 2, 10}) {
+      const auto image = createRandomImage(40, cols, 0.8, rng);
+      for (const auto & [row_begin, row_end] : {std::make_pair(0, 40), std::make_pair(18, 40)}) {
+        auto mask = toBitMask(image);
+        mask.erode(radius, row_begin, row_end);
+        const auto eroded = morphReference(image, radius, row_begin, row_end, true);
+        expectEqual(mask, eroded);
+
+        mask.dilate(radius, row_begin, row_end);
+        expectEqual(mask, morphReference(eroded, radius, row_begin, row_end, false));
+      }
+    }
+  }
+}
+
+TEST(BlockageBitMask, countAndColumnRange)
+{
+  BitMask mask;
+  mask.reset(4, 130, false);
+  EXPECT_EQ(mask.count(0, 4), 0U);
+  EXPECT_EQ(mask.columnRange(0, 4), std::make_pair(0, 0));
+
+  mask.set(1, 3, true);
+  mask.set(2, 70, true);
+  mask.set(3, 129, true);
+  EXPECT_EQ(mask.count(0, 4), 3U);
+  EXPECT_EQ(mask.count(2, 4), 2U);
+  EXPECT_EQ(mask.columnRange(0, 4), std::make_pair(3, 130));
+  EXPECT_EQ(mask.columnRange(0, 3), std::make_pair(3, 71));
+  EXPECT_EQ(mask.columnRange(2, 3), std::make_pair(70, 71));
+
+  mask.clearRows(0, 2);
+  EXPECT_FALSE(mask.get(1, 3));
+  EXPECT_EQ(mask.count(0, 4), 2U);
+
+  // the bits past the last column are not counted
+  mask.reset(2, 70, true);
+  EXPECT_EQ(mask.count(0, 2), 140U);
+  mask.dilate(3, 0, 2);
+  EXPECT_EQ(mask.count(0, 2), 140U);
+}
+
+TEST(BlockageBitMask, timeSeries)
+{
+  std::mt19937 rng(1);
+  BitMaskTimeSeries time_series;
+  time_series.setCapacity(3);
+  BitMask result;
+
+  time_series.getResult(5, 100, result);
+  EXPECT_EQ(result.count(0, 5), 0U);
+
+  std::vector<Image> images;
+  for (int i = 0; i < 10; ++i) {
+    images.push_back(createRandomImage(5, 100, 0.5, rng));
+    time_series.push(toBitMask(images.back()));
+
+    // sum of the last masks, as in a circular buffer
+    const size_t size = std::min<size_t>(images.size(), 3);
+    Image expected(5, std::vector<bool>(100));
+    for (int row = 0; row < 5; ++row) {
+      for (int col = 0; col < 100; ++col) {
+        size_t sum = 0;
+        for (size_t j = images.size() - size; j < images.size(); ++j) {
+          sum += images[j][row][col];
+        }
+        expected[row][col] = sum + 1 >= size;
+      }
+    }
+    ASSERT_EQ(time_series.size(), size);
+    time_series.getResult(5, 100, result);
+    expectEqual(result, expected);
+  }
+
+  // masks of another size restart the buffer
+  time_series.push(toBitMask(createRandomImage(6, 100, 0.0, rng)));
+  EXPECT_EQ(time_series.size(), 1U);
+  time_series.getResult(5, 100, result);
+  EXPECT_EQ(result.count(0, 5), 0U);
+}
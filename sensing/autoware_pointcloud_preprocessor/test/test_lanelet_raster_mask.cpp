@@ -0,0 +1,108 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/vector_map_filter/lanelet_raster_mask.hpp"
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using autoware::pointcloud_preprocessor::LaneletRasterMask;
+using autoware::universe_utils::Point2d;
+using autoware::universe_utils::Polygon2d;
+
+namespace
+{
+// curved lane of the given width along an arc, as a lanelet polygon with its left and right bounds
+Polygon2d createCurvedLane(
+  const Point2d & center, const double radius, const double width, const double start_angle,
+  const double end_angle)
+{
+  Polygon2d polygon;
+  constexpr int num_points = 20;
+  for (int i = 0; i <= num_points; ++i) {
+    const double angle = start_angle + (end_angle - start_angle) * i / num_points;
+    polygon.outer().emplace_back(
+      center.x() + (radius - width / 2) * std::cos(angle),
+      center.y() + (radius - width / 2) * std::sin(angle));
+  }
+  for (int i = num_points; i >= 0; --i) {
+    const double angle = start_angle + (end_angle - start_angle) * i / num_points;
+    polygon.outer().emplace_back(
+      center.x() + (radius + width / 2) * std::cos(angle),
+      center.y() + (radius + width / 2) * std::sin(angle));
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+bool withinReference(const std::vector<Polygon2d> & polygons, const Point2d & point)
+{
+  for (const auto & polygon : polygons) {
+    if (boost::geometry::within(point, polygon)) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+TEST(LaneletRasterMask, sameAsPolygonWithin)
+{
+  // map coordinates are large, as in the map frame
+  const Point2d center(89000.0, 43000.0);
+  std::vector<Polygon2d> polygons;
+  for (int i = 0; i < 8; ++i) {
+    polygons.push_back(createCurvedLane(center, 20.0 + 3.5 * (i % 4), 3.5, 0.8 * i, 0.8 * i + 1.5));
+  }
+  // adjacent lanes sharing a bound
+  polygons.push_back(createCurvedLane(Point2d(center.x() + 60.0, center.y()), 30.0, 3.5, 0.0, 1.0));
+  polygons.push_back(createCurvedLane(Point2d(center.x() + 60.0, center.y()), 33.5, 3.5, 0.0, 1.0));
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> distribution(-50.0, 100.0);
+  for (const double resolution : {0.2, 0.5, 1.7}) {
+    const LaneletRasterMask mask(polygons, resolution);
+    for (int i = 0; i < 100000; ++i) {
+      const Point2d point(center.x() + distribution(rng), center.y() + distribution(rng));
+      ASSERT_EQ(mask.isWithin(point.x(), point.y()), withinReference(polygons, point))
+        << "resolution " << resolution << ", point " << point.x() << ", " << point.y();
+    }
+    // the vertices are on the boundary, so not within
+    for (const auto & polygon : polygons) {
+      for (const auto & vertex : polygon.outer()) {
+        EXPECT_EQ(mask.isWithin(vertex.x(), vertex.y()), withinReference(polygons, vertex));
+      }
+    }
+  }
+}
+
+TEST(LaneletRasterMask, outOfMap)
+{
+  std::vector<Polygon2d> polygons{createCurvedLane(Point2d(0.0, 0.0), 10.0, 3.5, 0.0, 1.0)};
+  const LaneletRasterMask mask(polygons, 0.5);
+  EXPECT_TRUE(mask.isWithin(10.0 * std::cos(0.5), 10.0 * std::sin(0.5)));
+  EXPECT_FALSE(mask.isWithin(-1e9, 1e9));
+  EXPECT_FALSE(mask.isWithin(std::numeric_limits<double>::quiet_NaN(), 0.0));
+  EXPECT_FALSE(mask.isWithin(std::numeric_limits<double>::infinity(), 0.0));
+
+  const LaneletRasterMask empty_mask({}, 0.5);
+  EXPECT_FALSE(empty_mask.isWithin(0.0, 0.0));
+}
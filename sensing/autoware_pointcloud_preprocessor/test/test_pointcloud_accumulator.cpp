@@ -0,0 +1,177 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/pointcloud_accumulator/pointcloud_accumulator_nodelet.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using autoware::pointcloud_preprocessor::PointcloudAccumulatorComponent;
+using sensor_msgs::msg::PointCloud2;
+
+namespace
+{
+class PointcloudAccumulator : public PointcloudAccumulatorComponent
+{
+public:
+  using PointcloudAccumulatorComponent::PointcloudAccumulatorComponent;
+  using PointcloudAccumulatorComponent::filter;
+};
+
+std::shared_ptr<PointcloudAccumulator> createAccumulator(
+  const double accumulation_time_sec, const int pointcloud_buffer_size)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {{"accumulation_time_sec", accumulation_time_sec},
+     {"pointcloud_buffer_size", pointcloud_buffer_size}});
+  return std::make_shared<PointcloudAccumulator>(options);
+}
+
+// num_points points whose x is the id of the pointcloud, with a wider point type than the output
+PointCloud2::ConstSharedPtr createPointCloud(
+  const int id, const int num_points, const double stamp_sec, const bool is_dense = true)
+{
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  for (int i = 0; i < num_points; ++i) {
+    pcl::PointXYZI point;
+    point.x = static_cast<float>(id);
+    point.y = static_cast<float>(i);
+    point.z = 1.0f;
+    point.intensity = 100.0f;
+    cloud.push_back(point);
+  }
+  if (!is_dense) {
+    cloud.points.back().z = std::numeric_limits<float>::quiet_NaN();
+  }
+  cloud.is_dense = is_dense;
+
+  auto msg = std::make_shared<PointCloud2>();
+  pcl::toROSMsg(cloud, *msg);
+  msg->header.frame_id = "base_link";
+  msg->header.stamp = rclcpp::Time(static_cast<int64_t>(stamp_sec * 1e9));
+  return msg;
+}
+
+PointCloud2 accumulate(
+  PointcloudAccumulator & accumulator, const PointCloud2::ConstSharedPtr & input)
+{
+  PointCloud2 output;
+  accumulator.filter(input, nullptr, output);
+  return output;
+}
+
+// ids of the pointclouds the points of the output come from, in the output order
+std::vector<int> getIds(const PointCloud2 & output)
+{
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  pcl::fromROSMsg(output, cloud);
+  std::vector<int> ids;
+  for (const auto & point : cloud) {
+    ids.push_back(static_cast<int>(point.x));
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(PointcloudAccumulator, newestFirst)
+{
+  auto accumulator = createAccumulator(1.0, 3);
+
+  EXPECT_EQ(getIds(accumulate(*accumulator, createPointCloud(0, 1, 0.0))), std::vector<int>({0}));
+  EXPECT_EQ(
+    getIds(accumulate(*accumulator, createPointCloud(1, 2, 0.5))), std::vector<int>({1, 1, 0}));
+  EXPECT_EQ(
+    getIds(accumulate(*accumulator, createPointCloud(2, 1, 1.0))),
+    std::vector<int>({2, 1, 1, 0}));
+
+  // the pointcloud 0 is evicted from the buffer, and the pointcloud 1 is older than the
+  // accumulation time
+  const auto input = createPointCloud(3, 2, 1.8);
+  const auto output = accumulate(*accumulator, input);
+  EXPECT_EQ(getIds(output), std::vector<int>({3, 3, 2}));
+  EXPECT_EQ(output.header, input->header);
+
+  // the points of each pointcloud keep their order
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  pcl::fromROSMsg(output, cloud);
+  EXPECT_FLOAT_EQ(cloud.points.at(0).y, 0.0f);
+  EXPECT_FLOAT_EQ(cloud.points.at(1).y, 1.0f);
+
+  // the newest pointclouds are kept when the buffer is shrunk
+  accumulator->set_parameter(rclcpp::Parameter("pointcloud_buffer_size", 1));
+  EXPECT_EQ(getIds(accumulate(*accumulator, createPointCloud(4, 1, 1.9))), std::vector<int>({4}));
+  accumulator->set_parameter(rclcpp::Parameter("pointcloud_buffer_size", 3));
+  EXPECT_EQ(
+    getIds(accumulate(*accumulator, createPointCloud(5, 1, 2.0))), std::vector<int>({5, 4}));
+}
+
+TEST(PointcloudAccumulator, pointXYZLayout)
+{
+  auto accumulator = createAccumulator(1.0, 3);
+  accumulate(*accumulator, createPointCloud(0, 3, 0.0));
+  const auto output = accumulate(*accumulator, createPointCloud(1, 2, 0.1));
+
+  // the points are copied with the layout of pcl::PointXYZ, not the one of the input
+  EXPECT_EQ(sizeof(pcl::PointXYZ), 16U);
+  EXPECT_EQ(output.point_step, sizeof(pcl::PointXYZ));
+  EXPECT_EQ(output.height, 1U);
+  EXPECT_EQ(output.width, 5U);
+  EXPECT_EQ(output.row_step, output.width * output.point_step);
+  EXPECT_EQ(output.data.size(), output.width * sizeof(pcl::PointXYZ));
+  ASSERT_EQ(output.fields.size(), 3U);
+  EXPECT_EQ(output.fields.at(0).name, "x");
+  EXPECT_EQ(output.fields.at(0).offset, 0U);
+  EXPECT_EQ(output.fields.at(1).name, "y");
+  EXPECT_EQ(output.fields.at(1).offset, 4U);
+  EXPECT_EQ(output.fields.at(2).name, "z");
+  EXPECT_EQ(output.fields.at(2).offset, 8U);
+
+  const auto * points = reinterpret_cast<const pcl::PointXYZ *>(output.data.data());
+  EXPECT_FLOAT_EQ(points[1].x, 1.0f);
+  EXPECT_FLOAT_EQ(points[1].y, 1.0f);
+  EXPECT_FLOAT_EQ(points[4].x, 0.0f);
+  EXPECT_FLOAT_EQ(points[4].y, 2.0f);
+  EXPECT_FLOAT_EQ(points[4].z, 1.0f);
+}
+
+TEST(PointcloudAccumulator, isDenseOfAllPointclouds)
+{
+  auto accumulator = createAccumulator(1.0, 3);
+
+  EXPECT_TRUE(accumulate(*accumulator, createPointCloud(0, 2, 0.0)).is_dense);
+  EXPECT_FALSE(accumulate(*accumulator, createPointCloud(1, 2, 0.5, false)).is_dense);
+  // the pointcloud which is not dense is still accumulated
+  EXPECT_FALSE(accumulate(*accumulator, createPointCloud(2, 2, 1.0)).is_dense);
+  // and is dropped after the accumulation time
+  const auto output = accumulate(*accumulator, createPointCloud(3, 2, 1.6));
+  EXPECT_EQ(getIds(output), std::vector<int>({3, 3, 2, 2}));
+  EXPECT_TRUE(output.is_dense);
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  int ret = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return ret;
+}
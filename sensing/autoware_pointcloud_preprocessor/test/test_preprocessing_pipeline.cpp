@@ -0,0 +1,253 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/crop_box_filter/crop_box_filter_nodelet.hpp"
+#include "autoware/pointcloud_preprocessor/outlier_filter/ring_outlier_filter.hpp"
+#include "autoware/pointcloud_preprocessor/preprocessing_pipeline/pipeline_stage.hpp"
+#include "autoware/pointcloud_preprocessor/preprocessing_pipeline/preprocessing_pipeline_node.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <pcl_conversions/pcl_conversions.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::pointcloud_preprocessor::createPipelineStage;
+using autoware::pointcloud_preprocessor::CropBoxParam;
+using autoware::pointcloud_preprocessor::PipelineStage;
+using autoware::pointcloud_preprocessor::PreprocessingPipelineComponent;
+using autoware::pointcloud_preprocessor::RingOutlierFilter;
+using autoware::pointcloud_preprocessor::RingOutlierFilterParam;
+using autoware::pointcloud_preprocessor::TransformInfo;
+using autoware_point_types::PointXYZIRC;
+using autoware_point_types::PointXYZIRCAEDT;
+using sensor_msgs::msg::PointCloud2;
+
+namespace
+{
+PointXYZIRCAEDT createPoint(const uint16_t channel, const float azimuth, const float distance)
+{
+  PointXYZIRCAEDT point;
+  point.x = distance * std::cos(azimuth);
+  point.y = distance * std::sin(azimuth);
+  point.z = 0.01f * channel;
+  point.intensity = static_cast<uint8_t>(channel + 10);
+  point.return_type = 1;
+  point.channel = channel;
+  point.azimuth = azimuth;
+  point.distance = distance;
+  return point;
+}
+
+// rings around the sensor, with some points of the vehicle itself close to the origin
+PointCloud2 createPointCloud()
+{
+  pcl::PointCloud<PointXYZIRCAEDT> cloud;
+  for (int i = 0; i < 100; ++i) {
+    for (uint16_t channel = 0; channel < 4; ++channel) {
+      cloud.push_back(createPoint(channel, 0.01f * i, 10.0f + channel));
+      if (i % 10 == 0) {
+        cloud.push_back(createPoint(channel, 0.01f * i, 0.5f));
+      }
+    }
+  }
+  PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  msg.header.frame_id = "base_link";
+  msg.header.stamp = rclcpp::Time(10, 0, RCL_ROS_TIME);
+  return msg;
+}
+
+PointCloud2 createRandomPointCloud(const size_t num_points)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+  pcl::PointCloud<PointXYZIRCAEDT> cloud;
+  for (size_t i = 0; i < num_points; ++i) {
+    PointXYZIRCAEDT point = createPoint(static_cast<uint16_t>(i % 16), 0.0f, 0.0f);
+    point.x = distribution(rng);
+    point.y = distribution(rng);
+    point.z = i % 50 == 0 ? std::numeric_limits<float>::quiet_NaN() : distribution(rng);
+    point.time_stamp = static_cast<uint32_t>(i);
+    cloud.push_back(point);
+  }
+  PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  return msg;
+}
+
+void expectSamePoints(const PointCloud2 & actual, const PointCloud2 & expected)
+{
+  EXPECT_EQ(actual.width, expected.width);
+  EXPECT_EQ(actual.height, expected.height);
+  EXPECT_EQ(actual.row_step, expected.row_step);
+  EXPECT_EQ(actual.point_step, expected.point_step);
+  EXPECT_EQ(actual.fields, expected.fields);
+  EXPECT_EQ(actual.data, expected.data);
+}
+}  // namespace
+
+TEST(PreprocessingPipeline, cropBoxInPlace)
+{
+  CropBoxParam param;
+  param.min_x = -1.0f;
+  param.max_x = 1.5f;
+  param.min_y = -2.0f;
+  param.max_y = 1.0f;
+  param.min_z = -0.5f;
+  param.max_z = 2.0f;
+
+  TransformInfo transform_info;
+  transform_info.need_transform = true;
+  transform_info.eigen_transform(0, 3) = 0.5f;
+  transform_info.eigen_transform(2, 3) = -1.0f;
+
+  const auto input = createRandomPointCloud(2000);
+  for (const bool negative : {false, true}) {
+    param.negative = negative;
+    for (const auto & info : {TransformInfo(), transform_info}) {
+      PointCloud2 output;
+      const int skipped_count = cropBox(input, param, info, output);
+
+      auto in_place = input;
+      const int in_place_skipped_count = cropBox(in_place, param, info, in_place);
+      EXPECT_EQ(in_place_skipped_count, skipped_count);
+      EXPECT_EQ(in_place_skipped_count, 40);
+      expectSamePoints(in_place, output);
+    }
+  }
+}
+
+TEST(PreprocessingPipeline, stageChain)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {{"crop_box.self.negative", true},
+     {"crop_box.self.min_x", -2.0},
+     {"crop_box.self.max_x", 2.0}});
+  rclcpp::Node node("test_stage_chain", options);
+
+  std::vector<std::unique_ptr<PipelineStage>> stages;
+  stages.push_back(createPipelineStage(node, "crop_box.self"));
+  stages.push_back(createPipelineStage(node, "ring_outlier_filter"));
+  EXPECT_EQ(stages[0]->topic_name(), "crop_box_self");
+  EXPECT_THROW(createPipelineStage(node, "unknown_filter"), std::invalid_argument);
+
+  // expected result, from the filters writing to separate buffers
+  const auto input = createPointCloud();
+  CropBoxParam crop_box_param;
+  crop_box_param.min_x = -2.0f;
+  crop_box_param.max_x = 2.0f;
+  crop_box_param.min_y = -1.0f;
+  crop_box_param.max_y = 1.0f;
+  crop_box_param.min_z = -1.0f;
+  crop_box_param.max_z = 1.0f;
+  crop_box_param.negative = true;
+  PointCloud2 cropped;
+  cropBox(input, crop_box_param, TransformInfo(), cropped);
+  RingOutlierFilter ring_outlier_filter;
+  ring_outlier_filter.setParam(RingOutlierFilterParam());
+  PointCloud2 expected;
+  ring_outlier_filter.filter(cropped, TransformInfo(), expected);
+  ASSERT_GT(expected.width, 0U);
+
+  // the buffers are reused from one frame to the next
+  auto scratch = std::make_unique<PointCloud2>();
+  for (int frame = 0; frame < 3; ++frame) {
+    auto points = std::make_unique<PointCloud2>(input);
+    for (auto & stage : stages) {
+      stage->process(points, scratch);
+    }
+    EXPECT_EQ(points->header, input.header);
+    EXPECT_EQ(points->point_step, sizeof(PointXYZIRC));
+    expectSamePoints(*points, expected);
+  }
+}
+
+TEST(PreprocessingPipeline, nodeWithDefaultConfig)
+{
+  rclcpp::NodeOptions options;
+  options.arguments(
+    {"--ros-args", "--params-file",
+     ament_index_cpp::get_package_share_directory("autoware_pointcloud_preprocessor") +
+       "/config/preprocessing_pipeline_node.param.yaml"});
+  auto pipeline_node = std::make_shared<PreprocessingPipelineComponent>(options);
+
+  auto test_node = std::make_shared<rclcpp::Node>("test_preprocessing_pipeline");
+  PointCloud2::ConstSharedPtr output;
+  auto output_sub = test_node->create_subscription<PointCloud2>(
+    "/preprocessing_pipeline_node/output/pointcloud", rclcpp::SensorDataQoS(),
+    [&output](const PointCloud2::ConstSharedPtr msg) { output = msg; });
+  auto input_pub = test_node->create_publisher<PointCloud2>(
+    "/preprocessing_pipeline_node/input/pointcloud", rclcpp::SensorDataQoS());
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(pipeline_node);
+  executor.add_node(test_node);
+
+  // the input is published until the pipeline node is connected and processes it
+  const auto input = createPointCloud();
+  const auto start = std::chrono::steady_clock::now();
+  while (!output && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    input_pub->publish(input);
+    executor.spin_some(std::chrono::milliseconds(50));
+  }
+  ASSERT_TRUE(output);
+
+  EXPECT_EQ(output->header.frame_id, "base_link");
+  EXPECT_EQ(output->point_step, sizeof(PointXYZIRC));
+  ASSERT_GT(output->width, 0U);
+  pcl::PointCloud<PointXYZIRC> output_cloud;
+  pcl::fromROSMsg(*output, output_cloud);
+  for (const auto & point : output_cloud) {
+    // the points of the vehicle are removed by the crop box stages
+    EXPECT_GT(std::hypot(point.x, point.y), 1.0f);
+  }
+
+  // the processing time of each stage is published, under a valid topic name
+  const auto has_debug_topics = [&test_node]() {
+    const auto topics = test_node->get_topic_names_and_types();
+    for (const auto & stage_name : {"crop_box_self", "crop_box_mirror", "ring_outlier_filter"}) {
+      if (!topics.count(
+            std::string("/preprocessing_pipeline/debug/") + stage_name + "/processing_time_ms")) {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto discovery_start = std::chrono::steady_clock::now();
+  while (!has_debug_topics() &&
+         std::chrono::steady_clock::now() - discovery_start < std::chrono::seconds(5)) {
+    executor.spin_some(std::chrono::milliseconds(50));
+  }
+  EXPECT_TRUE(has_debug_topics());
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  int ret = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return ret;
+}
@@ -0,0 +1,118 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pointcloud_preprocessor/outlier_filter/ring_outlier_filter.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using autoware::pointcloud_preprocessor::RingOutlierFilter;
+using autoware::pointcloud_preprocessor::RingOutlierFilterParam;
+using autoware::pointcloud_preprocessor::TransformInfo;
+using autoware_point_types::PointXYZIRC;
+using autoware_point_types::PointXYZIRCAEDT;
+
+namespace
+{
+PointXYZIRCAEDT createPoint(const uint16_t channel, const float azimuth, const float distance)
+{
+  PointXYZIRCAEDT point;
+  point.x = distance * std::cos(azimuth);
+  point.y = distance * std::sin(azimuth);
+  point.z = 0.01f * channel;
+  point.intensity = static_cast<uint8_t>(channel + 10);
+  point.return_type = 1;
+  point.channel = channel;
+  point.azimuth = azimuth;
+  point.distance = distance;
+  return point;
+}
+
+// rings fired one after another, with a spike at index 10 of the ring given as spike_channel
+sensor_msgs::msg::PointCloud2 createPointCloud(
+  const std::vector<uint16_t> & channels, const uint16_t spike_channel)
+{
+  pcl::PointCloud<PointXYZIRCAEDT> cloud;
+  for (int i = 0; i < 20; ++i) {
+    for (const auto channel : channels) {
+      const float distance = (channel == spike_channel && i == 10) ? 3.0f : 10.0f;
+      cloud.push_back(createPoint(channel, 0.01f * i, distance));
+    }
+  }
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  return msg;
+}
+}  // namespace
+
+TEST(RingOutlierFilter, removeSpike)
+{
+  RingOutlierFilter filter;
+  RingOutlierFilterParam param;
+  param.horizontal_bins = 4;
+  filter.setParam(param);
+
+  const auto input = createPointCloud({1, 0}, 1);
+  sensor_msgs::msg::PointCloud2 output;
+  pcl::PointCloud<PointXYZIRCAEDT> outlier_points;
+  float visibility_score = 0.0f;
+  filter.filter(input, TransformInfo(), output, &outlier_points, &visibility_score);
+
+  // the last point of each ring ends no walk and is never kept
+  ASSERT_EQ(output.width, 19U + 18U);
+  ASSERT_EQ(output.data.size(), output.width * sizeof(PointXYZIRC));
+  const auto * points = reinterpret_cast<const PointXYZIRC *>(output.data.data());
+  for (size_t i = 0; i < output.width; ++i) {
+    // the points are sorted by ring
+    const uint16_t channel = i < 19 ? 0 : 1;
+    EXPECT_EQ(points[i].channel, channel);
+    EXPECT_EQ(points[i].intensity, channel + 10);
+    EXPECT_EQ(points[i].return_type, 1);
+    EXPECT_FLOAT_EQ(std::hypot(points[i].x, points[i].y), 10.0f);
+  }
+
+  ASSERT_EQ(outlier_points.size(), 1U);
+  EXPECT_EQ(outlier_points.points.front().channel, 1);
+  EXPECT_FLOAT_EQ(outlier_points.points.front().distance, 3.0f);
+  EXPECT_FLOAT_EQ(visibility_score, 1.0f - 1.0f / (128.0f * 4.0f));
+
+  // the result does not depend on the buffers of the previous call
+  const auto input2 = createPointCloud({300, 2}, 2);
+  filter.filter(input2, TransformInfo(), output);
+  ASSERT_EQ(output.width, 18U + 19U);
+  points = reinterpret_cast<const PointXYZIRC *>(output.data.data());
+  EXPECT_EQ(points[0].channel, 2);
+  EXPECT_EQ(points[output.width - 1].channel, 300);
+}
+
+TEST(RingOutlierFilter, transform)
+{
+  RingOutlierFilter filter;
+  TransformInfo transform_info;
+  transform_info.need_transform = true;
+  transform_info.eigen_transform(0, 3) = 1.0f;
+
+  const auto input = createPointCloud({0}, 0);
+  sensor_msgs::msg::PointCloud2 output;
+  filter.filter(input, transform_info, output);
+
+  ASSERT_EQ(output.width, 18U);
+  const auto * points = reinterpret_cast<const PointXYZIRC *>(output.data.data());
+  EXPECT_FLOAT_EQ(points[0].x, 11.0f);
+  EXPECT_FLOAT_EQ(points[0].y, 0.0f);
+}
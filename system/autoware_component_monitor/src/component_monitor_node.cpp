@@ -14,60 +14,62 @@
 
 #include "component_monitor_node.hpp"
 
-#include "unit_conversions.hpp"
-
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_internal_msgs/msg/resource_usage_report.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <diagnostic_msgs/msg/key_value.hpp>
 
-#include <boost/process.hpp>
+#include <unistd.h>
 
-#include <cctype>
-#include <cstdint>
 #include <exception>
-#include <functional>
-#include <sstream>
 #include <string>
-#include <unordered_map>
-#include <utility>
-#include <vector>
 
 namespace autoware::component_monitor
 {
+namespace
+{
+diagnostic_msgs::msg::KeyValue create_key_value(const std::string & key, const std::string & value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+}  // namespace
+
 ComponentMonitor::ComponentMonitor(const rclcpp::NodeOptions & node_options)
-: Node("component_monitor", node_options), publish_rate_(declare_parameter<double>("publish_rate"))
+: Node("component_monitor", node_options),
+  publish_rate_(declare_parameter<double>("publish_rate")),
+  pid_(getpid())
 {
   usage_pub_ =
     create_publisher<ResourceUsageReport>("~/component_system_usage", rclcpp::SensorDataQoS());
-
-  // Make sure top ins installed and is in path
-  const auto path_top = boost::process::search_path("top");
-  if (path_top.empty()) {
-    RCLCPP_ERROR_STREAM(get_logger(), "Couldn't find 'top' in path.");
-    rclcpp::shutdown();
-  }
-
-  // Get the PID of the current process
-  int pid = getpid();
-
-  environment_ = boost::this_process::environment();
-  environment_["LC_NUMERIC"] = "en_US.UTF-8";
-
-  on_timer_tick_wrapped_ = std::bind(&ComponentMonitor::on_timer_tick, this, pid);
+  thread_usage_pub_ =
+    create_publisher<DiagnosticArray>("~/component_thread_usage", rclcpp::SensorDataQoS());
 
   timer_ = rclcpp::create_timer(
-    this, get_clock(), rclcpp::Rate(publish_rate_).period(), on_timer_tick_wrapped_);
+    this, get_clock(), rclcpp::Rate(publish_rate_).period(), [this]() { on_timer_tick(); });
 }
 
-void ComponentMonitor::on_timer_tick(const int pid) const
+void ComponentMonitor::on_timer_tick()
 {
-  if (usage_pub_->get_subscription_count() == 0) return;
+  // Keep sampling without subscribers so that the next usage covers only one period.
+  const auto usage = sampler_.sample();
+  const auto stamp = this->now();
 
   try {
-    auto usage_msg = pid_to_report(pid);
-    usage_msg.header.stamp = this->now();
-    usage_msg.pid = pid;
-    usage_pub_->publish(usage_msg);
+    if (usage_pub_->get_subscription_count() != 0) {
+      auto usage_msg = usage_to_report(usage);
+      usage_msg.header.stamp = stamp;
+      usage_pub_->publish(usage_msg);
+    }
+    if (thread_usage_pub_->get_subscription_count() != 0) {
+      auto thread_usage_msg = usage_to_thread_report(usage);
+      thread_usage_msg.header.stamp = stamp;
+      thread_usage_pub_->publish(thread_usage_msg);
+    }
   } catch (std::exception & e) {
     RCLCPP_ERROR(get_logger(), "%s", e.what());
   } catch (...) {
@@ -75,100 +77,45 @@ void ComponentMonitor::on_timer_tick(const int pid) const
   }
 }
 
-ComponentMonitor::ResourceUsageReport ComponentMonitor::pid_to_report(const pid_t & pid) const
+ComponentMonitor::ResourceUsageReport ComponentMonitor::usage_to_report(
+  const ProcessUsage & usage) const
 {
-  const auto std_out = run_system_command("top -b -n 1 -E k -p " + std::to_string(pid));
-
-  const auto fields = parse_lines_into_words(std_out);
-
   ResourceUsageReport report;
-  report.cpu_cores_utilized = std::stof(fields.back().at(8)) / 100.0f;
-  report.total_memory_bytes = unit_conversions::kib_to_bytes(std::stoul(fields.at(3).at(3)));
-  report.free_memory_bytes = unit_conversions::kib_to_bytes(std::stoul(fields.at(3).at(5)));
-  report.process_memory_bytes = parse_memory_res(fields.back().at(5));
-
+  report.pid = pid_;
+  report.cpu_cores_utilized = usage.cpu_cores_utilized;
+  report.total_memory_bytes = usage.total_memory_bytes;
+  report.free_memory_bytes = usage.free_memory_bytes;
+  report.process_memory_bytes = usage.process_memory_bytes;
   return report;
 }
 
-std::stringstream ComponentMonitor::run_system_command(const std::string & cmd) const
-{
-  int out_fd[2];
-  if (pipe2(out_fd, O_CLOEXEC) != 0) {
-    RCLCPP_ERROR_STREAM(get_logger(), "Error setting flags on out_fd");
-  }
-  boost::process::pipe out_pipe{out_fd[0], out_fd[1]};
-  boost::process::ipstream is_out{std::move(out_pipe)};
-
-  int err_fd[2];
-  if (pipe2(err_fd, O_CLOEXEC) != 0) {
-    RCLCPP_ERROR_STREAM(get_logger(), "Error setting flags on err_fd");
-  }
-  boost::process::pipe err_pipe{err_fd[0], err_fd[1]};
-  boost::process::ipstream is_err{std::move(err_pipe)};
-
-  boost::process::child c(
-    cmd, environment_, boost::process::std_out > is_out, boost::process::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    RCLCPP_ERROR_STREAM(get_logger(), "Error running command: " << os.str());
-  }
-
-  std::stringstream sstream;
-  sstream << is_out.rdbuf();
-  return sstream;
-}
-
-ComponentMonitor::VecVecStr ComponentMonitor::parse_lines_into_words(
-  const std::stringstream & std_out)
+ComponentMonitor::DiagnosticArray ComponentMonitor::usage_to_thread_report(
+  const ProcessUsage & usage) const
 {
-  VecVecStr fields;
-  std::string line;
-  std::istringstream input{std_out.str()};
-
-  while (std::getline(input, line)) {
-    std::istringstream iss_line{line};
-    std::string word;
-    std::vector<std::string> words;
-
-    while (iss_line >> word) {
-      words.push_back(word);
-    }
-
-    fields.push_back(words);
+  DiagnosticArray array;
+  array.status.reserve(usage.threads.size() + 1);
+
+  diagnostic_msgs::msg::DiagnosticStatus process_status;
+  process_status.name = "process";
+  process_status.hardware_id = std::to_string(pid_);
+  process_status.values.push_back(
+    create_key_value("cpu_cores_utilized", std::to_string(usage.cpu_cores_utilized)));
+  process_status.values.push_back(
+    create_key_value("process_memory_bytes", std::to_string(usage.process_memory_bytes)));
+  process_status.values.push_back(create_key_value(
+    "peak_process_memory_bytes", std::to_string(usage.peak_process_memory_bytes)));
+  array.status.push_back(process_status);
+
+  for (const auto & thread : usage.threads) {
+    diagnostic_msgs::msg::DiagnosticStatus thread_status;
+    thread_status.name = thread.name + " (" + std::to_string(thread.tid) + ")";
+    thread_status.hardware_id = std::to_string(pid_);
+    thread_status.values.push_back(create_key_value("tid", std::to_string(thread.tid)));
+    thread_status.values.push_back(
+      create_key_value("cpu_cores_utilized", std::to_string(thread.cpu_cores_utilized)));
+    array.status.push_back(thread_status);
   }
-
-  return fields;
-}
-
-std::uint64_t ComponentMonitor::parse_memory_res(const std::string & mem_res)
-{
-  // example 1: 12.3g
-  // example 2: 123 (without suffix, just bytes)
-  static const std::unordered_map<char, std::function<std::uint64_t(double)>> unit_map{
-    {'k', unit_conversions::kib_to_bytes<double>}, {'m', unit_conversions::mib_to_bytes<double>},
-    {'g', unit_conversions::gib_to_bytes<double>}, {'t', unit_conversions::tib_to_bytes<double>},
-    {'p', unit_conversions::pib_to_bytes<double>}, {'e', unit_conversions::eib_to_bytes<double>}};
-
-  if (std::isdigit(mem_res.back())) {
-    return std::stoull(mem_res);  // Handle plain bytes without any suffix
-  }
-
-  // Extract the numeric part and the unit suffix
-  double value = std::stod(mem_res.substr(0, mem_res.size() - 1));
-  char suffix = mem_res.back();
-
-  // Find the appropriate function from the map
-  auto it = unit_map.find(suffix);
-  if (it != unit_map.end()) {
-    const auto & conversion_function = it->second;
-    return conversion_function(value);
-  }
-
-  // Throw an exception or handle the error as needed if the suffix is not recognized
-  throw std::runtime_error("Unsupported unit suffix: " + std::string(1, suffix));
+  return array;
 }
 
 }  // namespace autoware::component_monitor
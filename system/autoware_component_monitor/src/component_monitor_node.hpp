@@ -15,16 +15,14 @@
 #ifndef COMPONENT_MONITOR_NODE_HPP_
 #define COMPONENT_MONITOR_NODE_HPP_
 
+#include "process_sampler.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_internal_msgs/msg/resource_usage_report.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
-#include <boost/process.hpp>
-
-#include <cstdint>
-#include <sstream>
-#include <string>
-#include <vector>
+#include <sys/types.h>
 
 namespace autoware::component_monitor
 {
@@ -35,66 +33,31 @@ public:
 
 private:
   using ResourceUsageReport = autoware_internal_msgs::msg::ResourceUsageReport;
-  using VecVecStr = std::vector<std::vector<std::string>>;
+  using DiagnosticArray = diagnostic_msgs::msg::DiagnosticArray;
 
   const double publish_rate_;
+  const pid_t pid_;
 
-  std::function<void()> on_timer_tick_wrapped_;
+  ProcessSampler sampler_;
 
   rclcpp::Publisher<ResourceUsageReport>::SharedPtr usage_pub_;
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr thread_usage_pub_;
   rclcpp::TimerBase::SharedPtr timer_;
 
-  boost::process::native_environment environment_;
-
-  void on_timer_tick(int pid) const;
+  void on_timer_tick();
 
   /**
-   * @brief Get system usage of the component.
-   *
-   * @details The output of top -b -n 1 -E k -p PID` is like below:
-   *
-   * top - 13:57:26 up  3:14,  1 user,  load average: 1,09, 1,10, 1,04
-   * Tasks:   1 total,   0 running,   1 sleeping,   0 stopped,   0 zombie
-   * %Cpu(s):  0,0 us,  0,8 sy,  0,0 ni, 99,2 id,  0,0 wa,  0,0 hi,  0,0 si,  0,0 st
-   * KiB Mem : 65532208 total, 35117428 free, 17669824 used, 12744956 buff/cache
-   * KiB Swap: 39062524 total, 39062524 free,        0 used. 45520816 avail Mem
-   *
-   *     PID USER      PR  NI    VIRT    RES    SHR S  %CPU  %MEM     TIME+ COMMAND
-   *    3352 meb       20   0 2905940   1,2g  39292 S   0,0   2,0  23:24.01 awesome
-   *
-   * We get 5th and 8th fields, which are RES, %CPU, respectively.
+   * @brief Convert the process usage to the report of the whole container.
    */
-  ResourceUsageReport pid_to_report(const pid_t & pid) const;
+  ResourceUsageReport usage_to_report(const ProcessUsage & usage) const;
 
   /**
-   * @brief Run a terminal command and return the standard output.
-   *
-   * @param cmd The terminal command to run
-   * @return  The standard output of the command
-   */
-  std::stringstream run_system_command(const std::string & cmd) const;
-
-  /**
-   * @brief Parses text from a stringstream into separated words by line.
-   *
-   * @param std_out Reference to the input stringstream.
-   * @return Nested vector with each inner vector containing words from one line.
-   */
-  static VecVecStr parse_lines_into_words(const std::stringstream & std_out);
-
-  /**
-   * @brief Parses a memory resource string and converts it to bytes.
-   *
-   * This function handles memory size strings with suffixes to denote
-   * the units (e.g., "k" for kibibytes, "m" for mebibytes, etc.).
-   * If the string has no suffix, it is interpreted as plain bytes.
-   *
-   * @param mem_res A string representing the memory resource with a unit suffix or just bytes.
-   * @return uint64_t The memory size in bytes.
+   * @brief Convert the process usage to the diagnostic array with a status for each thread.
    *
-   * @exception std::runtime_error Thrown if the suffix is not recognized.
+   * @details Each thread is named by its comm, which can be set by pthread_setname_np, and TID.
+   * The peak memory of the process is reported in the status named "process".
    */
-  static std::uint64_t parse_memory_res(const std::string & mem_res);
+  DiagnosticArray usage_to_thread_report(const ProcessUsage & usage) const;
 };
 
 }  // namespace autoware::component_monitor
@@ -0,0 +1,166 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "process_sampler.hpp"
+
+#include "unit_conversions.hpp"
+
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace autoware::component_monitor
+{
+namespace
+{
+std::string read_file(const std::string & path)
+{
+  std::ifstream ifs(path);
+  return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+ProcessSampler::ProcessSampler()
+: seconds_per_tick_(1.0 / static_cast<double>(sysconf(_SC_CLK_TCK))),
+  page_size_(static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE))),
+  prev_time_(Clock::now()),
+  prev_process_cpu_usec_(get_process_cpu_usec())
+{
+  for (const auto & [tid, stat] : read_thread_stats()) {
+    prev_thread_cpu_ticks_[tid] = stat.cpu_ticks;
+  }
+}
+
+ProcessUsage ProcessSampler::sample()
+{
+  const auto time = Clock::now();
+  const auto process_cpu_usec = get_process_cpu_usec();
+  const auto thread_stats = read_thread_stats();
+  const double elapsed = std::chrono::duration<double>(time - prev_time_).count();
+  const auto to_cores = [elapsed](double cpu_seconds) {
+    return 0.0 < elapsed ? static_cast<float>(cpu_seconds / elapsed) : 0.0f;
+  };
+
+  ProcessUsage usage;
+  usage.cpu_cores_utilized =
+    to_cores(static_cast<double>(process_cpu_usec - prev_process_cpu_usec_) * 1e-6);
+
+  // The threads created after the previous sample are measured from their start.
+  std::unordered_map<pid_t, std::uint64_t> thread_cpu_ticks;
+  usage.threads.reserve(thread_stats.size());
+  for (const auto & [tid, stat] : thread_stats) {
+    const auto iter = prev_thread_cpu_ticks_.find(tid);
+    const auto prev_ticks = iter != prev_thread_cpu_ticks_.end() ? iter->second : 0;
+    const auto ticks = stat.cpu_ticks - std::min(prev_ticks, stat.cpu_ticks);
+    usage.threads.push_back(
+      ThreadUsage{tid, stat.name, to_cores(static_cast<double>(ticks) * seconds_per_tick_)});
+    thread_cpu_ticks[tid] = stat.cpu_ticks;
+  }
+  std::sort(usage.threads.begin(), usage.threads.end(), [](const auto & a, const auto & b) {
+    return a.tid < b.tid;
+  });
+
+  const auto resident_pages = parse_statm_resident(read_file("/proc/self/statm"));
+  usage.process_memory_bytes = resident_pages ? resident_pages.value() * page_size_ : 0;
+
+  rusage self_usage{};
+  getrusage(RUSAGE_SELF, &self_usage);
+  usage.peak_process_memory_bytes = unit_conversions::kib_to_bytes(self_usage.ru_maxrss);
+
+  struct sysinfo system_info = {};
+  sysinfo(&system_info);
+  usage.total_memory_bytes =
+    static_cast<std::uint64_t>(system_info.totalram) * system_info.mem_unit;
+  usage.free_memory_bytes = static_cast<std::uint64_t>(system_info.freeram) * system_info.mem_unit;
+
+  prev_time_ = time;
+  prev_process_cpu_usec_ = process_cpu_usec;
+  prev_thread_cpu_ticks_ = std::move(thread_cpu_ticks);
+  return usage;
+}
+
+std::optional<ProcessSampler::ThreadStat> ProcessSampler::parse_thread_stat(
+  const std::string & stat)
+{
+  // Format: "pid (comm) state ppid ..." where utime and stime are the 14th and 15th fields.
+  const auto name_begin = stat.find('(');
+  const auto name_end = stat.rfind(')');
+  if (name_begin == std::string::npos || name_end == std::string::npos || name_end < name_begin) {
+    return std::nullopt;
+  }
+
+  std::istringstream iss(stat.substr(name_end + 1));
+  std::string field;
+  for (int i = 3; i < 14; ++i) {
+    if (!(iss >> field)) return std::nullopt;
+  }
+  std::uint64_t utime = 0;
+  std::uint64_t stime = 0;
+  if (!(iss >> utime >> stime)) return std::nullopt;
+
+  return ThreadStat{stat.substr(name_begin + 1, name_end - name_begin - 1), utime + stime};
+}
+
+std::optional<std::uint64_t> ProcessSampler::parse_statm_resident(const std::string & statm)
+{
+  // Format: "size resident shared text lib data dt" in pages.
+  std::istringstream iss(statm);
+  std::uint64_t size = 0;
+  std::uint64_t resident = 0;
+  if (!(iss >> size >> resident)) return std::nullopt;
+  return resident;
+}
+
+std::uint64_t ProcessSampler::get_process_cpu_usec()
+{
+  rusage self_usage{};
+  getrusage(RUSAGE_SELF, &self_usage);
+  const auto to_usec = [](const timeval & tv) {
+    return static_cast<std::uint64_t>(tv.tv_sec) * 1000000ULL +
+           static_cast<std::uint64_t>(tv.tv_usec);
+  };
+  return to_usec(self_usage.ru_utime) + to_usec(self_usage.ru_stime);
+}
+
+std::unordered_map<pid_t, ProcessSampler::ThreadStat> ProcessSampler::read_thread_stats() const
+{
+  std::unordered_map<pid_t, ThreadStat> stats;
+  DIR * dir = opendir("/proc/self/task");
+  if (!dir) return stats;
+
+  while (const dirent * entry = readdir(dir)) {
+    char * end = nullptr;
+    const auto tid = static_cast<pid_t>(std::strtol(entry->d_name, &end, 10));
+    if (end == entry->d_name || *end != '\0') continue;  // Skip "." and "..".
+
+    // The thread may exit while reading the directory.
+    const auto path = "/proc/self/task/" + std::string(entry->d_name) + "/stat";
+    const auto stat = parse_thread_stat(read_file(path));
+    if (stat) stats.emplace(tid, stat.value());
+  }
+  closedir(dir);
+  return stats;
+}
+
+}  // namespace autoware::component_monitor
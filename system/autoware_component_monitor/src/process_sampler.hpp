@@ -0,0 +1,99 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROCESS_SAMPLER_HPP_
+#define PROCESS_SAMPLER_HPP_
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware::component_monitor
+{
+struct ThreadUsage
+{
+  pid_t tid;
+  std::string name;
+  float cpu_cores_utilized;
+};
+
+struct ProcessUsage
+{
+  float cpu_cores_utilized;
+  std::uint64_t process_memory_bytes;
+  std::uint64_t peak_process_memory_bytes;
+  std::uint64_t total_memory_bytes;
+  std::uint64_t free_memory_bytes;
+  std::vector<ThreadUsage> threads;
+};
+
+/**
+ * @brief Samples CPU and memory usage of the current process and its threads without spawning
+ * any process.
+ *
+ * @details The CPU usage is the difference of the CPU time since the previous sample divided by
+ * the elapsed time. The process CPU time is read by getrusage, the thread CPU times by
+ * /proc/self/task/TID/stat, and the resident memory by /proc/self/statm.
+ */
+class ProcessSampler
+{
+public:
+  struct ThreadStat
+  {
+    std::string name;
+    std::uint64_t cpu_ticks;
+  };
+
+  ProcessSampler();
+
+  ProcessUsage sample();
+
+  /**
+   * @brief Parses the name and the CPU time (utime + stime) from the content of a stat file.
+   *
+   * @details The name is enclosed in parentheses and may contain spaces and parentheses, so the
+   * fields after the name are counted from the last closing parenthesis.
+   *
+   * @param stat The content of /proc/PID/task/TID/stat
+   * @return The parsed stat, or std::nullopt if the content is malformed.
+   */
+  static std::optional<ThreadStat> parse_thread_stat(const std::string & stat);
+
+  /**
+   * @brief Parses the resident set size in pages from the content of /proc/PID/statm.
+   */
+  static std::optional<std::uint64_t> parse_statm_resident(const std::string & statm);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  double seconds_per_tick_;
+  std::uint64_t page_size_;
+
+  Clock::time_point prev_time_;
+  std::uint64_t prev_process_cpu_usec_;
+  std::unordered_map<pid_t, std::uint64_t> prev_thread_cpu_ticks_;
+
+  static std::uint64_t get_process_cpu_usec();
+  std::unordered_map<pid_t, ThreadStat> read_thread_stats() const;
+};
+
+}  // namespace autoware::component_monitor
+
+#endif  // PROCESS_SAMPLER_HPP_
@@ -0,0 +1,79 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "process_sampler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace autoware::component_monitor
+{
+TEST(ProcessSampler, parse_thread_stat)
+{
+  const auto stat = ProcessSampler::parse_thread_stat(
+    "1234 (component_container) S 1 1234 1234 0 -1 4194560 2470 0 0 0 150 42 0 0 20 0 12 0");
+  ASSERT_TRUE(stat);
+  EXPECT_EQ(stat->name, "component_container");
+  EXPECT_EQ(stat->cpu_ticks, 192U);
+
+  // The name may contain spaces and parentheses.
+  const auto stat_with_spaces =
+    ProcessSampler::parse_thread_stat("42 (a (b) c) R 1 42 42 0 -1 0 0 0 0 0 7 3 0 0 20 0 1 0");
+  ASSERT_TRUE(stat_with_spaces);
+  EXPECT_EQ(stat_with_spaces->name, "a (b) c");
+  EXPECT_EQ(stat_with_spaces->cpu_ticks, 10U);
+
+  EXPECT_FALSE(ProcessSampler::parse_thread_stat(""));
+  EXPECT_FALSE(ProcessSampler::parse_thread_stat("42 (name) S 1 42"));
+}
+
+TEST(ProcessSampler, parse_statm_resident)
+{
+  EXPECT_EQ(ProcessSampler::parse_statm_resident("5000 1200 300 10 0 800 0\n"), 1200U);
+  EXPECT_FALSE(ProcessSampler::parse_statm_resident(""));
+}
+
+TEST(ProcessSampler, sample)
+{
+  ProcessSampler sampler;
+
+  // Keep a thread busy to make its CPU usage visible.
+  std::atomic<bool> running{true};
+  std::thread worker([&running]() {
+    while (running) {
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const auto usage = sampler.sample();
+  running = false;
+  worker.join();
+
+  EXPECT_GT(usage.cpu_cores_utilized, 0.0f);
+  EXPECT_GT(usage.process_memory_bytes, 0U);
+  EXPECT_GE(usage.peak_process_memory_bytes, usage.process_memory_bytes);
+  EXPECT_GE(usage.total_memory_bytes, usage.free_memory_bytes);
+  ASSERT_GE(usage.threads.size(), 2U);
+
+  float max_thread_cpu_cores_utilized = 0.0f;
+  for (const auto & thread : usage.threads) {
+    max_thread_cpu_cores_utilized =
+      std::max(max_thread_cpu_cores_utilized, thread.cpu_cores_utilized);
+  }
+  EXPECT_GT(max_thread_cpu_cores_utilized, 0.5f);
+}
+}  // namespace autoware::component_monitor
@@ -19,7 +19,10 @@
 #include "loader.hpp"
 #include "units.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <unordered_map>
+#include <vector>
 
 namespace diagnostic_graph_aggregator
 {
@@ -34,22 +37,124 @@ void Graph::create(const std::string & file, const std::string & id)
   for (const auto & node : nodes_) units_.push_back(node.get());
   for (const auto & diag : diags_) units_.push_back(diag.get());
 
+  // Rank the units so that the parents always have larger ranks than the children.
+  std::vector<size_t> degrees(units_.size());
+  std::deque<BaseUnit *> buffer;
+  ranks_.assign(units_.size(), 0);
+  for (const auto & unit : units_) {
+    degrees[unit_id(unit)] = unit->child_links().size();
+    if (degrees[unit_id(unit)] == 0) buffer.push_back(unit);
+  }
+  while (!buffer.empty()) {
+    const auto unit = buffer.front();
+    buffer.pop_front();
+    for (const auto & link : unit->parent_links()) {
+      const auto parent = link->parent();
+      ranks_[unit_id(parent)] = std::max(ranks_[unit_id(parent)], ranks_[unit_id(unit)] + 1);
+      if (--degrees[unit_id(parent)] == 0) buffer.push_back(parent);
+    }
+  }
+  const auto max_rank = std::max_element(ranks_.begin(), ranks_.end());
+  dirty_units_.resize(max_rank == ranks_.end() ? 0 : *max_rank + 1);
+  dirty_flags_.assign(units_.size(), false);
+  changed_flags_.assign(units_.size(), false);
+  timeout_flags_.assign(diags_.size(), false);
+
+  // Update all units once to initialize the status.
+  for (const auto & unit : units_) mark_dirty(unit);
+  propagate();
+  for (const auto & unit : changed_units_) changed_flags_[unit_id(unit)] = false;
+  changed_units_.clear();
+
   id_ = id;
 }
 
 void Graph::update(const rclcpp::Time & stamp)
 {
-  for (const auto & diag : diags_) diag->on_time(stamp);
+  // Check only the diags whose timeout stamps have passed. The diags that have been received
+  // again after scheduling are rescheduled with the new timeout stamps.
+  std::vector<DiagUnit *> pending;
+  while (!timeouts_.empty() && timeouts_.top().first < stamp.nanoseconds()) {
+    const auto diag = timeouts_.top().second;
+    timeouts_.pop();
+    timeout_flags_[diag->index()] = false;
+    if (diag->on_time(stamp)) {
+      mark_changed(diag);
+      mark_dirty(diag);
+    } else {
+      pending.push_back(diag);
+    }
+  }
+  for (const auto & diag : pending) schedule_timeout(diag);
+  propagate();
 }
 
 bool Graph::update(const rclcpp::Time & stamp, const DiagnosticStatus & status)
 {
+  const auto result = receive(stamp, status);
+  propagate();
+  return result;
+}
+
+bool Graph::receive(const rclcpp::Time & stamp, const DiagnosticStatus & status)
+{
+  // The received status is propagated to the parents at the next update.
   const auto iter = names_.find(status.name);
   if (iter == names_.end()) return false;
-  iter->second->on_diag(stamp, status);
+  const auto diag = iter->second;
+  diag->on_diag(stamp, status);
+  mark_changed(diag);
+  mark_dirty(diag);
+  schedule_timeout(diag);
   return true;
 }
 
+size_t Graph::unit_id(const BaseUnit * unit) const
+{
+  // The units are stored in the order of nodes and diags.
+  return unit->is_leaf() ? nodes_.size() + unit->index() : unit->index();
+}
+
+void Graph::mark_dirty(BaseUnit * unit)
+{
+  const auto id = unit_id(unit);
+  if (dirty_flags_[id]) return;
+  dirty_flags_[id] = true;
+  dirty_units_[ranks_[id]].push_back(unit);
+}
+
+void Graph::mark_changed(BaseUnit * unit)
+{
+  const auto id = unit_id(unit);
+  if (changed_flags_[id]) return;
+  changed_flags_[id] = true;
+  changed_units_.push_back(unit);
+}
+
+void Graph::schedule_timeout(DiagUnit * diag)
+{
+  if (timeout_flags_[diag->index()]) return;
+  const auto timeout = diag->timeout_stamp();
+  if (!timeout) return;
+  timeout_flags_[diag->index()] = true;
+  timeouts_.emplace(timeout->nanoseconds(), diag);
+}
+
+void Graph::propagate()
+{
+  // Since the parents have larger ranks, each unit is updated at most once after all children.
+  for (size_t rank = 0; rank < dirty_units_.size(); ++rank) {
+    auto & units = dirty_units_[rank];
+    for (const auto & unit : units) {
+      dirty_flags_[unit_id(unit)] = false;
+      if (!unit->update()) continue;
+      mark_changed(unit);
+      for (const auto & link : unit->parent_links()) mark_dirty(link->parent());
+    }
+    units.clear();
+  }
+}
+
 DiagGraphStruct Graph::create_struct(const rclcpp::Time & stamp) const
 {
   DiagGraphStruct msg;
@@ -72,6 +177,30 @@ DiagGraphStatus Graph::create_status(const rclcpp::Time & stamp) const
   return msg;
 }
 
+bool Graph::sync_status(DiagGraphStatus & msg)
+{
+  // Copy the status of the changed units only if the message has been created by this graph.
+  const auto is_created = msg.id == id_ && msg.nodes.size() == nodes_.size() &&
+                          msg.diags.size() == diags_.size() && msg.links.size() == links_.size();
+  if (!is_created) {
+    msg = create_status(msg.stamp);
+  } else {
+    for (const auto & unit : changed_units_) {
+      const auto index = unit->index();
+      if (unit->is_leaf()) {
+        msg.diags[index] = diags_[index]->create_status();
+      } else {
+        msg.nodes[index] = nodes_[index]->create_status();
+      }
+    }
+  }
+
+  const auto result = !is_created || !changed_units_.empty();
+  for (const auto & unit : changed_units_) changed_flags_[unit_id(unit)] = false;
+  changed_units_.clear();
+  return result;
+}
+
 // For unique_ptr members.
 Graph::Graph() = default;
 Graph::~Graph() = default;
@@ -19,9 +19,13 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <queue>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace diagnostic_graph_aggregator
@@ -33,16 +37,24 @@ public:
   void create(const std::string & file, const std::string & id = "");
   void update(const rclcpp::Time & stamp);  // cppcheck-suppress functionConst
   bool update(const rclcpp::Time & stamp, const DiagnosticStatus & status);
+  bool receive(const rclcpp::Time & stamp, const DiagnosticStatus & status);
   const auto & nodes() const { return nodes_; }
   const auto & diags() const { return diags_; }
   const auto & units() const { return units_; }
   DiagGraphStruct create_struct(const rclcpp::Time & stamp) const;
   DiagGraphStatus create_status(const rclcpp::Time & stamp) const;
+  bool sync_status(DiagGraphStatus & msg);
 
   Graph();   // For unique_ptr members.
   ~Graph();  // For unique_ptr members.
 
 private:
+  size_t unit_id(const BaseUnit * unit) const;
+  void mark_dirty(BaseUnit * unit);
+  void mark_changed(BaseUnit * unit);
+  void schedule_timeout(DiagUnit * diag);
+  void propagate();
+
   // Note: keep order correspondence between links and unit children for viewer.
   std::vector<std::unique_ptr<NodeUnit>> nodes_;
   std::vector<std::unique_ptr<DiagUnit>> diags_;
@@ -50,6 +62,22 @@ private:
   std::vector<BaseUnit *> units_;
   std::unordered_map<std::string, DiagUnit *> names_;
   std::string id_;
+
+  // The units to be updated, grouped by the rank that is larger than the ranks of the children.
+  std::vector<size_t> ranks_;
+  std::vector<std::vector<BaseUnit *>> dirty_units_;
+  std::vector<uint8_t> dirty_flags_;
+
+  // The units whose status has changed since the last status synchronization.
+  std::vector<BaseUnit *> changed_units_;
+  std::vector<uint8_t> changed_flags_;
+
+  // The diags waiting for timeout, ordered by the timeout stamp in nanoseconds.
+  using TimeoutItem = std::pair<int64_t, DiagUnit *>;
+  using TimeoutQueue =
+    std::priority_queue<TimeoutItem, std::vector<TimeoutItem>, std::greater<TimeoutItem>>;
+  TimeoutQueue timeouts_;
+  std::vector<uint8_t> timeout_flags_;
 };
 
 }  // namespace diagnostic_graph_aggregator
@@ -57,8 +57,7 @@ public:
   virtual bool is_leaf() const = 0;
   size_t index() const { return index_; }
   size_t parent_size() const { return parents_.size(); }
-
-protected:
+  const std::vector<UnitLink *> & parent_links() const { return parents_; }
   bool update();
 
 private:
@@ -110,7 +109,8 @@ public:
   std::string type() const override { return unit_name::diag; }
   std::vector<UnitLink *> child_links() const override { return {}; }
   bool on_time(const rclcpp::Time & stamp);
-  bool on_diag(const rclcpp::Time & stamp, const DiagnosticStatus & status);
+  void on_diag(const rclcpp::Time & stamp, const DiagnosticStatus & status);
+  std::optional<rclcpp::Time> timeout_stamp() const;
 
 private:
   void update_status() override;
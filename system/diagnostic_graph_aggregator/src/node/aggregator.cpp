@@ -50,6 +50,8 @@ AggregatorNode::AggregatorNode(const rclcpp::NodeOptions & options) : Node("aggr
     pub_struct_ = create_publisher<DiagGraphStruct>("/diagnostics_graph/struct", qos_struct);
     pub_status_ = create_publisher<DiagGraphStatus>("/diagnostics_graph/status", qos_status);
 
+    status_snapshot_period_ = declare_parameter<double>("status_snapshot_period");
+
     const auto rate = rclcpp::Rate(declare_parameter<double>("rate"));
     timer_ = rclcpp::create_timer(this, get_clock(), rate.period(), [this]() { on_timer(); });
   }
@@ -73,12 +75,20 @@ DiagnosticArray AggregatorNode::create_unknown_diags(const rclcpp::Time & stamp)
 
 void AggregatorNode::on_timer()
 {
-  // Check timeout of diag units.
+  // Check timeout of diag units and propagate the received status.
   const auto stamp = now();
   graph_.update(stamp);
 
-  // Publish status.
-  pub_status_->publish(graph_.create_status(stamp));
+  // Publish status. The unchanged status is skipped until the snapshot period elapses.
+  const auto is_changed = graph_.sync_status(status_);
+  const auto is_expired =
+    !status_publish_stamp_ ||
+    status_snapshot_period_ <= (stamp - status_publish_stamp_.value()).seconds();
+  if (is_changed || is_expired) {
+    status_.stamp = stamp;
+    pub_status_->publish(status_);
+    status_publish_stamp_ = stamp;
+  }
   pub_unknown_->publish(create_unknown_diags(stamp));
   if (modes_) modes_->update(stamp);
 }
@@ -86,9 +96,10 @@ void AggregatorNode::on_timer()
 void AggregatorNode::on_diag(const DiagnosticArray & msg)
 {
   // Update status. Store it as unknown if it does not exist in the graph.
+  // The status is propagated to the parent units at the next timer event.
   const auto & stamp = msg.header.stamp;
   for (const auto & status : msg.status) {
-    if (!graph_.update(stamp, status)) {
+    if (!graph_.receive(stamp, status)) {
       unknown_diags_[status.name] = status;
     }
   }
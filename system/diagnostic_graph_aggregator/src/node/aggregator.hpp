@@ -21,6 +21,7 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -46,6 +47,9 @@ private:
   void on_diag(const DiagnosticArray & msg);
 
   std::unordered_map<std::string, DiagnosticStatus> unknown_diags_;
+  DiagGraphStatus status_;
+  double status_snapshot_period_;
+  std::optional<rclcpp::Time> status_publish_stamp_;
 };
 
 }  // namespace diagnostic_graph_aggregator
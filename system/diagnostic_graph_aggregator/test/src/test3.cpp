@@ -0,0 +1,129 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph/graph.hpp"
+#include "graph/units.hpp"
+#include "utils.hpp"
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace diagnostic_graph_aggregator;  // NOLINT(build/namespaces)
+
+using diagnostic_msgs::msg::DiagnosticStatus;
+
+constexpr auto OK = DiagnosticStatus::OK;
+constexpr auto WARN = DiagnosticStatus::WARN;
+constexpr auto ERROR = DiagnosticStatus::ERROR;
+constexpr auto STALE = DiagnosticStatus::STALE;
+
+DiagnosticStatus create_input(size_t index, uint8_t level)
+{
+  DiagnosticStatus status;
+  status.level = level;
+  status.name = "test: input-" + std::to_string(index);
+  return status;
+}
+
+uint8_t get_output(const Graph & graph, const DiagGraphStatus & status)
+{
+  for (const auto & node : graph.nodes()) {
+    if (node->path() == "output") {
+      return status.nodes[node->index()].level;
+    }
+  }
+  throw std::runtime_error("output node is not found");
+}
+
+DiagnosticLevel get_input(const Graph & graph, size_t index)
+{
+  for (const auto & diag : graph.diags()) {
+    if (diag->name() == "test: input-" + std::to_string(index)) {
+      return diag->level();
+    }
+  }
+  throw std::runtime_error("input diag is not found");
+}
+
+void expect_same_status(const DiagGraphStatus & status1, const DiagGraphStatus & status2)
+{
+  ASSERT_EQ(status1.nodes.size(), status2.nodes.size());
+  ASSERT_EQ(status1.diags.size(), status2.diags.size());
+  for (size_t i = 0; i < status1.nodes.size(); ++i) {
+    EXPECT_EQ(status1.nodes[i].level, status2.nodes[i].level);
+  }
+  for (size_t i = 0; i < status1.diags.size(); ++i) {
+    EXPECT_EQ(status1.diags[i].level, status2.diags[i].level);
+    EXPECT_EQ(status1.diags[i].message, status2.diags[i].message);
+  }
+}
+
+TEST(Incremental, Timeout)
+{
+  const auto stamp = rclcpp::Time(1000, 0);
+  const auto duration = [](double seconds) { return rclcpp::Duration::from_seconds(seconds); };
+  Graph graph;
+  graph.create(resource("test2/and.yaml"));
+  EXPECT_EQ(get_output(graph, graph.create_status(stamp)), ERROR);
+
+  // The received status is propagated at the next update.
+  graph.receive(stamp, create_input(0, OK));
+  graph.receive(stamp, create_input(1, OK));
+  EXPECT_EQ(get_output(graph, graph.create_status(stamp)), ERROR);
+  graph.update(stamp + duration(0.5));
+  EXPECT_EQ(get_output(graph, graph.create_status(stamp)), OK);
+
+  // The input received again is not timed out.
+  graph.receive(stamp + duration(0.8), create_input(1, WARN));
+  graph.update(stamp + duration(1.5));
+  EXPECT_EQ(get_output(graph, graph.create_status(stamp)), ERROR);
+  EXPECT_EQ(get_input(graph, 0), STALE);
+  EXPECT_EQ(get_input(graph, 1), WARN);
+
+  graph.update(stamp + duration(2.0));
+  EXPECT_EQ(get_input(graph, 1), STALE);
+}
+
+TEST(Incremental, SyncStatus)
+{
+  const auto stamp = rclcpp::Time(1000, 0);
+  Graph graph;
+  graph.create(resource("test2/and.yaml"), "test");
+
+  // The first synchronization creates the whole message.
+  DiagGraphStatus status;
+  EXPECT_TRUE(graph.sync_status(status));
+  expect_same_status(status, graph.create_status(stamp));
+  EXPECT_FALSE(graph.sync_status(status));
+
+  // Only the changed units are copied.
+  auto input = create_input(0, WARN);
+  input.message = "warn";
+  graph.update(stamp, input);
+  graph.update(stamp, create_input(1, OK));
+  EXPECT_TRUE(graph.sync_status(status));
+  expect_same_status(status, graph.create_status(stamp));
+  EXPECT_EQ(get_output(graph, status), WARN);
+  EXPECT_FALSE(graph.sync_status(status));
+
+  // The status with the same level is also copied because the message may change.
+  input.message = "still warn";
+  graph.update(stamp, input);
+  EXPECT_TRUE(graph.sync_status(status));
+  expect_same_status(status, graph.create_status(stamp));
+}
@@ -15,6 +15,7 @@
 #ifndef AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 #define AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 
+#include "autoware_raw_vehicle_cmd_converter/compiled_map.hpp"
 #include "autoware_raw_vehicle_cmd_converter/csv_loader.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -44,6 +45,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  CompiledMap compiled_map_;
 };
 }  // namespace autoware::raw_vehicle_cmd_converter
 
@@ -15,6 +15,7 @@
 #ifndef AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 #define AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 
+#include "autoware_raw_vehicle_cmd_converter/compiled_map.hpp"
 #include "autoware_raw_vehicle_cmd_converter/csv_loader.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -45,6 +46,7 @@ private:
   std::vector<double> brake_index_;
   std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  CompiledMap compiled_map_;
 };
 }  // namespace autoware::raw_vehicle_cmd_converter
 
@@ -0,0 +1,86 @@
+//  Copyright 2024 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__COMPILED_MAP_HPP_
+#define AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__COMPILED_MAP_HPP_
+
+#include "autoware_raw_vehicle_cmd_converter/csv_loader.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::raw_vehicle_cmd_converter
+{
+/**
+ * @brief Actuation map in contiguous storage for lookups without heap allocation.
+ *
+ * The value at (x_index[j], y_index[i]) is stored at i * x_size + j, where x is the header row of
+ * the CSV (e.g. velocity) and y is the first column (e.g. throttle). The segment of an index is
+ * found in constant time from its mean step, which is exact for uniform grids, and by binary
+ * search otherwise. The interpolation is the same arithmetic as interpolation::lerp, so the
+ * results are identical to interpolating the rows of the CSV map.
+ */
+class CompiledMap
+{
+public:
+  struct Segment
+  {
+    size_t index;
+    double ratio;
+  };
+
+  CompiledMap() = default;
+  CompiledMap(
+    const std::vector<double> & x_index, const std::vector<double> & y_index, const Map & map);
+
+  bool empty() const { return values_.empty(); }
+  size_t x_size() const { return x_index_.size(); }
+  size_t y_size() const { return y_index_.size(); }
+
+  /**
+   * @brief Find the segment of the x index for the value within the range of the index.
+   */
+  Segment getXSegment(const double x) const;
+
+  /**
+   * @brief Interpolate the row along x. This is the value at (x, y_index[y]).
+   */
+  double getRowValue(const size_t y, const Segment & x_segment) const;
+
+  /**
+   * @brief Interpolate the value at (x, y) for y within the range of the y index.
+   */
+  double getValue(const Segment & x_segment, const double y) const;
+
+  /**
+   * @brief Find y such that the value at (x, y) is the given value by the inverse interpolation.
+   * @param value the value between the first and the last row values at x
+   * @param is_decreasing whether the row values at x decrease along the y index
+   */
+  double getInverseValue(
+    const Segment & x_segment, const double value, const bool is_decreasing) const;
+
+private:
+  std::vector<double> x_index_;
+  std::vector<double> y_index_;
+  std::vector<double> values_;
+  double x_inv_step_{0.0};
+  double y_inv_step_{0.0};
+
+  static double getInverseStep(const std::vector<double> & index);
+  static Segment getSegment(const std::vector<double> & index, double inv_step, double key);
+};
+}  // namespace autoware::raw_vehicle_cmd_converter
+
+#endif  // AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__COMPILED_MAP_HPP_
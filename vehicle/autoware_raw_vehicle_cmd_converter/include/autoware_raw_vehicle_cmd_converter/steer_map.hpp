@@ -15,6 +15,7 @@
 #ifndef AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__STEER_MAP_HPP_
 #define AUTOWARE_RAW_VEHICLE_CMD_CONVERTER__STEER_MAP_HPP_
 
+#include "autoware_raw_vehicle_cmd_converter/compiled_map.hpp"
 #include "autoware_raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "autoware_raw_vehicle_cmd_converter/pid.hpp"
 
@@ -30,12 +31,16 @@ class SteerMap
 public:
   bool readSteerMapFromCSV(const std::string & csv_path, const bool validation = false);
   void getSteer(const double steer_rate, const double steer, double & output) const;
+  std::vector<double> getSteerIdx() const { return steer_index_; }
+  std::vector<double> getOutputIdx() const { return output_index_; }
+  std::vector<std::vector<double>> getSteerMap() const { return steer_map_; }
 
 private:
   std::string vehicle_name_;
   std::vector<double> steer_index_;
   std::vector<double> output_index_;
   std::vector<std::vector<double>> steer_map_;
+  CompiledMap compiled_map_;
   rclcpp::Logger logger_{
     rclcpp::get_logger("autoware_raw_vehicle_cmd_converter").get_child("steer_map")};
 };
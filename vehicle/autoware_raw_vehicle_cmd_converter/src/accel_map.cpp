@@ -14,8 +14,6 @@
 
 #include "autoware_raw_vehicle_cmd_converter/accel_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
 #include <algorithm>
 #include <chrono>
 #include <string>
@@ -41,45 +39,41 @@ bool AccelMap::readAccelMapFromCSV(const std::string & csv_path, const bool vali
   if (validation && !CSVLoader::validateMap(accel_map_, true)) {
     return false;
   }
+  compiled_map_ = CompiledMap(vel_index_, throttle_index_, accel_map_);
   return true;
 }
 
 bool AccelMap::getThrottle(const double acc, double vel, double & throttle) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
-  // calculate throttle
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "throttle: vel");
+  const auto vel_segment = compiled_map_.getXSegment(clamped_vel);
+
+  // calculate throttle from the (throttle, acc) map by fixing vel
   // When the desired acceleration is smaller than the throttle area, return false => brake sequence
   // When the desired acceleration is greater than the throttle area, return max throttle
-  if (acc < interpolated_acc_vec.front()) {
+  if (acc < compiled_map_.getRowValue(0, vel_segment)) {
     return false;
-  } else if (interpolated_acc_vec.back() < acc) {
+  } else if (compiled_map_.getRowValue(throttle_index_.size() - 1, vel_segment) < acc) {
     throttle = throttle_index_.back();
     return true;
   }
-  throttle = interpolation::lerp(interpolated_acc_vec, throttle_index_, acc);
+  throttle = compiled_map_.getInverseValue(vel_segment, acc, false);
   return true;
 }
 
 bool AccelMap::getAcceleration(const double throttle, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "throttle: vel");
+  const auto vel_segment = compiled_map_.getXSegment(clamped_vel);
 
-  // calculate throttle
-  // When the desired acceleration is smaller than the throttle area, return min acc
-  // When the desired acceleration is greater than the throttle area, return max acc
-  const double clamped_throttle = CSVLoader::clampValue(throttle, throttle_index_, "throttle: acc");
-  acc = interpolation::lerp(throttle_index_, interpolated_acc_vec, clamped_throttle);
+  // calculate acc from the (throttle, acc) map by fixing vel
+  // When the desired throttle is smaller than the throttle area, return min acc
+  // When the desired throttle is greater than the throttle area, return max acc
+  const double clamped_throttle = CSVLoader::clampValue(
+    throttle, throttle_index_.front(), throttle_index_.back(), "throttle: acc");
+  acc = compiled_map_.getValue(vel_segment, clamped_throttle);
 
   return true;
 }
@@ -14,8 +14,6 @@
 
 #include "autoware_raw_vehicle_cmd_converter/brake_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
 #include <algorithm>
 #include <string>
 #include <vector>
@@ -40,57 +38,52 @@ bool BrakeMap::readBrakeMapFromCSV(const std::string & csv_path, const bool vali
     return false;
   }
   std::reverse(std::begin(brake_index_rev_), std::end(brake_index_rev_));
+  compiled_map_ = CompiledMap(vel_index_, brake_index_, brake_map_);
 
   return true;
 }
 
 bool BrakeMap::getBrake(const double acc, const double vel, double & brake)
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "brake: vel");
+  const auto vel_segment = compiled_map_.getXSegment(clamped_vel);
 
-  // calculate brake
+  // calculate brake from the (brake, acc) map by fixing vel
   // When the desired acceleration is smaller than the brake area, return max brake on the map
   // When the desired acceleration is greater than the brake area, return min brake on the map
-  if (acc < interpolated_acc_vec.back()) {
+  const double min_acc = compiled_map_.getRowValue(brake_index_.size() - 1, vel_segment);
+  if (acc < min_acc) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
       "value.",
-      acc, interpolated_acc_vec.back());
+      acc, min_acc);
     brake = brake_index_.back();
     return true;
-  } else if (interpolated_acc_vec.front() < acc) {
+  } else if (compiled_map_.getRowValue(0, vel_segment) < acc) {
     brake = brake_index_.front();
     return true;
   }
 
-  std::reverse(std::begin(interpolated_acc_vec), std::end(interpolated_acc_vec));
-  brake = interpolation::lerp(interpolated_acc_vec, brake_index_rev_, acc);
+  // The acc decreases as the brake increases.
+  brake = compiled_map_.getInverseValue(vel_segment, acc, true);
 
   return true;
 }
 
 bool BrakeMap::getAcceleration(const double brake, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
-  const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
-
-  // calculate brake
-  // When the desired acceleration is smaller than the brake area, return min acc
-  // When the desired acceleration is greater than the brake area, return min acc
-  const double clamped_brake = CSVLoader::clampValue(brake, brake_index_, "brake: acc");
-  acc = interpolation::lerp(brake_index_, interpolated_acc_vec, clamped_brake);
+  const double clamped_vel =
+    CSVLoader::clampValue(vel, vel_index_.front(), vel_index_.back(), "brake: vel");
+  const auto vel_segment = compiled_map_.getXSegment(clamped_vel);
+
+  // calculate acc from the (brake, acc) map by fixing vel
+  // When the desired brake is smaller than the brake area, return max acc
+  // When the desired brake is greater than the brake area, return min acc
+  const double clamped_brake =
+    CSVLoader::clampValue(brake, brake_index_.front(), brake_index_.back(), "brake: acc");
+  acc = compiled_map_.getValue(vel_segment, clamped_brake);
 
   return true;
 }
@@ -0,0 +1,114 @@
+//  Copyright 2024 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "autoware_raw_vehicle_cmd_converter/compiled_map.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware::raw_vehicle_cmd_converter
+{
+namespace
+{
+double lerp(const double src_val, const double dst_val, const double ratio)
+{
+  return src_val + (dst_val - src_val) * ratio;
+}
+}  // namespace
+
+CompiledMap::CompiledMap(
+  const std::vector<double> & x_index, const std::vector<double> & y_index, const Map & map)
+: x_index_(x_index), y_index_(y_index)
+{
+  values_.reserve(x_index_.size() * y_index_.size());
+  for (const auto & row : map) {
+    values_.insert(values_.end(), row.begin(), row.end());
+  }
+  x_inv_step_ = getInverseStep(x_index_);
+  y_inv_step_ = getInverseStep(y_index_);
+}
+
+double CompiledMap::getInverseStep(const std::vector<double> & index)
+{
+  if (index.size() < 2 || index.back() <= index.front()) {
+    return 0.0;
+  }
+  return static_cast<double>(index.size() - 1) / (index.back() - index.front());
+}
+
+CompiledMap::Segment CompiledMap::getSegment(
+  const std::vector<double> & index, const double inv_step, const double key)
+{
+  // Same as interpolation::lerp, the segment is the first one whose end is not less than the key.
+  if (index.size() < 2) {
+    throw std::invalid_argument("The size of points is less than 2.");
+  }
+  const size_t last = index.size() - 2;
+  const double guess = (key - index.front()) * inv_step;
+  size_t i = std::min(static_cast<size_t>(std::max(guess, 0.0)), last);
+  if (index[i + 1] < key || (0 < i && key <= index[i])) {
+    i = std::lower_bound(index.begin() + 1, index.end() - 1, key) - index.begin() - 1;
+  }
+  return Segment{i, (key - index[i]) / (index[i + 1] - index[i])};
+}
+
+CompiledMap::Segment CompiledMap::getXSegment(const double x) const
+{
+  return getSegment(x_index_, x_inv_step_, x);
+}
+
+double CompiledMap::getRowValue(const size_t y, const Segment & x_segment) const
+{
+  const double * row = values_.data() + y * x_index_.size() + x_segment.index;
+  return lerp(row[0], row[1], x_segment.ratio);
+}
+
+double CompiledMap::getValue(const Segment & x_segment, const double y) const
+{
+  const auto y_segment = getSegment(y_index_, y_inv_step_, y);
+  return lerp(
+    getRowValue(y_segment.index, x_segment), getRowValue(y_segment.index + 1, x_segment),
+    y_segment.ratio);
+}
+
+double CompiledMap::getInverseValue(
+  const Segment & x_segment, const double value, const bool is_decreasing) const
+{
+  // The row values at x are evaluated only on the path of the binary search. For the decreasing
+  // values, the rows are searched in the reverse order as interpolating the reversed vectors.
+  const size_t size = y_index_.size();
+  if (size < 2) {
+    throw std::invalid_argument("The size of points is less than 2.");
+  }
+  const auto row = [&](const size_t k) { return is_decreasing ? size - 1 - k : k; };
+  size_t first = 1;
+  size_t count = size - 2;
+  while (0 < count) {
+    const size_t step = count / 2;
+    if (getRowValue(row(first + step), x_segment) < value) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  const size_t k = first - 1;
+  const double src_value = getRowValue(row(k), x_segment);
+  const double dst_value = getRowValue(row(k + 1), x_segment);
+  const double ratio = (value - src_value) / (dst_value - src_value);
+  return lerp(y_index_[row(k)], y_index_[row(k + 1)], ratio);
+}
+}  // namespace autoware::raw_vehicle_cmd_converter
@@ -14,8 +14,7 @@
 
 #include "autoware_raw_vehicle_cmd_converter/steer_map.hpp"
 
-#include "interpolation/linear_interpolation.hpp"
-
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -38,19 +37,24 @@ bool SteerMap::readSteerMapFromCSV(const std::string & csv_path, const bool vali
   if (validation && !CSVLoader::validateMap(steer_map_, true)) {
     return false;
   }
+  compiled_map_ = CompiledMap(steer_index_, output_index_, steer_map_);
   return true;
 }
 
 void SteerMap::getSteer(const double steer_rate, const double steer, double & output) const
 {
-  const double clamped_steer = CSVLoader::clampValue(steer, steer_index_, "steer: steer");
-  std::vector<double> steer_rate_interp = {};
-  for (const auto & steer_rate_vec : steer_map_) {
-    steer_rate_interp.push_back(interpolation::lerp(steer_index_, steer_rate_vec, clamped_steer));
-  }
-
+  const double clamped_steer =
+    CSVLoader::clampValue(steer, steer_index_.front(), steer_index_.back(), "steer: steer");
+  const auto steer_segment = compiled_map_.getXSegment(clamped_steer);
+
+  // calculate output from the (output, steer_rate) map by fixing steer
+  // the steer rates increase along the output for a valid map, so that the first and last rows are
+  // the bounds of the steer rates, in either order
+  const double first_steer_rate = compiled_map_.getRowValue(0, steer_segment);
+  const double last_steer_rate = compiled_map_.getRowValue(output_index_.size() - 1, steer_segment);
+  const auto [min_steer_rate, max_steer_rate] = std::minmax(first_steer_rate, last_steer_rate);
   const double clamped_steer_rate =
-    CSVLoader::clampValue(steer_rate, steer_rate_interp, "steer: steer_rate");
-  output = interpolation::lerp(steer_rate_interp, output_index_, clamped_steer_rate);
+    CSVLoader::clampValue(steer_rate, min_steer_rate, max_steer_rate, "steer: steer_rate");
+  output = compiled_map_.getInverseValue(steer_segment, clamped_steer_rate, false);
 }
 }  // namespace autoware::raw_vehicle_cmd_converter
@@ -18,9 +18,14 @@
 #include "autoware_raw_vehicle_cmd_converter/pid.hpp"
 #include "autoware_raw_vehicle_cmd_converter/steer_map.hpp"
 #include "gtest/gtest.h"
+#include "interpolation/linear_interpolation.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 /*
  * Throttle data: (vel, throttle -> acc)
@@ -232,6 +237,155 @@ TEST(ConverterTests, SteerMapCalculation)
   EXPECT_DOUBLE_EQ(calcSteer(5.0, 5.0), 5.0);
 }
 
+// The lookups in the CSV map representation as reference to the compiled map
+namespace reference
+{
+using autoware::raw_vehicle_cmd_converter::CSVLoader;
+using autoware::raw_vehicle_cmd_converter::Map;
+
+std::vector<double> interpolateRows(
+  const Map & map, const std::vector<double> & x_index, const double x)
+{
+  std::vector<double> values;
+  for (const auto & row : map) {
+    values.push_back(interpolation::lerp(x_index, row, x));
+  }
+  return values;
+}
+
+bool getThrottle(const AccelMap & accel_map, const double acc, const double vel, double & throttle)
+{
+  const auto vel_index = accel_map.getVelIdx();
+  const auto throttle_index = accel_map.getThrottleIdx();
+  const double clamped_vel = CSVLoader::clampValue(vel, vel_index, "throttle: vel");
+  const auto accs = interpolateRows(accel_map.getAccelMap(), vel_index, clamped_vel);
+  if (acc < accs.front()) {
+    return false;
+  } else if (accs.back() < acc) {
+    throttle = throttle_index.back();
+    return true;
+  }
+  throttle = interpolation::lerp(accs, throttle_index, acc);
+  return true;
+}
+
+double getAccelAcceleration(const AccelMap & accel_map, const double throttle, const double vel)
+{
+  const auto vel_index = accel_map.getVelIdx();
+  const auto throttle_index = accel_map.getThrottleIdx();
+  const double clamped_vel = CSVLoader::clampValue(vel, vel_index, "throttle: vel");
+  const auto accs = interpolateRows(accel_map.getAccelMap(), vel_index, clamped_vel);
+  const double clamped_throttle = CSVLoader::clampValue(throttle, throttle_index, "throttle: acc");
+  return interpolation::lerp(throttle_index, accs, clamped_throttle);
+}
+
+double getBrake(const BrakeMap & brake_map, const double acc, const double vel)
+{
+  const auto vel_index = brake_map.getVelIdx();
+  auto brake_index = brake_map.getBrakeIdx();
+  const double clamped_vel = CSVLoader::clampValue(vel, vel_index, "brake: vel");
+  auto accs = interpolateRows(brake_map.getBrakeMap(), vel_index, clamped_vel);
+  if (acc < accs.back()) {
+    return brake_index.back();
+  } else if (accs.front() < acc) {
+    return brake_index.front();
+  }
+  std::reverse(accs.begin(), accs.end());
+  std::reverse(brake_index.begin(), brake_index.end());
+  return interpolation::lerp(accs, brake_index, acc);
+}
+
+double getBrakeAcceleration(const BrakeMap & brake_map, const double brake, const double vel)
+{
+  const auto vel_index = brake_map.getVelIdx();
+  const auto brake_index = brake_map.getBrakeIdx();
+  const double clamped_vel = CSVLoader::clampValue(vel, vel_index, "brake: vel");
+  const auto accs = interpolateRows(brake_map.getBrakeMap(), vel_index, clamped_vel);
+  const double clamped_brake = CSVLoader::clampValue(brake, brake_index, "brake: acc");
+  return interpolation::lerp(brake_index, accs, clamped_brake);
+}
+
+double getSteer(const SteerMap & steer_map, const double steer_rate, const double steer)
+{
+  const auto steer_index = steer_map.getSteerIdx();
+  const double clamped_steer = CSVLoader::clampValue(steer, steer_index, "steer: steer");
+  const auto steer_rates = interpolateRows(steer_map.getSteerMap(), steer_index, clamped_steer);
+  const double clamped_steer_rate =
+    CSVLoader::clampValue(steer_rate, steer_rates, "steer: steer_rate");
+  return interpolation::lerp(steer_rates, steer_map.getOutputIdx(), clamped_steer_rate);
+}
+}  // namespace reference
+
+TEST(ConverterTests, CompiledMapMatchesCSVMap)
+{
+  const auto data_path =
+    ament_index_cpp::get_package_share_directory("autoware_raw_vehicle_cmd_converter") +
+    "/data/default/";
+
+  for (const auto & path : {data_path + "accel_map.csv", map_path + "test_accel_map.csv"}) {
+    AccelMap accel_map;
+    ASSERT_TRUE(accel_map.readAccelMapFromCSV(path));
+    for (double vel = -1.0; vel <= 21.0; vel += 0.125) {
+      for (double acc = -1.0; acc <= 4.0; acc += 0.0625) {
+        double expected = -1.0;
+        double actual = -1.0;
+        EXPECT_EQ(
+          reference::getThrottle(accel_map, acc, vel, expected),
+          accel_map.getThrottle(acc, vel, actual));
+        EXPECT_DOUBLE_EQ(expected, actual);
+      }
+      for (double throttle = -0.1; throttle <= 1.1; throttle += 0.03125) {
+        double actual = 0.0;
+        accel_map.getAcceleration(throttle, vel, actual);
+        EXPECT_DOUBLE_EQ(reference::getAccelAcceleration(accel_map, throttle, vel), actual);
+      }
+    }
+  }
+
+  for (const auto & path : {data_path + "brake_map.csv", map_path + "test_brake_map.csv"}) {
+    BrakeMap brake_map;
+    ASSERT_TRUE(brake_map.readBrakeMapFromCSV(path));
+    for (double vel = -1.0; vel <= 21.0; vel += 0.125) {
+      for (double acc = -4.0; acc <= 1.0; acc += 0.0625) {
+        double actual = 0.0;
+        brake_map.getBrake(acc, vel, actual);
+        EXPECT_DOUBLE_EQ(reference::getBrake(brake_map, acc, vel), actual);
+      }
+      for (double brake = -0.1; brake <= 1.1; brake += 0.03125) {
+        double actual = 0.0;
+        brake_map.getAcceleration(brake, vel, actual);
+        EXPECT_DOUBLE_EQ(reference::getBrakeAcceleration(brake_map, brake, vel), actual);
+      }
+    }
+  }
+
+  // the steer and the steer rate go out of the range of both maps on both ends
+  for (const auto & path : {data_path + "steer_map.csv", map_path + "test_steer_map.csv"}) {
+    SteerMap steer_map;
+    ASSERT_TRUE(steer_map.readSteerMapFromCSV(path, true));
+    const auto steer_index = steer_map.getSteerIdx();
+    const double steer_margin = 0.2 * (steer_index.back() - steer_index.front());
+    const double steer_step = (steer_index.back() - steer_index.front()) / 64.0;
+    double min_steer_rate = std::numeric_limits<double>::max();
+    double max_steer_rate = std::numeric_limits<double>::lowest();
+    for (const auto & row : steer_map.getSteerMap()) {
+      min_steer_rate = std::min(min_steer_rate, *std::min_element(row.begin(), row.end()));
+      max_steer_rate = std::max(max_steer_rate, *std::max_element(row.begin(), row.end()));
+    }
+    const double steer_rate_margin = 0.2 * (max_steer_rate - min_steer_rate);
+    const double steer_rate_step = (max_steer_rate - min_steer_rate) / 64.0;
+    for (double steer = steer_index.front() - steer_margin;
+         steer <= steer_index.back() + steer_margin; steer += steer_step) {
+      for (double steer_rate = min_steer_rate - steer_rate_margin;
+           steer_rate <= max_steer_rate + steer_rate_margin; steer_rate += steer_rate_step) {
+        double actual = 0.0;
+        steer_map.getSteer(steer_rate, steer, actual);
+        EXPECT_DOUBLE_EQ(reference::getSteer(steer_map, steer_rate, steer), actual);
+      }
+    }
+  }
+}
+
 TEST(PIDTests, calculateFB)
 {
   PIDController steer_pid;